@@ -9,9 +9,12 @@
 #include "../Combat/CombatFormulas.h"
 #include "../Combat/CombatMessenger.h"
 #include "../Combat/SpellCaster.h"
+#include "../Combat/SpellDescriptor.h"
+#include "../Combat/SpellEffects.h"
 #include "../Combat/SpellUtils.h"
 #include "../Database/GameData.h"
 #include "../Core/Logger.h"
+#include "../Core/Random.h"
 #include "GamePacketServer.h"
 #include "StlBuffer.h"
 #include "ObjDefines.h"
@@ -23,6 +26,7 @@
 
 // Forward declarations for helper functions
 static void broadcastNpcMovement(Npc* npc, float targetX, float targetY);
+static void broadcastNpcMovement(Npc* npc, const StlBuffer& splineTail);
 
 // ============================================================================
 // NpcAI Namespace Implementation
@@ -190,31 +194,47 @@ Player* NpcAI::findAggroTarget(Npc* npc)
     if (!npc)
         return nullptr;
 
-    float aggroRange = npc->getAggroRange();
-    int mapId = npc->getMapId();
+    // Picked earlier this tick by the parallel pass. Players only die (never
+    // move or revive) while NPCs update, so the pick stands unless it died.
+    Player* candidate = nullptr;
+    if (npc->takeAggroCandidate(candidate) && (!candidate || !candidate->isDead()))
+        return candidate;
+
+    // Get all living players on the same map
+    std::vector<const PlayerHotState*> players;
+    for (Player* player : sWorldManager.getPlayersOnMap(npc->getMapId()))
+    {
+        if (player && !player->isDead())
+            players.push_back(&player->getHotState());
+    }
 
-    // Get all players on the same map
-    std::vector<Player*> players = sWorldManager.getPlayersOnMap(mapId);
+    return pickAggroTarget(npc, players);
+}
+
+Player* NpcAI::pickAggroTarget(const Npc* npc, const std::vector<const PlayerHotState*>& livingPlayers)
+{
+    float aggroRange = npc->getAggroRange();
 
     Player* closestTarget = nullptr;
     float closestDistSq = aggroRange * aggroRange;
 
-    for (Player* player : players)
+    for (const PlayerHotState* hot : livingPlayers)
     {
-        // Skip invalid targets
-        if (!player || player->isDead())
-            continue;
+        Player* player = hot->owner;
 
         // Check if hostile
         if (!npc->isHostileTo(player))
             continue;
 
         // Check distance
-        float dx = player->getX() - npc->getX();
-        float dy = player->getY() - npc->getY();
+        float dx = hot->x - npc->getX();
+        float dy = hot->y - npc->getY();
         float distSq = dx * dx + dy * dy;
 
-        if (distSq < closestDistSq)
+        // Equal distances go to the lower GUID so the pick doesn't depend
+        // on the map's set order
+        if (distSq < closestDistSq ||
+            (closestTarget && distSq == closestDistSq && player->getGuid() < closestTarget->getGuid()))
         {
             closestDistSq = distSq;
             closestTarget = player;
@@ -305,13 +325,14 @@ void NpcAI::performSpellCast(Npc* npc, Entity* target, int32_t spellId)
     if (spellId <= 0)
         return;
 
-    // Get spell template
-    const SpellTemplate* spell = sGameData.getSpell(spellId);
-    if (!spell)
+    // Get compiled spell
+    const SpellDescriptor* descriptor = sSpellDescriptors.get(spellId);
+    if (!descriptor)
         return;
+    const SpellTemplate* spell = descriptor->spell;
 
     // Validate cast
-    CastResult result = SpellCaster::validateCast(npc, spell, target);
+    CastResult result = SpellCaster::validateCast(npc, *descriptor, target, CastPhase::Start);
     if (result != CastResult::Success)
     {
         LOG_DEBUG("NpcAI: '{}' spell cast validation failed - %s",
@@ -319,67 +340,22 @@ void NpcAI::performSpellCast(Npc* npc, Entity* target, int32_t spellId)
         return;
     }
 
-    // Get targets for the spell
-    std::vector<Entity*> targets = SpellCaster::getTargets(npc, spell, target);
-    if (targets.empty())
+    // Process every effect slot (instant cast for NPCs - no cast time handling)
+    SpellEffects::CombatEventBuffer events;
+    SpellEffects::resolve(npc, *descriptor, target, events);
+    if (events.empty())
         return;
 
-    // Process spell effects (instant cast for NPCs - no cast time handling)
-    std::vector<std::pair<uint32_t, uint8_t>> hitTargets;
-
-    for (Entity* effectTarget : targets)
-    {
-        SpellDefines::Effects effectType = static_cast<SpellDefines::Effects>(spell->effect[0]);
-
-        if (effectType == SpellDefines::Effects::Damage ||
-            effectType == SpellDefines::Effects::MeleeAtk ||
-            effectType == SpellDefines::Effects::RangedAtk)
-        {
-            // Damage spell
-            DamageInfo damage = CombatFormulas::calculateDamage(npc, effectTarget, spell, 0);
-
-            hitTargets.push_back({static_cast<uint32_t>(effectTarget->getGuid()),
-                static_cast<uint8_t>(CombatMessenger::toPacketHitResult(damage.hitResult))});
-
-            if (damage.hitResult != HitResult::Miss &&
-                damage.hitResult != HitResult::Dodge &&
-                damage.hitResult != HitResult::Parry)
-            {
-                effectTarget->takeDamage(damage.finalDamage, npc);
-                CombatMessenger::sendDamageMessage(npc, effectTarget, spellId, damage, effectType);
-            }
-            else
-            {
-                CombatMessenger::sendMissMessage(npc, effectTarget, spellId, damage.hitResult, effectType);
-            }
-        }
-        else if (effectType == SpellDefines::Effects::Heal)
-        {
-            // Healing spell
-            HealInfo heal = CombatFormulas::calculateHeal(npc, effectTarget, spell, 0);
-
-            hitTargets.push_back({static_cast<uint32_t>(effectTarget->getGuid()),
-                static_cast<uint8_t>(CombatMessenger::toPacketHitResult(heal.hitResult))});
-
-            effectTarget->heal(heal.finalHeal, npc);
-            CombatMessenger::sendHealMessage(npc, effectTarget, spellId, heal);
-        }
-        else if (effectType == SpellDefines::Effects::ApplyAura)
-        {
-            // Buff/debuff spell
-            effectTarget->getAuras().applyAura(npc, spell, 0);
-            hitTargets.push_back({static_cast<uint32_t>(effectTarget->getGuid()),
-                static_cast<uint8_t>(SpellDefines::HitResult::Normal)});
-        }
-    }
+    events.sendCombatMessages(npc, spellId);
+    SpellEffects::HitList hitTargets = events.buildHitList();
 
     // Send spell execution notification
     GP_Server_SpellGo spellGo;
     spellGo.m_casterGuid = static_cast<uint32_t>(npc->getGuid());
     spellGo.m_spellId = spellId;
-    for (const auto& [guid, hitResult] : hitTargets)
+    for (const auto& [hitTarget, hitResult] : hitTargets)
     {
-        spellGo.m_targets[guid] = hitResult;
+        spellGo.m_targets[static_cast<uint32_t>(hitTarget->getGuid())] = hitResult;
     }
 
     StlBuffer buf;
@@ -397,7 +373,7 @@ void NpcAI::performSpellCast(Npc* npc, Entity* target, int32_t spellId)
     // Consume mana
     int32_t npcLevel = npc->getVariable(ObjDefines::Variable::Level);
     int32_t maxMana = npc->getVariable(ObjDefines::Variable::MaxMana);
-    int32_t manaCost = SpellUtils::calculateManaCost(spell, npcLevel, maxMana);
+    int32_t manaCost = descriptor->manaCost(npcLevel, maxMana);
     if (manaCost > 0)
     {
         int32_t currentMana = npc->getVariable(ObjDefines::Variable::Mana);
@@ -409,7 +385,7 @@ void NpcAI::performSpellCast(Npc* npc, Entity* target, int32_t spellId)
     npc->setSpellCooldown(static_cast<float>(spell->cooldown) / 1000.0f);
 
     LOG_DEBUG("NpcAI: '{}' cast spell '{}' on {} targets",
-              npc->getName(), spell->name, targets.size());
+              npc->getName(), spell->name, hitTargets.size());
 }
 
 bool NpcAI::isInMeleeRange(Npc* npc, Entity* target)
@@ -466,7 +442,7 @@ int32_t NpcAI::selectSpellToCast(Npc* npc, Entity* target)
     const NpcTemplate* tmpl = npc->getTemplate();
     if (tmpl)
     {
-        static thread_local std::mt19937 rng(std::random_device{}());
+        std::mt19937& rng = Random::engine();
         std::uniform_int_distribution<int> chanceDist(1, 100);
 
         int32_t primary = npc->getPrimarySpellId();
@@ -505,10 +481,12 @@ void NpcAI::updatePatrol(Npc* npc, float deltaTime)
     if (!npc)
         return;
 
-    const auto& waypoints = npc->getWaypoints();
-    if (waypoints.empty())
+    const NpcPatrolPath* path = npc->getPatrolPath();
+    if (!path || path->waypoints.empty())
         return;
 
+    const auto& waypoints = path->waypoints;
+
     float waitTimer = npc->getWaypointWaitTimer();
     if (waitTimer > 0.0f)
     {
@@ -532,7 +510,7 @@ void NpcAI::updatePatrol(Npc* npc, float deltaTime)
         return;
     }
 
-    moveTowards(npc, wp.x, wp.y, deltaTime);
+    moveTowards(npc, wp.x, wp.y, deltaTime, &path->splineTails[index]);
 }
 
 void NpcAI::updateWander(Npc* npc, float deltaTime)
@@ -540,8 +518,9 @@ void NpcAI::updateWander(Npc* npc, float deltaTime)
     if (!npc)
         return;
 
-    float radius = npc->getWanderDistance();
-    if (radius <= 0.0f)
+    // Targets are precomputed per spawn from reachable cells around home
+    const std::vector<NpcWanderTarget>* targets = npc->getWanderTargets();
+    if (!targets || targets->empty())
         return;
 
     float waitTimer = npc->getWanderWaitTimer();
@@ -553,19 +532,13 @@ void NpcAI::updateWander(Npc* npc, float deltaTime)
 
     if (!npc->hasWanderTarget())
     {
-        static thread_local std::mt19937 rng(std::random_device{}());
-        std::uniform_real_distribution<float> angleDist(0.0f, 6.283185f);
-        std::uniform_real_distribution<float> radiusDist(0.0f, radius);
-
-        float angle = angleDist(rng);
-        float dist = radiusDist(rng);
-
-        float targetX = npc->getHomeX() + std::cos(angle) * dist;
-        float targetY = npc->getHomeY() + std::sin(angle) * dist;
-        npc->setWanderTarget(targetX, targetY);
+        std::mt19937& rng = Random::engine();
+        std::uniform_int_distribution<int32_t> indexDist(0, static_cast<int32_t>(targets->size()) - 1);
+        npc->setWanderTarget(indexDist(rng));
     }
 
-    float distance = npc->distanceTo(npc->getWanderTargetX(), npc->getWanderTargetY());
+    const NpcWanderTarget* target = npc->getWanderTarget();
+    float distance = npc->distanceTo(target->x, target->y);
     if (distance <= 2.0f)
     {
         npc->clearWanderTarget();
@@ -573,7 +546,7 @@ void NpcAI::updateWander(Npc* npc, float deltaTime)
         return;
     }
 
-    moveTowards(npc, npc->getWanderTargetX(), npc->getWanderTargetY(), deltaTime);
+    moveTowards(npc, target->x, target->y, deltaTime, &target->splineTail);
 }
 
 void NpcAI::callForHelp(Npc* npc, Entity* target)
@@ -606,7 +579,8 @@ void NpcAI::callForHelp(Npc* npc, Entity* target)
     }
 }
 
-void NpcAI::moveTowards(Npc* npc, float targetX, float targetY, float deltaTime)
+void NpcAI::moveTowards(Npc* npc, float targetX, float targetY, float deltaTime,
+                        const StlBuffer* splineTail)
 {
     if (!npc)
         return;
@@ -642,7 +616,10 @@ void NpcAI::moveTowards(Npc* npc, float targetX, float targetY, float deltaTime)
     npc->setOrientation(orientation);
 
     // Broadcast movement to nearby players
-    broadcastNpcMovement(npc, targetX, targetY);
+    if (splineTail)
+        broadcastNpcMovement(npc, *splineTail);
+    else
+        broadcastNpcMovement(npc, targetX, targetY);
 }
 
 void NpcAI::moveTowardsEntity(Npc* npc, Entity* target, float deltaTime)
@@ -733,3 +710,38 @@ static void broadcastNpcMovement(Npc* npc, float targetX, float targetY)
         player->sendPacket(buf);
     }
 }
+
+// Helper function to broadcast NPC movement along a pre-packed spline tail
+static void broadcastNpcMovement(Npc* npc, const StlBuffer& splineTail)
+{
+    if (!npc)
+        return;
+
+    // Only the opcode, guid and start position change per send
+    StlBuffer buf;
+    uint16_t opcode = Opcode::Server_UnitSpline;
+    buf << opcode;
+    buf << static_cast<uint32_t>(npc->getGuid()) << npc->getX() << npc->getY();
+    buf.write(reinterpret_cast<const char*>(splineTail.data()), splineTail.size());
+
+    std::vector<Player*> players = sWorldManager.getPlayersOnMap(npc->getMapId());
+    for (Player* player : players)
+    {
+        player->sendPacket(buf);
+    }
+}
+
+StlBuffer NpcAI::buildSplineTail(float targetX, float targetY)
+{
+    // Pack through the real packet so the layout can't drift, then strip
+    // the per-send header (guid, startX, startY)
+    GP_Server_UnitSpline packet;
+    packet.m_spline.push_back({targetX, targetY});
+    packet.m_slide = false;
+    packet.m_silent = false;
+
+    StlBuffer buf;
+    packet.pack(buf);
+    buf.eraseFront(sizeof(packet.m_guid) + sizeof(packet.m_startX) + sizeof(packet.m_startY));
+    return buf;
+}
@@ -9,6 +9,8 @@
 class Npc;
 class Entity;
 class Player;
+class StlBuffer;
+struct PlayerHotState;
 
 // ============================================================================
 // NpcAI Namespace - AI behavior functions
@@ -27,6 +29,12 @@ namespace NpcAI
     // Aggro detection - finds hostile targets in range
     Player* findAggroTarget(Npc* npc);
 
+    // Closest hostile player within aggro range among `livingPlayers`
+    // (dead players already removed), read from their hot state.
+    // Read-only, so the world runs it for idle NPCs in parallel ahead of
+    // their updates.
+    Player* pickAggroTarget(const Npc* npc, const std::vector<const PlayerHotState*>& livingPlayers);
+
     // Combat logic
     void performMeleeAttack(Npc* npc, Entity* target);
     void performSpellCast(Npc* npc, Entity* target, int32_t spellId);
@@ -42,7 +50,9 @@ namespace NpcAI
     void callForHelp(Npc* npc, Entity* target);
 
     // Movement
-    void moveTowards(Npc* npc, float targetX, float targetY, float deltaTime);
+    // splineTail: pre-packed spline for the target (idle movement tables)
+    void moveTowards(Npc* npc, float targetX, float targetY, float deltaTime,
+                     const StlBuffer* splineTail = nullptr);
     void moveTowardsEntity(Npc* npc, Entity* target, float deltaTime);
     void returnHome(Npc* npc, float deltaTime);
 
@@ -55,9 +65,17 @@ namespace NpcAI
     // Calculate orientation from NPC to target
     float calculateOrientation(float fromX, float fromY, float toX, float toY);
 
+    // Pack the GP_Server_UnitSpline bytes that follow guid/start position for
+    // a single-point move, so idle movement can be resolved ahead of time
+    StlBuffer buildSplineTail(float targetX, float targetY);
+
     // Configuration
     constexpr float NPC_MOVE_SPEED = 100.0f;        // Pixels per second
     constexpr float MELEE_ATTACK_COOLDOWN = 2.0f;   // Seconds between melee attacks
     constexpr float EVADE_SPEED_MULTIPLIER = 2.0f;  // NPCs move faster when evading
     constexpr float HOME_ARRIVAL_DISTANCE = 10.0f;  // Distance to consider "at home"
+    constexpr int MAX_WANDER_TARGETS = 32;          // Precomputed wander points per spawn
+    constexpr uint8_t MIN_WANDER_CLEARANCE = 2;     // Cells to the nearest wall for a wander point
+    constexpr uint8_t MIN_SPAWN_CLEARANCE = 2;      // Same, for a spawn position
+    constexpr int SPAWN_NUDGE_RADIUS = 4;           // Cells searched for a clearer spawn position
 }
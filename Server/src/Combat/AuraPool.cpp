@@ -0,0 +1,114 @@
+// AuraPool - Storage for every applied aura
+// Task 5.8: Aura System
+
+#include "stdafx.h"
+#include "Combat/AuraPool.h"
+
+AuraPool& AuraPool::instance()
+{
+    // Never destroyed: entities release their auras from their destructors,
+    // and some of those run during static teardown
+    static AuraPool* instance = new AuraPool();
+    return *instance;
+}
+
+uint32_t AuraPool::acquire(const Aura& aura, AuraManager* owner, uint32_t& ownerHead, uint32_t& ownerTail)
+{
+    uint32_t slot;
+    if (!m_free.empty())
+    {
+        slot = m_free.back();
+        m_free.pop_back();
+    }
+    else
+    {
+        if (m_used == m_chunks.size() * CHUNK_SIZE)
+            m_chunks.push_back(std::make_unique<Chunk>());
+        slot = m_used++;
+    }
+
+    AuraSlot& entry = at(slot);
+    entry.aura = aura;
+    entry.owner = owner;
+
+    // Owner's list: append, keeping application order
+    entry.ownerPrev = ownerTail;
+    entry.ownerNext = AuraConfig::INVALID_SLOT;
+    if (ownerTail != AuraConfig::INVALID_SLOT)
+        at(ownerTail).ownerNext = slot;
+    else
+        ownerHead = slot;
+    ownerTail = slot;
+
+    // Caster's list: push front (casterless auras aren't indexed)
+    entry.casterPrev = AuraConfig::INVALID_SLOT;
+    entry.casterNext = AuraConfig::INVALID_SLOT;
+    if (aura.casterGuid != 0)
+    {
+        auto [it, inserted] = m_casterHeads.try_emplace(aura.casterGuid, AuraConfig::INVALID_SLOT);
+        entry.casterNext = it->second;
+        if (it->second != AuraConfig::INVALID_SLOT)
+            at(it->second).casterPrev = slot;
+        it->second = slot;
+    }
+
+    ++m_liveCount;
+    return slot;
+}
+
+void AuraPool::release(uint32_t slot, uint32_t& ownerHead, uint32_t& ownerTail)
+{
+    AuraSlot& entry = at(slot);
+    if (!entry.owner)
+        return;
+
+    if (entry.ownerPrev != AuraConfig::INVALID_SLOT)
+        at(entry.ownerPrev).ownerNext = entry.ownerNext;
+    else
+        ownerHead = entry.ownerNext;
+
+    if (entry.ownerNext != AuraConfig::INVALID_SLOT)
+        at(entry.ownerNext).ownerPrev = entry.ownerPrev;
+    else
+        ownerTail = entry.ownerPrev;
+
+    if (entry.aura.casterGuid != 0)
+    {
+        if (entry.casterPrev != AuraConfig::INVALID_SLOT)
+            at(entry.casterPrev).casterNext = entry.casterNext;
+        else
+            m_casterHeads[entry.aura.casterGuid] = entry.casterNext;
+
+        if (entry.casterNext != AuraConfig::INVALID_SLOT)
+            at(entry.casterNext).casterPrev = entry.casterPrev;
+    }
+
+    entry.owner = nullptr;
+    m_free.push_back(slot);
+    --m_liveCount;
+}
+
+AuraSlot* AuraPool::find(uint32_t slot, uint32_t auraId)
+{
+    if (slot >= m_used)
+        return nullptr;
+
+    AuraSlot& entry = at(slot);
+    if (!entry.owner || entry.aura.auraId != auraId)
+        return nullptr;
+
+    return &entry;
+}
+
+uint32_t AuraPool::getCasterHead(uint64_t casterGuid) const
+{
+    auto it = m_casterHeads.find(casterGuid);
+    return it != m_casterHeads.end() ? it->second : AuraConfig::INVALID_SLOT;
+}
+
+void AuraPool::forgetCaster(uint64_t casterGuid)
+{
+    auto it = m_casterHeads.find(casterGuid);
+    if (it != m_casterHeads.end() && it->second == AuraConfig::INVALID_SLOT)
+        m_casterHeads.erase(it);
+}
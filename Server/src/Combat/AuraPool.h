@@ -0,0 +1,90 @@
+// AuraPool - Storage for every applied aura
+// Task 5.8: Aura System
+//
+// Auras live in fixed-size chunks of slots. A slot index is a stable handle
+// for as long as its aura stays applied, and growing the pool never moves
+// one. Each live slot is linked into two intrusive lists: its owner's
+// (AuraManager walks its auras through it, in application order) and its
+// caster's, the reverse index that lets a caster's auras be removed without
+// visiting every entity. Applying or removing an aura is O(1) and, once the
+// pool has grown to the live aura count, allocation-free.
+
+#pragma once
+
+#include "Combat/AuraSystem.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// ============================================================================
+// Aura Slot
+// ============================================================================
+
+struct AuraSlot
+{
+    Aura aura;
+    AuraManager* owner = nullptr;    // nullptr while the slot is free
+
+    // Owner's list (application order)
+    uint32_t ownerPrev = AuraConfig::INVALID_SLOT;
+    uint32_t ownerNext = AuraConfig::INVALID_SLOT;
+
+    // Caster's list (reverse index, most recent first)
+    uint32_t casterPrev = AuraConfig::INVALID_SLOT;
+    uint32_t casterNext = AuraConfig::INVALID_SLOT;
+};
+
+// ============================================================================
+// AuraPool
+// ============================================================================
+
+class AuraPool
+{
+public:
+    static AuraPool& instance();
+
+    // Store `aura` for `owner`: appended to the owner's list (whose head and
+    // tail the owner keeps) and pushed onto its caster's list
+    uint32_t acquire(const Aura& aura, AuraManager* owner, uint32_t& ownerHead, uint32_t& ownerTail);
+
+    // Unlink a slot from both lists and free it
+    void release(uint32_t slot, uint32_t& ownerHead, uint32_t& ownerTail);
+
+    AuraSlot& at(uint32_t slot) { return (*m_chunks[slot / CHUNK_SIZE])[slot % CHUNK_SIZE]; }
+    const AuraSlot& at(uint32_t slot) const { return (*m_chunks[slot / CHUNK_SIZE])[slot % CHUNK_SIZE]; }
+
+    // The slot's aura if it is still the application `auraId` (nullptr once
+    // removed, even if the slot has been reused since)
+    AuraSlot* find(uint32_t slot, uint32_t auraId);
+
+    // Most recent aura applied by a caster that is still in place
+    // (INVALID_SLOT if none)
+    uint32_t getCasterHead(uint64_t casterGuid) const;
+
+    // Drop a caster's reverse index entry once it is empty (caster left
+    // the world); otherwise the entry is kept for its next application
+    void forgetCaster(uint64_t casterGuid);
+
+    size_t getLiveCount() const { return m_liveCount; }
+
+private:
+    AuraPool() = default;
+    AuraPool(const AuraPool&) = delete;
+    AuraPool& operator=(const AuraPool&) = delete;
+
+    static constexpr uint32_t CHUNK_SIZE = 256;
+    using Chunk = std::array<AuraSlot, CHUNK_SIZE>;
+
+    std::vector<std::unique_ptr<Chunk>> m_chunks;
+    std::vector<uint32_t> m_free;
+    uint32_t m_used = 0;             // Slots handed out at least once
+    size_t m_liveCount = 0;
+
+    // Caster GUID -> head of its list
+    std::unordered_map<uint64_t, uint32_t> m_casterHeads;
+};
+
+#define sAuraPool AuraPool::instance()
@@ -0,0 +1,102 @@
+// AuraScheduler - Global timing wheel for aura ticks and expiries
+// Task 5.8: Aura System
+
+#include "stdafx.h"
+#include "Combat/AuraScheduler.h"
+#include "Combat/AuraSystem.h"
+#include "World/Entity.h"
+#include "World/WorldManager.h"
+
+#include <algorithm>
+
+AuraScheduler& AuraScheduler::instance()
+{
+    static AuraScheduler instance;
+    return instance;
+}
+
+AuraScheduler::AuraScheduler()
+    : m_wheel(AuraSchedulerConfig::WHEEL_SLOTS)
+{
+}
+
+void AuraScheduler::schedule(uint64_t dueMs, uint32_t ownerGuid, uint32_t auraId, uint32_t slot, int8_t effectIndex)
+{
+    // Never land in a slot that has already been processed (including the
+    // one currently firing), or the event would wait a full wheel turn
+    uint64_t wheelSlot = std::max(dueMs / AuraSchedulerConfig::SLOT_MS, m_nextSlot);
+
+    AuraEvent event;
+    event.dueMs = dueMs;
+    event.ownerGuid = ownerGuid;
+    event.auraId = auraId;
+    event.slot = slot;
+    event.effectIndex = effectIndex;
+
+    m_wheel[wheelSlot % AuraSchedulerConfig::WHEEL_SLOTS].push_back(event);
+    ++m_pendingCount;
+}
+
+void AuraScheduler::markDirty(uint32_t ownerGuid)
+{
+    if (ownerGuid != 0 && m_dirtySet.insert(ownerGuid).second)
+        m_dirtyOwners.push_back(ownerGuid);
+}
+
+void AuraScheduler::update(int32_t deltaTimeMs)
+{
+    if (deltaTimeMs > 0)
+        m_nowMs += static_cast<uint64_t>(deltaTimeMs);
+
+    while ((m_nextSlot + 1) * AuraSchedulerConfig::SLOT_MS <= m_nowMs)
+    {
+        uint64_t slot = m_nextSlot++;
+        auto& bucket = m_wheel[slot % AuraSchedulerConfig::WHEEL_SLOTS];
+        if (bucket.empty())
+            continue;
+
+        // Detach the bucket so handlers can schedule freely
+        m_firing.clear();
+        m_firing.swap(bucket);
+
+        for (const AuraEvent& event : m_firing)
+        {
+            if (event.dueMs / AuraSchedulerConfig::SLOT_MS > slot)
+            {
+                // Due on a later turn of the wheel
+                bucket.push_back(event);
+                continue;
+            }
+
+            --m_pendingCount;
+            dispatch(event);
+        }
+    }
+
+    flushDirty();
+}
+
+void AuraScheduler::dispatch(const AuraEvent& event)
+{
+    Entity* owner = sWorldManager.findEntity(event.ownerGuid);
+    if (!owner)
+        return;  // Owner left the world; its auras went with it
+
+    owner->getAuras().processEvent(event);
+}
+
+void AuraScheduler::flushDirty()
+{
+    if (m_dirtyOwners.empty())
+        return;
+
+    for (uint32_t guid : m_dirtyOwners)
+    {
+        Entity* owner = sWorldManager.findEntity(guid);
+        if (owner && owner->getAuras().isDirty())
+            owner->getAuras().broadcastAuras();
+    }
+
+    m_dirtyOwners.clear();
+    m_dirtySet.clear();
+}
@@ -0,0 +1,88 @@
+// AuraScheduler - Global timing wheel for aura ticks and expiries
+// Task 5.8: Aura System
+//
+// Periodic effects (DoT/HoT/mana) and aura expiries are registered here
+// instead of being polled by every AuraManager every tick. Entities whose
+// auras are all static or permanent cost nothing per tick. Aura changes are
+// also collected here so each entity sends at most one Server_UnitAuras
+// per tick.
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+// ============================================================================
+// Scheduler Configuration
+// ============================================================================
+
+namespace AuraSchedulerConfig
+{
+    constexpr uint64_t SLOT_MS = 50;         // One slot per world tick (20/s)
+    constexpr uint32_t WHEEL_SLOTS = 1024;   // ~51s horizon; longer waits wrap
+}
+
+// ============================================================================
+// Aura Event - A pending tick or expiry
+// ============================================================================
+
+struct AuraEvent
+{
+    uint64_t dueMs = 0;          // Scheduler time the event is due
+    uint32_t ownerGuid = 0;      // Entity carrying the aura
+    uint32_t auraId = 0;         // Aura::auraId (stale events are dropped)
+    uint32_t slot = 0;           // AuraPool slot the aura was applied in
+    int8_t effectIndex = 0;      // Periodic effect slot, or ExpiryEvent
+
+    static constexpr int8_t ExpiryEvent = -1;
+};
+
+// ============================================================================
+// AuraScheduler
+// ============================================================================
+
+class AuraScheduler
+{
+public:
+    static AuraScheduler& instance();
+
+    // Scheduler clock (ms since start, advanced by update())
+    uint64_t getNowMs() const { return m_nowMs; }
+
+    // Unique id for a newly applied aura
+    uint32_t nextAuraId() { return ++m_lastAuraId; }
+
+    // Register a periodic tick or expiry
+    void schedule(uint64_t dueMs, uint32_t ownerGuid, uint32_t auraId, uint32_t slot, int8_t effectIndex);
+
+    // Queue an entity's aura list for broadcast at the end of this tick
+    void markDirty(uint32_t ownerGuid);
+
+    // Fire every event whose slot has fully elapsed, then flush dirty
+    // aura lists (call once per world tick)
+    void update(int32_t deltaTimeMs);
+
+    // Stats
+    size_t getPendingCount() const { return m_pendingCount; }
+
+private:
+    AuraScheduler();
+    AuraScheduler(const AuraScheduler&) = delete;
+    AuraScheduler& operator=(const AuraScheduler&) = delete;
+
+    void dispatch(const AuraEvent& event);
+    void flushDirty();
+
+    std::vector<std::vector<AuraEvent>> m_wheel;
+    std::vector<AuraEvent> m_firing;  // Scratch bucket reused each slot
+    uint64_t m_nowMs = 0;
+    uint64_t m_nextSlot = 0;          // First slot not yet processed
+    size_t m_pendingCount = 0;
+    uint32_t m_lastAuraId = 0;
+
+    std::vector<uint32_t> m_dirtyOwners;
+    std::unordered_set<uint32_t> m_dirtySet;
+};
+
+#define sAuraScheduler AuraScheduler::instance()
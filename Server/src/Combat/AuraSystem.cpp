@@ -4,6 +4,8 @@
 
 #include "stdafx.h"
 #include "Combat/AuraSystem.h"
+#include "Combat/AuraPool.h"
+#include "Combat/AuraScheduler.h"
 #include "Combat/CombatFormulas.h"
 #include "Combat/CombatMessenger.h"
 #include "Combat/SpellUtils.h"
@@ -37,7 +39,6 @@ Aura createAuraFromSpell(Entity* caster, const SpellTemplate* spell, int effectI
 
     // Duration from spell template
     aura.maxDurationMs = spell->duration;
-    aura.elapsedMs = 0;
 
     // Stacking from spell template
     aura.maxStacks = spell->stackAmount > 0 ? spell->stackAmount : 1;
@@ -70,7 +71,6 @@ Aura createAuraFromSpell(Entity* caster, const SpellTemplate* spell, int effectI
     {
         effect.periodicIntervalMs = AuraConfig::DEFAULT_PERIODIC_INTERVAL_MS;
     }
-    effect.periodicTimer = 0;
 
     aura.effects.push_back(effect);
 
@@ -137,6 +137,66 @@ const char* getAuraTypeName(SpellDefines::AuraType type)
 
 } // namespace AuraUtils
 
+// ============================================================================
+// AuraManager - Pool Helpers
+// ============================================================================
+
+AuraManager::~AuraManager()
+{
+    // The owner is going away; nothing to undo or broadcast
+    while (m_head != AuraConfig::INVALID_SLOT)
+        sAuraPool.release(m_head, m_head, m_tail);
+}
+
+template <typename Fn>
+void AuraManager::forEachSlot(Fn fn) const
+{
+    uint32_t slot = m_head;
+    while (slot != AuraConfig::INVALID_SLOT)
+    {
+        uint32_t next = sAuraPool.at(slot).ownerNext;
+        fn(slot, sAuraPool.at(slot).aura);
+        slot = next;
+    }
+}
+
+template <typename Pred>
+uint32_t AuraManager::findSlot(Pred pred) const
+{
+    for (uint32_t slot = m_head; slot != AuraConfig::INVALID_SLOT; slot = sAuraPool.at(slot).ownerNext)
+    {
+        if (pred(sAuraPool.at(slot).aura))
+            return slot;
+    }
+    return AuraConfig::INVALID_SLOT;
+}
+
+void AuraManager::removeSlot(uint32_t slot)
+{
+    // Unlinked first: effect removal checks the auras left behind
+    Aura removed = sAuraPool.at(slot).aura;
+    sAuraPool.release(slot, m_head, m_tail);
+    --m_auraCount;
+    if (removed.isPositive())
+        --m_buffCount;
+
+    for (const auto& effect : removed.effects)
+    {
+        removeAuraEffect(removed, effect);
+    }
+    markDirty();
+}
+
+template <typename Pred>
+void AuraManager::removeIf(Pred pred)
+{
+    forEachSlot([this, &pred](uint32_t slot, const Aura& aura)
+    {
+        if (pred(aura))
+            removeSlot(slot);
+    });
+}
+
 // ============================================================================
 // AuraManager - Application
 // ============================================================================
@@ -166,12 +226,17 @@ bool AuraManager::applyAura(const Aura& newAura)
     }
 
     // Check for existing aura that can be refreshed/stacked
-    Aura* existing = findStackableAura(newAura.spellId, newAura.casterGuid);
+    uint32_t existingSlot = findStackableAura(newAura.spellId, newAura.casterGuid);
 
-    if (existing)
+    if (existingSlot != AuraConfig::INVALID_SLOT)
     {
-        // Refresh duration
-        existing->elapsedMs = 0;
+        Aura* existing = &sAuraPool.at(existingSlot).aura;
+
+        // Refresh duration; the previously scheduled expiry goes stale
+        existing->appliedAtMs = sAuraScheduler.getNowMs();
+        if (existing->maxDurationMs > 0)
+            sAuraScheduler.schedule(existing->getExpiryMs(), static_cast<uint32_t>(m_owner->getGuid()),
+                                    existing->auraId, existingSlot, AuraEvent::ExpiryEvent);
 
         // Add stacks if possible
         if (existing->stacks < existing->maxStacks)
@@ -192,6 +257,8 @@ bool AuraManager::applyAura(const Aura& newAura)
 
     // Apply new aura
     Aura aura = newAura;
+    aura.auraId = sAuraScheduler.nextAuraId();
+    aura.appliedAtMs = sAuraScheduler.getNowMs();
 
     // Apply each effect
     for (const auto& effect : aura.effects)
@@ -199,7 +266,12 @@ bool AuraManager::applyAura(const Aura& newAura)
         applyAuraEffect(aura, effect);
     }
 
-    m_auras.push_back(aura);
+    uint32_t slot = sAuraPool.acquire(aura, this, m_head, m_tail);
+    ++m_auraCount;
+    if (aura.isPositive())
+        ++m_buffCount;
+
+    scheduleAura(slot);
     markDirty();
 
     LOG_DEBUG("AuraManager: Applied aura {} (type={}) to entity {}",
@@ -212,124 +284,79 @@ bool AuraManager::applyAura(const Aura& newAura)
 
 void AuraManager::removeAura(int32_t spellId, uint64_t casterGuid)
 {
-    auto it = std::remove_if(m_auras.begin(), m_auras.end(),
-        [this, spellId, casterGuid](const Aura& aura)
-        {
-            if (aura.spellId != spellId)
-                return false;
-            if (casterGuid != 0 && aura.casterGuid != casterGuid)
-                return false;
-
-            // Remove effects before erasing
-            for (const auto& effect : aura.effects)
-            {
-                removeAuraEffect(aura, effect);
-            }
+    removeIf([this, spellId, casterGuid](const Aura& aura)
+    {
+        if (aura.spellId != spellId)
+            return false;
+        if (casterGuid != 0 && aura.casterGuid != casterGuid)
+            return false;
 
-            LOG_DEBUG("AuraManager: Removed aura {} from entity {}",
-                      aura.spellId, m_owner->getGuid());
-            return true;
-        });
+        LOG_DEBUG("AuraManager: Removed aura {} from entity {}",
+                  aura.spellId, m_owner->getGuid());
+        return true;
+    });
+}
 
-    if (it != m_auras.end())
+void AuraManager::removeAurasFromCaster(uint64_t casterGuid)
+{
+    // Only the caster's auras are visited, not this entity's whole list
+    uint32_t slot = sAuraPool.getCasterHead(casterGuid);
+    while (slot != AuraConfig::INVALID_SLOT)
     {
-        m_auras.erase(it, m_auras.end());
-        markDirty();
+        const AuraSlot& entry = sAuraPool.at(slot);
+        uint32_t next = entry.casterNext;
+        if (entry.owner == this)
+            removeSlot(slot);
+        slot = next;
     }
 }
 
-void AuraManager::removeAurasFromCaster(uint64_t casterGuid)
+void AuraManager::removeAurasAppliedBy(uint64_t casterGuid)
 {
-    auto it = std::remove_if(m_auras.begin(), m_auras.end(),
-        [this, casterGuid](const Aura& aura)
-        {
-            if (aura.casterGuid != casterGuid)
-                return false;
-
-            for (const auto& effect : aura.effects)
-            {
-                removeAuraEffect(aura, effect);
-            }
-            return true;
-        });
+    if (casterGuid == 0)
+        return;
 
-    if (it != m_auras.end())
+    uint32_t slot = sAuraPool.getCasterHead(casterGuid);
+    while (slot != AuraConfig::INVALID_SLOT)
     {
-        m_auras.erase(it, m_auras.end());
-        markDirty();
+        const AuraSlot& entry = sAuraPool.at(slot);
+        uint32_t next = entry.casterNext;
+        entry.owner->removeSlot(slot);
+        slot = next;
     }
+
+    sAuraPool.forgetCaster(casterGuid);
 }
 
 void AuraManager::removeAurasByType(SpellDefines::AuraType type)
 {
-    auto it = std::remove_if(m_auras.begin(), m_auras.end(),
-        [this, type](const Aura& aura)
-        {
-            for (const auto& effect : aura.effects)
-            {
-                if (effect.type == type)
-                {
-                    for (const auto& eff : aura.effects)
-                    {
-                        removeAuraEffect(aura, eff);
-                    }
-                    return true;
-                }
-            }
-            return false;
-        });
-
-    if (it != m_auras.end())
+    removeIf([type](const Aura& aura)
     {
-        m_auras.erase(it, m_auras.end());
-        markDirty();
-    }
+        for (const auto& effect : aura.effects)
+        {
+            if (effect.type == type)
+                return true;
+        }
+        return false;
+    });
 }
 
 void AuraManager::removeDispellableAuras(bool positive)
 {
-    auto it = std::remove_if(m_auras.begin(), m_auras.end(),
-        [this, positive](const Aura& aura)
-        {
-            if (aura.isPositive() != positive)
-                return false;
-            if (aura.flags & AuraConfig::Flags::CannotDispel)
-                return false;
-
-            for (const auto& effect : aura.effects)
-            {
-                removeAuraEffect(aura, effect);
-            }
-            return true;
-        });
-
-    if (it != m_auras.end())
+    removeIf([positive](const Aura& aura)
     {
-        m_auras.erase(it, m_auras.end());
-        markDirty();
-    }
+        if (aura.isPositive() != positive)
+            return false;
+        return (aura.flags & AuraConfig::Flags::CannotDispel) == 0;
+    });
 }
 
 void AuraManager::clearAll(bool includePersistent)
 {
-    auto it = std::remove_if(m_auras.begin(), m_auras.end(),
-        [this, includePersistent](const Aura& aura)
-        {
-            if (!includePersistent && (aura.flags & AuraConfig::Flags::Persistent))
-                return false;
-
-            for (const auto& effect : aura.effects)
-            {
-                removeAuraEffect(aura, effect);
-            }
-            return true;
-        });
-
-    if (it != m_auras.end())
+    removeIf([includePersistent](const Aura& aura)
     {
-        m_auras.erase(it, m_auras.end());
-        markDirty();
-    }
+        return includePersistent || (aura.flags & AuraConfig::Flags::Persistent) == 0;
+    });
 }
 
 // ============================================================================
@@ -338,56 +365,41 @@ void AuraManager::clearAll(bool includePersistent)
 
 bool AuraManager::hasAura(int32_t spellId) const
 {
-    return std::any_of(m_auras.begin(), m_auras.end(),
-        [spellId](const Aura& aura) { return aura.spellId == spellId; });
+    return findSlot([spellId](const Aura& aura) { return aura.spellId == spellId; })
+           != AuraConfig::INVALID_SLOT;
 }
 
 bool AuraManager::hasAura(int32_t spellId, uint64_t casterGuid) const
 {
-    return std::any_of(m_auras.begin(), m_auras.end(),
-        [spellId, casterGuid](const Aura& aura)
+    return findSlot([spellId, casterGuid](const Aura& aura)
         {
             return aura.spellId == spellId && aura.casterGuid == casterGuid;
-        });
+        }) != AuraConfig::INVALID_SLOT;
 }
 
 bool AuraManager::hasAuraType(SpellDefines::AuraType type) const
 {
-    for (const auto& aura : m_auras)
-    {
-        for (const auto& effect : aura.effects)
+    return findSlot([type](const Aura& aura)
         {
-            if (effect.type == type)
-                return true;
-        }
-    }
-    return false;
+            for (const auto& effect : aura.effects)
+            {
+                if (effect.type == type)
+                    return true;
+            }
+            return false;
+        }) != AuraConfig::INVALID_SLOT;
 }
 
 Aura* AuraManager::getAura(int32_t spellId)
 {
-    auto it = std::find_if(m_auras.begin(), m_auras.end(),
-        [spellId](const Aura& aura) { return aura.spellId == spellId; });
-    return it != m_auras.end() ? &(*it) : nullptr;
+    uint32_t slot = findSlot([spellId](const Aura& aura) { return aura.spellId == spellId; });
+    return slot != AuraConfig::INVALID_SLOT ? &sAuraPool.at(slot).aura : nullptr;
 }
 
 const Aura* AuraManager::getAura(int32_t spellId) const
 {
-    auto it = std::find_if(m_auras.begin(), m_auras.end(),
-        [spellId](const Aura& aura) { return aura.spellId == spellId; });
-    return it != m_auras.end() ? &(*it) : nullptr;
-}
-
-size_t AuraManager::getBuffCount() const
-{
-    return std::count_if(m_auras.begin(), m_auras.end(),
-        [](const Aura& aura) { return aura.isPositive(); });
-}
-
-size_t AuraManager::getDebuffCount() const
-{
-    return std::count_if(m_auras.begin(), m_auras.end(),
-        [](const Aura& aura) { return !aura.isPositive(); });
+    uint32_t slot = findSlot([spellId](const Aura& aura) { return aura.spellId == spellId; });
+    return slot != AuraConfig::INVALID_SLOT ? &sAuraPool.at(slot).aura : nullptr;
 }
 
 // ============================================================================
@@ -398,7 +410,7 @@ int32_t AuraManager::getAuraModifier(SpellDefines::AuraType type) const
 {
     int32_t total = 0;
 
-    for (const auto& aura : m_auras)
+    forEachSlot([&total, type](uint32_t, const Aura& aura)
     {
         for (size_t i = 0; i < aura.effects.size(); ++i)
         {
@@ -407,7 +419,7 @@ int32_t AuraManager::getAuraModifier(SpellDefines::AuraType type) const
                 total += aura.getEffectValue(i);
             }
         }
-    }
+    });
 
     return total;
 }
@@ -416,7 +428,7 @@ int32_t AuraManager::getStatModifier(int32_t statType) const
 {
     int32_t total = 0;
 
-    for (const auto& aura : m_auras)
+    forEachSlot([&total, statType](uint32_t, const Aura& aura)
     {
         for (size_t i = 0; i < aura.effects.size(); ++i)
         {
@@ -426,7 +438,7 @@ int32_t AuraManager::getStatModifier(int32_t statType) const
                 total += aura.getEffectValue(i);
             }
         }
-    }
+    });
 
     return total;
 }
@@ -464,137 +476,139 @@ int32_t AuraManager::consumeAbsorb(int32_t damage)
 // AuraManager - Update
 // ============================================================================
 
-void AuraManager::update(int32_t deltaTimeMs)
+void AuraManager::scheduleAura(uint32_t slot)
 {
-    if (m_auras.empty())
+    if (!m_owner)
         return;
 
-    bool anyExpired = false;
+    const Aura& aura = sAuraPool.at(slot).aura;
+    uint32_t ownerGuid = static_cast<uint32_t>(m_owner->getGuid());
 
-    for (auto& aura : m_auras)
+    if (aura.maxDurationMs > 0)
+        sAuraScheduler.schedule(aura.getExpiryMs(), ownerGuid, aura.auraId, slot, AuraEvent::ExpiryEvent);
+
+    for (size_t i = 0; i < aura.effects.size(); ++i)
     {
-        // Update duration
-        if (aura.maxDurationMs > 0)
+        int32_t interval = aura.effects[i].periodicIntervalMs;
+        if (interval > 0)
         {
-            aura.elapsedMs += deltaTimeMs;
-
-            if (aura.isExpired())
-            {
-                anyExpired = true;
-                continue;  // Will be removed after loop
-            }
+            sAuraScheduler.schedule(aura.appliedAtMs + static_cast<uint64_t>(interval),
+                                    ownerGuid, aura.auraId, slot, static_cast<int8_t>(i));
         }
-
-        // Process periodic effects
-        processPeriodicEffects(aura, deltaTimeMs);
     }
+}
 
-    // Remove expired auras
-    if (anyExpired)
+void AuraManager::processEvent(const AuraEvent& event)
+{
+    if (!m_owner)
+        return;
+
+    // The slot names the aura directly; the id check drops events for an
+    // aura removed since (its slot may already hold another one)
+    auto findById = [this, &event]() -> Aura*
     {
-        auto it = std::remove_if(m_auras.begin(), m_auras.end(),
-            [this](const Aura& aura)
-            {
-                if (aura.isExpired())
-                {
-                    for (const auto& effect : aura.effects)
-                    {
-                        removeAuraEffect(aura, effect);
-                    }
-                    LOG_DEBUG("AuraManager: Aura {} expired on entity {}",
-                              aura.spellId, m_owner->getGuid());
-                    return true;
-                }
-                return false;
-            });
+        AuraSlot* entry = sAuraPool.find(event.slot, event.auraId);
+        return entry && entry->owner == this ? &entry->aura : nullptr;
+    };
 
-        m_auras.erase(it, m_auras.end());
-        markDirty();
+    Aura* it = findById();
+    if (!it)
+        return;  // Removed since the event was scheduled
+
+    if (event.effectIndex == AuraEvent::ExpiryEvent)
+    {
+        // A refresh schedules a new expiry; only the latest one counts
+        if (it->maxDurationMs <= 0 || it->getExpiryMs() != event.dueMs)
+            return;
+
+        LOG_DEBUG("AuraManager: Aura %d expired on entity %llu",
+                  it->spellId, static_cast<unsigned long long>(m_owner->getGuid()));
+        removeSlot(event.slot);
+        return;
     }
 
-    // Broadcast if dirty
-    if (m_dirty)
+    size_t effectIndex = static_cast<size_t>(event.effectIndex);
+    if (effectIndex >= it->effects.size())
+        return;
+
+    // A tick landing exactly on expiry does not fire
+    if (it->maxDurationMs > 0 && event.dueMs >= it->getExpiryMs())
+        return;
+
+    int32_t interval = it->effects[effectIndex].periodicIntervalMs;
+    uint32_t auraId = it->auraId;
+
+    if (!m_owner->isDead())
+        applyPeriodicTick(*it, effectIndex);
+
+    // The tick may have killed the owner and cleared its auras
+    if (interval > 0 && findById())
     {
-        broadcastAuras();
+        sAuraScheduler.schedule(event.dueMs + static_cast<uint64_t>(interval),
+                                event.ownerGuid, auraId, event.slot, event.effectIndex);
     }
 }
 
-void AuraManager::processPeriodicEffects(Aura& aura, int32_t deltaTimeMs)
+void AuraManager::applyPeriodicTick(const Aura& aura, size_t effectIndex)
 {
-    if (!m_owner)
-        return;
+    const AuraEffect& effect = aura.effects[effectIndex];
+    int32_t value = aura.getEffectValue(effectIndex);
 
-    for (auto& effect : aura.effects)
+    switch (effect.type)
     {
-        if (effect.periodicIntervalMs <= 0)
-            continue;
+        case SpellDefines::AuraType::PeriodicDamage:
+        {
+            // Send combat message first (Task 5.10)
+            CombatMessenger::sendPeriodicDamage(aura.casterGuid, m_owner, aura.spellId, value);
 
-        effect.periodicTimer += deltaTimeMs;
+            // Apply damage using Entity::takeDamage for proper death handling (Task 5.11)
+            // Note: We need the caster Entity, but we only have GUID
+            // For DoT, the attacker is whoever cast the original aura
+            // TODO: Could track caster entity reference in Aura for proper death credit
+            m_owner->takeDamage(value, nullptr);
 
-        while (effect.periodicTimer >= effect.periodicIntervalMs)
+            LOG_DEBUG("AuraManager: DoT %d dealt %d periodic damage to entity %llu",
+                      aura.spellId, value, static_cast<unsigned long long>(m_owner->getGuid()));
+            break;
+        }
+
+        case SpellDefines::AuraType::PeriodicHeal:
         {
-            effect.periodicTimer -= effect.periodicIntervalMs;
+            // Calculate actual heal before applying
+            int32_t health = m_owner->getVariable(ObjDefines::Variable::Health);
+            int32_t maxHealth = m_owner->getVariable(ObjDefines::Variable::MaxHealth);
+            int32_t actualHeal = std::min(value, maxHealth - health);
 
-            // Apply periodic effect
-            int32_t value = aura.getEffectValue(&effect - &aura.effects[0]);
+            // Send combat message (Task 5.10)
+            CombatMessenger::sendPeriodicHeal(aura.casterGuid, m_owner, aura.spellId, actualHeal);
 
-            switch (effect.type)
-            {
-                case SpellDefines::AuraType::PeriodicDamage:
-                {
-                    // Send combat message first (Task 5.10)
-                    CombatMessenger::sendPeriodicDamage(aura.casterGuid, m_owner, aura.spellId, value);
-
-                    // Apply damage using Entity::takeDamage for proper death handling (Task 5.11)
-                    // Note: We need the caster Entity, but we only have GUID
-                    // For DoT, the attacker is whoever cast the original aura
-                    // TODO: Could track caster entity reference in Aura for proper death credit
-                    m_owner->takeDamage(value, nullptr);
-
-                    LOG_DEBUG("AuraManager: DoT {} dealt {} periodic damage to entity {}",
-                              aura.spellId, value, m_owner->getGuid());
-                    break;
-                }
-
-                case SpellDefines::AuraType::PeriodicHeal:
-                {
-                    // Calculate actual heal before applying
-                    int32_t health = m_owner->getVariable(ObjDefines::Variable::Health);
-                    int32_t maxHealth = m_owner->getVariable(ObjDefines::Variable::MaxHealth);
-                    int32_t actualHeal = std::min(value, maxHealth - health);
-
-                    // Send combat message (Task 5.10)
-                    CombatMessenger::sendPeriodicHeal(aura.casterGuid, m_owner, aura.spellId, actualHeal);
-
-                    // Apply heal using Entity::heal for consistent handling
-                    m_owner->heal(value, nullptr);
-
-                    LOG_DEBUG("AuraManager: HoT {} healed {} on entity {}",
-                              aura.spellId, actualHeal, m_owner->getGuid());
-                    break;
-                }
-
-                case SpellDefines::AuraType::PeriodicBurnMana:
-                {
-                    int32_t mana = m_owner->getVariable(ObjDefines::Variable::Mana);
-                    mana = std::max(0, mana - value);
-                    m_owner->setVariable(ObjDefines::Variable::Mana, mana);
-                    break;
-                }
-
-                case SpellDefines::AuraType::PeriodicRestoreMana:
-                {
-                    int32_t mana = m_owner->getVariable(ObjDefines::Variable::Mana);
-                    int32_t maxMana = m_owner->getVariable(ObjDefines::Variable::MaxMana);
-                    mana = std::min(maxMana, mana + value);
-                    m_owner->setVariable(ObjDefines::Variable::Mana, mana);
-                    break;
-                }
-
-                default:
-                    break;
-            }
+            // Apply heal using Entity::heal for consistent handling
+            m_owner->heal(value, nullptr);
+
+            LOG_DEBUG("AuraManager: HoT %d healed %d on entity %llu",
+                      aura.spellId, actualHeal, static_cast<unsigned long long>(m_owner->getGuid()));
+            break;
         }
+
+        case SpellDefines::AuraType::PeriodicBurnMana:
+        {
+            int32_t mana = m_owner->getVariable(ObjDefines::Variable::Mana);
+            mana = std::max(0, mana - value);
+            m_owner->setVariable(ObjDefines::Variable::Mana, mana);
+            break;
+        }
+
+        case SpellDefines::AuraType::PeriodicRestoreMana:
+        {
+            int32_t mana = m_owner->getVariable(ObjDefines::Variable::Mana);
+            int32_t maxMana = m_owner->getVariable(ObjDefines::Variable::MaxMana);
+            mana = std::min(maxMana, mana + value);
+            m_owner->setVariable(ObjDefines::Variable::Mana, mana);
+            break;
+        }
+
+        default:
+            break;
     }
 }
 
@@ -689,8 +703,8 @@ void AuraManager::removeAuraEffect(const Aura& aura, const AuraEffect& effect)
 
 bool AuraManager::canApplyAura(const Aura& aura) const
 {
-    size_t currentBuffs = getBuffCount();
-    size_t currentDebuffs = getDebuffCount();
+    size_t currentBuffs = m_buffCount;
+    size_t currentDebuffs = m_auraCount - m_buffCount;
 
     if (aura.isPositive())
     {
@@ -702,43 +716,48 @@ bool AuraManager::canApplyAura(const Aura& aura) const
     }
 }
 
-Aura* AuraManager::findStackableAura(int32_t spellId, uint64_t casterGuid)
+uint32_t AuraManager::findStackableAura(int32_t spellId, uint64_t casterGuid) const
 {
     // Find existing aura with same spell ID
     // Some auras stack per-caster, others are shared
-    for (auto& aura : m_auras)
-    {
-        if (aura.spellId == spellId)
-        {
-            // For now, same spell ID = same aura (refreshes/stacks)
-            // Future: Could check casterGuid for per-caster stacking
-            (void)casterGuid;
-            return &aura;
-        }
-    }
-    return nullptr;
+    // For now, same spell ID = same aura (refreshes/stacks)
+    // Future: Could check casterGuid for per-caster stacking
+    (void)casterGuid;
+    return findSlot([spellId](const Aura& aura) { return aura.spellId == spellId; });
 }
 
 // ============================================================================
 // AuraManager - Client Sync
 // ============================================================================
 
+void AuraManager::markDirty()
+{
+    if (m_dirty)
+        return;
+
+    m_dirty = true;
+    if (m_owner)
+        sAuraScheduler.markDirty(static_cast<uint32_t>(m_owner->getGuid()));
+}
+
 void AuraManager::broadcastAuras()
 {
     if (!m_owner)
         return;
 
+    uint64_t nowMs = sAuraScheduler.getNowMs();
+
     // Build the packet
     GP_Server_UnitAuras packet;
     packet.m_unitGuid = static_cast<uint32_t>(m_owner->getGuid());
 
-    for (const auto& aura : m_auras)
+    forEachSlot([&packet, nowMs](uint32_t, const Aura& aura)
     {
         GP_Server_UnitAuras::AuraInfo info;
         info.spellId = aura.spellId;
         info.casterGuid = static_cast<uint32_t>(aura.casterGuid);
         info.maxDuration = aura.maxDurationMs;
-        info.elapsedTime = aura.elapsedMs;
+        info.elapsedTime = aura.getElapsedMs(nowMs);
         info.stacks = aura.stacks;
         info.positive = aura.isPositive();
 
@@ -750,7 +769,7 @@ void AuraManager::broadcastAuras()
         {
             packet.m_debuffs.push_back(info);
         }
-    }
+    });
 
     // Serialize
     StlBuffer buf;
@@ -767,7 +786,11 @@ void AuraManager::broadcastAuras()
         // Broadcast to nearby players (only for player entities)
         sWorldManager.broadcastToVisible(playerOwner, buf, false);  // Self already handled above
     }
-    // TODO: For NPCs, would need to broadcast to all players who can see the NPC
+    else
+    {
+        // NPCs are visible to everyone on their map
+        sWorldManager.broadcastToMap(m_owner->getMapId(), buf);
+    }
 
     clearDirty();
 
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <vector>
 #include <unordered_map>
@@ -14,6 +15,7 @@
 class Entity;
 class Player;
 struct SpellTemplate;
+struct AuraEvent;
 
 // ============================================================================
 // Aura Configuration
@@ -29,6 +31,12 @@ namespace AuraConfig
     constexpr int32_t DEFAULT_STACK_LIMIT = 1;
     constexpr int32_t DEFAULT_PERIODIC_INTERVAL_MS = 3000;  // 3 seconds
 
+    // One effect per spell effect slot
+    constexpr size_t MAX_EFFECTS = 3;
+
+    // No aura (AuraPool slot index)
+    constexpr uint32_t INVALID_SLOT = 0xFFFFFFFF;
+
     // Aura flags for special behavior
     namespace Flags
     {
@@ -52,8 +60,38 @@ struct AuraEffect
     int32_t baseValue = 0;           // Base effect value
     int32_t perStackValue = 0;       // Additional value per stack
     int32_t miscValue = 0;           // Additional data (stat type, school, etc.)
-    int32_t periodicIntervalMs = 0;  // For DoT/HoT: tick interval
-    int32_t periodicTimer = 0;       // Current timer for next tick
+    int32_t periodicIntervalMs = 0;  // For DoT/HoT: tick interval (ticks run from AuraScheduler)
+};
+
+// ============================================================================
+// Aura Effect List - An aura's effects, stored inline so an Aura is a flat
+// value that copies into an AuraPool slot without touching the heap
+// ============================================================================
+
+class AuraEffectList
+{
+public:
+    // Effects past MAX_EFFECTS are dropped (a spell has no more slots)
+    void push_back(const AuraEffect& effect)
+    {
+        if (m_count < AuraConfig::MAX_EFFECTS)
+            m_effects[m_count++] = effect;
+    }
+
+    size_t size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+
+    AuraEffect& operator[](size_t index) { return m_effects[index]; }
+    const AuraEffect& operator[](size_t index) const { return m_effects[index]; }
+
+    AuraEffect* begin() { return m_effects.data(); }
+    AuraEffect* end() { return m_effects.data() + m_count; }
+    const AuraEffect* begin() const { return m_effects.data(); }
+    const AuraEffect* end() const { return m_effects.data() + m_count; }
+
+private:
+    std::array<AuraEffect, AuraConfig::MAX_EFFECTS> m_effects{};
+    uint8_t m_count = 0;
 };
 
 // ============================================================================
@@ -63,13 +101,14 @@ struct AuraEffect
 struct Aura
 {
     // Identification
+    uint32_t auraId = 0;             // Unique per application (AuraScheduler::nextAuraId)
     int32_t spellId = 0;             // Source spell ID
     uint64_t casterGuid = 0;         // Who applied this aura
     int32_t effectIndex = 0;         // Which spell effect created this (0-2)
 
-    // Duration
+    // Duration (timestamps are on the AuraScheduler clock)
     int32_t maxDurationMs = 0;       // Total duration (0 = permanent)
-    int32_t elapsedMs = 0;           // Time elapsed since application
+    uint64_t appliedAtMs = 0;        // Application/last refresh time
 
     // Stacking
     int32_t stacks = 1;              // Current stack count
@@ -79,12 +118,20 @@ struct Aura
     uint32_t flags = 0;              // AuraConfig::Flags
 
     // Effects (up to 3 per aura, matching spell effects)
-    std::vector<AuraEffect> effects;
+    AuraEffectList effects;
 
     // Helper methods
     bool isPositive() const { return (flags & AuraConfig::Flags::Positive) != 0; }
-    bool isExpired() const { return maxDurationMs > 0 && elapsedMs >= maxDurationMs; }
-    int32_t getRemainingMs() const { return maxDurationMs > 0 ? std::max(0, maxDurationMs - elapsedMs) : -1; }
+    uint64_t getExpiryMs() const { return appliedAtMs + static_cast<uint64_t>(maxDurationMs); }
+    bool isExpired(uint64_t nowMs) const { return maxDurationMs > 0 && nowMs >= getExpiryMs(); }
+    int32_t getElapsedMs(uint64_t nowMs) const
+    {
+        return nowMs > appliedAtMs ? static_cast<int32_t>(nowMs - appliedAtMs) : 0;
+    }
+    int32_t getRemainingMs(uint64_t nowMs) const
+    {
+        return maxDurationMs > 0 ? std::max(0, maxDurationMs - getElapsedMs(nowMs)) : -1;
+    }
 
     // Get scaled effect value (base + per-stack bonus)
     int32_t getEffectValue(size_t effectIdx) const
@@ -99,11 +146,15 @@ struct Aura
 // AuraManager - Manages all auras on a single entity
 // ============================================================================
 
+// The auras themselves live in sAuraPool; the manager keeps the head and
+// tail of its list there, in application order.
 class AuraManager
 {
 public:
     AuraManager() = default;
-    ~AuraManager() = default;
+    ~AuraManager();
+    AuraManager(const AuraManager&) = delete;
+    AuraManager& operator=(const AuraManager&) = delete;
 
     // Set the owning entity (called on creation)
     void setOwner(Entity* owner) { m_owner = owner; }
@@ -127,6 +178,10 @@ public:
     // Remove all auras from a specific caster
     void removeAurasFromCaster(uint64_t casterGuid);
 
+    // Remove every aura a caster applied, on any entity (caster left the
+    // world). Walks only that caster's auras.
+    static void removeAurasAppliedBy(uint64_t casterGuid);
+
     // Remove all auras of a specific type
     void removeAurasByType(SpellDefines::AuraType type);
 
@@ -147,17 +202,15 @@ public:
     // Check if entity has any aura of a specific type
     bool hasAuraType(SpellDefines::AuraType type) const;
 
-    // Get aura by spell ID (returns nullptr if not found)
+    // Get aura by spell ID (returns nullptr if not found). The pointer
+    // stays valid until the aura is removed.
     Aura* getAura(int32_t spellId);
     const Aura* getAura(int32_t spellId) const;
 
-    // Get all auras
-    const std::vector<Aura>& getAuras() const { return m_auras; }
-
     // Get aura count
-    size_t getAuraCount() const { return m_auras.size(); }
-    size_t getBuffCount() const;
-    size_t getDebuffCount() const;
+    size_t getAuraCount() const { return m_auraCount; }
+    size_t getBuffCount() const { return m_buffCount; }
+    size_t getDebuffCount() const { return m_auraCount - m_buffCount; }
 
     // ========================================================================
     // Aura Modifiers (Task 5.9)
@@ -184,16 +237,17 @@ public:
     // Update
     // ========================================================================
 
-    // Update all auras (call each tick)
-    // deltaTimeMs is time since last update in milliseconds
-    void update(int32_t deltaTimeMs);
+    // Handle a due periodic tick or expiry (called by AuraScheduler).
+    // There is no per-tick update; auras without timers cost nothing.
+    void processEvent(const AuraEvent& event);
 
     // ========================================================================
     // Client Sync
     // ========================================================================
 
-    // Mark that auras have changed and need to be sent to clients
-    void markDirty() { m_dirty = true; }
+    // Mark that auras have changed; the owner's list is sent once at the
+    // end of the tick by AuraScheduler
+    void markDirty();
     bool isDirty() const { return m_dirty; }
     void clearDirty() { m_dirty = false; }
 
@@ -204,8 +258,27 @@ private:
     // Check if aura can be applied (respecting limits)
     bool canApplyAura(const Aura& aura) const;
 
-    // Handle periodic effects (DoT/HoT ticks)
-    void processPeriodicEffects(Aura& aura, int32_t deltaTimeMs);
+    // Register expiry and periodic ticks for a newly applied aura
+    void scheduleAura(uint32_t slot);
+
+    // Unlink an aura from the pool, then undo its effects
+    void removeSlot(uint32_t slot);
+
+    // Remove every aura matching pred
+    template <typename Pred>
+    void removeIf(Pred pred);
+
+    // Visit each aura's slot in application order; fn may remove the aura
+    // it is given
+    template <typename Fn>
+    void forEachSlot(Fn fn) const;
+
+    // First aura matching pred (INVALID_SLOT if none)
+    template <typename Pred>
+    uint32_t findSlot(Pred pred) const;
+
+    // Apply one periodic tick (DoT/HoT/mana) of an aura effect
+    void applyPeriodicTick(const Aura& aura, size_t effectIndex);
 
     // Apply aura effect when first added
     void applyAuraEffect(const Aura& aura, const AuraEffect& effect);
@@ -214,10 +287,14 @@ private:
     void removeAuraEffect(const Aura& aura, const AuraEffect& effect);
 
     // Find existing aura that would stack/refresh with new one
-    Aura* findStackableAura(int32_t spellId, uint64_t casterGuid);
+    // (INVALID_SLOT if none)
+    uint32_t findStackableAura(int32_t spellId, uint64_t casterGuid) const;
 
     Entity* m_owner = nullptr;
-    std::vector<Aura> m_auras;
+    uint32_t m_head = AuraConfig::INVALID_SLOT;  // This entity's auras in sAuraPool
+    uint32_t m_tail = AuraConfig::INVALID_SLOT;
+    uint32_t m_auraCount = 0;
+    uint32_t m_buffCount = 0;
     bool m_dirty = false;  // True if auras changed since last broadcast
 };
 
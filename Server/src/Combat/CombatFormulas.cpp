@@ -6,6 +6,7 @@
 #include "stdafx.h"
 #include "Combat/CombatFormulas.h"
 #include "Combat/SpellUtils.h"
+#include "Core/Random.h"
 #include "Database/GameData.h"
 #include "World/Entity.h"
 #include "World/Player.h"
@@ -13,6 +14,7 @@
 #include "UnitDefines.h"
 #include <random>
 #include <algorithm>
+#include <array>
 #include <cmath>
 
 namespace CombatFormulas
@@ -22,13 +24,12 @@ namespace CombatFormulas
 // Random Number Generation
 // ==========================================================================
 
-// Thread-local random engine for combat rolls
-static thread_local std::mt19937 s_rng(std::random_device{}());
+// Combat rolls draw from the shared engine (seedable, see Core/Random.h)
 
 int roll100()
 {
     std::uniform_int_distribution<int> dist(0, 99);
-    return dist(s_rng);
+    return dist(Random::engine());
 }
 
 bool rollChance(int chance)
@@ -79,30 +80,206 @@ bool isMagicalSpell(const SpellTemplate* spell)
 }
 
 // ==========================================================================
-// Hit Chance Calculations (Task 5.6)
+// Lookup Tables
 // ==========================================================================
 
-int getHitChance(Entity* attacker, Entity* victim, const SpellTemplate* spell)
+namespace
 {
-    (void)spell;  // May be used for spell-specific hit modifiers
 
-    int baseHit = Config::BASE_HIT_CHANCE;
+// Level-difference modifiers, indexed by (attacker - victim) + MAX_LEVEL_DIFF.
+// getLevelDifference already clamps, so every lookup is in range.
+struct LevelModifiers
+{
+    int hitChance;      // Before gear (clamped 1-100)
+    int critPenalty;    // Subtracted from crit chance
+    int resistChance;   // Before resistance stats
+    int glanceChance;   // Melee/physical only
+};
 
-    // Level difference affects hit chance
-    int levelDiff = getLevelDifference(attacker, victim);
+constexpr int LEVEL_DIFF_ENTRIES = 2 * Config::MAX_LEVEL_DIFF + 1;
 
-    if (levelDiff < 0)
+constexpr std::array<LevelModifiers, LEVEL_DIFF_ENTRIES> buildLevelModifiers()
+{
+    std::array<LevelModifiers, LEVEL_DIFF_ENTRIES> table{};
+    for (int i = 0; i < LEVEL_DIFF_ENTRIES; ++i)
     {
-        // Attacker is lower level - harder to hit
-        baseHit -= (-levelDiff) * Config::MISS_PER_LEVEL;
+        int levelDiff = i - Config::MAX_LEVEL_DIFF;
+        int levelsBelow = levelDiff < 0 ? -levelDiff : 0;  // Target is this much higher
+
+        int hitChance = Config::BASE_HIT_CHANCE - levelsBelow * Config::MISS_PER_LEVEL;
+        table[i].hitChance = hitChance < 1 ? 1 : (hitChance > 100 ? 100 : hitChance);
+        table[i].critPenalty = levelsBelow * Config::CRIT_PENALTY_PER_LEVEL;
+        table[i].resistChance = levelsBelow * Config::RESIST_PER_LEVEL;
+        table[i].glanceChance = levelsBelow > Config::GLANCE_LEVEL_THRESHOLD
+            ? (levelsBelow - Config::GLANCE_LEVEL_THRESHOLD) * Config::GLANCE_PER_LEVEL
+            : 0;
     }
+    return table;
+}
 
-    // TODO: Add hit rating from gear/buffs
+constexpr std::array<LevelModifiers, LEVEL_DIFF_ENTRIES> LEVEL_MODIFIERS = buildLevelModifiers();
 
-    return std::clamp(baseHit, 1, 100);  // Always at least 1% chance
+constexpr const LevelModifiers& levelModifiers(int levelDiff)
+{
+    return LEVEL_MODIFIERS[levelDiff + Config::MAX_LEVEL_DIFF];
 }
 
-int getCritChance(Entity* attacker, Entity* victim, const SpellTemplate* spell)
+static_assert(levelModifiers(0).hitChance == Config::BASE_HIT_CHANCE &&
+              levelModifiers(-4).hitChance == Config::BASE_HIT_CHANCE - 4 * Config::MISS_PER_LEVEL &&
+              levelModifiers(-3).glanceChance == Config::GLANCE_PER_LEVEL &&
+              levelModifiers(-2).glanceChance == 0 &&
+              levelModifiers(Config::MAX_LEVEL_DIFF).critPenalty == 0,
+              "Level modifier table disagrees with the combat formulas");
+
+// Damage kept after diminishing-returns reduction: 1 - min(x / (x + k), cap)
+constexpr float reductionMultiplier(float value, float constant)
+{
+    float reduction = value / (value + constant);
+    return 1.0f - (reduction < Config::MAX_DAMAGE_REDUCTION ? reduction : Config::MAX_DAMAGE_REDUCTION);
+}
+
+// Armor is quantized into brackets and interpolated linearly between them.
+// The curve is convex and flattest where the brackets are, so the error
+// stays far below one point of damage; past ARMOR_AT_CAP reduction is flat.
+constexpr float ARMOR_K = Config::ARMOR_CONSTANT * Config::ARMOR_LEVEL;
+constexpr int32_t ARMOR_AT_CAP = static_cast<int32_t>(
+    ARMOR_K * Config::MAX_DAMAGE_REDUCTION / (1.0f - Config::MAX_DAMAGE_REDUCTION));
+constexpr int32_t ARMOR_BRACKET_SHIFT = 5;  // 32 armor per bracket
+constexpr int32_t ARMOR_BRACKETS = (ARMOR_AT_CAP >> ARMOR_BRACKET_SHIFT) + 2;
+
+constexpr std::array<float, ARMOR_BRACKETS> buildArmorTable()
+{
+    std::array<float, ARMOR_BRACKETS> table{};
+    for (int32_t i = 0; i < ARMOR_BRACKETS; ++i)
+        table[i] = reductionMultiplier(static_cast<float>(i << ARMOR_BRACKET_SHIFT), ARMOR_K);
+    return table;
+}
+
+constexpr std::array<float, ARMOR_BRACKETS> ARMOR_MULTIPLIERS = buildArmorTable();
+
+constexpr float armorMultiplier(int32_t armor)
+{
+    if (armor >= ARMOR_AT_CAP)
+        return 1.0f - Config::MAX_DAMAGE_REDUCTION;
+
+    int32_t bracket = armor >> ARMOR_BRACKET_SHIFT;
+    float fraction = static_cast<float>(armor & ((1 << ARMOR_BRACKET_SHIFT) - 1)) *
+                     (1.0f / (1 << ARMOR_BRACKET_SHIFT));
+    float low = ARMOR_MULTIPLIERS[bracket];
+    return low + (ARMOR_MULTIPLIERS[bracket + 1] - low) * fraction;
+}
+
+// Largest difference from the direct formula over every armor value up to
+// just past the cap
+constexpr float armorTableError()
+{
+    float worst = 0.0f;
+    for (int32_t armor = 0; armor <= ARMOR_AT_CAP + (1 << ARMOR_BRACKET_SHIFT); ++armor)
+    {
+        float error = armorMultiplier(armor) - reductionMultiplier(static_cast<float>(armor), ARMOR_K);
+        error = error < 0.0f ? -error : error;
+        worst = error > worst ? error : worst;
+    }
+    return worst;
+}
+
+static_assert(armorTableError() < 1e-5f, "Armor brackets too coarse for the reduction curve");
+
+// Resistance reaches the cap within a few hundred points, so it gets one
+// exact entry per point
+constexpr int32_t RESIST_AT_CAP = static_cast<int32_t>(
+    Config::RESIST_CONSTANT * Config::MAX_DAMAGE_REDUCTION / (1.0f - Config::MAX_DAMAGE_REDUCTION));
+
+constexpr std::array<float, RESIST_AT_CAP + 1> buildResistTable()
+{
+    std::array<float, RESIST_AT_CAP + 1> table{};
+    for (int32_t i = 0; i <= RESIST_AT_CAP; ++i)
+        table[i] = reductionMultiplier(static_cast<float>(i), Config::RESIST_CONSTANT);
+    return table;
+}
+
+constexpr std::array<float, RESIST_AT_CAP + 1> RESIST_MULTIPLIERS = buildResistTable();
+
+static_assert(RESIST_MULTIPLIERS[RESIST_AT_CAP] == 1.0f - Config::MAX_DAMAGE_REDUCTION &&
+              RESIST_MULTIPLIERS[100] == 0.5f,
+              "Resistance table disagrees with the reduction formula");
+
+// One attack's possible outcomes as cumulative slices of ROLL_SCALE, so a
+// single draw resolves it. Each outcome takes its chance of whatever the
+// earlier ones left, exactly as the old miss -> avoidance -> crit chain of
+// separate percentage rolls did; ROLL_SCALE is 100^6 so up to six chained
+// percentages divide evenly and the odds are unchanged.
+class AttackTable
+{
+public:
+    static constexpr uint64_t ROLL_SCALE = 1'000'000'000'000ULL;
+
+    constexpr void add(HitResult result, int chance)
+    {
+        if (chance <= 0)
+            return;
+
+        uint64_t width = m_remaining / 100 * static_cast<uint64_t>(std::min(chance, 100));
+        m_remaining -= width;
+        m_bounds[m_count] = ROLL_SCALE - m_remaining;
+        m_results[m_count] = result;
+        ++m_count;
+    }
+
+    constexpr HitResult resolve(uint64_t roll) const
+    {
+        for (int i = 0; i < m_count; ++i)
+        {
+            if (roll < m_bounds[i])
+                return m_results[i];
+        }
+        return HitResult::Hit;
+    }
+
+    HitResult roll() const
+    {
+        std::uniform_int_distribution<uint64_t> dist(0, ROLL_SCALE - 1);
+        return resolve(dist(Random::engine()));
+    }
+
+private:
+    static constexpr int MAX_OUTCOMES = 6;  // Miss, dodge, parry, block, glance, crit
+
+    std::array<uint64_t, MAX_OUTCOMES> m_bounds{};
+    std::array<HitResult, MAX_OUTCOMES> m_results{};
+    int m_count = 0;
+    uint64_t m_remaining = ROLL_SCALE;
+};
+
+constexpr AttackTable sampleAttackTable()
+{
+    AttackTable table;
+    table.add(HitResult::Miss, 10);   // 10%
+    table.add(HitResult::Dodge, 10);  // 10% of the remaining 90% = 9%
+    table.add(HitResult::Crit, 50);   // 50% of the remaining 81% = 40.5%
+    return table;
+}
+
+static_assert(sampleAttackTable().resolve(AttackTable::ROLL_SCALE / 100 * 10 - 1) == HitResult::Miss &&
+              sampleAttackTable().resolve(AttackTable::ROLL_SCALE / 100 * 10) == HitResult::Dodge &&
+              sampleAttackTable().resolve(AttackTable::ROLL_SCALE / 1000 * 190) == HitResult::Crit &&
+              sampleAttackTable().resolve(AttackTable::ROLL_SCALE / 1000 * 595 - 1) == HitResult::Crit &&
+              sampleAttackTable().resolve(AttackTable::ROLL_SCALE / 1000 * 595) == HitResult::Hit,
+              "Attack table must reproduce the chained roll odds");
+
+} // namespace
+
+// ==========================================================================
+// Hit Chance Calculations (Task 5.6)
+// ==========================================================================
+
+namespace
+{
+
+// Chance helpers that take an already computed level difference, so one
+// attack reads both levels once
+
+int critChanceAt(Entity* attacker, const SpellTemplate* spell, int levelDiff)
 {
     int baseCrit = Config::BASE_CRIT_CHANCE;
 
@@ -121,18 +298,67 @@ int getCritChance(Entity* attacker, Entity* victim, const SpellTemplate* spell)
         }
     }
 
-    // Reduce crit chance against higher level targets
-    if (victim)
+    // Reduced crit chance against higher level targets
+    baseCrit -= levelModifiers(levelDiff).critPenalty;
+
+    return std::clamp(baseCrit, 0, 100);
+}
+
+int resistChanceAt(Entity* victim, const SpellTemplate* spell, int levelDiff)
+{
+    // Can only resist magical spells
+    if (isPhysicalSpell(spell))
+        return 0;
+
+    // Attacker is lower level - more likely to be resisted
+    int baseResist = levelModifiers(levelDiff).resistChance;
+
+    // Add resistance from gear/buffs based on spell school
+    if (victim && spell)
     {
-        int levelDiff = getLevelDifference(attacker, victim);
-        if (levelDiff < 0)
+        SpellDefines::School school = static_cast<SpellDefines::School>(spell->castSchool);
+        int32_t resistance = 0;
+
+        switch (school)
         {
-            // Target is higher level - reduced crit chance
-            baseCrit -= (-levelDiff) * 2;  // 2% reduction per level
+            case SpellDefines::School::Frost:
+                resistance = getStatValue(victim, UnitDefines::Stat::ResistFrost);
+                break;
+            case SpellDefines::School::Fire:
+                resistance = getStatValue(victim, UnitDefines::Stat::ResistFire);
+                break;
+            case SpellDefines::School::Shadow:
+                resistance = getStatValue(victim, UnitDefines::Stat::ResistShadow);
+                break;
+            case SpellDefines::School::Holy:
+                resistance = getStatValue(victim, UnitDefines::Stat::ResistHoly);
+                break;
+            default:
+                break;
         }
+
+        // Convert resistance to resist chance (diminishing returns)
+        // Roughly 1% per 10 resistance, capping effectiveness
+        baseResist += resistance / 10;
     }
 
-    return std::clamp(baseCrit, 0, 100);
+    return std::clamp(baseResist, 0, 75);
+}
+
+} // namespace
+
+int getHitChance(Entity* attacker, Entity* victim, const SpellTemplate* spell)
+{
+    (void)spell;  // May be used for spell-specific hit modifiers
+
+    // Level difference affects hit chance (table is already clamped to 1-100)
+    // TODO: Add hit rating from gear/buffs
+    return levelModifiers(getLevelDifference(attacker, victim)).hitChance;
+}
+
+int getCritChance(Entity* attacker, Entity* victim, const SpellTemplate* spell)
+{
+    return critChanceAt(attacker, spell, victim ? getLevelDifference(attacker, victim) : 0);
 }
 
 int getDodgeChance(Entity* victim, const SpellTemplate* spell)
@@ -224,172 +450,55 @@ int getBlockChance(Entity* victim, const SpellTemplate* spell)
 
 int getResistChance(Entity* attacker, Entity* victim, const SpellTemplate* spell)
 {
-    // Can only resist magical spells
-    if (isPhysicalSpell(spell))
-        return 0;
-
-    int baseResist = 0;
-
-    // Level difference affects resist chance
-    int levelDiff = getLevelDifference(attacker, victim);
-    if (levelDiff < 0)
-    {
-        // Attacker is lower level - more likely to be resisted
-        baseResist += (-levelDiff) * Config::RESIST_PER_LEVEL;
-    }
-
-    // Add resistance from gear/buffs based on spell school
-    if (victim && spell)
-    {
-        SpellDefines::School school = static_cast<SpellDefines::School>(spell->castSchool);
-        int32_t resistance = 0;
-
-        switch (school)
-        {
-            case SpellDefines::School::Frost:
-                resistance = getStatValue(victim, UnitDefines::Stat::ResistFrost);
-                break;
-            case SpellDefines::School::Fire:
-                resistance = getStatValue(victim, UnitDefines::Stat::ResistFire);
-                break;
-            case SpellDefines::School::Shadow:
-                resistance = getStatValue(victim, UnitDefines::Stat::ResistShadow);
-                break;
-            case SpellDefines::School::Holy:
-                resistance = getStatValue(victim, UnitDefines::Stat::ResistHoly);
-                break;
-            default:
-                break;
-        }
-
-        // Convert resistance to resist chance (diminishing returns)
-        // Roughly 1% per 10 resistance, capping effectiveness
-        baseResist += resistance / 10;
-    }
-
-    return std::clamp(baseResist, 0, 75);
+    return resistChanceAt(victim, spell, getLevelDifference(attacker, victim));
 }
 
 // ==========================================================================
 // Hit Roll (Task 5.6)
 // ==========================================================================
 
-HitResult rollToHit(Entity* attacker, Entity* victim, const SpellTemplate* spell)
+namespace
 {
-    // Roll order: Miss -> Dodge/Parry/Block -> Resist -> Crit -> Hit
-
-    // 1. Check for miss
-    int hitChance = getHitChance(attacker, victim, spell);
-    if (!rollChance(hitChance))
-    {
-        return HitResult::Miss;
-    }
 
-    // 2. Physical avoidance (dodge, parry, block)
-    if (isPhysicalSpell(spell))
-    {
-        int dodgeChance = getDodgeChance(victim, spell);
-        if (rollChance(dodgeChance))
-        {
-            return HitResult::Dodge;
-        }
+// Outcome order: Miss -> Dodge/Parry/Block/Glancing (physical) or
+// Resist (magic) -> Crit -> Hit
+AttackTable buildAttackTable(Entity* attacker, Entity* victim, const SpellTemplate* spell, bool physical)
+{
+    int levelDiff = getLevelDifference(attacker, victim);
+    const LevelModifiers& level = levelModifiers(levelDiff);
 
-        int parryChance = getParryChance(victim, spell);
-        if (rollChance(parryChance))
-        {
-            return HitResult::Parry;
-        }
+    AttackTable table;
+    table.add(HitResult::Miss, 100 - level.hitChance);
 
-        int blockChance = getBlockChance(victim, spell);
-        if (rollChance(blockChance))
-        {
-            return HitResult::Block;
-        }
+    if (physical)
+    {
+        table.add(HitResult::Dodge, getDodgeChance(victim, spell));
+        table.add(HitResult::Parry, getParryChance(victim, spell));
+        table.add(HitResult::Block, getBlockChance(victim, spell));
 
-        // Check for glancing blow (melee vs higher level target)
-        int levelDiff = getLevelDifference(attacker, victim);
-        if (levelDiff < -2)  // Target is 3+ levels higher
-        {
-            int glanceChance = (-levelDiff - 2) * 10;  // 10% per level beyond 2
-            if (rollChance(glanceChance))
-            {
-                return HitResult::GlancingBlow;
-            }
-        }
+        // Glancing blow (melee vs target 3+ levels higher)
+        table.add(HitResult::GlancingBlow, level.glanceChance);
     }
-
-    // 3. Magic resistance
-    if (isMagicalSpell(spell))
+    else
     {
-        int resistChance = getResistChance(attacker, victim, spell);
-        if (rollChance(resistChance))
-        {
-            return HitResult::Resist;
-        }
+        table.add(HitResult::Resist, resistChanceAt(victim, spell, levelDiff));
     }
 
-    // 4. Critical hit check
-    int critChance = getCritChance(attacker, victim, spell);
-    if (rollChance(critChance))
-    {
-        return HitResult::Crit;
-    }
+    table.add(HitResult::Crit, critChanceAt(attacker, spell, levelDiff));
+    return table;
+}
 
-    // 5. Normal hit
-    return HitResult::Hit;
+} // namespace
+
+HitResult rollToHit(Entity* attacker, Entity* victim, const SpellTemplate* spell)
+{
+    return buildAttackTable(attacker, victim, spell, isPhysicalSpell(spell)).roll();
 }
 
 HitResult rollMeleeHit(Entity* attacker, Entity* victim)
 {
-    // Simplified melee hit roll for basic attacks (no spell)
-    // Roll order: Miss -> Dodge/Parry/Block -> Crit -> Hit
-
-    // 1. Check for miss
-    int hitChance = getHitChance(attacker, victim, nullptr);
-    if (!rollChance(hitChance))
-    {
-        return HitResult::Miss;
-    }
-
-    // 2. Physical avoidance (dodge, parry, block)
-    int dodgeChance = getDodgeChance(victim, nullptr);
-    if (rollChance(dodgeChance))
-    {
-        return HitResult::Dodge;
-    }
-
-    int parryChance = getParryChance(victim, nullptr);
-    if (rollChance(parryChance))
-    {
-        return HitResult::Parry;
-    }
-
-    int blockChance = getBlockChance(victim, nullptr);
-    if (rollChance(blockChance))
-    {
-        return HitResult::Block;
-    }
-
-    // 3. Check for glancing blow (melee vs higher level target)
-    int levelDiff = getLevelDifference(attacker, victim);
-    if (levelDiff < -2)  // Target is 3+ levels higher
-    {
-        int glanceChance = (-levelDiff - 2) * 10;  // 10% per level beyond 2
-        if (rollChance(glanceChance))
-        {
-            return HitResult::GlancingBlow;
-        }
-    }
-
-    // 4. Critical hit check
-    int critChance = getCritChance(attacker, victim, nullptr);
-    if (rollChance(critChance))
-    {
-        return HitResult::Crit;
-    }
-
-    // 5. Normal hit
-    return HitResult::Hit;
+    // Basic attacks (no spell) are always physical
+    return buildAttackTable(attacker, victim, nullptr, true).roll();
 }
 
 // ==========================================================================
@@ -456,17 +565,9 @@ int32_t applyArmorReduction(int32_t damage, int32_t armor)
     if (armor <= 0)
         return damage;
 
-    // Use a fixed level for armor calculation (20 is mid-range)
-    // This gives consistent results regardless of attacker level
-    float armorConstant = Config::ARMOR_CONSTANT * 20.0f;
-
-    // Diminishing returns formula: reduction = armor / (armor + constant)
-    float reduction = static_cast<float>(armor) / (static_cast<float>(armor) + armorConstant);
-
-    // Apply reduction (cap at 75% reduction)
-    reduction = std::min(reduction, 0.75f);
-
-    return static_cast<int32_t>(static_cast<float>(damage) * (1.0f - reduction));
+    // Diminishing returns, armor / (armor + ARMOR_CONSTANT * ARMOR_LEVEL)
+    // capped at 75%, read from the bracketed table
+    return static_cast<int32_t>(static_cast<float>(damage) * armorMultiplier(armor));
 }
 
 int32_t calculateResistReduction(int32_t damage, Entity* victim, SpellDefines::School school)
@@ -498,22 +599,20 @@ int32_t calculateResistReduction(int32_t damage, Entity* victim, SpellDefines::S
     if (resistance <= 0)
         return damage;
 
-    // Apply similar diminishing returns formula as armor
-    // resistance / (resistance + constant) gives reduction %
-    float resistConstant = 100.0f;  // Lower constant = resistance more effective
-    float reduction = static_cast<float>(resistance) / (static_cast<float>(resistance) + resistConstant);
-
-    // Cap at 75% reduction
-    reduction = std::min(reduction, 0.75f);
+    // Same diminishing returns as armor with a lower constant (resistance
+    // is more effective), capped at 75%
+    float multiplier = resistance >= RESIST_AT_CAP
+        ? 1.0f - Config::MAX_DAMAGE_REDUCTION
+        : RESIST_MULTIPLIERS[resistance];
 
-    return static_cast<int32_t>(static_cast<float>(damage) * (1.0f - reduction));
+    return static_cast<int32_t>(static_cast<float>(damage) * multiplier);
 }
 
 int32_t applyDamageVariance(int32_t damage)
 {
     // Apply ±DAMAGE_VARIANCE (e.g., ±10%)
     std::uniform_real_distribution<float> dist(1.0f - Config::DAMAGE_VARIANCE, 1.0f + Config::DAMAGE_VARIANCE);
-    float multiplier = dist(s_rng);
+    float multiplier = dist(Random::engine());
     return static_cast<int32_t>(static_cast<float>(damage) * multiplier);
 }
 
@@ -661,7 +760,7 @@ HealInfo calculateHeal(Entity* healer, Entity* target, const SpellTemplate* spel
 
     // Apply small variance to healing (±5%)
     std::uniform_real_distribution<float> dist(0.95f, 1.05f);
-    float multiplier = dist(s_rng);
+    float multiplier = dist(Random::engine());
     heal = static_cast<int32_t>(static_cast<float>(heal) * multiplier);
 
     result.finalHeal = heal;
@@ -76,9 +76,19 @@ namespace CombatFormulas
         constexpr float GLANCING_MULTIPLIER = 0.70f;
 
         // Armor constant for diminishing returns formula
-        // damage_reduction = armor / (armor + ARMOR_CONSTANT * target_level)
+        // damage_reduction = armor / (armor + ARMOR_CONSTANT * ARMOR_LEVEL)
         constexpr float ARMOR_CONSTANT = 400.0f;
 
+        // Fixed level in the armor formula (mid-range, so armor is worth the
+        // same against every attacker)
+        constexpr int ARMOR_LEVEL = 20;
+
+        // Resistance diminishing returns: resistance / (resistance + RESIST_CONSTANT)
+        constexpr float RESIST_CONSTANT = 100.0f;
+
+        // Cap on armor and resistance damage reduction
+        constexpr float MAX_DAMAGE_REDUCTION = 0.75f;
+
         // Base hit chance (%)
         constexpr int BASE_HIT_CHANCE = 95;
 
@@ -100,6 +110,14 @@ namespace CombatFormulas
         // Resist chance per level difference for magic (%)
         constexpr int RESIST_PER_LEVEL = 3;
 
+        // Crit chance lost per level the target is above the attacker (%)
+        constexpr int CRIT_PENALTY_PER_LEVEL = 2;
+
+        // Glancing blows start once the target is this many levels higher
+        // and gain GLANCE_PER_LEVEL (%) for each level beyond it
+        constexpr int GLANCE_LEVEL_THRESHOLD = 2;
+        constexpr int GLANCE_PER_LEVEL = 10;
+
         // Max level difference for combat (beyond this, always miss/resist)
         constexpr int MAX_LEVEL_DIFF = 10;
 
@@ -3,9 +3,9 @@
 
 #include "stdafx.h"
 #include "Combat/CooldownManager.h"
+#include "Core/GameClock.h"
 #include "Core/Logger.h"
 
-#include <chrono>
 #include <algorithm>
 
 // ============================================================================
@@ -14,9 +14,7 @@
 
 int64_t CooldownManager::getCurrentTimeMs()
 {
-    using namespace std::chrono;
-    auto now = steady_clock::now();
-    return duration_cast<milliseconds>(now.time_since_epoch()).count();
+    return sGameClock.getNowMs();
 }
 
 // ============================================================================
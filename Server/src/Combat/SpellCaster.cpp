@@ -5,6 +5,7 @@
 #include "stdafx.h"
 #include "Combat/SpellCaster.h"
 #include "Combat/SpellUtils.h"
+#include "Combat/SpellDescriptor.h"
 #include "Combat/CooldownManager.h"
 #include "Combat/AuraSystem.h"
 #include "Database/GameData.h"
@@ -63,14 +64,14 @@ const char* getCastResultString(CastResult result)
 
 CastResult SpellCaster::validateCast(Entity* caster, int32_t spellId, Entity* target)
 {
-    // Get spell template
-    const SpellTemplate* spell = sGameData.getSpell(spellId);
-    if (!spell)
+    // Get compiled spell
+    const SpellDescriptor* descriptor = sSpellDescriptors.get(spellId);
+    if (!descriptor)
     {
         return CastResult::UnknownSpell;
     }
 
-    return validateCast(caster, spell, target);
+    return validateCast(caster, *descriptor, target, CastPhase::Start);
 }
 
 CastResult SpellCaster::validateCast(Entity* caster, const SpellTemplate* spell, Entity* target)
@@ -80,32 +81,56 @@ CastResult SpellCaster::validateCast(Entity* caster, const SpellTemplate* spell,
         return CastResult::InternalError;
     }
 
+    const SpellDescriptor* descriptor = sSpellDescriptors.get(spell->entry);
+    if (!descriptor)
+    {
+        return CastResult::UnknownSpell;
+    }
+
+    return validateCast(caster, *descriptor, target, CastPhase::Start);
+}
+
+CastResult SpellCaster::validateCast(Entity* caster, const SpellDescriptor& descriptor,
+                                     Entity* target, CastPhase phase)
+{
+    if (!caster)
+    {
+        return CastResult::InternalError;
+    }
+
+    uint16_t checks = descriptor.checks;
+    if (phase == CastPhase::Finish)
+        checks &= ~CastCheck::StartOnly;
+
+    Player* player = caster->getType() == MutualObject::Type::Player ?
+        static_cast<Player*>(caster) : nullptr;
+
     // 1. Check caster state (dead, stunned, silenced, etc.)
-    CastResult result = checkCasterState(caster, spell);
+    CastResult result = checkCasterState(caster, checks);
     if (result != CastResult::Success)
         return result;
 
     // 2. Check resources (mana, health, cooldowns)
-    result = checkResources(caster, spell);
+    result = checkResources(caster, player, descriptor, checks);
     if (result != CastResult::Success)
         return result;
 
     // 3. Check equipment requirements
-    result = checkEquipment(caster, spell);
+    result = checkEquipment(player, checks);
     if (result != CastResult::Success)
         return result;
 
     // 4. Check target validity (only if spell requires target)
-    if (!SpellUtils::isSelfOnly(spell))
+    if (checks & CastCheck::Target)
     {
-        result = checkTarget(caster, spell, target);
+        result = checkTarget(caster, descriptor, target, checks);
         if (result != CastResult::Success)
             return result;
 
         // 5. Check range (only for targeted spells)
         if (target && target != caster)
         {
-            result = checkRange(caster, spell, target);
+            result = checkRange(caster, descriptor, target, checks);
             if (result != CastResult::Success)
                 return result;
         }
@@ -118,7 +143,7 @@ CastResult SpellCaster::validateCast(Entity* caster, const SpellTemplate* spell,
 // Caster State Checks
 // ============================================================================
 
-CastResult SpellCaster::checkCasterState(Entity* caster, const SpellTemplate* spell)
+CastResult SpellCaster::checkCasterState(Entity* caster, uint16_t checks)
 {
     // Check if caster is dead
     int health = caster->getVariable(ObjDefines::Variable::Health);
@@ -133,27 +158,17 @@ CastResult SpellCaster::checkCasterState(Entity* caster, const SpellTemplate* sp
         return CastResult::CasterStunned;
     }
 
-    // Check silenced state (for magic spells)
-    // Only check for non-physical spells
-    if (spell->castSchool != static_cast<int32_t>(SpellDefines::School::Physical))
+    // Check silenced state (only for non-physical spells)
+    if ((checks & CastCheck::Silence) && caster->isSilenced())
     {
-        if (caster->isSilenced())
-        {
-            return CastResult::CasterSilenced;
-        }
+        return CastResult::CasterSilenced;
     }
 
-    // Check if already casting (for players)
-    Player* player = dynamic_cast<Player*>(caster);
-    if (player)
-    {
-        // TODO: Track current cast in Player class
-        // if (player->isCasting()) return CastResult::CasterCasting;
+    // TODO: Track current cast in Player class
+    // if (player->isCasting()) return CastResult::CasterCasting;
 
-        // Check if player knows this spell
-        // TODO: Implement spellbook checking
-        // if (!player->knowsSpell(spell->entry)) return CastResult::SpellNotLearned;
-    }
+    // TODO: Implement spellbook checking
+    // if (!player->knowsSpell(spell->entry)) return CastResult::SpellNotLearned;
 
     return CastResult::Success;
 }
@@ -162,52 +177,58 @@ CastResult SpellCaster::checkCasterState(Entity* caster, const SpellTemplate* sp
 // Resource Checks
 // ============================================================================
 
-CastResult SpellCaster::checkResources(Entity* caster, const SpellTemplate* spell)
+CastResult SpellCaster::checkResources(Entity* caster, Player* player,
+                                       const SpellDescriptor& descriptor, uint16_t checks)
 {
-    // Get caster's resources
-    int32_t currentMana = caster->getVariable(ObjDefines::Variable::Mana);
-    int32_t maxMana = caster->getVariable(ObjDefines::Variable::MaxMana);
-    int32_t currentHealth = caster->getVariable(ObjDefines::Variable::Health);
-    int32_t level = caster->getVariable(ObjDefines::Variable::Level);
+    const SpellTemplate* spell = descriptor.spell;
 
-    // Calculate mana cost
-    int32_t manaCost = SpellUtils::calculateManaCost(spell, level, maxMana);
-    if (manaCost > 0 && currentMana < manaCost)
+    // Check mana cost
+    if (checks & CastCheck::ManaCost)
     {
-        return CastResult::NotEnoughMana;
+        int32_t level = caster->getVariable(ObjDefines::Variable::Level);
+        int32_t maxMana = caster->getVariable(ObjDefines::Variable::MaxMana);
+        int32_t manaCost = descriptor.manaCost(level, maxMana);
+        if (manaCost > 0 && caster->getVariable(ObjDefines::Variable::Mana) < manaCost)
+        {
+            return CastResult::NotEnoughMana;
+        }
     }
 
     // Check health cost (some spells cost health instead of/in addition to mana)
-    int32_t healthCost = spell->healthCost;
-    if (spell->healthPctCost > 0)
+    if (checks & CastCheck::HealthCost)
     {
-        int32_t maxHealth = caster->getVariable(ObjDefines::Variable::MaxHealth);
-        healthCost += (maxHealth * spell->healthPctCost) / 100;
-    }
-    if (healthCost > 0 && currentHealth <= healthCost)
-    {
-        return CastResult::NotEnoughHealth;
+        int32_t healthCost = spell->healthCost;
+        if (spell->healthPctCost > 0)
+        {
+            int32_t maxHealth = caster->getVariable(ObjDefines::Variable::MaxHealth);
+            healthCost += (maxHealth * spell->healthPctCost) / 100;
+        }
+        if (healthCost > 0 && caster->getVariable(ObjDefines::Variable::Health) <= healthCost)
+        {
+            return CastResult::NotEnoughHealth;
+        }
     }
 
     // Check cooldown (Task 5.7)
-    Player* player = dynamic_cast<Player*>(caster);
     if (player)
     {
+        const CooldownManager& cooldowns = player->getCooldowns();
+
         // Check if the specific spell is on cooldown
-        if (player->getCooldowns().isOnCooldown(spell->entry))
+        if (cooldowns.isOnCooldown(spell->entry))
         {
             return CastResult::OnCooldown;
         }
 
         // Check if the spell's category is on cooldown (for shared cooldowns)
-        if (spell->cooldownCategory > 0 &&
-            player->getCooldowns().isCategoryOnCooldown(spell->cooldownCategory))
+        if ((checks & CastCheck::CategoryCooldown) &&
+            cooldowns.isCategoryOnCooldown(spell->cooldownCategory))
         {
             return CastResult::OnCooldown;
         }
 
         // Check global cooldown
-        if (player->getCooldowns().isOnGCD())
+        if (cooldowns.isOnGCD())
         {
             return CastResult::OnGlobalCooldown;
         }
@@ -231,53 +252,38 @@ CastResult SpellCaster::checkResources(Entity* caster, const SpellTemplate* spel
 // Target Checks
 // ============================================================================
 
-CastResult SpellCaster::checkTarget(Entity* caster, const SpellTemplate* spell, Entity* target)
+CastResult SpellCaster::checkTarget(Entity* caster, const SpellDescriptor& descriptor,
+                                    Entity* target, uint16_t checks)
 {
-    // Self-targeted spells don't need target validation
-    if (SpellUtils::isSelfOnly(spell))
-    {
-        return CastResult::Success;
-    }
-
     // Check if we need a target
-    if (SpellUtils::requiresTarget(spell) && !target)
-    {
-        return CastResult::NoTarget;
-    }
-
-    // If no target and no target required, use self
     if (!target)
     {
-        return CastResult::Success;
+        return descriptor.targetMode == SpellTargetMode::Required ?
+            CastResult::NoTarget : CastResult::Success;  // No target: use self
     }
 
     // Check target alive/dead
-    int targetHealth = target->getVariable(ObjDefines::Variable::Health);
-    bool targetDead = (targetHealth <= 0);
-
     // Most spells require living targets
     // TODO: Check for resurrection-type spells
-    if (targetDead)
+    if (target->getVariable(ObjDefines::Variable::Health) <= 0)
     {
         return CastResult::TargetDead;
     }
 
-    // Check friendly/hostile targeting
-    bool canTargetFriendly = SpellUtils::canTargetFriendly(spell);
-    bool canTargetHostile = SpellUtils::canTargetHostile(spell);
-    bool isHostile = areHostile(caster, target);
-    bool isFriendly = areFriendly(caster, target);
-
-    // Hostile spell on friendly target
-    if (canTargetHostile && !canTargetFriendly && isFriendly && target != caster)
+    // Check friendly/hostile targeting (spells that can hit only one side)
+    if (checks & CastCheck::TargetRelation)
     {
-        return CastResult::TargetFriendly;
-    }
+        // Hostile spell on friendly target
+        if (descriptor.canTargetHostile && target != caster && areFriendly(caster, target))
+        {
+            return CastResult::TargetFriendly;
+        }
 
-    // Friendly spell on hostile target
-    if (canTargetFriendly && !canTargetHostile && isHostile)
-    {
-        return CastResult::TargetHostile;
+        // Friendly spell on hostile target
+        if (descriptor.canTargetFriendly && areHostile(caster, target))
+        {
+            return CastResult::TargetHostile;
+        }
     }
 
     // Check if target is immune to this spell type
@@ -292,25 +298,31 @@ CastResult SpellCaster::checkTarget(Entity* caster, const SpellTemplate* spell,
 // Range Checks
 // ============================================================================
 
-CastResult SpellCaster::checkRange(Entity* caster, const SpellTemplate* spell, Entity* target)
+CastResult SpellCaster::checkRange(Entity* caster, const SpellDescriptor& descriptor,
+                                   Entity* target, uint16_t checks)
 {
     if (!target || target == caster)
     {
         return CastResult::Success;  // Self-cast, no range check needed
     }
 
-    float distance = getDistance(caster, target);
-
-    // Check maximum range
-    if (spell->range > 0 && distance > static_cast<float>(spell->range))
+    if (checks & (CastCheck::MaxRange | CastCheck::MinRange))
     {
-        return CastResult::OutOfRange;
-    }
+        float dx = caster->getX() - target->getX();
+        float dy = caster->getY() - target->getY();
+        float distanceSq = dx * dx + dy * dy;
 
-    // Check minimum range
-    if (spell->rangeMin > 0 && distance < static_cast<float>(spell->rangeMin))
-    {
-        return CastResult::TooClose;
+        // Check maximum range
+        if ((checks & CastCheck::MaxRange) && distanceSq > descriptor.maxRangeSq)
+        {
+            return CastResult::OutOfRange;
+        }
+
+        // Check minimum range
+        if ((checks & CastCheck::MinRange) && distanceSq < descriptor.minRangeSq)
+        {
+            return CastResult::TooClose;
+        }
     }
 
     // Check line of sight
@@ -326,18 +338,14 @@ CastResult SpellCaster::checkRange(Entity* caster, const SpellTemplate* spell, E
 // Equipment Checks
 // ============================================================================
 
-CastResult SpellCaster::checkEquipment(Entity* caster, const SpellTemplate* spell)
+CastResult SpellCaster::checkEquipment(Player* player, uint16_t checks)
 {
     // Check required equipment type
-    if (spell->requiredEquipment > 0)
+    if ((checks & CastCheck::Equipment) && player)
     {
-        Player* player = dynamic_cast<Player*>(caster);
-        if (player)
-        {
-            // TODO: Check equipped weapon type in Phase 6 (Inventory)
-            // if (!player->hasEquippedWeaponType(spell->requiredEquipment))
-            //     return CastResult::WrongEquipment;
-        }
+        // TODO: Check equipped weapon type in Phase 6 (Inventory)
+        // if (!player->hasEquippedWeaponType(spell->requiredEquipment))
+        //     return CastResult::WrongEquipment;
     }
 
     return CastResult::Success;
@@ -347,6 +355,17 @@ CastResult SpellCaster::checkEquipment(Entity* caster, const SpellTemplate* spel
 // Targeting (Task 5.3)
 // ============================================================================
 
+std::vector<Entity*> SpellCaster::getTargets(Entity* caster, const SpellDescriptor& descriptor, Entity* target)
+{
+    // Self-targeted spells
+    if (descriptor.targetMode == SpellTargetMode::Self)
+    {
+        return caster ? std::vector<Entity*>{caster} : std::vector<Entity*>{};
+    }
+
+    return getTargets(caster, descriptor.spell, target);
+}
+
 std::vector<Entity*> SpellCaster::getTargets(Entity* caster, const SpellTemplate* spell, Entity* target)
 {
     std::vector<Entity*> targets;
@@ -363,110 +382,143 @@ std::vector<Entity*> SpellCaster::getTargets(Entity* caster, const SpellTemplate
         return targets;
     }
 
-    // Check each effect's targeting
+    // Union of each effect's targeting
     for (int i = 0; i < 3; ++i)
     {
         if (spell->effect[i] == 0)
             continue;
 
-        int32_t targetType = spell->effectTargetType[i];
-        int32_t radius = spell->effectRadius[i];
+        collectEffectTargets(caster, spell, i, target, targets);
+    }
+
+    // Limit to max targets if specified
+    if (spell->maxTargets > 0 && targets.size() > static_cast<size_t>(spell->maxTargets))
+    {
+        targets.resize(static_cast<size_t>(spell->maxTargets));
+    }
+
+    return targets;
+}
+
+std::vector<Entity*> SpellCaster::getEffectTargets(Entity* caster, const SpellDescriptor& descriptor,
+                                                   int effectIndex, Entity* target)
+{
+    std::vector<Entity*> targets;
+    const SpellTemplate* spell = descriptor.spell;
+
+    if (!caster || effectIndex < 0 || effectIndex >= 3 || spell->effect[effectIndex] == 0)
+    {
+        return targets;
+    }
+
+    if (descriptor.targetMode == SpellTargetMode::Self)
+    {
+        targets.push_back(caster);
+        return targets;
+    }
+
+    collectEffectTargets(caster, spell, effectIndex, target, targets);
+
+    if (spell->maxTargets > 0 && targets.size() > static_cast<size_t>(spell->maxTargets))
+    {
+        targets.resize(static_cast<size_t>(spell->maxTargets));
+    }
+
+    return targets;
+}
+
+void SpellCaster::collectEffectTargets(Entity* caster, const SpellTemplate* spell, int i,
+                                       Entity* target, std::vector<Entity*>& targets)
+{
+    int32_t targetType = spell->effectTargetType[i];
+    int32_t radius = spell->effectRadius[i];
 
-        // Target type 0 = self
-        if (targetType == 0)
+    // Target type 0 = self
+    if (targetType == 0)
+    {
+        if (std::find(targets.begin(), targets.end(), caster) == targets.end())
         {
-            if (std::find(targets.begin(), targets.end(), caster) == targets.end())
-            {
-                targets.push_back(caster);
-            }
+            targets.push_back(caster);
         }
-        // Target type 1 = single friendly
-        else if (targetType == 1)
+    }
+    // Target type 1 = single friendly
+    else if (targetType == 1)
+    {
+        if (target && areFriendly(caster, target))
         {
-            if (target && areFriendly(caster, target))
+            if (std::find(targets.begin(), targets.end(), target) == targets.end())
             {
-                if (std::find(targets.begin(), targets.end(), target) == targets.end())
-                {
-                    targets.push_back(target);
-                }
+                targets.push_back(target);
             }
         }
-        // Target type 2 = single hostile
-        else if (targetType == 2)
+    }
+    // Target type 2 = single hostile
+    else if (targetType == 2)
+    {
+        if (target && areHostile(caster, target))
         {
-            if (target && areHostile(caster, target))
+            if (std::find(targets.begin(), targets.end(), target) == targets.end())
             {
-                if (std::find(targets.begin(), targets.end(), target) == targets.end())
-                {
-                    targets.push_back(target);
-                }
+                targets.push_back(target);
             }
         }
-        // AoE targeting (radius > 0)
-        else if (radius > 0)
+    }
+    // AoE targeting (radius > 0)
+    else if (radius > 0)
+    {
+        // Get center point for AoE
+        float centerX, centerY;
+        if (targetType == 3)  // AoE around self
         {
-            // Get center point for AoE
-            float centerX, centerY;
-            if (targetType == 3)  // AoE around self
-            {
-                centerX = caster->getX();
-                centerY = caster->getY();
-            }
-            else if (targetType == 4 && target)  // AoE around target
-            {
-                centerX = target->getX();
-                centerY = target->getY();
-            }
-            else
-            {
+            centerX = caster->getX();
+            centerY = caster->getY();
+        }
+        else if (targetType == 4 && target)  // AoE around target
+        {
+            centerX = target->getX();
+            centerY = target->getY();
+        }
+        else
+        {
+            return;
+        }
+
+        // Get all players in range from WorldManager
+        int mapId = caster->getMapId();
+        auto playersOnMap = sWorldManager.getPlayersOnMap(mapId);
+
+        bool isHostileEffect = (spell->effectPositive[i] == 0);
+        float radiusF = static_cast<float>(radius);
+
+        for (Player* player : playersOnMap)
+        {
+            // Check distance from center
+            float dx = player->getX() - centerX;
+            float dy = player->getY() - centerY;
+            float dist = std::sqrt(dx * dx + dy * dy);
+
+            if (dist > radiusF)
                 continue;
-            }
 
-            // Get all players in range from WorldManager
-            int mapId = caster->getMapId();
-            auto playersOnMap = sWorldManager.getPlayersOnMap(mapId);
+            // Skip self if not self-buff
+            if (player == caster && isHostileEffect)
+                continue;
 
-            bool isHostileEffect = (spell->effectPositive[i] == 0);
-            float radiusF = static_cast<float>(radius);
+            // Check friendly/hostile
+            if (isHostileEffect && !areHostile(caster, player))
+                continue;
+            if (!isHostileEffect && !areFriendly(caster, player))
+                continue;
 
-            for (Player* player : playersOnMap)
+            // Add to targets if not already present
+            if (std::find(targets.begin(), targets.end(), static_cast<Entity*>(player)) == targets.end())
             {
-                // Check distance from center
-                float dx = player->getX() - centerX;
-                float dy = player->getY() - centerY;
-                float dist = std::sqrt(dx * dx + dy * dy);
-
-                if (dist > radiusF)
-                    continue;
-
-                // Skip self if not self-buff
-                if (player == caster && isHostileEffect)
-                    continue;
-
-                // Check friendly/hostile
-                if (isHostileEffect && !areHostile(caster, player))
-                    continue;
-                if (!isHostileEffect && !areFriendly(caster, player))
-                    continue;
-
-                // Add to targets if not already present
-                if (std::find(targets.begin(), targets.end(), static_cast<Entity*>(player)) == targets.end())
-                {
-                    targets.push_back(player);
-                }
+                targets.push_back(player);
             }
-
-            // TODO: Also check NPCs when NPC system is implemented (Task 5.13)
         }
-    }
 
-    // Limit to max targets if specified
-    if (spell->maxTargets > 0 && targets.size() > static_cast<size_t>(spell->maxTargets))
-    {
-        targets.resize(static_cast<size_t>(spell->maxTargets));
+        // TODO: Also check NPCs when NPC system is implemented (Task 5.13)
     }
-
-    return targets;
 }
 
 // ============================================================================
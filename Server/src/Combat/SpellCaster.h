@@ -12,6 +12,8 @@
 class Entity;
 class Player;
 struct SpellTemplate;
+struct SpellDescriptor;
+enum class CastPhase : uint8_t;
 
 // ============================================================================
 // Cast Result Enum - Specific error codes for cast failures
@@ -83,9 +85,19 @@ public:
     // Validate with spell template already looked up
     static CastResult validateCast(Entity* caster, const SpellTemplate* spell, Entity* target);
 
+    // Validate a compiled spell, running only the checks it needs and, at
+    // cast finish, only those that can have changed since the cast started
+    static CastResult validateCast(Entity* caster, const SpellDescriptor& descriptor,
+                                   Entity* target, CastPhase phase);
+
     // Get list of targets for a spell (handles AoE, self-cast, etc.)
     // Task 5.3: Spell Targeting
     static std::vector<Entity*> getTargets(Entity* caster, const SpellTemplate* spell, Entity* target);
+    static std::vector<Entity*> getTargets(Entity* caster, const SpellDescriptor& descriptor, Entity* target);
+
+    // Targets of one effect slot (what that slot's handler is applied to)
+    static std::vector<Entity*> getEffectTargets(Entity* caster, const SpellDescriptor& descriptor,
+                                                 int effectIndex, Entity* target);
 
     // Calculate if caster has line of sight to target
     static bool hasLineOfSight(Entity* caster, Entity* target);
@@ -100,12 +112,16 @@ public:
     static bool areFriendly(Entity* a, Entity* b);
 
 private:
-    // Individual validation checks
-    static CastResult checkCasterState(Entity* caster, const SpellTemplate* spell);
-    static CastResult checkResources(Entity* caster, const SpellTemplate* spell);
-    static CastResult checkTarget(Entity* caster, const SpellTemplate* spell, Entity* target);
-    static CastResult checkRange(Entity* caster, const SpellTemplate* spell, Entity* target);
-    static CastResult checkEquipment(Entity* caster, const SpellTemplate* spell);
+    // Individual validation checks (`checks` = CastCheck bits to run)
+    static CastResult checkCasterState(Entity* caster, uint16_t checks);
+    static CastResult checkResources(Entity* caster, Player* player, const SpellDescriptor& descriptor, uint16_t checks);
+    static CastResult checkTarget(Entity* caster, const SpellDescriptor& descriptor, Entity* target, uint16_t checks);
+    static CastResult checkRange(Entity* caster, const SpellDescriptor& descriptor, Entity* target, uint16_t checks);
+    static CastResult checkEquipment(Player* player, uint16_t checks);
+
+    // Append effect slot `effectIndex`'s targets not already in `targets`
+    static void collectEffectTargets(Entity* caster, const SpellTemplate* spell, int effectIndex,
+                                     Entity* target, std::vector<Entity*>& targets);
 
     // Helper: Check if entity has an aura/mechanic
     static bool hasAura(Entity* entity, int32_t auraId);
@@ -0,0 +1,192 @@
+// SpellDescriptor - Spell templates compiled for the cast pipeline
+
+#include "stdafx.h"
+#include "Combat/SpellDescriptor.h"
+#include "Combat/SpellUtils.h"
+#include "Database/GameData.h"
+#include "Core/Logger.h"
+
+// ============================================================================
+// LevelFormula
+// ============================================================================
+
+void LevelFormula::compile(const std::string& formula, int32_t maxLevel)
+{
+    m_byLevel.clear();
+    m_formula = formula.empty() ? nullptr : &formula;
+    if (!m_formula)
+        return;
+
+    m_byLevel.reserve(static_cast<size_t>(maxLevel) + 1);
+    for (int32_t level = 0; level <= maxLevel; ++level)
+    {
+        m_byLevel.push_back(SpellUtils::evaluateFormula(formula, level));
+    }
+}
+
+int32_t LevelFormula::evaluate(int32_t level) const
+{
+    if (!m_formula)
+        return 0;
+
+    if (level >= 0 && static_cast<size_t>(level) < m_byLevel.size())
+        return m_byLevel[static_cast<size_t>(level)];
+
+    return SpellUtils::evaluateFormula(*m_formula, level);
+}
+
+// ============================================================================
+// SpellDescriptor
+// ============================================================================
+
+int32_t SpellDescriptor::manaCost(int32_t casterLevel, int32_t maxMana) const
+{
+    // Percentage-based mana cost takes priority
+    if (spell->manaPct > 0)
+        return (maxMana * spell->manaPct) / 100;
+
+    return manaFormula.evaluate(casterLevel);
+}
+
+int32_t SpellDescriptor::effectValue(int effectIndex, int32_t casterLevel) const
+{
+    if (effectIndex < 0 || effectIndex >= 3)
+        return 0;
+
+    if (!effectFormula[effectIndex].empty())
+        return effectFormula[effectIndex].evaluate(casterLevel);
+
+    // Base data1 value with simple level scaling via data2
+    return spell->effectData1[effectIndex] + spell->effectData2[effectIndex] * casterLevel;
+}
+
+// ============================================================================
+// SpellDescriptorStore
+// ============================================================================
+
+SpellDescriptorStore& SpellDescriptorStore::instance()
+{
+    static SpellDescriptorStore instance;
+    return instance;
+}
+
+namespace
+{
+
+bool isAuraEffect(int32_t effect)
+{
+    return effect == static_cast<int32_t>(SpellDefines::Effects::ApplyAura) ||
+           effect == static_cast<int32_t>(SpellDefines::Effects::ApplyAreaAura);
+}
+
+void compileDescriptor(SpellDescriptor& descriptor, const SpellTemplate& spell, int32_t maxLevel)
+{
+    descriptor.spell = &spell;
+    descriptor.instant = spell.castTime <= 0;
+
+    // Targeting
+    descriptor.canTargetFriendly = SpellUtils::canTargetFriendly(&spell);
+    descriptor.canTargetHostile = SpellUtils::canTargetHostile(&spell);
+    if (SpellUtils::isSelfOnly(&spell))
+        descriptor.targetMode = SpellTargetMode::Self;
+    else if (SpellUtils::requiresTarget(&spell))
+        descriptor.targetMode = SpellTargetMode::Required;
+    else
+        descriptor.targetMode = SpellTargetMode::Optional;
+
+    // Checks that can apply to this spell at all
+    uint16_t checks = 0;
+    if (spell.castSchool != static_cast<int32_t>(SpellDefines::School::Physical))
+        checks |= CastCheck::Silence;
+    if (spell.manaPct > 0 || !spell.manaFormula.empty())
+        checks |= CastCheck::ManaCost;
+    if (spell.healthCost > 0 || spell.healthPctCost > 0)
+        checks |= CastCheck::HealthCost;
+    if (spell.cooldownCategory > 0)
+        checks |= CastCheck::CategoryCooldown;
+    if (spell.requiredEquipment > 0)
+        checks |= CastCheck::Equipment;
+    if (descriptor.targetMode != SpellTargetMode::Self)
+    {
+        checks |= CastCheck::Target;
+        if (descriptor.canTargetFriendly != descriptor.canTargetHostile)
+            checks |= CastCheck::TargetRelation;
+        if (spell.range > 0)
+            checks |= CastCheck::MaxRange;
+        if (spell.rangeMin > 0)
+            checks |= CastCheck::MinRange;
+    }
+    descriptor.checks = checks;
+
+    float range = static_cast<float>(spell.range);
+    float rangeMin = static_cast<float>(spell.rangeMin);
+    descriptor.maxRangeSq = range * range;
+    descriptor.minRangeSq = rangeMin * rangeMin;
+
+    // Formulas (a percentage cost never reads the mana formula)
+    if (spell.manaPct <= 0)
+        descriptor.manaFormula.compile(spell.manaFormula, maxLevel);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        descriptor.effectFormula[i].compile(spell.effectScaleFormula[i], maxLevel);
+
+        if (spell.effect[i] > 0 && spell.effect[i] <= 0xFF)
+            descriptor.effectHandler[i] = SpellEffects::getHandler(static_cast<SpellDefines::Effects>(spell.effect[i]));
+        else if (spell.effect[i] != 0)
+            descriptor.effectHandler[i] = SpellEffects::getHandler(SpellDefines::Effects::None);
+    }
+
+    // Fold aura slots with identical targeting into the first of them, so
+    // a multi-effect aura is applied once instead of stacking onto itself
+    for (int i = 0; i < 3; ++i)
+    {
+        if (!isAuraEffect(spell.effect[i]) || !descriptor.effectHandler[i])
+            continue;
+
+        descriptor.auraSlots[i] = static_cast<uint8_t>(1 << i);
+        for (int j = i + 1; j < 3; ++j)
+        {
+            if (isAuraEffect(spell.effect[j]) &&
+                spell.effectTargetType[j] == spell.effectTargetType[i] &&
+                spell.effectRadius[j] == spell.effectRadius[i])
+            {
+                descriptor.auraSlots[i] |= static_cast<uint8_t>(1 << j);
+                descriptor.effectHandler[j] = nullptr;
+            }
+        }
+    }
+}
+
+} // namespace
+
+void SpellDescriptorStore::build()
+{
+    m_byEntry.clear();
+    m_count = 0;
+
+    const auto& spells = sGameData.getAllSpells();
+
+    int32_t maxEntry = -1;
+    for (const auto& [entry, spell] : spells)
+    {
+        if (entry > maxEntry)
+            maxEntry = entry;
+    }
+    if (maxEntry < 0)
+        return;
+
+    m_byEntry.resize(static_cast<size_t>(maxEntry) + 1);
+
+    int32_t maxLevel = sGameData.getMaxLevel();
+    for (const auto& [entry, spell] : spells)
+    {
+        if (entry < 0)
+            continue;
+
+        compileDescriptor(m_byEntry[static_cast<size_t>(entry)], spell, maxLevel);
+        ++m_count;
+    }
+
+    LOG_INFO("Compiled %zu spell descriptors (formulas tabled for levels 0-%d)", m_count, maxLevel);
+}
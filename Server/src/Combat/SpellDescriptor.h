@@ -0,0 +1,146 @@
+// SpellDescriptor - Spell templates compiled for the cast pipeline
+//
+// Everything the cast path used to re-derive from SpellTemplate on every
+// cast is worked out once after game data loads: which validation checks
+// can apply to the spell at all, how it picks targets, its mana cost and
+// effect value formulas evaluated for every character level, and the
+// handler for each effect slot. Descriptors live in a table indexed by
+// spell entry and never move once built.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Combat/SpellEffects.h"
+
+struct SpellTemplate;
+
+// ============================================================================
+// Cast Checks - validation steps a spell can need
+// ============================================================================
+
+namespace CastCheck
+{
+    enum : uint16_t
+    {
+        Silence             = 1 << 0,   // Non-physical school
+        ManaCost            = 1 << 1,   // manaPct or manaFormula
+        HealthCost          = 1 << 2,   // healthCost or healthPctCost
+        CategoryCooldown    = 1 << 3,   // Shares a cooldown category
+        Equipment           = 1 << 4,   // requiredEquipment
+        Target              = 1 << 5,   // Not self-only
+        TargetRelation      = 1 << 6,   // Only friendly or only hostile targets
+        MaxRange            = 1 << 7,
+        MinRange            = 1 << 8,
+    };
+
+    // Checks that cannot change while a cast is in progress: the target
+    // was picked at cast start and who is friend or foe does not change
+    constexpr uint16_t StartOnly = TargetRelation;
+}
+
+// When a cast is being validated
+enum class CastPhase : uint8_t
+{
+    Start,      // Cast request (instant casts run only this)
+    Finish,     // Cast time elapsed; re-check what may have changed
+};
+
+// How a spell finds its target
+enum class SpellTargetMode : uint8_t
+{
+    Self,       // Every effect targets the caster
+    Optional,   // Uses the target if given, else the caster
+    Required,   // Needs an explicit target
+};
+
+// ============================================================================
+// LevelFormula - Formula pre-evaluated for every character level
+// ============================================================================
+
+class LevelFormula
+{
+public:
+    // Evaluate `formula` for levels 0..maxLevel (empty formula = 0)
+    void compile(const std::string& formula, int32_t maxLevel);
+
+    bool empty() const { return m_formula == nullptr; }
+
+    // Levels beyond the table fall back to parsing the formula
+    int32_t evaluate(int32_t level) const;
+
+private:
+    const std::string* m_formula = nullptr;
+    std::vector<int32_t> m_byLevel;
+};
+
+// ============================================================================
+// SpellDescriptor
+// ============================================================================
+
+struct SpellDescriptor
+{
+    const SpellTemplate* spell = nullptr;
+
+    uint16_t checks = 0;                    // CastCheck bits
+    SpellTargetMode targetMode = SpellTargetMode::Optional;
+    bool canTargetFriendly = false;
+    bool canTargetHostile = false;
+    bool instant = true;
+
+    // Squared ranges for distance checks (0 = unlimited / none)
+    float maxRangeSq = 0.0f;
+    float minRangeSq = 0.0f;
+
+    LevelFormula manaFormula;
+    LevelFormula effectFormula[3];
+
+    // Resolved from effect[i]; nullptr for empty slots and for aura slots
+    // folded into an earlier one
+    SpellEffects::Handler effectHandler[3] = {nullptr, nullptr, nullptr};
+
+    // Aura slots that land on the same targets become one aura: bit j of
+    // auraSlots[i] is set when slot i's aura carries slot j's effect too
+    uint8_t auraSlots[3] = {0, 0, 0};
+
+    bool has(uint16_t check) const { return (checks & check) != 0; }
+
+    int32_t manaCost(int32_t casterLevel, int32_t maxMana) const;
+    int32_t effectValue(int effectIndex, int32_t casterLevel) const;
+};
+
+// ============================================================================
+// SpellDescriptorStore - Descriptors for every loaded spell
+// ============================================================================
+
+class SpellDescriptorStore
+{
+public:
+    static SpellDescriptorStore& instance();
+
+    // Compile every spell in GameData (call after it loads)
+    void build();
+
+    // nullptr for unknown spells
+    const SpellDescriptor* get(int32_t entry) const
+    {
+        if (entry < 0 || static_cast<size_t>(entry) >= m_byEntry.size())
+            return nullptr;
+        const SpellDescriptor& descriptor = m_byEntry[static_cast<size_t>(entry)];
+        return descriptor.spell ? &descriptor : nullptr;
+    }
+
+    size_t size() const { return m_count; }
+
+private:
+    SpellDescriptorStore() = default;
+
+    SpellDescriptorStore(const SpellDescriptorStore&) = delete;
+    SpellDescriptorStore& operator=(const SpellDescriptorStore&) = delete;
+
+    std::vector<SpellDescriptor> m_byEntry;
+    size_t m_count = 0;
+};
+
+#define sSpellDescriptors SpellDescriptorStore::instance()
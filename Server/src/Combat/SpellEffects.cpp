@@ -0,0 +1,254 @@
+// SpellEffects - Handlers for spell effects, indexed by effect type
+
+#include "stdafx.h"
+#include "Combat/SpellEffects.h"
+#include "Combat/SpellDescriptor.h"
+#include "Combat/SpellCaster.h"
+#include "Combat/CombatMessenger.h"
+#include "Combat/AuraSystem.h"
+#include "Database/GameData.h"
+#include "World/Entity.h"
+#include "World/Player.h"
+#include "World/Npc.h"
+#include "World/WorldManager.h"
+#include "Core/Logger.h"
+#include <algorithm>
+#include <array>
+
+namespace SpellEffects
+{
+
+// ============================================================================
+// CombatEventBuffer
+// ============================================================================
+
+CombatEvent& CombatEventBuffer::add(CombatEvent::Kind kind, const Context& context, Entity* target)
+{
+    const SpellTemplate* spell = context.descriptor->spell;
+
+    CombatEvent& event = m_events.emplace_back();
+    event.kind = kind;
+    event.effectIndex = static_cast<uint8_t>(context.effectIndex);
+    event.effect = static_cast<SpellDefines::Effects>(spell->effect[context.effectIndex]);
+    event.target = target;
+    return event;
+}
+
+HitList CombatEventBuffer::buildHitList() const
+{
+    HitList hits;
+    hits.reserve(m_events.size());
+
+    for (const CombatEvent& event : m_events)
+    {
+        auto seen = std::find_if(hits.begin(), hits.end(),
+            [&event](const auto& hit) { return hit.first == event.target; });
+        if (seen == hits.end())
+            hits.push_back({event.target, static_cast<uint8_t>(event.hitResult)});
+    }
+
+    return hits;
+}
+
+void CombatEventBuffer::sendCombatMessages(Entity* caster, int32_t spellId) const
+{
+    for (const CombatEvent& event : m_events)
+    {
+        switch (event.kind)
+        {
+            case CombatEvent::Kind::Damage:
+                CombatMessenger::sendDamageMessage(caster, event.target, spellId, event.damage, event.effect);
+                break;
+            case CombatEvent::Kind::Miss:
+                CombatMessenger::sendMissMessage(caster, event.target, spellId, event.damage.hitResult, event.effect);
+                break;
+            case CombatEvent::Kind::Heal:
+                CombatMessenger::sendHealMessage(caster, event.target, spellId, event.heal);
+                break;
+            case CombatEvent::Kind::Hit:
+                break;
+        }
+    }
+}
+
+// ============================================================================
+// Handlers
+// ============================================================================
+
+namespace
+{
+
+// Damage, MeleeAtk, RangedAtk
+void handleDamage(const Context& context, const std::vector<Entity*>& targets)
+{
+    const SpellTemplate* spell = context.descriptor->spell;
+
+    for (Entity* target : targets)
+    {
+        DamageInfo damage = CombatFormulas::calculateDamage(context.caster, target, spell, context.effectIndex);
+
+        // Complete misses deal nothing
+        bool missed = damage.hitResult == HitResult::Miss ||
+                      damage.hitResult == HitResult::Dodge ||
+                      damage.hitResult == HitResult::Parry;
+
+        CombatEvent& event = context.events->add(
+            missed ? CombatEvent::Kind::Miss : CombatEvent::Kind::Damage, context, target);
+        event.hitResult = CombatMessenger::toPacketHitResult(damage.hitResult);
+        event.damage = damage;
+
+        if (missed)
+            continue;
+
+        target->takeDamage(damage.finalDamage, context.caster);
+
+        // Add threat to NPCs
+        if (Npc* npc = dynamic_cast<Npc*>(target))
+        {
+            npc->addThreat(context.caster, damage.finalDamage);
+        }
+    }
+}
+
+// Healing threat: NPCs attacking the healed player should aggro the healer
+void addHealingThreat(Entity* healer, Player* healed, int32_t amount)
+{
+    std::vector<Npc*> npcs = sWorldManager.getNpcsOnMap(healed->getMapId());
+    for (Npc* npc : npcs)
+    {
+        if (!npc || npc->isDead())
+            continue;
+
+        if (npc->getAIState() != NpcAIState::Combat)
+            continue;
+
+        if (npc->getTarget() == healed ||
+            npc->getThreatManager().getThreat(healed) > 0)
+        {
+            npc->addThreat(healer, amount);
+        }
+    }
+}
+
+// Heal, RestoreMana, RestoreManaPct
+void handleHeal(const Context& context, const std::vector<Entity*>& targets)
+{
+    const SpellTemplate* spell = context.descriptor->spell;
+
+    for (Entity* target : targets)
+    {
+        HealInfo heal = CombatFormulas::calculateHeal(context.caster, target, spell, context.effectIndex);
+
+        CombatEvent& event = context.events->add(CombatEvent::Kind::Heal, context, target);
+        event.hitResult = CombatMessenger::toPacketHitResult(heal.hitResult);
+        event.heal = heal;
+
+        target->heal(heal.finalHeal, context.caster);
+
+        if (Player* healedPlayer = dynamic_cast<Player*>(target))
+        {
+            addHealingThreat(context.caster, healedPlayer, heal.finalHeal);
+        }
+    }
+}
+
+// ApplyAura, ApplyAreaAura
+void handleApplyAura(const Context& context, const std::vector<Entity*>& targets)
+{
+    const SpellDescriptor& descriptor = *context.descriptor;
+    const SpellTemplate* spell = descriptor.spell;
+
+    // Built once per cast; aura slots folded into this one add their effects
+    Aura aura = AuraUtils::createAuraFromSpell(context.caster, spell, context.effectIndex);
+    for (int slot = context.effectIndex + 1; slot < 3; ++slot)
+    {
+        if (!(descriptor.auraSlots[context.effectIndex] & (1 << slot)))
+            continue;
+
+        Aura folded = AuraUtils::createAuraFromSpell(context.caster, spell, slot);
+        for (const AuraEffect& effect : folded.effects)
+            aura.effects.push_back(effect);
+    }
+
+    for (Entity* target : targets)
+    {
+        bool applied = target->getAuras().applyAura(aura);
+        context.events->add(CombatEvent::Kind::Hit, context, target);
+
+        if (applied)
+        {
+            LOG_DEBUG("Applied aura from spell %d to target %llu", spell->entry, target->getGuid());
+        }
+    }
+}
+
+// Effects handled elsewhere or not yet implemented
+void handleNoEffect(const Context& context, const std::vector<Entity*>& targets)
+{
+    for (Entity* target : targets)
+    {
+        context.events->add(CombatEvent::Kind::Hit, context, target);
+    }
+}
+
+using HandlerTable = std::array<Handler, 256>;
+
+HandlerTable buildHandlerTable()
+{
+    HandlerTable table;
+    table.fill(&handleNoEffect);
+
+    auto set = [&table](SpellDefines::Effects effect, Handler handler) {
+        table[static_cast<uint8_t>(effect)] = handler;
+    };
+
+    set(SpellDefines::Effects::Damage, &handleDamage);
+    set(SpellDefines::Effects::MeleeAtk, &handleDamage);
+    set(SpellDefines::Effects::RangedAtk, &handleDamage);
+
+    set(SpellDefines::Effects::Heal, &handleHeal);
+    set(SpellDefines::Effects::RestoreMana, &handleHeal);
+    set(SpellDefines::Effects::RestoreManaPct, &handleHeal);
+
+    set(SpellDefines::Effects::ApplyAura, &handleApplyAura);
+    set(SpellDefines::Effects::ApplyAreaAura, &handleApplyAura);
+
+    return table;
+}
+
+} // namespace
+
+Handler getHandler(SpellDefines::Effects effect)
+{
+    static const HandlerTable table = buildHandlerTable();
+    return table[static_cast<uint8_t>(effect)];
+}
+
+// ============================================================================
+// Resolve
+// ============================================================================
+
+void resolve(Entity* caster, const SpellDescriptor& descriptor, Entity* target,
+             CombatEventBuffer& events)
+{
+    Context context;
+    context.caster = caster;
+    context.descriptor = &descriptor;
+    context.events = &events;
+
+    for (int slot = 0; slot < 3; ++slot)
+    {
+        Handler handler = descriptor.effectHandler[slot];
+        if (!handler)
+            continue;
+
+        std::vector<Entity*> targets = SpellCaster::getEffectTargets(caster, descriptor, slot, target);
+        if (targets.empty())
+            continue;
+
+        context.effectIndex = slot;
+        handler(context, targets);
+    }
+}
+
+} // namespace SpellEffects
@@ -0,0 +1,94 @@
+// SpellEffects - Handlers for spell effects, indexed by effect type
+//
+// A spell's effect slots resolve to handlers once, when its descriptor is
+// built. Resolving a cast runs each slot's handler over that slot's own
+// target list; handlers apply state changes (damage, heals, auras, threat)
+// and record what happened in a CombatEventBuffer. Combat messages and the
+// SpellGo hit list are produced from the buffer once every slot has run,
+// so player spells, item spells and NPC spells share one path.
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "SpellDefines.h"
+#include "Combat/CombatFormulas.h"
+
+class Entity;
+struct SpellDescriptor;
+
+namespace SpellEffects
+{
+    // Per-target results for GP_Server_SpellGo (target, packet hit result)
+    using HitList = std::vector<std::pair<Entity*, uint8_t>>;
+
+    class CombatEventBuffer;
+
+    // ========================================================================
+    // Combat Events
+    // ========================================================================
+
+    struct CombatEvent
+    {
+        enum class Kind : uint8_t
+        {
+            Damage,     // damage applied
+            Miss,       // damage roll missed / dodged / parried
+            Heal,       // heal applied
+            Hit,        // effect landed with no combat message (auras etc.)
+        };
+
+        Kind kind = Kind::Hit;
+        uint8_t effectIndex = 0;
+        SpellDefines::Effects effect = SpellDefines::Effects::None;
+        SpellDefines::HitResult hitResult = SpellDefines::HitResult::Normal;
+        Entity* target = nullptr;
+        DamageInfo damage;      // Damage / Miss
+        HealInfo heal;          // Heal
+    };
+
+    struct Context
+    {
+        Entity* caster = nullptr;
+        const SpellDescriptor* descriptor = nullptr;
+        int effectIndex = 0;
+        CombatEventBuffer* events = nullptr;
+    };
+
+    class CombatEventBuffer
+    {
+    public:
+        void clear() { m_events.clear(); }
+        bool empty() const { return m_events.empty(); }
+        const std::vector<CombatEvent>& events() const { return m_events; }
+
+        CombatEvent& add(CombatEvent::Kind kind, const Context& context, Entity* target);
+
+        // One entry per target, in first-hit order; the earliest effect
+        // slot that reached a target gives its hit result
+        HitList buildHitList() const;
+
+        // Send the combat message for every damage, miss and heal event
+        void sendCombatMessages(Entity* caster, int32_t spellId) const;
+
+    private:
+        std::vector<CombatEvent> m_events;
+    };
+
+    // ========================================================================
+    // Handlers
+    // ========================================================================
+
+    // Apply one effect slot to all of its targets
+    using Handler = void (*)(const Context& context, const std::vector<Entity*>& targets);
+
+    // Handler for an effect type (effects without server-side behavior
+    // just record a hit)
+    Handler getHandler(SpellDefines::Effects effect);
+
+    // Run every effect slot of a validated cast. `target` is the explicit
+    // target (may be null); each slot picks its own targets from it.
+    void resolve(Entity* caster, const SpellDescriptor& descriptor, Entity* target,
+                 CombatEventBuffer& events);
+}
@@ -3,6 +3,7 @@
 
 #include "stdafx.h"
 #include "Combat/SpellUtils.h"
+#include "Combat/SpellDescriptor.h"
 #include <cmath>
 #include <cctype>
 #include <stack>
@@ -156,6 +157,11 @@ int32_t calculateManaCost(const SpellTemplate* spell, int32_t casterLevel, int32
     if (!spell)
         return 0;
 
+    // Compiled spells read the formula from their level table
+    const SpellDescriptor* descriptor = sSpellDescriptors.get(spell->entry);
+    if (descriptor && descriptor->spell == spell)
+        return descriptor->manaCost(casterLevel, maxMana);
+
     // Percentage-based mana cost takes priority
     if (spell->manaPct > 0)
     {
@@ -195,6 +201,10 @@ int32_t calculateEffectValue(const SpellTemplate* spell, int effectIndex, int32_
     if (!spell || effectIndex < 0 || effectIndex >= 3)
         return 0;
 
+    const SpellDescriptor* descriptor = sSpellDescriptors.get(spell->entry);
+    if (descriptor && descriptor->spell == spell)
+        return descriptor->effectValue(effectIndex, casterLevel);
+
     // If there's a scale formula, use it
     if (!spell->effectScaleFormula[effectIndex].empty())
     {
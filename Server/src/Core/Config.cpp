@@ -78,6 +78,18 @@ bool Config::load(const std::string& filename)
                 m_serverPort = static_cast<uint16_t>(std::stoi(value));
             } else if (key == "MaxConnections") {
                 m_maxConnections = std::stoi(value);
+            } else if (key == "MaxConnectionsPerIp") {
+                m_maxConnectionsPerIp = std::stoi(value);
+            } else if (key == "LoginQueueSize") {
+                m_loginQueueSize = std::stoi(value);
+            } else if (key == "SocketBufferSize") {
+                m_socketBufferSize = std::stoi(value);
+            } else if (key == "MaxSendQueueBytes") {
+                m_maxSendQueueBytes = std::stoi(value);
+            } else if (key == "NetworkBackend") {
+                m_networkBackend = value;
+            } else if (key == "LatencyProbes") {
+                m_latencyProbes = (value == "1" || value == "true");
             }
         }
         else if (currentSection == "Database") {
@@ -89,6 +101,51 @@ bool Config::load(const std::string& filename)
                 m_serverDbPath = value;
             }
         }
+        else if (currentSection == "Chat") {
+            if (key == "FilterFile") {
+                m_chatFilterPath = value;
+            }
+        }
+        else if (currentSection == "Backup") {
+            if (key == "Enabled") {
+                m_backupEnabled = (value == "1" || value == "true");
+            } else if (key == "Directory") {
+                m_backupDirectory = value;
+            } else if (key == "Hour") {
+                m_backupHour = std::stoi(value);
+            } else if (key == "Keep") {
+                m_backupKeep = std::stoi(value);
+            } else if (key == "Compress") {
+                m_backupCompress = (value == "1" || value == "true");
+            } else if (key == "PagesPerStep") {
+                m_backupPagesPerStep = std::stoi(value);
+            } else if (key == "StepSliceMs") {
+                m_backupStepSliceMs = std::stoi(value);
+            } else if (key == "StepPauseMs") {
+                m_backupStepPauseMs = std::stoi(value);
+            }
+        }
+        else if (currentSection == "Checkpoint") {
+            if (key == "Enabled") {
+                m_checkpointEnabled = (value == "1" || value == "true");
+            } else if (key == "Path") {
+                m_checkpointPath = value;
+            } else if (key == "IntervalSeconds") {
+                m_checkpointIntervalSeconds = std::stoi(value);
+            }
+        }
+        else if (currentSection == "World") {
+            if (key == "TickThreads") {
+                m_tickThreads = std::stoi(value);
+            }
+        }
+        else if (currentSection == "Shard") {
+            if (key == "Socket") {
+                m_shardSocketPath = value;
+            } else if (key == "Maps") {
+                m_shardMaps = value;
+            }
+        }
         else if (currentSection == "Logging") {
             if (key == "Level") {
                 m_logLevel = value;
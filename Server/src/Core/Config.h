@@ -16,12 +16,43 @@ public:
     // Server settings
     uint16_t getServerPort() const { return m_serverPort; }
     int getMaxConnections() const { return m_maxConnections; }
+    int getMaxConnectionsPerIp() const { return m_maxConnectionsPerIp; }
+    int getLoginQueueSize() const { return m_loginQueueSize; }
+    int getSocketBufferSize() const { return m_socketBufferSize; }
+    int getMaxSendQueueBytes() const { return m_maxSendQueueBytes; }
+    const std::string& getNetworkBackend() const { return m_networkBackend; }
+    bool getLatencyProbes() const { return m_latencyProbes; }
 
     // Database paths
     const std::string& getGameDbPath() const { return m_gameDbPath; }
     const std::string& getServerDbPath() const { return m_serverDbPath; }
     const std::string& getMapsPath() const { return m_mapsPath; }
 
+    // Chat
+    const std::string& getChatFilterPath() const { return m_chatFilterPath; }
+
+    // Backups of the server database (BackupManager)
+    bool getBackupEnabled() const { return m_backupEnabled; }
+    const std::string& getBackupDirectory() const { return m_backupDirectory; }
+    int getBackupHour() const { return m_backupHour; }
+    int getBackupKeep() const { return m_backupKeep; }
+    bool getBackupCompress() const { return m_backupCompress; }
+    int getBackupPagesPerStep() const { return m_backupPagesPerStep; }
+    int getBackupStepSliceMs() const { return m_backupStepSliceMs; }
+    int getBackupStepPauseMs() const { return m_backupStepPauseMs; }
+
+    // Warm-restart world checkpoint (WorldCheckpoint)
+    bool getCheckpointEnabled() const { return m_checkpointEnabled; }
+    const std::string& getCheckpointPath() const { return m_checkpointPath; }
+    int getCheckpointIntervalSeconds() const { return m_checkpointIntervalSeconds; }
+
+    // World tick threads (TaskPool): 0 = one per hardware thread, 1 = serial
+    int getTickThreads() const { return m_tickThreads; }
+
+    // Multi-process mode (Gateway / WorldShard)
+    const std::string& getShardSocketPath() const { return m_shardSocketPath; }
+    const std::string& getShardMaps() const { return m_shardMaps; }
+
     // Logging
     const std::string& getLogLevel() const { return m_logLevel; }
 
@@ -30,9 +61,30 @@ private:
 
     uint16_t m_serverPort = 8080;
     int m_maxConnections = 100;
+    int m_maxConnectionsPerIp = 10;      // 0 = unlimited
+    int m_loginQueueSize = 1000;         // Connections waiting for a free slot
+    int m_socketBufferSize = 65536;      // SO_SNDBUF/SO_RCVBUF, 0 = OS default
+    int m_maxSendQueueBytes = 4194304;   // Unsent bytes per session before it is dropped, 0 = unlimited
+    std::string m_networkBackend = "epoll";  // io_uring, epoll or select (SocketPoller)
+    bool m_latencyProbes = true;         // Server-initiated timestamped pings (LatencyMonitor)
     std::string m_gameDbPath = "../game/game.db";
     std::string m_mapsPath = "../game/maps";
     std::string m_serverDbPath = "data/server.db";
+    std::string m_chatFilterPath = "data/chat_filter.txt";
+    bool m_backupEnabled = false;
+    std::string m_backupDirectory = "data/backups";
+    int m_backupHour = 4;                // Local hour of the daily backup
+    int m_backupKeep = 7;                // Backups kept by rotation, 0 = all
+    bool m_backupCompress = true;        // gzip when built with zlib
+    int m_backupPagesPerStep = 256;      // Upper bound of pages copied per step
+    int m_backupStepSliceMs = 5;         // Target wall time of one step
+    int m_backupStepPauseMs = 20;        // Sleep between steps
+    bool m_checkpointEnabled = false;
+    std::string m_checkpointPath = "data/world.checkpoint";
+    int m_checkpointIntervalSeconds = 60;  // Also written on shutdown
+    int m_tickThreads = 0;               // Includes the main thread
+    std::string m_shardSocketPath = "data/gateway.sock";
+    std::string m_shardMaps;             // "<world>:<map>,<map>;...", unlisted maps on world 1
     std::string m_logLevel = "info";
 };
 
@@ -62,8 +62,37 @@ bool GameClock::tick()
     return false;
 }
 
+void GameClock::startSimulated()
+{
+    m_simulated = true;
+    m_simulatedMs = SIMULATED_EPOCH_MS;
+    m_tickCount = 0;
+    m_accumulator = 0.0f;
+    m_deltaTime = m_tickInterval;
+    m_started = true;
+}
+
+void GameClock::step()
+{
+    m_simulatedMs += static_cast<int64_t>(m_tickInterval * 1000.0f + 0.5f);
+    m_deltaTime = m_tickInterval;
+    m_tickCount++;
+}
+
+int64_t GameClock::getNowMs() const
+{
+    if (m_simulated)
+        return m_simulatedMs;
+
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(Clock::now().time_since_epoch()).count();
+}
+
 double GameClock::getElapsedTime() const
 {
+    if (m_simulated)
+        return static_cast<double>(m_simulatedMs - SIMULATED_EPOCH_MS) / 1000.0;
+
     auto elapsed = std::chrono::duration<double>(Clock::now() - m_startTime);
     return elapsed.count();
 }
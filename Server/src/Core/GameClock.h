@@ -34,6 +34,16 @@ public:
     int getTickRate() const { return m_tickRate; }
     float getTickInterval() const { return m_tickInterval; }
 
+    // Millisecond timestamp for gameplay timers (cooldowns, rate limits).
+    // Steady clock when live; advances only through step() when simulated.
+    int64_t getNowMs() const;
+
+    // Simulated time: the clock stops following the steady clock and each
+    // step() advances exactly one tick interval (headless perf runs)
+    void startSimulated();
+    void step();
+    bool isSimulated() const { return m_simulated; }
+
     // Check for lag (tick took longer than expected)
     bool wasLagging() const { return m_wasLagging; }
     float getLagAmount() const { return m_lagAmount; }
@@ -62,6 +72,12 @@ private:
     float m_lagAmount = 0.0f;
 
     bool m_started = false;
+
+    // Simulated time starts well clear of zero so "no timestamp" (0) stays
+    // distinguishable from the first tick
+    static constexpr int64_t SIMULATED_EPOCH_MS = 1'000'000;
+    bool m_simulated = false;
+    int64_t m_simulatedMs = 0;
 };
 
 #define sGameClock GameClock::instance()
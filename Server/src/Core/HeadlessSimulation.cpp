@@ -0,0 +1,431 @@
+// HeadlessSimulation - In-process world simulation for perf runs
+
+#include "stdafx.h"
+#include "Core/HeadlessSimulation.h"
+#include "Core/GameClock.h"
+#include "Core/Logger.h"
+#include "Database/CharacterDb.h"
+#include "Database/DatabaseManager.h"
+#include "Network/Session.h"
+#include "Network/SessionManager.h"
+#include "Network/PacketRouter.h"
+#include "World/WorldManager.h"
+#include "World/Map.h"
+#include "World/Player.h"
+#include "World/Npc.h"
+#include "GamePacketClient.h"
+#include "GamePacketServer.h"
+#include "ChatDefines.h"
+#include "SpellDefines.h"
+#include "StlBuffer.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// ============================================================================
+// Simulation Configuration
+// ============================================================================
+
+namespace SimConfig
+{
+    constexpr const char* PASSWORD = "simpassword";
+    constexpr float MOVE_RADIUS = 200.0f;          // Max distance of a move order
+    constexpr int MOVE_ATTEMPTS = 4;               // Destinations tried before skipping the move
+    constexpr float RESPAWN_RATE = 0.05f;          // Chance per tick a dead player asks to respawn
+    constexpr uint64_t PING_INTERVAL_TICKS = 100;  // Per player, staggered
+}
+
+struct SimPlayer
+{
+    Session* session = nullptr;
+    std::vector<int32_t> spells;
+};
+
+// Client packets are dispatched exactly as the network loop would after
+// reading the opcode off the wire
+void dispatch(Session& session, const GamePacket& packet)
+{
+    StlBuffer buf;
+    packet.pack(buf);
+    sPacketRouter.dispatch(session, packet.getOpcode(), buf);
+}
+
+// Letters only (character names reject digits): 0 -> "Sima", 27 -> "Simbb"
+std::string makeCharacterName(int index)
+{
+    std::string suffix;
+    do
+    {
+        suffix.insert(suffix.begin(), static_cast<char>('a' + index % 26));
+        index /= 26;
+    } while (index-- > 0);
+    return "Sim" + suffix;
+}
+
+uint64_t elapsedMicros(TimePoint start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+}
+
+// ============================================================================
+// Setup
+// ============================================================================
+
+bool createPlayer(int index, SimPlayer& sim)
+{
+    Session* session = sSessionManager.createSession(0);
+
+    GP_Client_Authenticate auth;
+    auth.m_token = "sim" + std::to_string(index) + ":" + SimConfig::PASSWORD;
+    dispatch(*session, auth);
+    if (session->getAccountId() == 0)
+    {
+        LOG_ERROR("Simulation: authentication failed for player %d", index);
+        return false;
+    }
+
+    GP_Client_CharCreate create;
+    create.m_name = makeCharacterName(index);
+    create.m_classId = static_cast<uint8_t>(1 + index % 3);
+    create.m_gender = static_cast<uint8_t>(index % 2);
+    create.m_portraitId = 1;
+    dispatch(*session, create);
+
+    auto characters = CharacterDb::getCharactersByAccount(static_cast<int32_t>(session->getAccountId()));
+    if (characters.empty())
+    {
+        LOG_ERROR("Simulation: character creation failed for player %d", index);
+        return false;
+    }
+
+    GP_Client_EnterWorld enter;
+    enter.m_characterGuid = static_cast<uint32_t>(characters.front().guid);
+    dispatch(*session, enter);
+    if (!session->getPlayer())
+    {
+        LOG_ERROR("Simulation: player %d failed to enter the world", index);
+        return false;
+    }
+
+    auto stmt = sDatabase.prepare("SELECT spell_id FROM character_spells WHERE character_guid = ? ORDER BY spell_id");
+    if (stmt.valid())
+    {
+        stmt.bind(1, characters.front().guid);
+        while (stmt.step())
+            sim.spells.push_back(stmt.getInt(0));
+    }
+
+    sim.session = session;
+    return true;
+}
+
+// ============================================================================
+// Input Generator
+// ============================================================================
+
+// Nearest NPC matching the wanted state; ties go to the lower GUID so the
+// choice does not depend on container order
+Npc* findNearestNpc(Player* player, bool dead)
+{
+    Npc* best = nullptr;
+    float bestDistance = std::numeric_limits<float>::max();
+    for (Npc* npc : sWorldManager.getNpcsOnMap(player->getMapId()))
+    {
+        if (!npc->isSpawned() || npc->isDead() != dead)
+            continue;
+
+        float distance = player->distanceTo(npc);
+        if (distance < bestDistance || (best && distance == bestDistance && npc->getGuid() < best->getGuid()))
+        {
+            best = npc;
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+bool isReachable(const Player* player, float x, float y)
+{
+    const Map* map = player->getMap();
+    if (!map)
+        return true;
+    return map->isReachable(map->cellIdFromWorldPos(player->getX(), player->getY()),
+                            map->cellIdFromWorldPos(x, y));
+}
+
+class InputGenerator
+{
+public:
+    InputGenerator(const SimulationOptions& options)
+        : m_options(options)
+        , m_rng(options.seed ^ 0xA5A5A5A5u)
+    {
+    }
+
+    void generate(SimPlayer& sim, size_t index, uint64_t tick)
+    {
+        Session& session = *sim.session;
+        Player* player = session.getPlayer();
+        if (!player)
+            return;
+
+        if ((tick + index) % SimConfig::PING_INTERVAL_TICKS == 0)
+            dispatch(session, GP_Mutual_Ping());
+
+        if (player->isDead())
+        {
+            if (roll(SimConfig::RESPAWN_RATE))
+                dispatch(session, GP_Client_RequestRespawn());
+            return;
+        }
+
+        if (roll(m_options.moveRate))
+        {
+            // Clients only click walkable ground; retry a few times rather
+            // than flood the handler with rejected moves
+            std::uniform_real_distribution<float> offset(-SimConfig::MOVE_RADIUS, SimConfig::MOVE_RADIUS);
+            for (int attempt = 0; attempt < SimConfig::MOVE_ATTEMPTS; ++attempt)
+            {
+                GP_Client_RequestMove move;
+                move.m_destX = player->getX() + offset(m_rng);
+                move.m_destY = player->getY() + offset(m_rng);
+                if (isReachable(player, move.m_destX, move.m_destY))
+                {
+                    dispatch(session, move);
+                    break;
+                }
+            }
+        }
+
+        if (!sim.spells.empty() && roll(m_options.castRate))
+        {
+            if (Npc* target = findNearestNpc(player, false))
+            {
+                std::uniform_int_distribution<size_t> pick(0, sim.spells.size() - 1);
+                GP_Client_CastSpell cast;
+                cast.m_spellId = sim.spells[pick(m_rng)];
+                cast.m_targetGuid = target->getGuid();
+                cast.m_targetX = target->getX();
+                cast.m_targetY = target->getY();
+                dispatch(session, cast);
+            }
+        }
+
+        if (roll(m_options.lootRate))
+        {
+            if (Npc* corpse = findNearestNpc(player, true))
+            {
+                GP_Client_CastSpell open;
+                open.m_spellId = SpellDefines::StaticSpells::LootUnit;
+                open.m_targetGuid = corpse->getGuid();
+                dispatch(session, open);
+
+                GP_Client_LootItem loot;
+                loot.m_sourceGuid = corpse->getGuid();
+                loot.m_itemId.m_itemId = GP_Client_LootItem::TakeAll;
+                dispatch(session, loot);
+            }
+        }
+
+        if (roll(m_options.chatRate))
+        {
+            GP_Client_ChatMsg chat;
+            chat.m_channelId = static_cast<uint8_t>(ChatDefines::Channels::Say);
+            chat.m_text = "simulated chat " + std::to_string(tick);
+            dispatch(session, chat);
+        }
+    }
+
+private:
+    bool roll(float chance)
+    {
+        return std::uniform_real_distribution<float>(0.0f, 1.0f)(m_rng) < chance;
+    }
+
+    const SimulationOptions& m_options;
+    std::mt19937 m_rng;  // Separate from gameplay rolls: input stays fixed when world logic changes
+};
+
+// ============================================================================
+// Report
+// ============================================================================
+
+// FNV-1a over the end state of every player and NPC, in GUID order
+uint64_t computeStateDigest()
+{
+    uint64_t hash = 1469598103934665603ULL;
+    auto mix = [&hash](int64_t value) {
+        for (int i = 0; i < 8; ++i)
+        {
+            hash ^= static_cast<uint8_t>(value >> (i * 8));
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    std::vector<Player*> players = sWorldManager.getAllPlayers();
+    std::sort(players.begin(), players.end(),
+              [](const Player* a, const Player* b) { return a->getGuid() < b->getGuid(); });
+    for (const Player* player : players)
+    {
+        mix(player->getGuid());
+        mix(player->getLevel());
+        mix(player->getExperience());
+        mix(player->getGold());
+        mix(player->getHealth());
+        mix(static_cast<int64_t>(player->getX()));
+        mix(static_cast<int64_t>(player->getY()));
+    }
+
+    std::vector<Npc*> npcs;
+    for (Player* player : players)
+    {
+        for (Npc* npc : sWorldManager.getNpcsOnMap(player->getMapId()))
+            npcs.push_back(npc);
+    }
+    std::sort(npcs.begin(), npcs.end(),
+              [](const Npc* a, const Npc* b) { return a->getGuid() < b->getGuid(); });
+    npcs.erase(std::unique(npcs.begin(), npcs.end()), npcs.end());
+    for (const Npc* npc : npcs)
+    {
+        mix(npc->getGuid());
+        mix(npc->isSpawned());
+        mix(npc->isDead());
+        mix(static_cast<int64_t>(npc->getX()));
+        mix(static_cast<int64_t>(npc->getY()));
+    }
+    return hash;
+}
+
+void printPhase(const char* name, uint64_t totalUs, uint64_t ticks, uint64_t allUs)
+{
+    std::printf("  %-10s %10.1f us/tick  %5.1f%%\n", name,
+                static_cast<double>(totalUs) / ticks,
+                allUs ? 100.0 * static_cast<double>(totalUs) / allUs : 0.0);
+}
+
+bool parseRate(const std::string& entry, const char* key, float& rate)
+{
+    size_t length = std::strlen(key);
+    if (entry.compare(0, length, key) != 0 || entry.size() <= length || entry[length] != '=')
+        return false;
+    rate = std::strtof(entry.c_str() + length + 1, nullptr);
+    return true;
+}
+
+} // namespace
+
+namespace HeadlessSimulation
+{
+
+bool parseArguments(int argc, char* argv[], SimulationOptions& options)
+{
+    bool simulate = false;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        std::string arg = argv[i];
+        const char* value = argv[i + 1];
+        if (arg == "--simulate")
+        {
+            options.players = std::max(1, std::atoi(value));
+            simulate = true;
+        }
+        else if (arg == "--ticks")
+            options.ticks = std::max(1ULL, std::strtoull(value, nullptr, 10));
+        else if (arg == "--seed")
+            options.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--script")
+        {
+            // move=0.2,cast=0.1,... (unlisted actions keep their default)
+            std::string script = value;
+            size_t start = 0;
+            while (start <= script.size())
+            {
+                size_t end = script.find(',', start);
+                std::string entry = script.substr(start, end - start);
+                if (!parseRate(entry, "move", options.moveRate) &&
+                    !parseRate(entry, "cast", options.castRate) &&
+                    !parseRate(entry, "loot", options.lootRate) &&
+                    !parseRate(entry, "chat", options.chatRate))
+                {
+                    LOG_WARN("Simulation: ignoring script entry '%s'", entry.c_str());
+                }
+                if (end == std::string::npos)
+                    break;
+                start = end + 1;
+            }
+        }
+        else
+            continue;
+        ++i;
+    }
+    return simulate;
+}
+
+int run(const SimulationOptions& options)
+{
+    sGameClock.startSimulated();
+
+    std::vector<SimPlayer> players(static_cast<size_t>(options.players));
+    for (size_t i = 0; i < players.size(); ++i)
+    {
+        if (!createPlayer(static_cast<int>(i), players[i]))
+            return 1;
+    }
+
+    // Per-packet logging would dominate the profile
+    sLogger.setLevel(LogLevel::Warning);
+
+    std::printf("Simulating %d players for %llu ticks (seed %u, move=%.2f cast=%.2f loot=%.2f chat=%.2f)\n",
+                options.players, static_cast<unsigned long long>(options.ticks), options.seed,
+                options.moveRate, options.castRate, options.lootRate, options.chatRate);
+
+    InputGenerator input(options);
+    uint64_t inputUs = 0;
+
+    sWorldManager.setPhaseProfiling(true);
+    sWorldManager.resetPhaseTimes();
+
+    auto runStart = Clock::now();
+    for (uint64_t tick = 0; tick < options.ticks; ++tick)
+    {
+        sGameClock.step();
+
+        auto inputStart = Clock::now();
+        for (size_t i = 0; i < players.size(); ++i)
+            input.generate(players[i], i, tick);
+        inputUs += elapsedMicros(inputStart);
+
+        sWorldManager.update(sGameClock.getDeltaTime());
+        sWorldManager.flushContainerSyncs();
+    }
+    uint64_t totalUs = elapsedMicros(runStart);
+
+    sWorldManager.setPhaseProfiling(false);
+    sLogger.setLevel(LogLevel::Info);
+
+    const WorldManager::PhaseTimes& phases = sWorldManager.getPhaseTimes();
+    std::printf("Per-phase tick cost:\n");
+    printPhase("input", inputUs, options.ticks, totalUs);
+    printPhase("players", phases.playersUs, options.ticks, totalUs);
+    printPhase("npcs", phases.npcsUs, options.ticks, totalUs);
+    printPhase("auras", phases.aurasUs, options.ticks, totalUs);
+    printPhase("respawns", phases.respawnsUs, options.ticks, totalUs);
+    printPhase("duels", phases.duelsUs, options.ticks, totalUs);
+    printPhase("total", totalUs, options.ticks, totalUs);
+    std::printf("Throughput: %.0f ticks/s (%.1fx real time)\n",
+                totalUs ? 1e6 * options.ticks / totalUs : 0.0,
+                totalUs ? 1e6 * options.ticks / totalUs / sGameClock.getTickRate() : 0.0);
+    std::printf("State digest: %016llx\n", static_cast<unsigned long long>(computeStateDigest()));
+    std::fflush(stdout);
+    return 0;
+}
+
+} // namespace HeadlessSimulation
@@ -0,0 +1,50 @@
+// HeadlessSimulation - In-process world simulation for perf runs
+//
+// Builds the world as the live server does (game.db, game/maps), then
+// drives N synthetic players without sockets: each is a Session created
+// with no connection, so every outbound packet is serialized and dropped.
+// Input comes from a seeded generator that feeds client packets (move,
+// cast, loot, chat, respawn, ping) straight into PacketRouter::dispatch.
+//
+// The game clock runs in simulated time and ticks as fast as the world
+// updates; gameplay RNG is seeded, so two runs with the same options do
+// the same work and finish with the same state digest.
+//
+// Usage: DreadmystServer --simulate 200 --ticks 2400 --seed 7
+//                        [--script move=0.2,cast=0.1,loot=0.05,chat=0.01]
+
+#pragma once
+
+#include <cstdint>
+
+// ============================================================================
+// Simulation Options
+// ============================================================================
+
+struct SimulationOptions
+{
+    int players = 0;          // Synthetic players (0 = not simulating)
+    uint64_t ticks = 1200;    // World ticks to run (60 s of game time at 20/s)
+    uint32_t seed = 1;        // Gameplay RNG and input generator seed
+
+    // Chance per player per tick of issuing each action
+    float moveRate = 0.2f;
+    float castRate = 0.1f;
+    float lootRate = 0.05f;
+    float chatRate = 0.01f;
+};
+
+namespace HeadlessSimulation
+{
+    // Fills `options` from --simulate/--ticks/--seed/--script; returns
+    // false when --simulate is absent (normal server start)
+    bool parseArguments(int argc, char* argv[], SimulationOptions& options);
+
+    // Server DB path used while simulating; nothing is persisted
+    constexpr const char* DATABASE_PATH = ":memory:";
+
+    // Run the simulation against an initialized world; returns the
+    // process exit code. Random::seed(options.seed) must already have been
+    // called before the world was built so NPC spawns are reproducible.
+    int run(const SimulationOptions& options);
+}
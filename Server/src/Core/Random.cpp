@@ -0,0 +1,41 @@
+// Random - Shared random engine for gameplay rolls
+
+#include "stdafx.h"
+#include "Core/Random.h"
+
+#include <atomic>
+
+namespace
+{
+std::atomic<uint32_t> s_seed{std::random_device{}()};
+std::atomic<uint32_t> s_generation{0};
+std::atomic<uint32_t> s_threadCount{0};
+} // namespace
+
+namespace Random
+{
+
+std::mt19937& engine()
+{
+    // Each thread mixes its ordinal into the seed so threads don't repeat
+    // one another's sequence
+    thread_local uint32_t ordinal = s_threadCount.fetch_add(1);
+    thread_local uint32_t generation = s_generation.load();
+    thread_local std::mt19937 rng(s_seed.load() + ordinal * 0x9E3779B9u);
+
+    uint32_t current = s_generation.load(std::memory_order_relaxed);
+    if (generation != current)
+    {
+        generation = current;
+        rng.seed(s_seed.load() + ordinal * 0x9E3779B9u);
+    }
+    return rng;
+}
+
+void seed(uint32_t value)
+{
+    s_seed = value;
+    s_generation.fetch_add(1);
+}
+
+} // namespace Random
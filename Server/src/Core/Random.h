@@ -0,0 +1,21 @@
+// Random - Shared random engine for gameplay rolls
+//
+// Every gameplay roll (combat, loot, AI wander, respawn jitter) draws from
+// Random::engine() so a run can be made reproducible with one seed. Live
+// servers seed from std::random_device; the headless simulation seeds
+// explicitly. Engines are per thread; reseeding applies to every thread's
+// engine on its next draw.
+
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+namespace Random
+{
+    // Engine for the calling thread
+    std::mt19937& engine();
+
+    // Reseed all engines (deterministic runs)
+    void seed(uint32_t value);
+}
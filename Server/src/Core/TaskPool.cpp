@@ -0,0 +1,136 @@
+// TaskPool - Worker threads for the parallel phases of the world tick
+
+#include "stdafx.h"
+#include "Core/TaskPool.h"
+#include "Core/Logger.h"
+#include <algorithm>
+
+TaskPool& TaskPool::instance()
+{
+    static TaskPool instance;
+    return instance;
+}
+
+TaskPool::~TaskPool()
+{
+    stop();
+}
+
+void TaskPool::start(size_t workers)
+{
+    if (!m_threads.empty())
+        return;  // Already running
+
+    m_stopping = false;
+    m_lanes = std::make_unique<Lane[]>(workers + 1);
+    m_threads.reserve(workers);
+    for (size_t i = 0; i < workers; ++i)
+    {
+        m_threads.emplace_back(&TaskPool::workerThread, this, i + 1);
+    }
+
+    LOG_INFO("Task pool started (%zu worker threads)", workers);
+}
+
+void TaskPool::stop()
+{
+    if (m_threads.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+
+    for (std::thread& thread : m_threads)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+    m_threads.clear();
+
+    LOG_INFO("Task pool stopped");
+}
+
+void TaskPool::parallelFor(size_t count, size_t grain, const RangeFn& fn)
+{
+    if (count == 0)
+        return;
+
+    if (grain == 0)
+        grain = 1;
+
+    size_t chunks = (count + grain - 1) / grain;
+    size_t participants = getConcurrency();
+    if (participants == 1 || chunks == 1)
+    {
+        fn(0, count, 0);
+        return;
+    }
+
+    // Deal the chunks out as evenly sized contiguous runs
+    for (size_t i = 0; i < participants; ++i)
+    {
+        m_lanes[i].next.store(chunks * i / participants, std::memory_order_relaxed);
+        m_lanes[i].end = chunks * (i + 1) / participants;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fn = &fn;
+        m_count = count;
+        m_grain = grain;
+        m_busyWorkers = m_threads.size();
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    runLanes(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_busyWorkers == 0; });
+    m_fn = nullptr;
+}
+
+void TaskPool::workerThread(size_t participant)
+{
+    uint64_t seen = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this, seen] { return m_stopping || m_generation != seen; });
+            if (m_stopping)
+                return;
+            seen = m_generation;
+        }
+
+        runLanes(participant);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_busyWorkers == 0)
+            m_done.notify_one();
+    }
+}
+
+void TaskPool::runLanes(size_t participant)
+{
+    size_t participants = getConcurrency();
+
+    // Own run first, then steal from the others in turn
+    for (size_t offset = 0; offset < participants; ++offset)
+    {
+        Lane& lane = m_lanes[(participant + offset) % participants];
+        while (true)
+        {
+            size_t chunk = lane.next.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= lane.end)
+                break;
+
+            size_t begin = chunk * m_grain;
+            size_t end = std::min(begin + m_grain, m_count);
+            (*m_fn)(begin, end, participant);
+        }
+    }
+}
@@ -0,0 +1,77 @@
+// TaskPool - Worker threads for the parallel phases of the world tick
+//
+// parallelFor() splits an index range into chunks and gives every
+// participant (the calling thread plus each worker) a contiguous run of
+// them. A participant that empties its own run steals chunks from the
+// others', so one slow range doesn't leave the rest of the pool idle. The
+// call returns once every chunk has run.
+//
+// Work passed to parallelFor must only write state owned by its own
+// indices. Anything that reaches other entities (damage, packets, saves)
+// is left for the caller to commit serially, in index order, afterwards -
+// so the result is the same whatever the thread count.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TaskPool
+{
+public:
+    // fn(begin, end, participant): participant is 0 for the calling thread
+    // and 1..workers for pool threads, for indexing per-thread scratch
+    using RangeFn = std::function<void(size_t begin, size_t end, size_t participant)>;
+
+    static TaskPool& instance();
+
+    // Start `workers` threads (0 = everything runs on the caller)
+    void start(size_t workers);
+    void stop();
+
+    // Threads taking part in parallelFor (workers + caller)
+    size_t getConcurrency() const { return m_threads.size() + 1; }
+
+    // Run fn over [0, count) in chunks of at most `grain` indices
+    void parallelFor(size_t count, size_t grain, const RangeFn& fn);
+
+private:
+    TaskPool() = default;
+    ~TaskPool();
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    // A participant's run of chunks; owner and thieves both claim from next
+    struct alignas(64) Lane
+    {
+        std::atomic<size_t> next{0};
+        size_t end = 0;
+    };
+
+    void workerThread(size_t participant);
+    void runLanes(size_t participant);
+
+    std::vector<std::thread> m_threads;
+    std::unique_ptr<Lane[]> m_lanes;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    uint64_t m_generation = 0;     // Bumped once per parallelFor
+    size_t m_busyWorkers = 0;
+    bool m_stopping = false;
+
+    // Current job
+    const RangeFn* m_fn = nullptr;
+    size_t m_count = 0;
+    size_t m_grain = 1;
+};
+
+#define sTaskPool TaskPool::instance()
@@ -0,0 +1,391 @@
+// BackupManager - Online backups of the server database
+
+#include "stdafx.h"
+#include "Database/BackupManager.h"
+#include "Core/Config.h"
+#include "Core/Logger.h"
+
+#include <sqlite3.h>
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#ifdef DREADMYST_HAVE_ZLIB
+    #include <zlib.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+constexpr const char* BACKUP_PREFIX = "server-";
+constexpr const char* TEMP_SUFFIX = ".tmp";
+
+bool isBackupFile(const std::string& name)
+{
+    auto endsWith = [&name](const char* suffix) {
+        size_t length = std::char_traits<char>::length(suffix);
+        return name.size() >= length && name.compare(name.size() - length, length, suffix) == 0;
+    };
+    return name.rfind(BACKUP_PREFIX, 0) == 0 && (endsWith(".db") || endsWith(".db.gz"));
+}
+
+std::string makeTimestamp()
+{
+    std::time_t now = std::time(nullptr);
+    char buf[32];
+    std::strftime(buf, sizeof(buf), "%Y%m%d-%H%M%S", std::localtime(&now));
+    return buf;
+}
+} // namespace
+
+BackupManager& BackupManager::instance()
+{
+    static BackupManager instance;
+    return instance;
+}
+
+BackupManager::~BackupManager()
+{
+    stop();
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+void BackupManager::start(const std::string& sourcePath)
+{
+    if (m_running || !sConfig.getBackupEnabled()) {
+        return;
+    }
+
+    m_sourcePath = sourcePath;
+
+    // A copy interrupted by a crash or hot upgrade leaves its temp file
+    std::error_code ec;
+    fs::create_directories(sConfig.getBackupDirectory(), ec);
+    for (const auto& entry : fs::directory_iterator(sConfig.getBackupDirectory(), ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind(BACKUP_PREFIX, 0) == 0 && entry.path().extension() == TEMP_SUFFIX) {
+            fs::remove(entry.path(), ec);
+        }
+    }
+
+#ifndef DREADMYST_HAVE_ZLIB
+    if (sConfig.getBackupCompress()) {
+        LOG_WARN("Backup: built without zlib, backups will not be compressed");
+    }
+#endif
+
+    m_stopRequested = false;
+    m_running = true;
+    m_thread = std::thread(&BackupManager::workerThread, this);
+
+    LOG_INFO("Backup manager started (daily at %02d:00, keeping %d in %s)",
+             sConfig.getBackupHour(), sConfig.getBackupKeep(), sConfig.getBackupDirectory().c_str());
+}
+
+void BackupManager::stop()
+{
+    if (!m_running) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_condition.notify_one();
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    m_running = false;
+    LOG_INFO("Backup manager stopped");
+}
+
+void BackupManager::requestBackup()
+{
+    if (!m_running) {
+        LOG_WARN("Backup requested but backups are disabled ([Backup] Enabled=0)");
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_backupRequested = true;
+    }
+    m_condition.notify_one();
+}
+
+// ============================================================================
+// Scheduling
+// ============================================================================
+
+std::chrono::system_clock::time_point BackupManager::nextScheduledRun() const
+{
+    auto now = std::chrono::system_clock::now();
+    std::time_t nowTime = std::chrono::system_clock::to_time_t(now);
+
+    std::tm next = *std::localtime(&nowTime);
+    next.tm_hour = std::clamp(sConfig.getBackupHour(), 0, 23);
+    next.tm_min = 0;
+    next.tm_sec = 0;
+    next.tm_isdst = -1;
+
+    auto scheduled = std::chrono::system_clock::from_time_t(std::mktime(&next));
+    if (scheduled <= now) {
+        next.tm_mday += 1;  // mktime normalizes month/year rollover
+        scheduled = std::chrono::system_clock::from_time_t(std::mktime(&next));
+    }
+    return scheduled;
+}
+
+void BackupManager::workerThread()
+{
+    while (true) {
+        auto next = nextScheduledRun();
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait_until(lock, next, [this] {
+                return m_stopRequested || m_backupRequested;
+            });
+
+            if (m_stopRequested) {
+                break;
+            }
+            m_backupRequested = false;
+        }
+
+        runBackup();
+    }
+}
+
+// ============================================================================
+// Backup
+// ============================================================================
+
+bool BackupManager::runBackup()
+{
+    const fs::path directory = sConfig.getBackupDirectory();
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+
+    const std::string base = (directory / (BACKUP_PREFIX + makeTimestamp() + ".db")).string();
+    const std::string temp = base + TEMP_SUFFIX;
+
+    auto startTime = std::chrono::steady_clock::now();
+    LOG_INFO("Backup: copying %s", m_sourcePath.c_str());
+
+    if (!copyDatabase(temp)) {
+        fs::remove(temp, ec);
+        return false;
+    }
+
+    // Compressed output replaces the plain copy; on failure keep the plain one
+    std::string finalPath = base;
+    if (sConfig.getBackupCompress() && compressFile(temp, base + ".gz" + TEMP_SUFFIX)) {
+        finalPath = base + ".gz";
+        fs::rename(base + ".gz" + TEMP_SUFFIX, finalPath, ec);
+        fs::remove(temp, ec);
+    }
+    else {
+        fs::rename(temp, finalPath, ec);
+    }
+
+    if (ec) {
+        LOG_ERROR("Backup: could not finalize %s: %s", finalPath.c_str(), ec.message().c_str());
+        return false;
+    }
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    LOG_INFO("Backup: wrote %s (%llu KB) in %.1fs", finalPath.c_str(),
+             static_cast<unsigned long long>(fs::file_size(finalPath, ec) / 1024), elapsed);
+
+    rotate();
+    return true;
+}
+
+bool BackupManager::copyDatabase(const std::string& destPath)
+{
+    sqlite3* source = nullptr;
+    if (sqlite3_open_v2(m_sourcePath.c_str(), &source, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+        LOG_ERROR("Backup: cannot open %s: %s", m_sourcePath.c_str(), sqlite3_errmsg(source));
+        sqlite3_close(source);
+        return false;
+    }
+    sqlite3_busy_timeout(source, 1000);
+
+    // Hold one read transaction across every step: in WAL mode this pins a
+    // snapshot without blocking the writer, so saves during the copy
+    // neither stall nor restart it
+    bool snapshot = false;
+    {
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(source, "PRAGMA journal_mode", -1, &stmt, nullptr) == SQLITE_OK &&
+            sqlite3_step(stmt) == SQLITE_ROW) {
+            const char* mode = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+            snapshot = mode && std::string(mode) == "wal";
+        }
+        sqlite3_finalize(stmt);
+    }
+
+    if (snapshot) {
+        snapshot = sqlite3_exec(source, "BEGIN; SELECT COUNT(*) FROM sqlite_master;",
+                                nullptr, nullptr, nullptr) == SQLITE_OK;
+    }
+    if (!snapshot) {
+        LOG_WARN("Backup: %s is not in WAL mode; the copy restarts whenever the server writes",
+                 m_sourcePath.c_str());
+    }
+
+    sqlite3* dest = nullptr;
+    bool copied = false;
+    if (sqlite3_open(destPath.c_str(), &dest) == SQLITE_OK) {
+        copied = stepBackup(source, dest);
+
+        // The copy inherits WAL from the source header; a standalone file
+        // restores more simply with a rollback journal
+        if (copied) {
+            sqlite3_exec(dest, "PRAGMA journal_mode = DELETE", nullptr, nullptr, nullptr);
+        }
+    }
+    else {
+        LOG_ERROR("Backup: cannot create %s: %s", destPath.c_str(), sqlite3_errmsg(dest));
+    }
+    sqlite3_close(dest);
+
+    if (snapshot) {
+        sqlite3_exec(source, "COMMIT", nullptr, nullptr, nullptr);
+    }
+    sqlite3_close(source);
+    return copied;
+}
+
+bool BackupManager::stepBackup(sqlite3* source, sqlite3* dest)
+{
+    sqlite3_backup* backup = sqlite3_backup_init(dest, "main", source, "main");
+    if (!backup) {
+        LOG_ERROR("Backup: init failed: %s", sqlite3_errmsg(dest));
+        return false;
+    }
+
+    const int maxPages = std::max(1, sConfig.getBackupPagesPerStep());
+    const auto slice = std::chrono::milliseconds(std::max(1, sConfig.getBackupStepSliceMs()));
+    const auto pause = std::chrono::milliseconds(std::max(0, sConfig.getBackupStepPauseMs()));
+
+    int pages = maxPages;
+    int steps = 0;
+    auto longestStep = std::chrono::steady_clock::duration::zero();
+    int result = SQLITE_OK;
+
+    while (true) {
+        auto stepStart = std::chrono::steady_clock::now();
+        result = sqlite3_backup_step(backup, pages);
+        auto stepTime = std::chrono::steady_clock::now() - stepStart;
+        longestStep = std::max(longestStep, stepTime);
+        ++steps;
+
+        if (result == SQLITE_DONE) {
+            break;
+        }
+        if (result != SQLITE_OK && result != SQLITE_BUSY && result != SQLITE_LOCKED) {
+            LOG_ERROR("Backup: step failed: %s", sqlite3_errstr(result));
+            break;
+        }
+
+        // Keep each step inside its slice: halve on overrun, grow back while
+        // comfortably under
+        if (stepTime > slice && pages > 1) {
+            pages /= 2;
+        }
+        else if (stepTime * 2 < slice && pages < maxPages) {
+            pages = std::min(maxPages, pages * 2);
+        }
+
+        // Pause between steps; wakes early for shutdown
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_condition.wait_for(lock, pause, [this] { return m_stopRequested.load(); })) {
+            LOG_WARN("Backup: abandoned at shutdown (%d of %d pages copied)",
+                     sqlite3_backup_pagecount(backup) - sqlite3_backup_remaining(backup),
+                     sqlite3_backup_pagecount(backup));
+            break;
+        }
+    }
+
+    int pageCount = sqlite3_backup_pagecount(backup);
+    sqlite3_backup_finish(backup);
+
+    if (result != SQLITE_DONE) {
+        return false;
+    }
+
+    LOG_INFO("Backup: %d pages in %d steps (longest %.1fms)", pageCount, steps,
+             std::chrono::duration<double, std::milli>(longestStep).count());
+    return true;
+}
+
+bool BackupManager::compressFile(const std::string& from, const std::string& to)
+{
+#ifdef DREADMYST_HAVE_ZLIB
+    std::ifstream in(from, std::ios::binary);
+    gzFile out = gzopen(to.c_str(), "wb6");
+    if (!in || !out) {
+        LOG_ERROR("Backup: cannot compress %s", from.c_str());
+        if (out) {
+            gzclose(out);
+        }
+        return false;
+    }
+
+    std::vector<char> buffer(64 * 1024);
+    bool ok = true;
+    while (ok && in) {
+        in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        int count = static_cast<int>(in.gcount());
+        if (count > 0 && gzwrite(out, buffer.data(), static_cast<unsigned>(count)) != count) {
+            ok = false;
+        }
+    }
+
+    if (gzclose(out) != Z_OK || !ok) {
+        LOG_ERROR("Backup: compression of %s failed", from.c_str());
+        std::error_code ec;
+        fs::remove(to, ec);
+        return false;
+    }
+    return true;
+#else
+    (void)from;
+    (void)to;
+    return false;
+#endif
+}
+
+void BackupManager::rotate()
+{
+    int keep = sConfig.getBackupKeep();
+    if (keep <= 0) {
+        return;
+    }
+
+    // Timestamped names sort chronologically
+    std::vector<fs::path> backups;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(sConfig.getBackupDirectory(), ec)) {
+        if (entry.is_regular_file() && isBackupFile(entry.path().filename().string())) {
+            backups.push_back(entry.path());
+        }
+    }
+    std::sort(backups.begin(), backups.end());
+
+    for (size_t i = 0; i + static_cast<size_t>(keep) < backups.size(); ++i) {
+        if (fs::remove(backups[i], ec)) {
+            LOG_INFO("Backup: rotated out %s", backups[i].filename().string().c_str());
+        }
+    }
+}
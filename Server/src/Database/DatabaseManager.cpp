@@ -208,6 +208,10 @@ bool DatabaseManager::open(const std::string& path)
     // Enable foreign key support (use internal version - we already hold the lock)
     executeInternal("PRAGMA foreign_keys = ON");
 
+    // WAL: readers such as the online backup keep a snapshot without
+    // blocking writes (in-memory databases stay in memory mode)
+    executeInternal("PRAGMA journal_mode = WAL");
+
     // Set busy timeout (5 seconds)
     sqlite3_busy_timeout(m_db, 5000);
 
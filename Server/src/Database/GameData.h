@@ -274,6 +274,7 @@ public:
 
     // Template lookups (returns nullptr if not found)
     const SpellTemplate* getSpell(int32_t entry) const;
+    const std::unordered_map<int32_t, SpellTemplate>& getAllSpells() const { return m_spells; }
     const ItemTemplate* getItem(int32_t entry) const;
     const NpcTemplate* getNpc(int32_t entry) const;
     const QuestTemplate* getQuest(int32_t entry) const;
@@ -5,6 +5,7 @@
 #include "Handlers/MiscHandlers.h"
 #include "Network/Session.h"
 #include "Network/PacketRouter.h"
+#include "Network/LatencyMonitor.h"
 #include "Core/Logger.h"
 #include "GamePacketBase.h"
 #include "GamePacketServer.h"
@@ -31,6 +32,23 @@ void handlePing(Session& session, StlBuffer& data)
     LOG_DEBUG("Session %u: Ping echoed", session.getId());
 }
 
+void handleMutualPing(Session& session, StlBuffer& data)
+{
+    // Only the echo of our own probe (same timestamp and nonce) answers it,
+    // and isn't echoed again - that would start a ping-pong. Anything else
+    // is the client's own ping and gets its reply.
+    if (data.size() - data.readPos() >= GP_Mutual_PingProbe::PAYLOAD_SIZE) {
+        GP_Mutual_PingProbe probe;
+        probe.unpack(data);
+        if (sLatencyMonitor.completeProbe(session, probe.m_sentAtMicros, probe.m_nonce)) {
+            session.updateLastPing();
+            return;
+        }
+    }
+
+    handlePing(session, data);
+}
+
 void registerMiscHandlers()
 {
     // Client_Ping (0x01) - Primary ping from client, allowed in any connected state
@@ -42,10 +60,11 @@ void registerMiscHandlers()
         "Client_Ping"
     );
 
-    // Also handle Mutual_Ping (0x00) for backwards compatibility
+    // Mutual_Ping (0x00) - replies to server latency probes, echoed
+    // otherwise for backwards compatibility
     sPacketRouter.registerHandler(
         Opcode::Mutual_Ping,
-        handlePing,
+        handleMutualPing,
         SessionState::Connected,
         true,
         "Mutual_Ping"
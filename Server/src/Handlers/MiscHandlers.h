@@ -11,6 +11,9 @@ namespace Handlers
     // Handle ping packet - echoes back to client
     void handlePing(Session& session, StlBuffer& data);
 
+    // Handle Mutual_Ping - answers a server latency probe, otherwise echoed
+    void handleMutualPing(Session& session, StlBuffer& data);
+
     // Register all miscellaneous handlers
     void registerMiscHandlers();
 }
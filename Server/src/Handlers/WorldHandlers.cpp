@@ -5,6 +5,7 @@
 #include "stdafx.h"
 #include "Handlers/WorldHandlers.h"
 #include "Network/Session.h"
+#include "Network/Gateway.h"
 #include "Network/PacketRouter.h"
 #include "Database/CharacterDb.h"
 #include "Database/GameData.h"
@@ -18,6 +19,8 @@
 #include "Combat/CombatFormulas.h"
 #include "Combat/CombatMessenger.h"
 #include "Combat/SpellUtils.h"
+#include "Combat/SpellDescriptor.h"
+#include "Combat/SpellEffects.h"
 #include "Systems/Inventory.h"
 #include "Systems/Equipment.h"
 #include "Systems/LootSystem.h"
@@ -38,6 +41,7 @@
 #include "GamePacketBase.h"
 #include "GamePacketClient.h"
 #include "GamePacketServer.h"
+#include <cmath>
 
 namespace Handlers
 {
@@ -482,6 +486,13 @@ void handleEnterWorld(Session& session, StlBuffer& data)
         return;
     }
 
+    // Gateway: the world process owning the character's map loads it
+    if (sGateway.isActive())
+    {
+        sGateway.enterWorld(session, *characterInfo);
+        return;
+    }
+
     // Clean up any existing player (shouldn't happen, but be safe)
     if (session.getPlayer())
     {
@@ -546,6 +557,75 @@ void handleEnterWorld(Session& session, StlBuffer& data)
 // Movement Handlers (Task 4.8)
 // ============================================================================
 
+// GP_Client_RequestMove has a fixed layout (wasdFlags u8, destX f32,
+// destY f32); read it in place instead of through GamePacket::unpack
+static bool readMoveDestination(const StlBuffer& data, float& destX, float& destY)
+{
+    constexpr size_t PAYLOAD_SIZE = sizeof(uint8_t) + 2 * sizeof(float);
+    if (data.size() < data.readPos() + PAYLOAD_SIZE)
+        return false;
+
+    const uint8_t* in = data.data() + data.readPos() + sizeof(uint8_t);
+    auto readFloat = [](const uint8_t* bytes) {
+        uint32_t bits = static_cast<uint32_t>(bytes[0]) |
+                        (static_cast<uint32_t>(bytes[1]) << 8) |
+                        (static_cast<uint32_t>(bytes[2]) << 16) |
+                        (static_cast<uint32_t>(bytes[3]) << 24);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    };
+    destX = readFloat(in);
+    destY = readFloat(in + sizeof(float));
+    return true;
+}
+
+// Overwrite a little-endian float of a pre-built packet
+static void patchFloat(StlBuffer& buf, size_t offset, float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint8_t* out = buf.data() + offset;
+    out[0] = static_cast<uint8_t>(bits & 0xFF);
+    out[1] = static_cast<uint8_t>((bits >> 8) & 0xFF);
+    out[2] = static_cast<uint8_t>((bits >> 16) & 0xFF);
+    out[3] = static_cast<uint8_t>((bits >> 24) & 0xFF);
+}
+
+static void patchUInt32(StlBuffer& buf, size_t offset, uint32_t value)
+{
+    uint8_t* out = buf.data() + offset;
+    out[0] = static_cast<uint8_t>(value & 0xFF);
+    out[1] = static_cast<uint8_t>((value >> 8) & 0xFF);
+    out[2] = static_cast<uint8_t>((value >> 16) & 0xFF);
+    out[3] = static_cast<uint8_t>((value >> 24) & 0xFF);
+}
+
+// Serialized Server_UnitSpline with `points` zeroed spline points. Sends
+// patch the guid and positions in place (see SplineOffset).
+static StlBuffer buildSplineTemplate(size_t points, bool silent)
+{
+    GP_Server_UnitSpline packet;
+    packet.m_spline.resize(points, {0.0f, 0.0f});
+    packet.m_slide = false;
+    packet.m_silent = silent;
+
+    StlBuffer buf;
+    uint16_t opcode = packet.getOpcode();
+    buf << opcode;
+    packet.pack(buf);
+    return buf;
+}
+
+// Field offsets of the spline template: opcode, guid, start, point count, points
+namespace SplineOffset
+{
+    constexpr size_t Guid = sizeof(uint16_t);
+    constexpr size_t StartX = Guid + sizeof(uint32_t);
+    constexpr size_t StartY = StartX + sizeof(float);
+    constexpr size_t FirstPoint = StartY + sizeof(float) + sizeof(uint16_t);
+}
+
 void handleRequestMove(Session& session, StlBuffer& data)
 {
     Player* player = session.getPlayer();
@@ -555,51 +635,62 @@ void handleRequestMove(Session& session, StlBuffer& data)
         return;
     }
 
-    // Parse the packet
-    GP_Client_RequestMove packet;
-    packet.unpack(data);
-
-    float destX = packet.m_destX;
-    float destY = packet.m_destY;
+    float destX = 0.0f;
+    float destY = 0.0f;
+    if (!readMoveDestination(data, destX, destY))
+    {
+        LOG_WARN("Session %u: Truncated RequestMove (size=%zu)", session.getId(), data.size());
+        return;
+    }
 
-    // Store old position for visibility updates
-    float oldX = player->getX();
-    float oldY = player->getY();
+    // NaN would slip past the distance check below (every comparison with
+    // it is false) and end up queued, broadcast and saved
+    if (!std::isfinite(destX) || !std::isfinite(destY))
+    {
+        LOG_WARN("Session %u: Player '%s' move rejected - non-finite destination",
+                 session.getId(), player->getName().c_str());
+        return;
+    }
 
-    // Basic validation - check if destination is within reasonable range
-    float distance = player->distanceTo(destX, destY);
+    // Validate from where the player will be once any move already queued
+    // this tick lands, exactly as if it had been applied
+    float fromX = player->getMoveOriginX();
+    float fromY = player->getMoveOriginY();
+    float dx = destX - fromX;
+    float dy = destY - fromY;
+    float distanceSq = dx * dx + dy * dy;
 
     // Anti-hack: Reject moves that are too far (teleport attempt)
     // Allow larger distances since client sends click destination, not next step
     constexpr float MAX_MOVE_DISTANCE = 2000.0f;  // Max click distance
-    if (distance > MAX_MOVE_DISTANCE)
+    if (distanceSq > MAX_MOVE_DISTANCE * MAX_MOVE_DISTANCE)
     {
         LOG_WARN("Session %u: Player '%s' move rejected - distance %.1f exceeds max %.1f",
-                 session.getId(), player->getName().c_str(), distance, MAX_MOVE_DISTANCE);
+                 session.getId(), player->getName().c_str(), std::sqrt(distanceSq), MAX_MOVE_DISTANCE);
         return;
     }
 
-    // TODO: Add collision detection against map data
-    // For now, trust the client's destination
-
-    // Update orientation to face movement direction (Task 4.9)
-    player->updateOrientationFromMovement(destX, destY);
-
-    // Update player's target destination (actual position update happens over time)
-    // For simplicity, we'll update position immediately since we don't have
-    // server-side movement interpolation yet
-    player->setPosition(destX, destY);
-    player->setMoving(true);
-    player->markDirty();  // Position changed, needs save
-
-    // Broadcast movement to all players who can see this player
-    broadcastMovement(player, destX, destY);
+    // Collision: destination must be walkable and in the same connected
+    // region as the player (precomputed at map load, O(1) per check).
+    // Skipped when the player is already off the walkable grid so a bad
+    // position can't lock them in place.
+    if (const Map* map = player->getMap())
+    {
+        int fromCell = map->cellIdFromWorldPos(fromX, fromY);
+        int destCell = map->cellIdFromWorldPos(destX, destY);
+        if (map->isWalkable(fromCell) && !map->isReachable(fromCell, destCell))
+        {
+            LOG_WARN("Session %u: Player '%s' move rejected - (%.1f, %.1f) not reachable",
+                     session.getId(), player->getName().c_str(), destX, destY);
+            return;
+        }
+    }
 
-    // Update visibility based on new position
-    sWorldManager.onPlayerMoved(player, oldX, oldY);
+    // Applied (and broadcast) once per tick; a later move replaces this one
+    player->queueMove(destX, destY);
 
-    LOG_DEBUG("Session %u: Player '%s' moving to (%.1f, %.1f), distance=%.1f",
-              session.getId(), player->getName().c_str(), destX, destY, distance);
+    LOG_DEBUG("Session %u: Player '%s' moving to (%.1f, %.1f)",
+              session.getId(), player->getName().c_str(), destX, destY);
 }
 
 void handleRequestStop(Session& session, StlBuffer& data)
@@ -613,15 +704,12 @@ void handleRequestStop(Session& session, StlBuffer& data)
         return;
     }
 
-    // Player stopped moving
-    player->setMoving(false);
-
-    // Broadcast stop to visible players
-    broadcastStop(player);
+    // Player stops once any queued move has landed
+    player->queueStop();
 
-    LOG_DEBUG("Session %u: Player '%s' stopped at (%.1f, %.1f)",
+    LOG_DEBUG("Session %u: Player '%s' stopping at (%.1f, %.1f)",
               session.getId(), player->getName().c_str(),
-              player->getX(), player->getY());
+              player->getMoveOriginX(), player->getMoveOriginY());
 }
 
 void broadcastMovement(Player* player, float destX, float destY)
@@ -629,27 +717,17 @@ void broadcastMovement(Player* player, float destX, float destY)
     if (!player)
         return;
 
-    // Build UnitSpline packet
-    GP_Server_UnitSpline packet;
-    packet.m_guid = static_cast<uint32_t>(player->getGuid());
-    packet.m_startX = player->getX();
-    packet.m_startY = player->getY();
-
-    // Simple spline with just the destination point
-    // More complex pathing could add intermediate waypoints
-    packet.m_spline.push_back({destX, destY});
-
-    packet.m_slide = false;   // Not a forced/slide movement
-    packet.m_silent = false;  // Play movement animation
-
-    // Serialize the packet
-    StlBuffer buf;
-    uint16_t opcode = packet.getOpcode();
-    buf << opcode;
-    packet.pack(buf);
+    // Simple spline with just the destination point; only the guid and
+    // positions change between sends
+    static StlBuffer packet = buildSplineTemplate(1, false);
+    patchUInt32(packet, SplineOffset::Guid, static_cast<uint32_t>(player->getGuid()));
+    patchFloat(packet, SplineOffset::StartX, player->getX());
+    patchFloat(packet, SplineOffset::StartY, player->getY());
+    patchFloat(packet, SplineOffset::FirstPoint, destX);
+    patchFloat(packet, SplineOffset::FirstPoint + sizeof(float), destY);
 
     // Broadcast to all players who can see this player
-    sWorldManager.broadcastToVisible(player, buf, false);  // Don't send to self
+    sWorldManager.broadcastToVisible(player, packet, false);  // Don't send to self
 }
 
 void broadcastStop(Player* player)
@@ -659,20 +737,13 @@ void broadcastStop(Player* player)
 
     // Send a spline with empty path to indicate stop
     // The client interprets an empty spline as "stop at current position"
-    GP_Server_UnitSpline packet;
-    packet.m_guid = static_cast<uint32_t>(player->getGuid());
-    packet.m_startX = player->getX();
-    packet.m_startY = player->getY();
-    packet.m_spline.clear();  // Empty = stop
-    packet.m_slide = false;
-    packet.m_silent = true;   // Silent stop, no animation change
+    // Silent stop, no animation change
+    static StlBuffer packet = buildSplineTemplate(0, true);
+    patchUInt32(packet, SplineOffset::Guid, static_cast<uint32_t>(player->getGuid()));
+    patchFloat(packet, SplineOffset::StartX, player->getX());
+    patchFloat(packet, SplineOffset::StartY, player->getY());
 
-    StlBuffer buf;
-    uint16_t opcode = packet.getOpcode();
-    buf << opcode;
-    packet.pack(buf);
-
-    sWorldManager.broadcastToVisible(player, buf, false);
+    sWorldManager.broadcastToVisible(player, packet, false);
 }
 
 // ============================================================================
@@ -735,24 +806,37 @@ Entity* findTargetEntity(uint32_t guid)
     }
 }
 
-void sendCastError(Session& session, int32_t spellId, int32_t errorCode)
+// Use GP_Server_CastStop to indicate failure; the client uses this to show
+// the error message
+static void sendCastStop(PacketSink& sink, uint32_t casterGuid, int32_t spellId)
 {
-    // Use GP_Server_CastStop to indicate failure
-    // The client uses this to show error message
     GP_Server_CastStop packet;
-    packet.m_guid = session.getPlayer() ? session.getPlayer()->getGuid() : 0;
+    packet.m_guid = casterGuid;
     packet.m_spellId = spellId;
 
     StlBuffer buf;
     uint16_t opcode = packet.getOpcode();
     buf << opcode;
     packet.pack(buf);
-    session.sendPacket(buf);
+    sink.sendPacket(buf);
+}
+
+void sendCastError(Session& session, int32_t spellId, int32_t errorCode)
+{
+    sendCastStop(session, session.getPlayer() ? session.getPlayer()->getGuid() : 0, spellId);
 
     LOG_DEBUG("Session %u: Cast spell %d failed with error %d",
               session.getId(), spellId, errorCode);
 }
 
+void sendCastError(Player* caster, int32_t spellId, int32_t errorCode)
+{
+    sendCastStop(caster->getSink(), caster->getGuid(), spellId);
+
+    LOG_DEBUG("Player %u: Cast spell %d failed with error %d",
+              caster->getGuid(), spellId, errorCode);
+}
+
 void sendSpellGo(Player* caster, int32_t spellId, const std::vector<std::pair<Entity*, uint8_t>>& targets)
 {
     if (!caster)
@@ -914,7 +998,7 @@ void handleCompleteQuest(Session& session, StlBuffer& data)
         return;
 
     sendQuestList(session);
-    player->sendInventory();
+    player->markInventoryDirty();
 }
 
 void handleAbandonQuest(Session& session, StlBuffer& data)
@@ -1194,19 +1278,20 @@ void handleCastSpell(Session& session, StlBuffer& data)
         return;
     }
 
-    // Get spell template
-    const SpellTemplate* spell = sGameData.getSpell(spellId);
-    if (!spell)
+    // Get compiled spell
+    const SpellDescriptor* descriptor = sSpellDescriptors.get(spellId);
+    if (!descriptor)
     {
         sendCastError(session, spellId, static_cast<int32_t>(CastResult::UnknownSpell));
         return;
     }
+    const SpellTemplate* spell = descriptor->spell;
 
     // Find target entity
     Entity* target = findTargetEntity(targetGuid);
 
     // Validate cast
-    CastResult result = SpellCaster::validateCast(caster, spell, target);
+    CastResult result = SpellCaster::validateCast(caster, *descriptor, target, CastPhase::Start);
     if (result != CastResult::Success)
     {
         sendCastError(session, spellId, static_cast<int32_t>(result));
@@ -1214,141 +1299,25 @@ void handleCastSpell(Session& session, StlBuffer& data)
         return;
     }
 
-    // Get targets for the spell (handles AoE, self-cast, etc.)
-    std::vector<Entity*> targets = SpellCaster::getTargets(caster, spell, target);
-    if (targets.empty())
-    {
-        sendCastError(session, spellId, static_cast<int32_t>(CastResult::NoTarget));
-        return;
-    }
-
     // For instant spells, execute immediately
-    // TODO: Handle cast time spells with GP_Server_CastStart
-    if (spell->castTime <= 0)
+    if (descriptor->instant)
     {
-        // Process spell effects on each target
-        std::vector<std::pair<Entity*, uint8_t>> hitTargets;
-
-        for (Entity* effectTarget : targets)
+        size_t targetCount = resolveSpellCast(caster, *descriptor, target);
+        if (targetCount > 0)
         {
-            // Determine spell effect type (use first effect slot)
-            SpellDefines::Effects effectType = static_cast<SpellDefines::Effects>(spell->effect[0]);
-
-            if (effectType == SpellDefines::Effects::Damage ||
-                effectType == SpellDefines::Effects::MeleeAtk ||
-                effectType == SpellDefines::Effects::RangedAtk)
-            {
-                // Damage spell
-                DamageInfo damage = CombatFormulas::calculateDamage(caster, effectTarget, spell, 0);
-
-                // Record hit result
-                hitTargets.push_back({effectTarget, static_cast<uint8_t>(
-                    CombatMessenger::toPacketHitResult(damage.hitResult))});
-
-                // Apply damage if not a complete miss
-                if (damage.hitResult != HitResult::Miss &&
-                    damage.hitResult != HitResult::Dodge &&
-                    damage.hitResult != HitResult::Parry)
-                {
-                    effectTarget->takeDamage(damage.finalDamage, caster);
-
-                    // Send combat message
-                    CombatMessenger::sendDamageMessage(caster, effectTarget, spellId, damage, effectType);
-
-                    // Add threat to NPCs
-                    if (Npc* npc = dynamic_cast<Npc*>(effectTarget))
-                    {
-                        npc->addThreat(caster, damage.finalDamage);
-                    }
-                }
-                else
-                {
-                    CombatMessenger::sendMissMessage(caster, effectTarget, spellId, damage.hitResult, effectType);
-                }
-            }
-            else if (effectType == SpellDefines::Effects::Heal ||
-                     effectType == SpellDefines::Effects::RestoreMana ||
-                     effectType == SpellDefines::Effects::RestoreManaPct)
-            {
-                // Healing spell
-                HealInfo heal = CombatFormulas::calculateHeal(caster, effectTarget, spell, 0);
-
-                hitTargets.push_back({effectTarget, static_cast<uint8_t>(
-                    CombatMessenger::toPacketHitResult(heal.hitResult))});
-
-                // Apply heal
-                effectTarget->heal(heal.finalHeal, caster);
-
-                // Send combat message
-                CombatMessenger::sendHealMessage(caster, effectTarget, spellId, heal);
-
-                // Healing threat: NPCs attacking the healed target should aggro the healer
-                if (Player* healedPlayer = dynamic_cast<Player*>(effectTarget))
-                {
-                    std::vector<Npc*> npcs = sWorldManager.getNpcsOnMap(healedPlayer->getMapId());
-                    for (Npc* npc : npcs)
-                    {
-                        if (!npc || npc->isDead())
-                            continue;
-
-                        if (npc->getAIState() != NpcAIState::Combat)
-                            continue;
-
-                        if (npc->getTarget() == healedPlayer ||
-                            npc->getThreatManager().getThreat(healedPlayer) > 0)
-                        {
-                            npc->addThreat(caster, heal.finalHeal);
-                        }
-                    }
-                }
-            }
-            else if (effectType == SpellDefines::Effects::ApplyAura ||
-                     effectType == SpellDefines::Effects::ApplyAreaAura)
-            {
-                // Buff/debuff spell - apply aura using the AuraManager API
-                // The AuraManager builds the aura from the spell template
-                bool applied = effectTarget->getAuras().applyAura(caster, spell, 0);
-
-                hitTargets.push_back({effectTarget, static_cast<uint8_t>(SpellDefines::HitResult::Normal)});
-
-                if (applied)
-                {
-                    LOG_DEBUG("Applied aura from spell %d to target %llu",
-                              spellId, effectTarget->getGuid());
-                }
-            }
-            else
-            {
-                // Other effect types - just record as hit
-                hitTargets.push_back({effectTarget, static_cast<uint8_t>(SpellDefines::HitResult::Normal)});
-            }
+            LOG_INFO("Session %u: Player '%s' cast spell '%s' on %zu targets",
+                     session.getId(), caster->getName().c_str(), spell->name.c_str(), targetCount);
         }
-
-        // Send spell execution notification
-        sendSpellGo(caster, spellId, hitTargets);
-
-        // Quest progress: spell cast
-        sQuestManager.onSpellCast(caster, spellId);
-
-        // Consume mana (calculate from formula)
-        int32_t casterLevel = caster->getVariable(ObjDefines::Variable::Level);
-        int32_t maxMana = caster->getMaxMana();
-        int32_t manaCost = SpellUtils::calculateManaCost(spell, casterLevel, maxMana);
-        if (manaCost > 0)
-        {
-            int32_t currentMana = caster->getMana();
-            caster->setVariable(ObjDefines::Variable::Mana, currentMana - manaCost);
-            caster->broadcastVariable(ObjDefines::Variable::Mana, currentMana - manaCost);
-        }
-
-        // Start cooldown
-        caster->getCooldowns().startCooldown(spellId, spell->cooldown);
-
-        LOG_INFO("Session %u: Player '%s' cast spell '%s' on %zu targets",
-                 session.getId(), caster->getName().c_str(), spell->name.c_str(), targets.size());
     }
     else
     {
+        // Refuse a cast that would find no targets (resolved again at completion)
+        if (SpellCaster::getTargets(caster, *descriptor, target).empty())
+        {
+            sendCastError(session, spellId, static_cast<int32_t>(CastResult::NoTarget));
+            return;
+        }
+
         // Cast time spell - send cast start to caster and nearby players
         GP_Server_CastStart castStart;
         castStart.m_guid = caster->getGuid();
@@ -1394,9 +1363,9 @@ void executePendingCast(Player* caster, int32_t spellId, uint32_t targetGuid)
     if (!caster)
         return;
 
-    // Get spell template
-    const SpellTemplate* spell = sGameData.getSpell(spellId);
-    if (!spell)
+    // Get compiled spell
+    const SpellDescriptor* descriptor = sSpellDescriptors.get(spellId);
+    if (!descriptor)
     {
         LOG_ERROR("executePendingCast: Unknown spell %d", spellId);
         return;
@@ -1405,132 +1374,62 @@ void executePendingCast(Player* caster, int32_t spellId, uint32_t targetGuid)
     // Find target entity
     Entity* target = findTargetEntity(targetGuid);
 
-    // Re-validate (conditions may have changed during cast time)
-    CastResult result = SpellCaster::validateCast(caster, spell, target);
+    // Re-validate what may have changed during cast time
+    CastResult result = SpellCaster::validateCast(caster, *descriptor, target, CastPhase::Finish);
     if (result != CastResult::Success)
     {
-        sendCastError(caster->getSession(), spellId, static_cast<int32_t>(result));
+        sendCastError(caster, spellId, static_cast<int32_t>(result));
         LOG_DEBUG("executePendingCast: Cast validation failed - %s", getCastResultString(result));
         return;
     }
 
-    // Get targets for the spell
-    std::vector<Entity*> targets = SpellCaster::getTargets(caster, spell, target);
-    if (targets.empty())
+    size_t targetCount = resolveSpellCast(caster, *descriptor, target);
+    if (targetCount > 0)
     {
-        sendCastError(caster->getSession(), spellId, static_cast<int32_t>(CastResult::NoTarget));
-        return;
+        LOG_INFO("Player '%s' completed cast of spell '%s' on %zu targets",
+                 caster->getName().c_str(), descriptor->spell->name.c_str(), targetCount);
     }
+}
 
-    // Process spell effects on each target
-    std::vector<std::pair<Entity*, uint8_t>> hitTargets;
+size_t resolveSpellCast(Player* caster, const SpellDescriptor& descriptor, Entity* target)
+{
+    const SpellTemplate* spell = descriptor.spell;
 
-    for (Entity* effectTarget : targets)
+    // Run every effect slot over its own targets
+    SpellEffects::CombatEventBuffer events;
+    SpellEffects::resolve(caster, descriptor, target, events);
+    if (events.empty())
     {
-        // Determine spell effect type
-        SpellDefines::Effects effectType = static_cast<SpellDefines::Effects>(spell->effect[0]);
-
-        if (effectType == SpellDefines::Effects::Damage ||
-            effectType == SpellDefines::Effects::MeleeAtk ||
-            effectType == SpellDefines::Effects::RangedAtk)
-        {
-            // Damage spell
-            DamageInfo damage = CombatFormulas::calculateDamage(caster, effectTarget, spell, 0);
-
-            hitTargets.push_back({effectTarget, static_cast<uint8_t>(
-                CombatMessenger::toPacketHitResult(damage.hitResult))});
-
-            if (damage.hitResult != HitResult::Miss &&
-                damage.hitResult != HitResult::Dodge &&
-                damage.hitResult != HitResult::Parry)
-            {
-                effectTarget->takeDamage(damage.finalDamage, caster);
-                CombatMessenger::sendDamageMessage(caster, effectTarget, spellId, damage, effectType);
-
-                if (Npc* npc = dynamic_cast<Npc*>(effectTarget))
-                {
-                    npc->addThreat(caster, damage.finalDamage);
-                }
-            }
-            else
-            {
-                CombatMessenger::sendMissMessage(caster, effectTarget, spellId, damage.hitResult, effectType);
-            }
-        }
-        else if (effectType == SpellDefines::Effects::Heal ||
-                 effectType == SpellDefines::Effects::RestoreMana ||
-                 effectType == SpellDefines::Effects::RestoreManaPct)
-        {
-            // Healing spell
-            HealInfo heal = CombatFormulas::calculateHeal(caster, effectTarget, spell, 0);
-
-            hitTargets.push_back({effectTarget, static_cast<uint8_t>(
-                CombatMessenger::toPacketHitResult(heal.hitResult))});
-
-            effectTarget->heal(heal.finalHeal, caster);
-            CombatMessenger::sendHealMessage(caster, effectTarget, spellId, heal);
-
-            if (Player* healedPlayer = dynamic_cast<Player*>(effectTarget))
-            {
-                std::vector<Npc*> npcs = sWorldManager.getNpcsOnMap(healedPlayer->getMapId());
-                for (Npc* npc : npcs)
-                {
-                    if (!npc || npc->isDead())
-                        continue;
-
-                    if (npc->getAIState() != NpcAIState::Combat)
-                        continue;
-
-                    if (npc->getTarget() == healedPlayer ||
-                        npc->getThreatManager().getThreat(healedPlayer) > 0)
-                    {
-                        npc->addThreat(caster, heal.finalHeal);
-                    }
-                }
-            }
-        }
-        else if (effectType == SpellDefines::Effects::ApplyAura ||
-                 effectType == SpellDefines::Effects::ApplyAreaAura)
-        {
-            // Buff/debuff spell
-            bool applied = effectTarget->getAuras().applyAura(caster, spell, 0);
-
-            hitTargets.push_back({effectTarget, static_cast<uint8_t>(SpellDefines::HitResult::Normal)});
-
-            if (applied)
-            {
-                LOG_DEBUG("Applied aura from spell %d to target %llu", spellId, effectTarget->getGuid());
-            }
-        }
-        else
-        {
-            // Other effect types
-            hitTargets.push_back({effectTarget, static_cast<uint8_t>(SpellDefines::HitResult::Normal)});
-        }
+        sendCastError(caster, spell->entry, static_cast<int32_t>(CastResult::NoTarget));
+        return 0;
     }
 
+    events.sendCombatMessages(caster, spell->entry);
+    SpellEffects::HitList hitTargets = events.buildHitList();
+
     // Send spell execution notification
-    sendSpellGo(caster, spellId, hitTargets);
+    sendSpellGo(caster, spell->entry, hitTargets);
 
     // Quest progress: spell cast
-    sQuestManager.onSpellCast(caster, spellId);
+    sQuestManager.onSpellCast(caster, spell->entry);
 
     // Consume mana
-    int32_t casterLevel = caster->getVariable(ObjDefines::Variable::Level);
-    int32_t maxMana = caster->getMaxMana();
-    int32_t manaCost = SpellUtils::calculateManaCost(spell, casterLevel, maxMana);
-    if (manaCost > 0)
+    if (descriptor.has(CastCheck::ManaCost))
     {
-        int32_t currentMana = caster->getMana();
-        caster->setVariable(ObjDefines::Variable::Mana, currentMana - manaCost);
-        caster->broadcastVariable(ObjDefines::Variable::Mana, currentMana - manaCost);
+        int32_t casterLevel = caster->getVariable(ObjDefines::Variable::Level);
+        int32_t manaCost = descriptor.manaCost(casterLevel, caster->getMaxMana());
+        if (manaCost > 0)
+        {
+            int32_t currentMana = caster->getMana();
+            caster->setVariable(ObjDefines::Variable::Mana, currentMana - manaCost);
+            caster->broadcastVariable(ObjDefines::Variable::Mana, currentMana - manaCost);
+        }
     }
 
     // Start cooldown
-    caster->getCooldowns().startCooldown(spellId, spell->cooldown);
+    caster->getCooldowns().startCooldown(spell->entry, spell->cooldown);
 
-    LOG_INFO("Player '%s' completed cast of spell '%s' on %zu targets",
-             caster->getName().c_str(), spell->name.c_str(), targets.size());
+    return hitTargets.size();
 }
 
 // ============================================================================
@@ -1571,7 +1470,7 @@ void handleMoveItem(Session& session, StlBuffer& data)
 
         // Mark for save and send updated inventory to client
         player->markDirty();
-        player->sendInventory();
+        player->markInventoryDirty();
     }
     else
     {
@@ -1623,7 +1522,7 @@ void handleSplitItemStack(Session& session, StlBuffer& data)
 
         // Mark for save and send updated inventory to client
         player->markDirty();
-        player->sendInventory();
+        player->markInventoryDirty();
     }
     else
     {
@@ -1671,7 +1570,7 @@ void handleDestroyItem(Session& session, StlBuffer& data)
 
     // Mark for save and send updated inventory to client
     player->markDirty();
-    player->sendInventory();
+    player->markInventoryDirty();
 }
 
 // ============================================================================
@@ -1797,7 +1696,7 @@ void handleEquipItem(Session& session, StlBuffer& data)
 
     // Mark for save and send updated inventory
     player->markDirty();
-    player->sendInventory();
+    player->markInventoryDirty();
 
     LOG_INFO("Session %u: Player '%s' equipped item %d in slot %d",
              session.getId(), player->getName().c_str(),
@@ -1861,7 +1760,7 @@ void handleUnequipItem(Session& session, StlBuffer& data)
 
     // Mark for save and send updated inventory
     player->markDirty();
-    player->sendInventory();
+    player->markInventoryDirty();
 
     LOG_INFO("Session %u: Player '%s' unequipped item %d from slot %d to inventory slot %d",
              session.getId(), player->getName().c_str(),
@@ -2181,8 +2080,8 @@ void handleMoveInventoryToBank(Session& session, StlBuffer& data)
     }
 
     // Send updated bank and inventory
-    sendBank(session);
-    player->sendInventory();
+    player->markBankDirty();
+    player->markInventoryDirty();
 }
 
 void handleMoveBankToBank(Session& session, StlBuffer& data)
@@ -2218,7 +2117,7 @@ void handleMoveBankToBank(Session& session, StlBuffer& data)
     }
 
     // Send updated bank
-    sendBank(session);
+    player->markBankDirty();
 }
 
 void handleUnBankItem(Session& session, StlBuffer& data)
@@ -2328,8 +2227,8 @@ void handleUnBankItem(Session& session, StlBuffer& data)
     }
 
     // Send updated bank and inventory
-    sendBank(session);
-    player->sendInventory();
+    player->markBankDirty();
+    player->markInventoryDirty();
 }
 
 void handleSortBank(Session& session, StlBuffer& data)
@@ -2349,7 +2248,7 @@ void handleSortBank(Session& session, StlBuffer& data)
     player->getBank().sort();
 
     // Send updated bank
-    sendBank(session);
+    player->markBankDirty();
 }
 
 void sendBank(Session& session)
@@ -2358,31 +2257,8 @@ void sendBank(Session& session)
     if (!player)
         return;
 
-    GP_Server_Bank bankPacket;
-
-    const auto& slots = player->getBank().getSlots();
-    for (int slot = 0; slot < Bank::MAX_SLOTS; ++slot)
-    {
-        if (!slots[slot].isEmpty())
-        {
-            GP_Server_Bank::Slot s;
-            s.slot = slot;
-            s.itemId.m_itemId = slots[slot].itemId;
-            s.itemId.m_durability = slots[slot].durability;
-            s.itemId.m_enchant = slots[slot].enchantId;
-            s.itemId.m_count = slots[slot].stackCount;
-            s.stackCount = slots[slot].stackCount;
-            bankPacket.m_slots.push_back(s);
-        }
-    }
-
-    StlBuffer buf;
-    uint16_t opcode = bankPacket.getOpcode();
-    buf << opcode;
-    bankPacket.pack(buf);
-    player->sendPacket(buf);
-
-    LOG_DEBUG("Session %u: Sent bank with %zu items", session.getId(), bankPacket.m_slots.size());
+    // Delegate to the Player's sendBank method
+    player->sendBank();
 }
 
 // ============================================================================
@@ -2679,13 +2555,14 @@ void handleUseItem(Session& session, StlBuffer& data)
         return;
     }
 
-    // Get spell template
-    const SpellTemplate* spell = sGameData.getSpell(spellId);
-    if (!spell)
+    // Get compiled spell
+    const SpellDescriptor* descriptor = sSpellDescriptors.get(spellId);
+    if (!descriptor)
     {
         LOG_ERROR("Session %u: Item %d has invalid spell %d", session.getId(), item->itemId, spellId);
         return;
     }
+    const SpellTemplate* spell = descriptor->spell;
 
     // Check item/spell cooldown (uses category cooldown for shared item cooldowns)
     if (spell->cooldownCategory > 0 && player->getCooldowns().isCategoryOnCooldown(spell->cooldownCategory))
@@ -2713,7 +2590,7 @@ void handleUseItem(Session& session, StlBuffer& data)
     }
 
     // Validate cast (same as regular spell cast)
-    CastResult result = SpellCaster::validateCast(player, spell, target);
+    CastResult result = SpellCaster::validateCast(player, *descriptor, target, CastPhase::Start);
     if (result != CastResult::Success)
     {
         sendCastError(session, spellId, static_cast<int32_t>(result));
@@ -2722,75 +2599,17 @@ void handleUseItem(Session& session, StlBuffer& data)
         return;
     }
 
-    // Get targets for the spell
-    std::vector<Entity*> targets = SpellCaster::getTargets(player, spell, target);
-    if (targets.empty())
+    // Run every effect slot over its own targets
+    SpellEffects::CombatEventBuffer events;
+    SpellEffects::resolve(player, *descriptor, target, events);
+    if (events.empty())
     {
         sendCastError(session, spellId, static_cast<int32_t>(CastResult::NoTarget));
         return;
     }
 
-    // Process spell effects on each target (same logic as executePendingCast)
-    std::vector<std::pair<Entity*, uint8_t>> hitTargets;
-
-    for (Entity* effectTarget : targets)
-    {
-        SpellDefines::Effects effectType = static_cast<SpellDefines::Effects>(spell->effect[0]);
-
-        if (effectType == SpellDefines::Effects::Damage ||
-            effectType == SpellDefines::Effects::MeleeAtk ||
-            effectType == SpellDefines::Effects::RangedAtk)
-        {
-            // Damage effect
-            DamageInfo damage = CombatFormulas::calculateDamage(player, effectTarget, spell, 0);
-
-            hitTargets.push_back({effectTarget, static_cast<uint8_t>(
-                CombatMessenger::toPacketHitResult(damage.hitResult))});
-
-            if (damage.hitResult != HitResult::Miss &&
-                damage.hitResult != HitResult::Dodge &&
-                damage.hitResult != HitResult::Parry)
-            {
-                effectTarget->takeDamage(damage.finalDamage, player);
-                CombatMessenger::sendDamageMessage(player, effectTarget, spellId, damage, effectType);
-            }
-            else
-            {
-                CombatMessenger::sendMissMessage(player, effectTarget, spellId, damage.hitResult, effectType);
-            }
-        }
-        else if (effectType == SpellDefines::Effects::Heal ||
-                 effectType == SpellDefines::Effects::RestoreMana ||
-                 effectType == SpellDefines::Effects::RestoreManaPct)
-        {
-            // Healing effect
-            HealInfo heal = CombatFormulas::calculateHeal(player, effectTarget, spell, 0);
-
-            hitTargets.push_back({effectTarget, static_cast<uint8_t>(
-                CombatMessenger::toPacketHitResult(heal.hitResult))});
-
-            effectTarget->heal(heal.finalHeal, player);
-            CombatMessenger::sendHealMessage(player, effectTarget, spellId, heal);
-        }
-        else if (effectType == SpellDefines::Effects::ApplyAura ||
-                 effectType == SpellDefines::Effects::ApplyAreaAura)
-        {
-            // Buff/debuff effect
-            bool applied = effectTarget->getAuras().applyAura(player, spell, 0);
-
-            hitTargets.push_back({effectTarget, static_cast<uint8_t>(SpellDefines::HitResult::Normal)});
-
-            if (applied)
-            {
-                LOG_DEBUG("Applied aura from item spell %d to target %llu", spellId, effectTarget->getGuid());
-            }
-        }
-        else
-        {
-            // Other effect types
-            hitTargets.push_back({effectTarget, static_cast<uint8_t>(SpellDefines::HitResult::Normal)});
-        }
-    }
+    events.sendCombatMessages(player, spellId);
+    SpellEffects::HitList hitTargets = events.buildHitList();
 
     // Send spell go to all players who can see
     sendSpellGo(player, spellId, hitTargets);
@@ -2819,7 +2638,7 @@ void handleUseItem(Session& session, StlBuffer& data)
     player->getInventory().markDirty();
 
     // Send inventory update to client
-    player->sendInventory();
+    player->markInventoryDirty();
 
     LOG_DEBUG("Session %u: Used item %d (spell %d) from slot %d",
               session.getId(), item->itemId, spellId, packet.m_slot);
@@ -2918,7 +2737,7 @@ void handleRepair(Session& session, StlBuffer& data)
         player->sendPacket(doneBuf);
 
         // Send updated equipment to show repaired durability
-        player->sendEquipment();
+        player->markEquipmentDirty();
 
         LOG_DEBUG("Session %u: Repaired equipment for %d gold", session.getId(), repairCost);
     }
@@ -3267,7 +3086,7 @@ void handleSocketItem(Session& session, StlBuffer& data)
     player->sendPacket(buf);
 
     // Send updated inventory
-    player->sendInventory();
+    player->markInventoryDirty();
 
     LOG_DEBUG("Session %u: Socketed gem %d into item at slot %d, socket %d",
               session.getId(), gemId, packet.m_targetSlot, packet.m_socketIndex);
@@ -3322,7 +3141,7 @@ void handleEmpowerItem(Session& session, StlBuffer& data)
     player->sendPacket(buf);
 
     // Send updated inventory
-    player->sendInventory();
+    player->markInventoryDirty();
 
     LOG_DEBUG("Session %u: Empowered item at slot %d with material from slot %d",
               session.getId(), packet.m_targetSlot, packet.m_materialSlot);
@@ -3345,7 +3164,7 @@ void handleSortInventory(Session& session, StlBuffer& data)
     inventory.sort();
 
     // Send updated inventory to client
-    player->sendInventory();
+    player->markInventoryDirty();
 
     LOG_DEBUG("Session %u: Sorted inventory", session.getId());
 }
@@ -9,6 +9,7 @@ class Session;
 class StlBuffer;
 class Player;
 class Entity;
+struct SpellDescriptor;
 
 namespace Handlers
 {
@@ -80,6 +81,10 @@ void handleCancelCast(Session& session, StlBuffer& data);
 // Execute a completed cast (called from Player when cast time finishes)
 void executePendingCast(Player* caster, int32_t spellId, uint32_t targetGuid);
 
+// Apply a validated cast: effects on every target, SpellGo, mana and
+// cooldown. Returns the number of targets (0 = none found, error sent).
+size_t resolveSpellCast(Player* caster, const SpellDescriptor& descriptor, Entity* target);
+
 // Handle target selection
 void handleSetSelected(Session& session, StlBuffer& data);
 
@@ -99,6 +104,7 @@ Entity* findTargetEntity(uint32_t guid);
 
 // Helper: Send spell cast result to caster
 void sendCastError(Session& session, int32_t spellId, int32_t errorCode);
+void sendCastError(Player* caster, int32_t spellId, int32_t errorCode);
 
 // Helper: Send spell execution to all relevant players
 void sendSpellGo(Player* caster, int32_t spellId, const std::vector<std::pair<Entity*, uint8_t>>& targets);
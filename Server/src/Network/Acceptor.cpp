@@ -0,0 +1,266 @@
+// Acceptor - Listening socket with connection admission control
+
+#include "stdafx.h"
+#include "Network/Acceptor.h"
+#include "Network/SessionManager.h"
+#include "Core/Config.h"
+#include "Core/Logger.h"
+#include "AccountDefines.h"
+#include "GamePacketServer.h"
+#include "SfSocket.h"
+#include "StlBuffer.h"
+
+#include <SFML/Network.hpp>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+#else
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+#endif
+
+namespace
+{
+    // sf::TcpSocket only exposes its native handle to subclasses
+    class AcceptedTcpSocket : public sf::TcpSocket
+    {
+    public:
+        using sf::TcpSocket::getHandle;
+    };
+
+    void tuneSocket(AcceptedTcpSocket& socket)
+    {
+        auto handle = socket.getHandle();
+
+        // SFML already disables Nagle when it creates a TCP socket; set it
+        // explicitly so small game packets never depend on that detail
+        int noDelay = 1;
+        setsockopt(handle, IPPROTO_TCP, TCP_NODELAY,
+                   reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+
+        int bufferSize = sConfig.getSocketBufferSize();
+        if (bufferSize > 0)
+        {
+            setsockopt(handle, SOL_SOCKET, SO_SNDBUF,
+                       reinterpret_cast<const char*>(&bufferSize), sizeof(bufferSize));
+            setsockopt(handle, SOL_SOCKET, SO_RCVBUF,
+                       reinterpret_cast<const char*>(&bufferSize), sizeof(bufferSize));
+        }
+    }
+
+    std::string addressToString(uint32_t address)
+    {
+        return sf::IpAddress(address).toString();
+    }
+}
+
+Acceptor& Acceptor::instance()
+{
+    static Acceptor instance;
+    return instance;
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+bool Acceptor::listen(uint16_t port)
+{
+    m_listener.setBlocking(false);
+    return m_listener.listen(port) == sf::Socket::Done;
+}
+
+void Acceptor::adoptListener(int handle)
+{
+    m_listener.setBlocking(false);
+    m_listener.create(handle);
+}
+
+void Acceptor::close()
+{
+    m_listener.close();
+
+    // Queued clients never became sessions; just drop them
+    m_queue.clear();
+    m_queuedPerAddress.clear();
+}
+
+// ============================================================================
+// Accepting
+// ============================================================================
+
+void Acceptor::acceptPending(std::vector<AcceptedConnection>& admitted)
+{
+    for (int i = 0; i < AcceptorConfig::MAX_ACCEPTS_PER_POLL; ++i)
+    {
+        auto rawSocket = std::make_shared<AcceptedTcpSocket>();
+        if (m_listener.accept(*rawSocket) != sf::Socket::Done)
+            break;  // Backlog drained
+
+        rawSocket->setBlocking(false);
+        tuneSocket(*rawSocket);
+        ++m_acceptedCount;
+
+        uint32_t address = rawSocket->getRemoteAddress().toInteger();
+        auto socket = std::make_unique<SfSocket>(rawSocket, SfSocket::Type::ServerSide);
+        admit(std::move(socket), address, admitted);
+    }
+}
+
+void Acceptor::admit(std::unique_ptr<SfSocket> socket, uint32_t address,
+                     std::vector<AcceptedConnection>& admitted)
+{
+    int perAddressLimit = sConfig.getMaxConnectionsPerIp();
+    if (perAddressLimit > 0 && connectionsFrom(address, admitted) >= perAddressLimit)
+    {
+        reject(*socket, address, "per-address limit");
+        return;
+    }
+
+    // Go straight in only if nobody is already waiting
+    if (m_queue.empty() && hasCapacity(admitted.size()))
+    {
+        admitted.push_back({std::move(socket), address});
+        return;
+    }
+
+    if (m_queue.size() >= static_cast<size_t>(std::max(0, sConfig.getLoginQueueSize())))
+    {
+        reject(*socket, address, "login queue full");
+        return;
+    }
+
+    m_queue.push_back({std::move(socket), address, 0});
+    ++m_queuedPerAddress[address];
+
+    QueuedConnection& entry = m_queue.back();
+    int32_t position = static_cast<int32_t>(m_queue.size());
+    if (!sendQueuePosition(entry, position))
+    {
+        releaseQueued(address);
+        m_queue.pop_back();
+        return;
+    }
+
+    LOG_INFO("Connection from %s queued at position %d",
+             addressToString(address).c_str(), position);
+}
+
+void Acceptor::update(std::vector<AcceptedConnection>& admitted)
+{
+    if (m_queue.empty())
+        return;
+
+    bool promoted = false;
+    while (!m_queue.empty() && hasCapacity(admitted.size()))
+    {
+        QueuedConnection& front = m_queue.front();
+        releaseQueued(front.address);
+
+        if (front.socket && front.socket->isConnected())
+        {
+            admitted.push_back({std::move(front.socket), front.address});
+            promoted = true;
+        }
+        m_queue.pop_front();
+    }
+
+    if (!promoted)
+        return;
+
+    // Everyone behind moved up; tell them and drop anyone who left
+    int32_t position = 0;
+    for (auto it = m_queue.begin(); it != m_queue.end();)
+    {
+        if (sendQueuePosition(*it, ++position))
+        {
+            ++it;
+            continue;
+        }
+
+        releaseQueued(it->address);
+        it = m_queue.erase(it);
+        --position;
+    }
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+bool Acceptor::hasCapacity(size_t pendingAdmits) const
+{
+    size_t limit = static_cast<size_t>(std::max(0, sConfig.getMaxConnections()));
+    return sSessionManager.getSessionCount() + pendingAdmits < limit;
+}
+
+int Acceptor::connectionsFrom(uint32_t address, const std::vector<AcceptedConnection>& admitted) const
+{
+    int count = static_cast<int>(sSessionManager.getSessionCountForAddress(address));
+
+    auto it = m_queuedPerAddress.find(address);
+    if (it != m_queuedPerAddress.end())
+        count += it->second;
+
+    for (const auto& connection : admitted)
+    {
+        if (connection.address == address)
+            ++count;
+    }
+
+    return count;
+}
+
+void Acceptor::reject(SfSocket& socket, uint32_t address, const char* reason)
+{
+    ++m_rejectedCount;
+
+    GP_Server_Validate packet;
+    packet.m_result = static_cast<uint8_t>(AccountDefines::AuthenticateResult::ServerFull);
+    packet.m_serverTime = std::time(nullptr);
+
+    StlBuffer buf;
+    uint16_t opcode = packet.getOpcode();
+    buf << opcode;
+    packet.pack(buf);
+    socket.send(buf);
+
+    // Read whatever the client already sent so closing sends FIN rather
+    // than RST (which could discard the reply in flight)
+    std::vector<std::unique_ptr<StlBuffer>> discarded;
+    socket.receive(discarded);
+    socket.disconnect();
+
+    LOG_WARN("Connection from %s rejected (%s)", addressToString(address).c_str(), reason);
+}
+
+bool Acceptor::sendQueuePosition(QueuedConnection& entry, int32_t position)
+{
+    if (!entry.socket || !entry.socket->isConnected())
+        return false;
+
+    if (entry.sentPosition == position)
+        return true;
+
+    GP_Server_QueuePosition packet;
+    packet.m_position = position;
+
+    StlBuffer buf;
+    uint16_t opcode = packet.getOpcode();
+    buf << opcode;
+    packet.pack(buf);
+
+    if (!entry.socket->send(buf))
+        return false;
+
+    entry.sentPosition = position;
+    return true;
+}
+
+void Acceptor::releaseQueued(uint32_t address)
+{
+    auto it = m_queuedPerAddress.find(address);
+    if (it != m_queuedPerAddress.end() && --it->second <= 0)
+        m_queuedPerAddress.erase(it);
+}
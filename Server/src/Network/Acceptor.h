@@ -0,0 +1,110 @@
+// Acceptor - Listening socket with connection admission control
+//
+// Drains the accept backlog on every wakeup, tunes accepted sockets, and
+// decides per connection whether it becomes a session right away, waits in
+// the login queue (receiving GP_Server_QueuePosition updates), or is turned
+// away with a ServerFull validate result.
+
+#pragma once
+
+#include <SFML/Network/TcpListener.hpp>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class SfSocket;
+
+// ============================================================================
+// Acceptor Configuration
+// ============================================================================
+
+namespace AcceptorConfig
+{
+    // Upper bound on accepts per wakeup so a connect flood can't starve the
+    // world tick; the rest is picked up on the next loop iteration
+    constexpr int MAX_ACCEPTS_PER_POLL = 256;
+}
+
+// A connection cleared to become a session
+struct AcceptedConnection
+{
+    std::unique_ptr<SfSocket> socket;
+    uint32_t address = 0;  // Remote IPv4 address (host order)
+};
+
+// ============================================================================
+// Acceptor
+// ============================================================================
+
+class Acceptor
+{
+public:
+    static Acceptor& instance();
+
+    // Lifecycle
+    bool listen(uint16_t port);
+    void close();
+
+    // Take over a listening socket handed off by a previous server process
+    void adoptListener(int handle);
+    int getListenerHandle() const { return m_listener.getHandle(); }
+
+    // Listener for the main loop's selector
+    sf::TcpListener& getListener() { return m_listener; }
+
+    // Accept everything waiting in the backlog. Connections that fit are
+    // appended to `admitted`; the rest are queued or rejected.
+    void acceptPending(std::vector<AcceptedConnection>& admitted);
+
+    // Promote queued connections into freed capacity and refresh the queue
+    // positions of those still waiting
+    void update(std::vector<AcceptedConnection>& admitted);
+
+    // Stats
+    size_t getQueueSize() const { return m_queue.size(); }
+    uint64_t getAcceptedCount() const { return m_acceptedCount; }
+    uint64_t getRejectedCount() const { return m_rejectedCount; }
+
+private:
+    Acceptor() = default;
+    Acceptor(const Acceptor&) = delete;
+    Acceptor& operator=(const Acceptor&) = delete;
+
+    // sf::TcpListener whose native handle can be read and replaced
+    class HandoffListener : public sf::TcpListener
+    {
+    public:
+        using sf::TcpListener::create;
+        using sf::TcpListener::getHandle;
+    };
+
+    struct QueuedConnection
+    {
+        std::unique_ptr<SfSocket> socket;
+        uint32_t address = 0;
+        int32_t sentPosition = 0;  // Last position sent to the client
+    };
+
+    // Route a freshly accepted connection
+    void admit(std::unique_ptr<SfSocket> socket, uint32_t address,
+               std::vector<AcceptedConnection>& admitted);
+
+    bool hasCapacity(size_t pendingAdmits) const;
+    int connectionsFrom(uint32_t address, const std::vector<AcceptedConnection>& admitted) const;
+
+    // Send ServerFull and close
+    void reject(SfSocket& socket, uint32_t address, const char* reason);
+
+    bool sendQueuePosition(QueuedConnection& entry, int32_t position);
+    void releaseQueued(uint32_t address);
+
+    HandoffListener m_listener;
+    std::deque<QueuedConnection> m_queue;
+    std::unordered_map<uint32_t, int> m_queuedPerAddress;
+    uint64_t m_acceptedCount = 0;
+    uint64_t m_rejectedCount = 0;
+};
+
+#define sAcceptor Acceptor::instance()
@@ -0,0 +1,444 @@
+// Gateway - Client-facing process of the multi-process server (--gateway)
+
+#include "stdafx.h"
+#include "Network/Gateway.h"
+#include "Network/Session.h"
+#include "Network/SessionManager.h"
+#include "Network/SocketPoller.h"
+#include "Database/CharacterDb.h"
+#include "Systems/ChatSystem.h"
+#include "Core/Logger.h"
+#include "GamePacketServer.h"
+#include "StlBuffer.h"
+
+#include <thread>
+
+#ifndef _WIN32
+    #include <unistd.h>
+#endif
+
+namespace
+{
+// How long stop() keeps writing queued Leaves to world processes
+constexpr int STOP_FLUSH_TIMEOUT_MS = 1000;
+
+uint32_t readU32(const uint8_t* bytes)
+{
+    return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+           (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+std::string describeMaps(const std::vector<int32_t>& maps, uint32_t worldId)
+{
+    std::string text;
+    for (int32_t mapId : maps)
+        text += (text.empty() ? "" : ",") + std::to_string(mapId);
+    if (worldId == 1)
+        text += text.empty() ? "all unlisted" : " and all unlisted";
+    return text.empty() ? "none" : text;
+}
+} // namespace
+
+Gateway& Gateway::instance()
+{
+    static Gateway instance;
+    return instance;
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+bool Gateway::start(const std::string& socketPath, const std::string& mapSpec, SocketPoller& poller)
+{
+    if (!m_maps.parse(mapSpec))
+        return false;
+
+    m_listener = ShardLink::listen(socketPath);
+    if (m_listener < 0)
+    {
+        LOG_ERROR("Gateway: cannot listen on %s (errno %d)", socketPath.c_str(), errno);
+        return false;
+    }
+
+    m_socketPath = socketPath;
+    poller.addHandle(m_listener, ShardConfig::LISTENER_TOKEN);
+    LOG_INFO("Gateway: waiting for world processes on %s", socketPath.c_str());
+    return true;
+}
+
+void Gateway::stop(SocketPoller& poller)
+{
+    if (m_listener < 0)
+        return;
+
+    // Sessions have left by now; let the worlds see their Leaves
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(STOP_FLUSH_TIMEOUT_MS);
+    for (auto& [worldId, link] : m_worlds)
+    {
+        while (link->flush() && link->hasPendingSend() && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        poller.removeHandle(link->getHandle());
+    }
+    m_worlds.clear();
+
+    poller.removeHandle(m_listener);
+#ifndef _WIN32
+    ::close(m_listener);
+    ::unlink(m_socketPath.c_str());
+#endif
+    m_listener = -1;
+    LOG_INFO("Gateway: closed world links");
+}
+
+// ============================================================================
+// World Links
+// ============================================================================
+
+ShardLink* Gateway::getLink(uint32_t worldId)
+{
+    auto it = m_worlds.find(worldId);
+    return it != m_worlds.end() ? it->second.get() : nullptr;
+}
+
+void Gateway::onReadable(uint32_t token, SocketPoller& poller)
+{
+    if (token == ShardConfig::LISTENER_TOKEN)
+    {
+        acceptWorld(poller);
+        return;
+    }
+
+    uint32_t worldId = token - ShardConfig::LINK_TOKEN_BASE;
+    ShardLink* link = getLink(worldId);
+    if (!link)
+        return;
+
+    std::vector<ShardFrame> frames;
+    bool open = link->receive(frames);
+    for (const ShardFrame& frame : frames)
+        onFrame(worldId, frame);
+
+    if (!open)
+        dropWorld(worldId, poller);
+}
+
+void Gateway::acceptWorld(SocketPoller& poller)
+{
+    while (true)
+    {
+        int handle = ShardLink::accept(m_listener);
+        if (handle < 0)
+            return;
+
+        // A world process says who it is right after connecting
+        auto link = std::make_unique<ShardLink>(handle);
+        std::vector<ShardFrame> frames;
+        if (!link->receive(frames, ShardConfig::HELLO_TIMEOUT_MS) || frames.front().type != ShardMessage::Hello)
+        {
+            LOG_WARN("Gateway: world link closed before saying hello");
+            continue;
+        }
+
+        StlBuffer hello = frameBody(frames.front());
+        uint32_t worldId = 0;
+        hello >> worldId;
+        if (worldId < 1 || worldId > ShardConfig::MAX_WORLDS || m_worlds.count(worldId))
+        {
+            LOG_WARN("Gateway: rejected world link claiming ID %u", worldId);
+            continue;
+        }
+
+        poller.addHandle(handle, ShardConfig::LINK_TOKEN_BASE + worldId);
+        m_worlds[worldId] = std::move(link);
+        LOG_INFO("Gateway: world %u connected (maps: %s)",
+                 worldId, describeMaps(m_maps.getMaps(worldId), worldId).c_str());
+
+        for (size_t i = 1; i < frames.size(); ++i)
+            onFrame(worldId, frames[i]);
+    }
+}
+
+void Gateway::dropWorld(uint32_t worldId, SocketPoller& poller)
+{
+    ShardLink* link = getLink(worldId);
+    if (!link)
+        return;
+
+    LOG_ERROR("Gateway: lost world %u", worldId);
+    poller.removeHandle(link->getHandle());
+    m_worlds.erase(worldId);
+
+    // Its characters are gone with it (as of their last save)
+    sSessionManager.forEachSession([&](Session& session) {
+        if (session.getWorldShard() != worldId)
+            return;
+        session.setWorldShard(0);
+        forgetName(session.getId());
+        session.initiateDisconnect("World server unavailable");
+        sSessionManager.queueRemoval(session.getId());
+    });
+
+    for (auto it = m_leaving.begin(); it != m_leaving.end();)
+        it = it->second == worldId ? m_leaving.erase(it) : std::next(it);
+}
+
+void Gateway::flush(SocketPoller& poller)
+{
+    std::vector<uint32_t> broken;
+    for (auto& [worldId, link] : m_worlds)
+    {
+        if (!link->flush())
+            broken.push_back(worldId);
+    }
+    for (uint32_t worldId : broken)
+        dropWorld(worldId, poller);
+}
+
+// ============================================================================
+// Sessions
+// ============================================================================
+
+void Gateway::sendWorldError(Session& session, const char* message)
+{
+    GP_Server_WorldError errorPacket;
+    errorPacket.m_code = 1;  // Generic error
+    errorPacket.m_message = message;
+
+    StlBuffer buf;
+    uint16_t opcode = errorPacket.getOpcode();
+    buf << opcode;
+    errorPacket.pack(buf);
+    session.sendPacket(buf);
+}
+
+void Gateway::forgetName(uint32_t sessionId)
+{
+    auto it = m_namesBySession.find(sessionId);
+    if (it == m_namesBySession.end())
+        return;
+
+    auto byName = m_sessionsByName.find(it->second);
+    if (byName != m_sessionsByName.end() && byName->second == sessionId)
+        m_sessionsByName.erase(byName);
+    m_namesBySession.erase(it);
+}
+
+void Gateway::enterWorld(Session& session, const CharacterInfo& character)
+{
+    uint32_t guid = static_cast<uint32_t>(character.guid);
+    if (m_leaving.count(guid))
+    {
+        LOG_INFO("Session %u: '%s' is still being saved by world %u",
+                 session.getId(), character.name.c_str(), m_leaving[guid]);
+        sendWorldError(session, "Character is still logging out, try again");
+        return;
+    }
+
+    uint32_t worldId = m_maps.getOwner(character.mapId);
+    ShardLink* link = getLink(worldId);
+    if (!link)
+    {
+        LOG_WARN("Session %u: world %u (map %d) is not connected", session.getId(), worldId, character.mapId);
+        sendWorldError(session, "World server unavailable");
+        return;
+    }
+
+    ShardHandoff record;
+    record.sessionId = session.getId();
+    record.accountId = session.getAccountId();
+    record.username = session.getUsername();
+    record.isGm = session.isGm();
+    record.characterGuid = guid;
+    record.characterName = character.name;
+    record.mapId = character.mapId;
+
+    StlBuffer body;
+    record.write(body);
+    link->send(ShardMessage::Enter, body);
+
+    session.setPlayerGuid(guid);
+    session.setWorldShard(worldId);
+    session.setState(SessionState::InWorld);
+    m_sessionsByName[character.name] = session.getId();
+    m_namesBySession[session.getId()] = character.name;
+
+    LOG_INFO("Session %u: '%s' entering world %u (map %d)",
+             session.getId(), character.name.c_str(), worldId, character.mapId);
+}
+
+void Gateway::forward(Session& session, uint16_t opcode, const StlBuffer& data)
+{
+    ShardLink* link = getLink(session.getWorldShard());
+    if (!link)
+        return;
+
+    link->sendPacket(ShardMessage::ClientPacket, session.getId(), opcode,
+                     data.data() + data.readPos(), data.size() - data.readPos());
+}
+
+void Gateway::leaveWorld(Session& session)
+{
+    uint32_t worldId = session.getWorldShard();
+    session.setWorldShard(0);
+    forgetName(session.getId());
+
+    ShardLink* link = getLink(worldId);
+    if (!link)
+        return;
+
+    StlBuffer body;
+    body << session.getId() << session.getPlayerGuid();
+    link->send(ShardMessage::Leave, body);
+    m_leaving[session.getPlayerGuid()] = worldId;
+}
+
+// ============================================================================
+// Messages from World Processes
+// ============================================================================
+
+void Gateway::onFrame(uint32_t worldId, const ShardFrame& frame)
+{
+    switch (frame.type)
+    {
+        case ShardMessage::ServerPacket:
+        {
+            // Read in place: this is nearly all of the traffic
+            if (frame.body.size() < sizeof(uint32_t) + sizeof(uint16_t))
+                return;
+
+            // Usually the hosting world, but a whisper reply may come from
+            // another one
+            Session* session = sSessionManager.getSession(readU32(frame.body.data()));
+            if (!session)
+                return;
+
+            StlBuffer packet;
+            packet.write(reinterpret_cast<const char*>(frame.body.data()) + sizeof(uint32_t),
+                         frame.body.size() - sizeof(uint32_t));
+            session->sendPacket(packet);
+            return;
+        }
+
+        case ShardMessage::Left:
+        {
+            StlBuffer body = frameBody(frame);
+            uint32_t guid = 0;
+            body >> guid;
+            m_leaving.erase(guid);
+            return;
+        }
+
+        case ShardMessage::Transfer:
+        {
+            StlBuffer body = frameBody(frame);
+            onTransfer(worldId, body);
+            return;
+        }
+
+        case ShardMessage::Kick:
+        {
+            StlBuffer body = frameBody(frame);
+            uint32_t sessionId = 0;
+            std::string reason;
+            body >> sessionId >> reason;
+
+            // The world has already saved and dropped the character
+            Session* session = sSessionManager.getSession(sessionId);
+            if (!session || session->getWorldShard() != worldId)
+                return;
+            session->setWorldShard(0);
+            forgetName(sessionId);
+            session->initiateDisconnect(reason);
+            sSessionManager.queueRemoval(sessionId);
+            return;
+        }
+
+        case ShardMessage::Chat:
+        {
+            StlBuffer body = frameBody(frame);
+            onChat(worldId, body);
+            return;
+        }
+
+        default:
+            LOG_WARN("Gateway: unexpected message %u from world %u",
+                     static_cast<uint32_t>(frame.type), worldId);
+            return;
+    }
+}
+
+void Gateway::onTransfer(uint32_t worldId, StlBuffer& body)
+{
+    ShardHandoff record;
+    if (!record.read(body))
+    {
+        LOG_WARN("Gateway: truncated transfer from world %u", worldId);
+        return;
+    }
+
+    // A client that left meanwhile is already saved on its new map
+    Session* session = sSessionManager.getSession(record.sessionId);
+    if (!session || session->getWorldShard() != worldId || session->isDisconnecting())
+        return;
+
+    uint32_t target = m_maps.getOwner(record.mapId);
+    ShardLink* link = getLink(target);
+    if (!link)
+    {
+        LOG_WARN("Session %u: world %u (map %d) is not connected", session->getId(), target, record.mapId);
+        session->setWorldShard(0);
+        forgetName(session->getId());
+        session->initiateDisconnect("World server unavailable");
+        return;
+    }
+
+    // The account is the gateway's to vouch for, not the world's
+    record.accountId = session->getAccountId();
+    record.username = session->getUsername();
+    record.isGm = session->isGm();
+
+    StlBuffer out;
+    record.write(out);
+    link->send(ShardMessage::Enter, out);
+    session->setWorldShard(target);
+
+    LOG_INFO("Session %u: '%s' moved from world %u to world %u (map %d)",
+             session->getId(), record.characterName.c_str(), worldId, target, record.mapId);
+}
+
+void Gateway::onChat(uint32_t worldId, StlBuffer& body)
+{
+    ShardChat chat;
+    if (!chat.read(body))
+        return;
+
+    StlBuffer out;
+    chat.write(out);
+
+    if (chat.channel == static_cast<uint8_t>(ChatDefines::Channels::Whisper))
+    {
+        auto it = m_sessionsByName.find(chat.targetName);
+        Session* target = it != m_sessionsByName.end() ? sSessionManager.getSession(it->second) : nullptr;
+        ShardLink* link = target ? getLink(target->getWorldShard()) : nullptr;
+        if (!link)
+        {
+            if (Session* sender = sSessionManager.getSession(chat.senderSessionId))
+            {
+                GP_Server_ChatError packet;
+                packet.m_code = static_cast<uint8_t>(ChatSystem::ChatError::PlayerNotFound);
+                sender->sendPacket(packet.build(StlBuffer{}));
+            }
+            return;
+        }
+        link->send(ShardMessage::Chat, out);
+        return;
+    }
+
+    // All-chat: every other world delivers to its own players
+    for (auto& [otherId, link] : m_worlds)
+    {
+        if (otherId != worldId)
+            link->send(ShardMessage::Chat, out);
+    }
+}
@@ -0,0 +1,82 @@
+// Gateway - Client-facing process of the multi-process server (--gateway)
+//
+// Accepts clients as usual and handles everything up to character select
+// itself (authentication, character list/create/delete, pings). Entering
+// the world hands the character to the world process owning its map
+// (ShardMapTable); from then on the session's packets are forwarded to
+// that world and the world's replies are written to the client. World
+// processes connect to the gateway's Unix socket at startup.
+//
+// Cross-world traffic goes through here: Transfer moves a character to
+// the world owning its new map, and whispers / all-chat lines reach
+// players on other worlds. Party and guild state is still per process.
+
+#pragma once
+
+#include "Network/ShardLink.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+class Session;
+class SocketPoller;
+struct CharacterInfo;
+
+class Gateway
+{
+public:
+    static Gateway& instance();
+
+    // Listen for world processes on `socketPath`; maps are assigned by
+    // `mapSpec` (see ShardMapTable)
+    bool start(const std::string& socketPath, const std::string& mapSpec, SocketPoller& poller);
+    bool isActive() const { return m_listener >= 0; }
+
+    // Close every world link (on shutdown, after sessions have left)
+    void stop(SocketPoller& poller);
+
+    // Poller tokens at or above ShardConfig::LISTENER_TOKEN are the
+    // gateway's; call for each that is ready
+    static bool ownsToken(uint32_t token) { return token >= ShardConfig::LISTENER_TOKEN; }
+    void onReadable(uint32_t token, SocketPoller& poller);
+
+    // Character chosen at character select (ownership already checked):
+    // hand it to the world process owning its map
+    void enterWorld(Session& session, const CharacterInfo& character);
+
+    // Client packet of a session in a world (opcode already read)
+    void forward(Session& session, uint16_t opcode, const StlBuffer& data);
+
+    // The session's client is gone; its world saves and drops the character
+    void leaveWorld(Session& session);
+
+    // Write what was queued for world processes (call once per loop)
+    void flush(SocketPoller& poller);
+
+private:
+    Gateway() = default;
+
+    void acceptWorld(SocketPoller& poller);
+    void onFrame(uint32_t worldId, const ShardFrame& frame);
+    void onTransfer(uint32_t worldId, StlBuffer& body);
+    void onChat(uint32_t worldId, StlBuffer& body);
+    void dropWorld(uint32_t worldId, SocketPoller& poller);
+    ShardLink* getLink(uint32_t worldId);
+    void forgetName(uint32_t sessionId);
+    void sendWorldError(Session& session, const char* message);
+
+    int m_listener = -1;
+    std::string m_socketPath;
+    ShardMapTable m_maps;
+    std::unordered_map<uint32_t, std::unique_ptr<ShardLink>> m_worlds;  // By world ID
+
+    // In-world characters by name (whisper routing), and characters a
+    // world is still saving after Leave - entering again waits for Left
+    std::unordered_map<std::string, uint32_t> m_sessionsByName;
+    std::unordered_map<uint32_t, std::string> m_namesBySession;
+    std::unordered_map<uint32_t, uint32_t> m_leaving;  // Character GUID -> world ID
+};
+
+#define sGateway Gateway::instance()
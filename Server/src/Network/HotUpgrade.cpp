@@ -0,0 +1,610 @@
+// HotUpgrade - Replace the server binary without disconnecting clients
+
+#include "stdafx.h"
+#include "Network/HotUpgrade.h"
+#include "Network/Acceptor.h"
+#include "Network/Session.h"
+#include "Network/SessionManager.h"
+#include "Network/SocketPoller.h"
+#include "Handlers/WorldHandlers.h"
+#include "Database/AsyncSaver.h"
+#include "Systems/ExperienceSystem.h"
+#include "World/Player.h"
+#include "World/WorldManager.h"
+#include "Core/Logger.h"
+#include "GamePacketClient.h"
+#include "SfSocket.h"
+#include "StlBuffer.h"
+
+#include <SFML/Network.hpp>
+
+#ifndef _WIN32
+    #include <climits>
+    #include <csignal>
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <sys/resource.h>
+    #include <sys/socket.h>
+    #include <sys/syscall.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+
+extern char** environ;
+#endif
+
+HotUpgrade& HotUpgrade::instance()
+{
+    static HotUpgrade instance;
+    return instance;
+}
+
+#ifdef _WIN32
+
+void HotUpgrade::initialize(int, char*[]) {}
+
+bool HotUpgrade::start()
+{
+    LOG_WARN("HotUpgrade: Not supported on this platform");
+    return false;
+}
+
+bool HotUpgrade::poll(SocketPoller&) { return false; }
+bool HotUpgrade::receive(std::vector<Session*>&) { return false; }
+bool HotUpgrade::handOff(SocketPoller&) { return false; }
+void HotUpgrade::abort(const char*) {}
+
+#else
+
+namespace
+{
+constexpr uint32_t SNAPSHOT_MAGIC = 0x55484D44;  // "DMHU"
+constexpr uint16_t SNAPSHOT_VERSION = 2;
+
+constexpr uint8_t MSG_READY = 'R';  // Successor -> predecessor: send the handoff
+constexpr uint8_t MSG_ACK = 'A';    // Successor -> predecessor: sessions restored
+
+// One session as written by handOff()
+struct SessionRecord
+{
+    uint32_t handleIndex = 0;
+    uint32_t remoteIp = 0;
+    uint8_t state = 0;
+    uint32_t accountId = 0;
+    std::string username;
+    bool isGm = false;
+    uint32_t playerGuid = 0;
+    std::vector<uint8_t> pendingReceive;
+    std::vector<uint8_t> pendingSend;
+};
+
+size_t bytesLeft(const StlBuffer& buf)
+{
+    return buf.size() - buf.readPos();
+}
+
+// Length-prefixed bytes; false if the length runs past the snapshot
+bool readBlob(StlBuffer& snapshot, std::vector<uint8_t>& out)
+{
+    uint32_t size = 0;
+    if (bytesLeft(snapshot) < sizeof(size))
+        return false;
+
+    snapshot >> size;
+    if (size > bytesLeft(snapshot))
+        return false;
+
+    out.resize(size);
+    for (uint8_t& byte : out)
+        snapshot >> byte;
+    return true;
+}
+
+// Every field is checked against what is left, so a truncated or corrupt
+// snapshot fails here instead of sizing buffers from garbage
+bool readSessionRecord(StlBuffer& snapshot, SessionRecord& record)
+{
+    constexpr size_t HEAD_BYTES = sizeof(record.handleIndex) + sizeof(record.remoteIp) +
+                                  sizeof(record.state) + sizeof(record.accountId) + sizeof(uint16_t);
+    if (bytesLeft(snapshot) < HEAD_BYTES)
+        return false;
+
+    snapshot >> record.handleIndex >> record.remoteIp >> record.state >> record.accountId;
+
+    // Username length, peeked so a short string isn't silently read as empty
+    const uint8_t* lengthBytes = snapshot.data() + snapshot.readPos();
+    size_t nameLength = static_cast<size_t>(lengthBytes[0]) | (static_cast<size_t>(lengthBytes[1]) << 8);
+    if (bytesLeft(snapshot) < sizeof(uint16_t) + nameLength + sizeof(uint8_t) + sizeof(record.playerGuid))
+        return false;
+
+    snapshot >> record.username >> record.isGm >> record.playerGuid;
+
+    return readBlob(snapshot, record.pendingReceive) && readBlob(snapshot, record.pendingSend);
+}
+
+// sf::TcpSocket taking over a handle received from the predecessor
+class AdoptedTcpSocket : public sf::TcpSocket
+{
+public:
+    explicit AdoptedTcpSocket(int handle)
+    {
+        setBlocking(false);
+        create(handle);
+    }
+};
+
+bool waitReadable(int fd, int timeoutMs)
+{
+    pollfd entry{fd, POLLIN, 0};
+    int result;
+    do
+    {
+        result = ::poll(&entry, 1, timeoutMs);
+    } while (result < 0 && errno == EINTR);
+    return result > 0;
+}
+
+bool writeAll(int fd, const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0)
+    {
+        ssize_t written = ::write(fd, bytes, size);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            return false;
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool readAll(int fd, void* data, size_t size, int timeoutMs)
+{
+    uint8_t* bytes = static_cast<uint8_t*>(data);
+    while (size > 0)
+    {
+        if (!waitReadable(fd, timeoutMs))
+            return false;
+
+        ssize_t got = ::read(fd, bytes, size);
+        if (got < 0 && (errno == EINTR || errno == EAGAIN))
+            continue;
+        if (got <= 0)
+            return false;
+        bytes += got;
+        size -= static_cast<size_t>(got);
+    }
+    return true;
+}
+
+// Send descriptors as SCM_RIGHTS, each batch riding on a single byte
+bool sendHandles(int channel, const std::vector<int>& handles)
+{
+    for (size_t offset = 0; offset < handles.size(); offset += HotUpgradeConfig::FDS_PER_MESSAGE)
+    {
+        size_t count = std::min(HotUpgradeConfig::FDS_PER_MESSAGE, handles.size() - offset);
+
+        union
+        {
+            cmsghdr header;
+            char buffer[CMSG_SPACE(sizeof(int) * HotUpgradeConfig::FDS_PER_MESSAGE)];
+        } control{};
+
+        uint8_t marker = 0;
+        iovec iov{&marker, 1};
+
+        msghdr message{};
+        message.msg_iov = &iov;
+        message.msg_iovlen = 1;
+        message.msg_control = control.buffer;
+        message.msg_controllen = CMSG_SPACE(sizeof(int) * count);
+
+        cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * count);
+        std::memcpy(CMSG_DATA(cmsg), handles.data() + offset, sizeof(int) * count);
+
+        ssize_t sent;
+        do
+        {
+            sent = ::sendmsg(channel, &message, 0);
+        } while (sent < 0 && errno == EINTR);
+
+        if (sent != 1)
+            return false;
+    }
+    return true;
+}
+
+bool receiveHandles(int channel, size_t expected, std::vector<int>& handles, int timeoutMs)
+{
+    while (handles.size() < expected)
+    {
+        if (!waitReadable(channel, timeoutMs))
+            return false;
+
+        union
+        {
+            cmsghdr header;
+            char buffer[CMSG_SPACE(sizeof(int) * HotUpgradeConfig::FDS_PER_MESSAGE)];
+        } control{};
+
+        uint8_t marker = 0;
+        iovec iov{&marker, 1};
+
+        msghdr message{};
+        message.msg_iov = &iov;
+        message.msg_iovlen = 1;
+        message.msg_control = control.buffer;
+        message.msg_controllen = sizeof(control.buffer);
+
+        ssize_t got = ::recvmsg(channel, &message, MSG_CMSG_CLOEXEC);
+        if (got < 0 && (errno == EINTR || errno == EAGAIN))
+            continue;
+        if (got != 1 || (message.msg_flags & MSG_CTRUNC))
+            return false;
+
+        for (cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg; cmsg = CMSG_NXTHDR(&message, cmsg))
+        {
+            if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+                continue;
+
+            size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            const uint8_t* data = CMSG_DATA(cmsg);
+            for (size_t i = 0; i < count; ++i)
+            {
+                int handle;
+                std::memcpy(&handle, data + i * sizeof(int), sizeof(int));
+                handles.push_back(handle);
+            }
+        }
+    }
+    return true;
+}
+
+// Runs in the forked child before exec: only async-signal-safe calls.
+// Leaves stdio and the upgrade channel open, closes everything else the
+// predecessor had (client sockets, database files) so the successor only
+// holds what it is explicitly handed.
+void closeInheritedHandles(int keep, int maxHandle)
+{
+#ifdef SYS_close_range
+    bool closed = true;
+    if (keep > 3)
+        closed = ::syscall(SYS_close_range, 3u, static_cast<unsigned>(keep - 1), 0u) == 0;
+    if (closed && ::syscall(SYS_close_range, static_cast<unsigned>(keep + 1), ~0u, 0u) == 0)
+        return;
+#endif
+    for (int fd = 3; fd < maxHandle; ++fd)
+    {
+        if (fd != keep)
+            ::close(fd);
+    }
+}
+} // namespace
+
+void HotUpgrade::initialize(int argc, char* argv[])
+{
+    // Resolve now: once the binary on disk is replaced, /proc/self/exe
+    // points at the deleted old image, while the path picks up the new one
+    char path[PATH_MAX];
+    ssize_t length = ::readlink("/proc/self/exe", path, sizeof(path) - 1);
+    if (length > 0)
+        m_executable.assign(path, static_cast<size_t>(length));
+    else if (argc > 0)
+        m_executable = argv[0];
+
+    m_arguments.assign(argv, argv + argc);
+
+    if (const char* channel = std::getenv(HotUpgradeConfig::CHANNEL_ENV))
+    {
+        m_successorChannel = std::atoi(channel);
+        ::unsetenv(HotUpgradeConfig::CHANNEL_ENV);
+        ::fcntl(m_successorChannel, F_SETFD, FD_CLOEXEC);
+    }
+}
+
+// ============================================================================
+// Predecessor
+// ============================================================================
+
+bool HotUpgrade::start()
+{
+    if (isInProgress())
+    {
+        LOG_WARN("HotUpgrade: Upgrade already in progress (successor pid %d)", m_childPid);
+        return false;
+    }
+
+    if (m_executable.empty())
+    {
+        LOG_ERROR("HotUpgrade: Executable path unknown");
+        return false;
+    }
+
+    int channels[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, channels) != 0)
+    {
+        LOG_ERROR("HotUpgrade: socketpair failed (errno %d)", errno);
+        return false;
+    }
+
+    // The child's end has to survive exec
+    ::fcntl(channels[1], F_SETFD, 0);
+
+    // Everything exec needs is built before fork; the child may only make
+    // async-signal-safe calls
+    std::vector<char*> argv;
+    for (std::string& argument : m_arguments)
+        argv.push_back(argument.data());
+    argv.push_back(nullptr);
+
+    std::string channelVar = std::string(HotUpgradeConfig::CHANNEL_ENV) + "=" + std::to_string(channels[1]);
+    std::vector<char*> envp;
+    for (char** entry = environ; *entry; ++entry)
+        envp.push_back(*entry);
+    envp.push_back(channelVar.data());
+    envp.push_back(nullptr);
+
+    rlimit limit{};
+    int maxHandle = 1024;
+    if (::getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY)
+        maxHandle = static_cast<int>(std::min<rlim_t>(limit.rlim_cur, INT_MAX));
+
+    pid_t pid = ::fork();
+    if (pid < 0)
+    {
+        LOG_ERROR("HotUpgrade: fork failed (errno %d)", errno);
+        ::close(channels[0]);
+        ::close(channels[1]);
+        return false;
+    }
+
+    if (pid == 0)
+    {
+        closeInheritedHandles(channels[1], maxHandle);
+        ::execve(m_executable.c_str(), argv.data(), envp.data());
+        ::_exit(127);
+    }
+
+    ::close(channels[1]);
+    ::fcntl(channels[0], F_SETFL, ::fcntl(channels[0], F_GETFL) | O_NONBLOCK);
+
+    m_channel = channels[0];
+    m_childPid = pid;
+
+    LOG_INFO("HotUpgrade: Started successor %s (pid %d)", m_executable.c_str(), pid);
+    return true;
+}
+
+bool HotUpgrade::poll(SocketPoller& poller)
+{
+    if (m_channel < 0)
+        return false;
+
+    uint8_t message = 0;
+    ssize_t got = ::read(m_channel, &message, 1);
+    if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+        return false;  // Successor still loading
+
+    if (got == 0)
+    {
+        abort("successor exited before taking over");
+        return false;
+    }
+
+    if (got < 0 || message != MSG_READY)
+    {
+        abort("unexpected message from successor");
+        return false;
+    }
+
+    return handOff(poller);
+}
+
+bool HotUpgrade::handOff(SocketPoller& poller)
+{
+    LOG_INFO("HotUpgrade: Successor ready, handing off");
+
+    // Everything the successor loads must already be on disk, including
+    // quest tallies still waiting for the end-of-iteration container sync
+    // and level-ups from XP granted since the last tick
+    sExperienceSystem.flushPendingExperience();
+    sWorldManager.flushContainerSyncs();
+    sSessionManager.forEachSession([](Session& session) {
+        if (Player* player = session.getPlayer())
+            player->save();
+    });
+    sAsyncSaver.flush();
+    sSessionManager.flushPendingSends();
+
+    // Partial input still inside the network backend belongs in the
+    // snapshot; the ring must not take more while the successor loads it
+    poller.pause();
+
+    // Snapshot: listener is handle 0, sessions reference theirs by index
+    std::vector<int> handles;
+    handles.push_back(sAcceptor.getListenerHandle());
+
+    StlBuffer records;
+    uint32_t sessionCount = 0;
+
+    sSessionManager.forEachSession([&](Session& session) {
+        SfSocket* socket = session.getSocket();
+        if (session.isDisconnecting() || !socket || !socket->isConnected())
+            return;
+
+        records << static_cast<uint32_t>(handles.size());
+        handles.push_back(SocketPoller::getNativeHandle(*socket->getSocket()));
+
+        records << session.getRemoteIp();
+        records << static_cast<uint8_t>(session.getState());
+        records << session.getAccountId() << session.getUsername() << session.isGm();
+        records << session.getPlayerGuid();
+
+        // Partial input, and output the socket has not accepted yet
+        const StlBuffer& pendingReceive = socket->getPendingReceive();
+        records << static_cast<uint32_t>(pendingReceive.size());
+        records.write(reinterpret_cast<const char*>(pendingReceive.data()), pendingReceive.size());
+
+        records << static_cast<uint32_t>(socket->getPendingSendSize());
+        records.write(reinterpret_cast<const char*>(socket->getPendingSendData()), socket->getPendingSendSize());
+
+        ++sessionCount;
+    });
+
+    StlBuffer snapshot;
+    snapshot << SNAPSHOT_MAGIC << SNAPSHOT_VERSION;
+    snapshot << static_cast<uint32_t>(handles.size()) << sessionCount;
+    snapshot.write(reinterpret_cast<const char*>(records.data()), records.size());
+
+    // Blocking from here on; the world is paused until the successor acks
+    ::fcntl(m_channel, F_SETFL, ::fcntl(m_channel, F_GETFL) & ~O_NONBLOCK);
+
+    uint32_t snapshotSize = static_cast<uint32_t>(snapshot.size());
+    if (!writeAll(m_channel, &snapshotSize, sizeof(snapshotSize)) ||
+        !writeAll(m_channel, snapshot.data(), snapshot.size()) ||
+        !sendHandles(m_channel, handles))
+    {
+        abort("failed to send snapshot");
+        poller.resume();
+        return false;
+    }
+
+    uint8_t ack = 0;
+    if (!readAll(m_channel, &ack, 1, HotUpgradeConfig::ACK_TIMEOUT_MS) || ack != MSG_ACK)
+    {
+        abort("successor did not acknowledge");
+        poller.resume();
+        return false;
+    }
+
+    LOG_INFO("HotUpgrade: Handed off %u sessions to pid %d", sessionCount, m_childPid);
+    return true;
+}
+
+void HotUpgrade::abort(const char* reason)
+{
+    LOG_ERROR("HotUpgrade: Upgrade aborted, %s; continuing to serve", reason);
+
+    ::close(m_channel);
+    m_channel = -1;
+
+    // A successor that missed its deadline may be holding our sockets
+    if (m_childPid > 0)
+    {
+        ::kill(m_childPid, SIGKILL);
+        ::waitpid(m_childPid, nullptr, 0);
+    }
+    m_childPid = -1;
+}
+
+// ============================================================================
+// Successor
+// ============================================================================
+
+bool HotUpgrade::receive(std::vector<Session*>& restored)
+{
+    int channel = m_successorChannel;
+    m_successorChannel = -1;
+
+    const int timeoutMs = HotUpgradeConfig::ACK_TIMEOUT_MS;
+
+    uint32_t snapshotSize = 0;
+    if (!writeAll(channel, &MSG_READY, 1) ||
+        !readAll(channel, &snapshotSize, sizeof(snapshotSize), timeoutMs))
+    {
+        LOG_ERROR("HotUpgrade: Predecessor did not send a snapshot");
+        ::close(channel);
+        return false;
+    }
+
+    std::vector<uint8_t> bytes(snapshotSize);
+    if (!readAll(channel, bytes.data(), bytes.size(), timeoutMs))
+    {
+        LOG_ERROR("HotUpgrade: Truncated snapshot");
+        ::close(channel);
+        return false;
+    }
+
+    StlBuffer snapshot(bytes);
+    uint32_t magic = 0;
+    uint16_t version = 0;
+    uint32_t handleCount = 0;
+    uint32_t sessionCount = 0;
+    snapshot >> magic >> version >> handleCount >> sessionCount;
+
+    std::vector<int> handles;
+    if (magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION || handleCount == 0 ||
+        !receiveHandles(channel, handleCount, handles, timeoutMs))
+    {
+        LOG_ERROR("HotUpgrade: Invalid snapshot (magic %08X, version %u)", magic, version);
+        ::close(channel);
+        return false;
+    }
+
+    // Parse everything before adopting anything, so a bad record leaves
+    // the predecessor serving (no ack) rather than a half-restored successor
+    std::vector<SessionRecord> records;
+    for (uint32_t i = 0; i < sessionCount; ++i)
+    {
+        SessionRecord record;
+        if (!readSessionRecord(snapshot, record))
+        {
+            LOG_ERROR("HotUpgrade: Corrupt snapshot (session record %u of %u)", i + 1, sessionCount);
+            ::close(channel);
+            return false;
+        }
+        records.push_back(std::move(record));
+    }
+
+    sAcceptor.adoptListener(handles[0]);
+
+    uint32_t inWorld = 0;
+    for (const SessionRecord& record : records)
+    {
+        if (record.handleIndex >= handles.size())
+            continue;
+
+        auto rawSocket = std::make_shared<AdoptedTcpSocket>(handles[record.handleIndex]);
+        auto socket = std::make_unique<SfSocket>(rawSocket, SfSocket::Type::ServerSide);
+        socket->restorePendingReceive(record.pendingReceive.data(), record.pendingReceive.size());
+        socket->restorePendingSend(record.pendingSend.data(), record.pendingSend.size());
+
+        Session* session = sSessionManager.createSession(record.remoteIp);
+        session->setSocket(std::move(socket));
+        if (!record.pendingSend.empty())
+            sSessionManager.queueFlush(*session);
+        restored.push_back(session);
+
+        auto sessionState = static_cast<SessionState>(record.state);
+        if (sessionState == SessionState::Connected)
+            continue;
+
+        session->setAuthenticated(record.accountId, record.username, record.isGm);
+
+        // Back into the world through the regular entry path; the client
+        // gets NewWorld for its current map and reloads it in place
+        if (sessionState == SessionState::InWorld && record.playerGuid != 0)
+        {
+            GP_Client_EnterWorld enter;
+            enter.m_characterGuid = record.playerGuid;
+
+            StlBuffer buf;
+            enter.pack(buf);
+            Handlers::handleEnterWorld(*session, buf);
+            ++inWorld;
+        }
+    }
+
+    bool acked = writeAll(channel, &MSG_ACK, 1);
+    ::close(channel);
+
+    LOG_INFO("HotUpgrade: Took over listener and %u sessions (%u in world)",
+             static_cast<uint32_t>(restored.size()), inWorld);
+    return acked;
+}
+
+#endif
@@ -0,0 +1,96 @@
+// HotUpgrade - Replace the server binary without disconnecting clients
+//
+// On SIGUSR2 the running server (predecessor) launches a fresh copy of its
+// executable (successor) connected through a Unix socketpair. The
+// successor loads game data as usual, then asks for the handoff; only at
+// that point does the predecessor pause, save every player, and send a
+// session snapshot plus the listening and client sockets (SCM_RIGHTS).
+// The successor adopts the sockets, puts in-world characters back into the
+// world through the normal EnterWorld path (the client sees a same-map
+// reload instead of a disconnect), acknowledges, and the predecessor exits
+// without touching the sockets again.
+//
+// If the successor fails at any point before acknowledging, the
+// predecessor keeps serving. POSIX only.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Session;
+class SocketPoller;
+
+// ============================================================================
+// Upgrade Configuration
+// ============================================================================
+
+namespace HotUpgradeConfig
+{
+    // Environment variable carrying the successor's end of the socketpair
+    constexpr const char* CHANNEL_ENV = "DREADMYST_UPGRADE_FD";
+
+    // How long the predecessor waits for the successor to restore sessions
+    constexpr int ACK_TIMEOUT_MS = 30000;
+
+    // File descriptors per SCM_RIGHTS message (Linux caps this at 253)
+    constexpr size_t FDS_PER_MESSAGE = 200;
+}
+
+// ============================================================================
+// HotUpgrade
+// ============================================================================
+
+class HotUpgrade
+{
+public:
+    static HotUpgrade& instance();
+
+    // Remember how this process was started (call first thing in main)
+    void initialize(int argc, char* argv[]);
+
+    // ------------------------------------------------------------------------
+    // Predecessor side
+    // ------------------------------------------------------------------------
+
+    // Launch the successor. Returns false if one is already running or the
+    // launch failed.
+    bool start();
+    bool isInProgress() const { return m_channel >= 0; }
+
+    // Service the successor channel (call every loop iteration while in
+    // progress). Performs the handoff once the successor is ready and
+    // returns true when it has taken over; the caller must then exit
+    // without disconnecting or saving anything. The poller is paused for
+    // the snapshot (an io_uring ring may hold received bytes).
+    bool poll(SocketPoller& poller);
+
+    // ------------------------------------------------------------------------
+    // Successor side
+    // ------------------------------------------------------------------------
+
+    // Started by a predecessor (instead of binding the port itself)
+    bool isSuccessor() const { return m_successorChannel >= 0; }
+
+    // Adopt the listener and the predecessor's sessions. Restored sessions
+    // are returned so the caller can register their sockets.
+    bool receive(std::vector<Session*>& restored);
+
+private:
+    HotUpgrade() = default;
+    HotUpgrade(const HotUpgrade&) = delete;
+    HotUpgrade& operator=(const HotUpgrade&) = delete;
+
+    bool handOff(SocketPoller& poller);
+    void abort(const char* reason);
+
+    std::string m_executable;
+    std::vector<std::string> m_arguments;
+
+    int m_channel = -1;            // Predecessor's end while an upgrade runs
+    int m_childPid = -1;
+    int m_successorChannel = -1;   // Successor's end, from the environment
+};
+
+#define sHotUpgrade HotUpgrade::instance()
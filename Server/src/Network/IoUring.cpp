@@ -0,0 +1,228 @@
+// IoUring - Minimal io_uring ring driven through the raw system calls
+
+#include "stdafx.h"
+#include "Network/IoUring.h"
+
+#ifdef DREADMYST_HAVE_IO_URING
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+namespace
+{
+size_t roundToPage(size_t size)
+{
+    size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    return (size + page - 1) / page * page;
+}
+
+void* mapAnonymous(size_t size)
+{
+    void* memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return memory == MAP_FAILED ? nullptr : memory;
+}
+} // namespace
+
+IoUring::~IoUring()
+{
+    if (m_fd >= 0)
+        ::close(m_fd);
+    if (m_sqes)
+        ::munmap(m_sqes, m_sqesSize);
+    if (m_sqRing)
+        ::munmap(m_sqRing, m_sqRingSize);
+    if (m_fixed)
+        ::munmap(m_fixed, m_fixedSize);
+    if (m_bufRing)
+        ::munmap(m_bufRing, m_bufRingSize);
+    if (m_provided)
+        ::munmap(m_provided, m_providedBytes);
+}
+
+bool IoUring::setup(unsigned entries)
+{
+    // Multishot receives post many completions per submission, so the
+    // completion queue gets extra room. Completion work is deferred to
+    // the wait (only the network thread uses the ring); kernels before
+    // 6.1 reject that and get a plain ring.
+    io_uring_params params{};
+    params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL |
+                   IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN;
+    params.cq_entries = entries * 4;
+    m_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    if (m_fd < 0 && errno == EINVAL)
+    {
+        params = io_uring_params{};
+        params.flags = IORING_SETUP_CQSIZE;
+        params.cq_entries = entries * 4;
+        m_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    }
+    if (m_fd < 0)
+        return false;
+
+    // One mapping for both queues, and a timeout on the wait (5.11+)
+    if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_EXT_ARG))
+    {
+        errno = ENOSYS;
+        return false;
+    }
+
+    m_sqRingSize = std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                            params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+    m_sqRing = ::mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      m_fd, IORING_OFF_SQ_RING);
+    if (m_sqRing == MAP_FAILED)
+    {
+        m_sqRing = nullptr;
+        return false;
+    }
+
+    m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = ::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        m_fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+        return false;
+    m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+    auto* base = static_cast<uint8_t*>(m_sqRing);
+    m_sqHead = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+    m_sqTail = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+    m_sqMask = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+    m_sqEntries = params.sq_entries;
+    m_sqArray = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+    m_sqLocalTail = *m_sqTail;
+
+    // Entry i always sits in slot i
+    for (unsigned i = 0; i < m_sqEntries; ++i)
+        m_sqArray[i] = i;
+
+    m_cqHead = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+    m_cqTail = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+    m_cqMask = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+    return true;
+}
+
+// ============================================================================
+// Submission
+// ============================================================================
+
+int IoUring::enter(unsigned toSubmit, unsigned minComplete, unsigned flags, const void* arg, size_t argSize)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_enter, m_fd, toSubmit, minComplete, flags, arg, argSize));
+}
+
+bool IoUring::reserve(unsigned count)
+{
+    if (count > m_sqEntries)
+        return false;
+
+    auto freeEntries = [this]() {
+        return m_sqEntries - (m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE));
+    };
+    if (freeEntries() < count)
+        submit();
+    return freeEntries() >= count;
+}
+
+io_uring_sqe* IoUring::getSqe()
+{
+    unsigned head = __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+    if (m_sqLocalTail - head >= m_sqEntries)
+        return nullptr;
+
+    io_uring_sqe* sqe = &m_sqes[m_sqLocalTail & m_sqMask];
+    std::memset(sqe, 0, sizeof(*sqe));
+    ++m_sqLocalTail;
+    return sqe;
+}
+
+bool IoUring::submit()
+{
+    __atomic_store_n(m_sqTail, m_sqLocalTail, __ATOMIC_RELEASE);
+    unsigned toSubmit = m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+    if (toSubmit == 0)
+        return true;
+    return enter(toSubmit, 0, 0, nullptr, 0) >= 0;
+}
+
+bool IoUring::submitAndWait(int timeoutMs)
+{
+    __atomic_store_n(m_sqTail, m_sqLocalTail, __ATOMIC_RELEASE);
+    unsigned toSubmit = m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+
+    __kernel_timespec timeout{};
+    timeout.tv_sec = timeoutMs / 1000;
+    timeout.tv_nsec = static_cast<long long>(timeoutMs % 1000) * 1000000;
+
+    io_uring_getevents_arg arg{};
+    arg.ts = reinterpret_cast<uint64_t>(&timeout);
+
+    // ETIME on timeout, EINTR on a signal; either way there may be nothing
+    enter(toSubmit, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+    return __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE) != *m_cqHead;
+}
+
+// ============================================================================
+// Buffers
+// ============================================================================
+
+uint8_t* IoUring::registerFixedBuffer(size_t size)
+{
+    m_fixedSize = roundToPage(size);
+    m_fixed = static_cast<uint8_t*>(mapAnonymous(m_fixedSize));
+    if (!m_fixed)
+        return nullptr;
+
+    iovec region{m_fixed, m_fixedSize};
+    if (::syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_BUFFERS, &region, 1) != 0)
+        return nullptr;
+    return m_fixed;
+}
+
+bool IoUring::registerBufferRing(uint16_t group, unsigned count, unsigned size)
+{
+    m_bufRingSize = roundToPage(count * sizeof(io_uring_buf));
+    m_bufRing = static_cast<io_uring_buf_ring*>(mapAnonymous(m_bufRingSize));
+    m_providedBytes = static_cast<size_t>(count) * size;
+    m_provided = static_cast<uint8_t*>(mapAnonymous(m_providedBytes));
+    if (!m_bufRing || !m_provided)
+        return false;
+
+    io_uring_buf_reg reg{};
+    reg.ring_addr = reinterpret_cast<uint64_t>(m_bufRing);
+    reg.ring_entries = count;
+    reg.bgid = group;
+    if (::syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_PBUF_RING, &reg, 1) != 0)
+        return false;
+
+    m_providedSize = size;
+    m_providedMask = count - 1;
+    for (unsigned i = 0; i < count; ++i)
+        recycleProvided(static_cast<uint16_t>(i));
+    publishProvided();
+    return true;
+}
+
+void IoUring::recycleProvided(uint16_t id)
+{
+    // Entries start at the ring base (in C++ the header's flexible array
+    // member lands 8 bytes in), and go field by field: the ring's tail
+    // overlays the first entry's resv
+    io_uring_buf& entry = reinterpret_cast<io_uring_buf*>(m_bufRing)[m_providedTail & m_providedMask];
+    entry.addr = reinterpret_cast<uint64_t>(m_provided + static_cast<size_t>(id) * m_providedSize);
+    entry.len = m_providedSize;
+    entry.bid = id;
+    ++m_providedTail;
+}
+
+void IoUring::publishProvided()
+{
+    __atomic_store_n(&m_bufRing->tail, m_providedTail, __ATOMIC_RELEASE);
+}
+
+#endif // DREADMYST_HAVE_IO_URING
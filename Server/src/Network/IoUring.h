@@ -0,0 +1,123 @@
+// IoUring - Minimal io_uring ring driven through the raw system calls
+//
+// Just what SocketPoller's io_uring backend needs: the mmapped submission
+// and completion queues, one registered (fixed) buffer region and one
+// provided-buffer ring for multishot receives. No liburing dependency.
+// Compiled in on Linux when the kernel headers know multishot receive
+// (DREADMYST_HAVE_IO_URING, set by CMake).
+
+#pragma once
+
+#ifdef DREADMYST_HAVE_IO_URING
+
+#include <linux/io_uring.h>
+#include <cstddef>
+#include <cstdint>
+
+class IoUring
+{
+public:
+    IoUring() = default;
+    ~IoUring();
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    // Create the ring with room for `entries` submissions. False (errno
+    // set) when the kernel refuses or lacks a feature the poller relies on.
+    bool setup(unsigned entries);
+
+    // ------------------------------------------------------------------------
+    // Submission
+    // ------------------------------------------------------------------------
+
+    // Make sure `count` entries can be taken without the queue filling up
+    // in between (linked entries must go to the kernel together); submits
+    // what is queued if needed. False if the queue is too small.
+    bool reserve(unsigned count);
+
+    // Next free submission entry, zeroed; nullptr when the queue is full
+    io_uring_sqe* getSqe();
+
+    // Hand queued entries to the kernel
+    bool submit();
+
+    // Submit, then wait up to timeoutMs for at least one completion.
+    // False on timeout or interruption.
+    bool submitAndWait(int timeoutMs);
+
+    // ------------------------------------------------------------------------
+    // Completion
+    // ------------------------------------------------------------------------
+
+    // Visit every posted completion, then release them to the kernel
+    template <typename Visitor>
+    unsigned forEachCompletion(Visitor&& visit)
+    {
+        unsigned head = *m_cqHead;
+        unsigned tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+        unsigned count = tail - head;
+        for (; head != tail; ++head)
+            visit(m_cqes[head & m_cqMask]);
+        __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+        return count;
+    }
+
+    // ------------------------------------------------------------------------
+    // Buffers
+    // ------------------------------------------------------------------------
+
+    // Register `size` bytes of page-aligned memory as fixed buffer 0
+    // (IORING_OP_WRITE_FIXED); returns its base or nullptr
+    uint8_t* registerFixedBuffer(size_t size);
+
+    // Provide `count` buffers of `size` bytes (count a power of two) as
+    // buffer group `group` for IOSQE_BUFFER_SELECT receives
+    bool registerBufferRing(uint16_t group, unsigned count, unsigned size);
+
+    const uint8_t* providedBuffer(uint16_t id) const { return m_provided + static_cast<size_t>(id) * m_providedSize; }
+
+    // Give a consumed buffer back; publishProvided() makes the returned
+    // buffers visible to the kernel in one store
+    void recycleProvided(uint16_t id);
+    void publishProvided();
+
+private:
+    int enter(unsigned toSubmit, unsigned minComplete, unsigned flags, const void* arg, size_t argSize);
+
+    int m_fd = -1;
+
+    // Submission queue
+    void* m_sqRing = nullptr;
+    size_t m_sqRingSize = 0;
+    unsigned* m_sqHead = nullptr;
+    unsigned* m_sqTail = nullptr;
+    unsigned* m_sqArray = nullptr;
+    unsigned m_sqMask = 0;
+    unsigned m_sqEntries = 0;
+    unsigned m_sqLocalTail = 0;    // Entries filled, not yet published
+    unsigned m_sqSubmitted = 0;    // Entries published to the kernel
+    io_uring_sqe* m_sqes = nullptr;
+    size_t m_sqesSize = 0;
+
+    // Completion queue (shares the submission mapping)
+    unsigned* m_cqHead = nullptr;
+    unsigned* m_cqTail = nullptr;
+    unsigned m_cqMask = 0;
+    io_uring_cqe* m_cqes = nullptr;
+
+    // Fixed buffer region
+    uint8_t* m_fixed = nullptr;
+    size_t m_fixedSize = 0;
+
+    // Provided-buffer ring and the buffers it hands out
+    io_uring_buf_ring* m_bufRing = nullptr;
+    size_t m_bufRingSize = 0;
+    uint8_t* m_provided = nullptr;
+    size_t m_providedBytes = 0;
+    unsigned m_providedSize = 0;
+    unsigned m_providedMask = 0;
+    uint16_t m_providedTail = 0;
+};
+
+#endif // DREADMYST_HAVE_IO_URING
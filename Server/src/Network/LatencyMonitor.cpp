@@ -0,0 +1,380 @@
+// LatencyMonitor - Network round trips and server-side queueing delay
+
+#include "stdafx.h"
+#include "Network/LatencyMonitor.h"
+#include "Network/Session.h"
+#include "Network/SessionManager.h"
+#include "Network/SocketPoller.h"
+#include "World/Player.h"
+#include "Core/Config.h"
+#include "Core/Logger.h"
+#include "GamePacketBase.h"
+#include "GamePacketServer.h"
+#include "SfSocket.h"
+#include "StlBuffer.h"
+
+#include <SFML/Network.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+
+#ifdef __linux__
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <sys/socket.h>
+#endif
+
+// ============================================================================
+// Opcode Classes
+// ============================================================================
+
+namespace
+{
+constexpr std::array<OpcodeClass, Opcode::MaxOpcode> buildOpcodeClasses()
+{
+    std::array<OpcodeClass, Opcode::MaxOpcode> table{};
+    for (OpcodeClass& entry : table)
+        entry = OpcodeClass::Other;
+
+    auto range = [&table](uint16_t first, uint16_t last, OpcodeClass opcodeClass) {
+        for (uint16_t opcode = first; opcode <= last; ++opcode)
+            table[opcode] = opcodeClass;
+    };
+
+    range(Opcode::Mutual_Ping, Opcode::Client_EnterWorld, OpcodeClass::Session);
+    range(Opcode::Client_CastSpell, Opcode::Client_CancelBuff, OpcodeClass::Combat);
+    range(Opcode::Client_ChatMsg, Opcode::Client_ChatMsg, OpcodeClass::Chat);
+    range(Opcode::Client_ClickedGossipOption, Opcode::Client_CompleteQuest, OpcodeClass::Interaction);
+    range(Opcode::Client_RequestMove, Opcode::Client_RequestStop, OpcodeClass::Movement);
+    range(Opcode::Client_ReqAbilityList, Opcode::Client_SetSelected, OpcodeClass::Combat);
+    range(Opcode::Client_EquipItem, Opcode::Client_SortInventory, OpcodeClass::Items);
+    range(Opcode::Client_Action, Opcode::Client_Action, OpcodeClass::Combat);
+    range(Opcode::Client_MoveInventoryToBank, Opcode::Client_Repair, OpcodeClass::Items);
+    range(Opcode::Client_GuildCreate, Opcode::Client_PartyChanges, OpcodeClass::Social);
+    range(Opcode::Client_DuelResponse, Opcode::Client_UpdateArenaStatus, OpcodeClass::Combat);
+    range(Opcode::Client_QueryWaypoints, Opcode::Client_ActivateWaypoint, OpcodeClass::Movement);
+    range(Opcode::Client_RequestRespawn, Opcode::Client_RequestRespawn, OpcodeClass::Combat);
+    range(Opcode::Client_SocketItem, Opcode::Client_EmpowerItem, OpcodeClass::Items);
+    range(Opcode::Client_RollDice, Opcode::Client_MOD, OpcodeClass::Chat);
+    range(Opcode::Client_RecoverMailLoot, Opcode::Client_RecoverMailLoot, OpcodeClass::Items);
+    range(Opcode::Client_ChangeChannels, Opcode::Client_SetIgnorePlayer, OpcodeClass::Chat);
+
+    return table;
+}
+
+constexpr std::array<OpcodeClass, Opcode::MaxOpcode> OPCODE_CLASSES = buildOpcodeClasses();
+
+static_assert(OPCODE_CLASSES[Opcode::Client_RequestMove] == OpcodeClass::Movement &&
+              OPCODE_CLASSES[Opcode::Client_CastSpell] == OpcodeClass::Combat,
+              "Opcode class ranges out of date");
+
+double toMillis(uint64_t micros)
+{
+    return static_cast<double>(micros) / 1000.0;
+}
+
+// Kernel's smoothed RTT for the connection, 0 when unavailable
+uint64_t tcpRttMicros(Session& session)
+{
+#ifdef __linux__
+    SfSocket* socket = session.getSocket();
+    if (!socket || !socket->getSocket())
+        return 0;
+
+    int handle = SocketPoller::getNativeHandle(*socket->getSocket());
+    if (handle < 0)
+        return 0;
+
+    tcp_info info{};
+    socklen_t length = sizeof(info);
+    if (getsockopt(handle, IPPROTO_TCP, TCP_INFO, &info, &length) != 0)
+        return 0;
+    return info.tcpi_rtt;
+#else
+    (void)session;
+    return 0;
+#endif
+}
+} // namespace
+
+const char* opcodeClassToString(OpcodeClass opcodeClass)
+{
+    switch (opcodeClass)
+    {
+        case OpcodeClass::Session:     return "Session";
+        case OpcodeClass::Movement:    return "Movement";
+        case OpcodeClass::Combat:      return "Combat";
+        case OpcodeClass::Interaction: return "Interaction";
+        case OpcodeClass::Items:       return "Items";
+        case OpcodeClass::Social:      return "Social";
+        case OpcodeClass::Chat:        return "Chat";
+        default:                       return "Other";
+    }
+}
+
+OpcodeClass classifyOpcode(uint16_t opcode)
+{
+    return opcode < OPCODE_CLASSES.size() ? OPCODE_CLASSES[opcode] : OpcodeClass::Other;
+}
+
+// ============================================================================
+// LatencyHistogram
+// ============================================================================
+
+size_t LatencyHistogram::bucketFor(uint64_t micros)
+{
+    constexpr uint64_t SUB_BUCKETS = 1ULL << LatencyConfig::SUB_BUCKET_BITS;
+    if (micros < SUB_BUCKETS)
+        return static_cast<size_t>(micros);
+
+    // Octave from the highest set bit, position within it from the next bits
+    size_t highBit = 0;
+    for (uint64_t value = micros; value > 1; value >>= 1)
+        ++highBit;
+    size_t octave = highBit - LatencyConfig::SUB_BUCKET_BITS + 1;
+    size_t sub = static_cast<size_t>(micros >> (highBit - LatencyConfig::SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+
+    return std::min(octave * SUB_BUCKETS + sub, LatencyConfig::HISTOGRAM_BUCKETS - 1);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t bucket)
+{
+    constexpr size_t SUB_BUCKETS = size_t(1) << LatencyConfig::SUB_BUCKET_BITS;
+    if (bucket < SUB_BUCKETS)
+        return bucket;
+
+    size_t octave = bucket / SUB_BUCKETS;
+    size_t sub = bucket % SUB_BUCKETS;
+    size_t shift = octave - 1;
+    return ((SUB_BUCKETS + sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t micros)
+{
+    ++m_buckets[bucketFor(micros)];
+    ++m_count;
+}
+
+void LatencyHistogram::clear()
+{
+    m_buckets.fill(0);
+    m_count = 0;
+}
+
+uint64_t LatencyHistogram::percentile(double fraction) const
+{
+    if (m_count == 0)
+        return 0;
+
+    uint64_t target = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(m_count)));
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < m_buckets.size(); ++bucket)
+    {
+        seen += m_buckets[bucket];
+        if (seen >= target && seen > 0)
+            return bucketUpperBound(bucket);
+    }
+    return bucketUpperBound(m_buckets.size() - 1);
+}
+
+// ============================================================================
+// LatencyMonitor
+// ============================================================================
+
+LatencyMonitor& LatencyMonitor::instance()
+{
+    static LatencyMonitor instance;
+    return instance;
+}
+
+uint64_t LatencyMonitor::nowMicros()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void LatencyMonitor::recordDispatch(Session& session, uint16_t opcode, uint64_t handlerStart, bool responded)
+{
+    const Player* player = session.getPlayer();
+    uint32_t key = makeKey(player ? player->getMapId() : 0, classifyOpcode(opcode));
+
+    m_queueing[key].dispatch.record(handlerStart >= m_readyAt ? handlerStart - m_readyAt : 0);
+
+    if (responded)
+        m_awaitingFlush.push_back({key, handlerStart});
+}
+
+void LatencyMonitor::recordFlush()
+{
+    if (m_awaitingFlush.empty())
+        return;
+
+    uint64_t flushedAt = nowMicros();
+    for (const AwaitingFlush& entry : m_awaitingFlush)
+        m_queueing[entry.key].flush.record(flushedAt - entry.handlerStart);
+    m_awaitingFlush.clear();
+}
+
+// ============================================================================
+// Round Trips
+// ============================================================================
+
+void LatencyMonitor::update()
+{
+    // Sweeping once a second is plenty for a 5 s probe interval
+    uint64_t now = nowMicros();
+    if (now - m_lastProbeSweep < 1'000'000)
+        return;
+    m_lastProbeSweep = now;
+
+    if (!sConfig.getLatencyProbes())
+        return;
+
+    sSessionManager.forEachSession([&](Session& session) {
+        if (session.getState() != SessionState::Authenticated &&
+            session.getState() != SessionState::InWorld)
+            return;
+        if (session.isRelayed())
+            return;  // Probed by the gateway, which answers the echoes
+
+        SessionLatency& latency = session.getLatency();
+        if (latency.probeSentAt != 0)
+        {
+            if (now - latency.probeSentAt < LatencyConfig::PROBE_TIMEOUT_US)
+                return;
+            ++latency.lost;
+            latency.probeSentAt = 0;
+        }
+
+        // This client doesn't echo probes; TCP RTT still covers it
+        if (latency.samples == 0 && latency.lost >= LatencyConfig::PROBE_GIVE_UP)
+            return;
+
+        if (now - latency.lastProbeAt < LatencyConfig::PROBE_INTERVAL_US)
+            return;
+
+        GP_Mutual_PingProbe probe;
+        probe.m_sentAtMicros = now;
+        probe.m_nonce = ++m_nextNonce;
+
+        StlBuffer buf;
+        uint16_t opcode = probe.getOpcode();
+        buf << opcode;
+        probe.pack(buf);
+        session.sendPacket(buf);
+
+        latency.probeSentAt = now;
+        latency.probeNonce = probe.m_nonce;
+        latency.lastProbeAt = now;
+    });
+}
+
+bool LatencyMonitor::completeProbe(Session& session, uint64_t sentAt, uint32_t nonce)
+{
+    SessionLatency& latency = session.getLatency();
+    if (latency.probeSentAt == 0 || sentAt != latency.probeSentAt || nonce != latency.probeNonce)
+        return false;
+
+    // Timed to when the socket became readable, not to this handler
+    uint64_t receivedAt = std::max(m_readyAt, latency.probeSentAt);
+    float rtt = static_cast<float>(receivedAt - latency.probeSentAt);
+    latency.probeSentAt = 0;
+
+    if (latency.samples == 0)
+    {
+        latency.rttMicros = rtt;
+        latency.jitterMicros = 0.0f;
+    }
+    else
+    {
+        latency.rttMicros += (rtt - latency.rttMicros) * LatencyConfig::RTT_GAIN;
+        latency.jitterMicros += (std::fabs(rtt - latency.lastRttMicros) - latency.jitterMicros) *
+                                LatencyConfig::JITTER_GAIN;
+    }
+
+    latency.lastRttMicros = rtt;
+    ++latency.samples;
+    return true;
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+void LatencyMonitor::report()
+{
+    struct NetworkHistograms
+    {
+        LatencyHistogram probeRtt;
+        LatencyHistogram jitter;
+        LatencyHistogram tcpRtt;
+        uint32_t sessions = 0;
+        uint32_t lost = 0;
+        uint32_t notEchoing = 0;   // Gave up probing (see PROBE_GIVE_UP)
+    };
+
+    // Network side: current per-session estimates, grouped by map
+    std::map<int, NetworkHistograms> network;
+    sSessionManager.forEachSession([&](Session& session) {
+        if (session.getState() != SessionState::Authenticated &&
+            session.getState() != SessionState::InWorld)
+            return;
+
+        const Player* player = session.getPlayer();
+        NetworkHistograms& histograms = network[player ? player->getMapId() : 0];
+        const SessionLatency& latency = session.getLatency();
+
+        ++histograms.sessions;
+        if (latency.samples == 0 && latency.lost >= LatencyConfig::PROBE_GIVE_UP)
+            ++histograms.notEchoing;
+        else
+            histograms.lost += latency.lost;
+        if (latency.samples > 0)
+        {
+            histograms.probeRtt.record(static_cast<uint64_t>(latency.rttMicros));
+            histograms.jitter.record(static_cast<uint64_t>(latency.jitterMicros));
+        }
+        if (uint64_t tcpRtt = tcpRttMicros(session))
+            histograms.tcpRtt.record(tcpRtt);
+    });
+
+    for (const auto& [mapId, histograms] : network)
+    {
+        LOG_INFO("Latency network map %d: %u sessions | ping RTT p50 %.1f p99 %.1f ms (%llu answering, %u not echoing, jitter p50 %.1f ms, %u lost) | TCP RTT p50 %.1f p99 %.1f ms",
+                 mapId, histograms.sessions,
+                 toMillis(histograms.probeRtt.percentile(0.50)),
+                 toMillis(histograms.probeRtt.percentile(0.99)),
+                 static_cast<unsigned long long>(histograms.probeRtt.getCount()),
+                 histograms.notEchoing,
+                 toMillis(histograms.jitter.percentile(0.50)),
+                 histograms.lost,
+                 toMillis(histograms.tcpRtt.percentile(0.50)),
+                 toMillis(histograms.tcpRtt.percentile(0.99)));
+    }
+
+    // Server side: everything recorded since the last report
+    std::vector<uint32_t> keys;
+    keys.reserve(m_queueing.size());
+    for (const auto& [key, histograms] : m_queueing)
+    {
+        if (histograms.dispatch.getCount() > 0)
+            keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    for (uint32_t key : keys)
+    {
+        QueueingHistograms& histograms = m_queueing[key];
+        LOG_INFO("Latency server map %d %s: %llu packets | readable->handler p50 %.2f p99 %.2f ms | handler->flushed p50 %.2f p99 %.2f ms",
+                 static_cast<int>(key >> 8),
+                 opcodeClassToString(static_cast<OpcodeClass>(key & 0xFF)),
+                 static_cast<unsigned long long>(histograms.dispatch.getCount()),
+                 toMillis(histograms.dispatch.percentile(0.50)),
+                 toMillis(histograms.dispatch.percentile(0.99)),
+                 toMillis(histograms.flush.percentile(0.50)),
+                 toMillis(histograms.flush.percentile(0.99)));
+    }
+
+    m_queueing.clear();
+}
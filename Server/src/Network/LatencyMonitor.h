@@ -0,0 +1,146 @@
+// LatencyMonitor - Network round trips and server-side queueing delay
+//
+// Two questions when a player reports lag: is the network slow, or is the
+// server sitting on their packets?
+//
+// Network: authenticated sessions get a Mutual_Ping every few seconds
+// carrying a monotonic microsecond timestamp and a nonce. Only an echo of
+// both answers the probe; payload-less client pings are echoed as before.
+// The echo is timed from the moment its socket became readable, which
+// keeps server processing out of the sample. Each session keeps an RTT
+// EWMA and RFC 3550 style jitter. Sessions that never echo a probe (a
+// client that only echoes its own pings) stop being probed after a few
+// tries. The kernel's smoothed TCP RTT is reported alongside, since it
+// needs no client cooperation.
+//
+// Server: each received packet records readable -> handler start, and for
+// packets that produced a response, handler start -> bytes flushed.
+// Histograms are kept per map and opcode class and logged with the
+// periodic status line, then reset.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class Session;
+
+// ============================================================================
+// Latency Configuration
+// ============================================================================
+
+namespace LatencyConfig
+{
+    constexpr uint64_t PROBE_INTERVAL_US = 5'000'000;   // Between pings per session
+    constexpr uint64_t PROBE_TIMEOUT_US = 15'000'000;   // Unanswered ping counts as lost
+    constexpr uint32_t PROBE_GIVE_UP = 3;               // Lost probes, none answered, before giving up
+
+    constexpr float RTT_GAIN = 1.0f / 8.0f;      // EWMA weight of a new sample (TCP SRTT)
+    constexpr float JITTER_GAIN = 1.0f / 16.0f;  // RFC 3550 interarrival jitter
+
+    // Log-linear histogram: 4 buckets per power of two, up to ~67 s in us
+    constexpr size_t SUB_BUCKET_BITS = 2;
+    constexpr size_t HISTOGRAM_BUCKETS = 104;
+}
+
+// Coarse grouping of client opcodes for the server-side histograms
+enum class OpcodeClass : uint8_t
+{
+    Session,      // Ping, auth, character select
+    Movement,     // Move/stop, waypoints
+    Combat,       // Spells, actions, targeting, PvP
+    Interaction,  // Gossip and quests
+    Items,        // Inventory, bank, vendor, trade, loot
+    Social,       // Guild, party
+    Chat,         // Chat, channels, reports, GM commands
+    Other,
+
+    Count
+};
+
+const char* opcodeClassToString(OpcodeClass opcodeClass);
+OpcodeClass classifyOpcode(uint16_t opcode);
+
+// ============================================================================
+// LatencyHistogram
+// ============================================================================
+
+class LatencyHistogram
+{
+public:
+    void record(uint64_t micros);
+    void clear();
+
+    uint64_t getCount() const { return m_count; }
+
+    // Upper bound of the bucket holding the given fraction of samples
+    uint64_t percentile(double fraction) const;
+
+private:
+    static size_t bucketFor(uint64_t micros);
+    static uint64_t bucketUpperBound(size_t bucket);
+
+    std::array<uint32_t, LatencyConfig::HISTOGRAM_BUCKETS> m_buckets{};
+    uint64_t m_count = 0;
+};
+
+// ============================================================================
+// LatencyMonitor
+// ============================================================================
+
+class LatencyMonitor
+{
+public:
+    static LatencyMonitor& instance();
+
+    // Monotonic clock used for every latency timestamp
+    static uint64_t nowMicros();
+
+    // Network loop hooks: once per wake-up with ready sockets, once per
+    // dispatched packet, and once after pending sends are flushed
+    void beginIteration(uint64_t readyAt) { m_readyAt = readyAt; }
+    void recordDispatch(Session& session, uint16_t opcode, uint64_t handlerStart, bool responded);
+    void recordFlush();
+
+    // Send due pings and expire unanswered ones (call each tick)
+    void update();
+
+    // A Mutual_Ping with a probe payload arrived; returns true if it is the
+    // echo of the session's outstanding probe
+    bool completeProbe(Session& session, uint64_t sentAt, uint32_t nonce);
+
+    // Log histograms since the last report and start a new window
+    void report();
+
+private:
+    LatencyMonitor() = default;
+    LatencyMonitor(const LatencyMonitor&) = delete;
+    LatencyMonitor& operator=(const LatencyMonitor&) = delete;
+
+    struct QueueingHistograms
+    {
+        LatencyHistogram dispatch;  // Socket readable -> handler start
+        LatencyHistogram flush;     // Handler start -> response flushed
+    };
+
+    struct AwaitingFlush
+    {
+        uint32_t key = 0;
+        uint64_t handlerStart = 0;
+    };
+
+    static uint32_t makeKey(int mapId, OpcodeClass opcodeClass)
+    {
+        return (static_cast<uint32_t>(mapId) << 8) | static_cast<uint32_t>(opcodeClass);
+    }
+
+    uint64_t m_readyAt = 0;
+    uint64_t m_lastProbeSweep = 0;
+    uint32_t m_nextNonce = 0;
+    std::unordered_map<uint32_t, QueueingHistograms> m_queueing;
+    std::vector<AwaitingFlush> m_awaitingFlush;
+};
+
+#define sLatencyMonitor LatencyMonitor::instance()
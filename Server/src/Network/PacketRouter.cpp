@@ -7,6 +7,8 @@
 #include "Handlers/CharacterHandlers.h"
 #include "Handlers/WorldHandlers.h"
 #include "Handlers/MiscHandlers.h"
+#include "Network/Gateway.h"
+#include "World/Player.h"
 #include "Core/Logger.h"
 #include "GamePacketBase.h"
 
@@ -206,6 +208,37 @@ void PacketRouter::dispatch(Session& session, uint16_t opcode, StlBuffer& data)
         return;
     }
 
+    // Gateway: the world process hosting the character handles everything
+    // past character select; pings are answered here
+    if (session.getWorldShard() != 0 &&
+        opcode != Opcode::Mutual_Ping && opcode != Opcode::Client_Ping) {
+        session.updateLastActivity();
+        sGateway.forward(session, opcode, data);
+        return;
+    }
+
+    // Movement is most of the inbound traffic: skip the handler lookup and
+    // logging and go straight to the handler, which only queues the move
+    if (opcode == Opcode::Client_RequestMove || opcode == Opcode::Client_RequestStop) {
+        if (session.getState() != SessionState::InWorld) {
+            LOG_WARN("Session %u: Invalid state for %s (state=%s)",
+                     session.getId(), getOpcodeName(opcode),
+                     sessionStateToString(session.getState()));
+            return;
+        }
+
+        session.updateLastActivity();
+        if (opcode == Opcode::Client_RequestMove)
+            Handlers::handleRequestMove(session, data);
+        else
+            Handlers::handleRequestStop(session, data);
+        return;
+    }
+
+    // Anything else sees the player where their last move put them
+    if (Player* player = session.getPlayer())
+        player->applyQueuedMovement();
+
     // Find handler
     auto it = m_handlers.find(opcode);
     if (it == m_handlers.end()) {
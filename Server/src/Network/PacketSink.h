@@ -0,0 +1,20 @@
+// PacketSink - Destination of a player's outbound packets
+//
+// World code reaches a player's client only through this interface, never
+// through its Session, so the connection does not have to live in the
+// process that simulates the player. Session is the local implementation;
+// in a world process it passes the packets to its RelaySink, which sends
+// them over the gateway link (WorldShard.h).
+
+#pragma once
+
+class StlBuffer;
+
+class PacketSink
+{
+public:
+    virtual ~PacketSink() = default;
+
+    // Queue one packet (opcode + payload) for the client
+    virtual void sendPacket(const StlBuffer& data) = 0;
+};
@@ -3,7 +3,11 @@
 
 #include "stdafx.h"
 #include "Network/Session.h"
+#include "Network/SessionManager.h"
+#include "Network/Gateway.h"
+#include "Network/WorldShard.h"
 #include "SfSocket.h"
+#include "Core/Config.h"
 #include "Core/Logger.h"
 #include "World/Player.h"
 #include "World/WorldManager.h"
@@ -37,11 +41,16 @@ Session::~Session()
 {
     // Ensure player is cleaned up
     clearPlayer();
+
+    if (m_worldShard != 0)
+        sGateway.leaveWorld(*this);
 }
 
 void Session::setSocket(std::unique_ptr<SfSocket> socket)
 {
     m_socket = std::move(socket);
+    if (m_socket)
+        m_socket->setSendLimit(static_cast<size_t>(std::max(0, sConfig.getMaxSendQueueBytes())));
 }
 
 bool Session::isConnected() const
@@ -58,6 +67,9 @@ void Session::setState(SessionState state)
 
         // Reset activity timer on state change
         updateLastActivity();
+
+        // New state, new timeout (may be sooner than the scheduled one)
+        sSessionManager.scheduleTimeout(*this);
     }
 }
 
@@ -121,11 +133,32 @@ void Session::clearPlayer()
     }
 }
 
+void Session::setRelay(std::unique_ptr<RelaySink> relay)
+{
+    m_relay = std::move(relay);
+}
+
 void Session::sendPacket(const StlBuffer& data)
 {
-    if (m_socket && !isDisconnecting()) {
-        m_socket->send(data);
+    if (m_relay) {
+        if (!isDisconnecting())
+            m_relay->sendPacket(data);
+        return;
+    }
+
+    if (!m_socket || isDisconnecting() || m_sendOverflow)
+        return;
+
+    if (!m_socket->queue(data)) {
+        // The client stopped reading; drop it rather than buffer without end
+        m_sendOverflow = true;
+        LOG_WARN("Session %u: send queue full (%zu bytes unsent), dropping slow consumer",
+                 m_id, m_socket->getPendingSendSize());
+        sSessionManager.queueRemoval(m_id);
+        return;
     }
+
+    sSessionManager.queueFlush(*this);
 }
 
 void Session::updateLastActivity()
@@ -149,6 +182,30 @@ bool Session::isPingTimedOut(int timeoutSeconds) const
     return (std::time(nullptr) - m_lastPing) > timeoutSeconds;
 }
 
+int64_t Session::computeTimeoutDeadline() const
+{
+    switch (m_state) {
+        case SessionState::Connected:
+            // Unauthenticated connections timeout quickly
+            return m_lastActivity + AUTH_TIMEOUT_SECONDS;
+
+        case SessionState::Authenticated:
+            // Character select can take longer
+            return m_lastActivity + CHAR_SELECT_TIMEOUT;
+
+        case SessionState::InWorld:
+            // In-world sessions check ping timeout
+            return m_lastPing + INWORLD_PING_TIMEOUT;
+
+        case SessionState::Disconnecting:
+            // Give the client a moment to close, then drop it ourselves
+            return m_lastActivity + DISCONNECT_GRACE_SECONDS;
+
+        default:
+            return m_lastActivity + AUTH_TIMEOUT_SECONDS;
+    }
+}
+
 void Session::initiateDisconnect(const std::string& reason)
 {
     if (m_state == SessionState::Disconnecting) {
@@ -164,30 +221,19 @@ void Session::initiateDisconnect(const std::string& reason)
         LOG_DEBUG("Session %u disconnecting", m_id);
     }
 
-    // Clean up player if in world
-    if (m_player) {
-        clearPlayer();
-    }
-}
-
-bool Session::shouldRemove() const
-{
-    // Remove if marked for removal
-    if (m_markedForRemoval) {
-        return true;
+    // The world process hosting the character saves it; a world process
+    // tells the gateway to drop the client
+    if (m_worldShard != 0) {
+        sGateway.leaveWorld(*this);
     }
-
-    // Remove if disconnecting and socket closed
-    if (m_state == SessionState::Disconnecting && !isConnected()) {
-        return true;
+    if (m_relay) {
+        sWorldShard.kick(*this, reason);
     }
 
-    // Remove if socket disconnected unexpectedly
-    if (!isConnected() && m_state != SessionState::Disconnecting) {
-        return true;
+    // Clean up player if in world
+    if (m_player) {
+        clearPlayer();
     }
-
-    return false;
 }
 
 std::string Session::getRemoteAddress() const
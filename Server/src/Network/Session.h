@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "Network/PacketSink.h"
+
 #include <memory>
 #include <cstdint>
 #include <string>
@@ -11,6 +13,7 @@
 class SfSocket;
 class StlBuffer;
 class Player;
+class RelaySink;
 
 // Session states representing the connection lifecycle
 enum class SessionState
@@ -24,11 +27,24 @@ enum class SessionState
 // Convert session state to string for logging
 const char* sessionStateToString(SessionState state);
 
-class Session
+// Round-trip measurements from server-initiated pings (LatencyMonitor)
+struct SessionLatency
+{
+    uint64_t probeSentAt = 0;   // Monotonic us of the unanswered ping, 0 = none
+    uint32_t probeNonce = 0;    // Nonce the echo must carry
+    uint64_t lastProbeAt = 0;
+    float rttMicros = 0.0f;     // EWMA
+    float jitterMicros = 0.0f;
+    float lastRttMicros = 0.0f;
+    uint32_t samples = 0;
+    uint32_t lost = 0;
+};
+
+class Session : public PacketSink
 {
 public:
     explicit Session(uint32_t id);
-    ~Session();
+    ~Session() override;
 
     // Non-copyable
     Session(const Session&) = delete;
@@ -69,8 +85,11 @@ public:
     uint32_t getPlayerGuid() const { return m_playerGuid; }
     void setPlayerGuid(uint32_t guid) { m_playerGuid = guid; }
 
-    // Packet handling
-    void sendPacket(const StlBuffer& data);
+    // Packet handling (queued on the socket, written by the next
+    // SessionManager::flushPendingSends; relayed sessions go to the gateway)
+    void sendPacket(const StlBuffer& data) override;
+    bool isFlushQueued() const { return m_flushQueued; }
+    void setFlushQueued(bool queued) { m_flushQueued = queued; }
 
     // Activity tracking
     void updateLastActivity();
@@ -78,6 +97,10 @@ public:
     int64_t getLastActivityTime() const { return m_lastActivity; }
     int64_t getLastPingTime() const { return m_lastPing; }
 
+    // Round-trip latency from server pings
+    SessionLatency& getLatency() { return m_latency; }
+    const SessionLatency& getLatency() const { return m_latency; }
+
     // Timeout checking
     bool isTimedOut(int timeoutSeconds) const;
     bool isPingTimedOut(int timeoutSeconds) const;
@@ -86,19 +109,44 @@ public:
     static constexpr int AUTH_TIMEOUT_SECONDS = 30;     // 30 sec to authenticate
     static constexpr int CHAR_SELECT_TIMEOUT = 300;     // 5 min in character select
     static constexpr int INWORLD_PING_TIMEOUT = 120;    // 2 min ping timeout in world
+    static constexpr int DISCONNECT_GRACE_SECONDS = 10; // Kicked session's socket left open
+
+    // Second after which this session is timed out in its current state
+    int64_t computeTimeoutDeadline() const;
+
+    // Deadline of the session's live timeout wheel entry (SessionManager)
+    int64_t getScheduledDeadline() const { return m_scheduledDeadline; }
+    void setScheduledDeadline(int64_t deadline) { m_scheduledDeadline = deadline; }
 
     // Disconnect handling
     void initiateDisconnect(const std::string& reason = "");
     const std::string& getDisconnectReason() const { return m_disconnectReason; }
-    bool shouldRemove() const;
-    void markForRemoval() { m_markedForRemoval = true; }
 
     // Remote address for logging
     std::string getRemoteAddress() const;
 
+    // Remote IPv4 address captured at accept (for per-address limits)
+    uint32_t getRemoteIp() const { return m_remoteIp; }
+    void setRemoteIp(uint32_t ip) { m_remoteIp = ip; }
+
+    // World process: a client connected to the gateway, without a socket
+    // here. Packets go back through the relay; the gateway times the client
+    // out and says when it has left.
+    void setRelay(std::unique_ptr<RelaySink> relay);
+    RelaySink* getRelay() { return m_relay.get(); }
+    bool isRelayed() const { return m_relay != nullptr; }
+
+    // Gateway: world process hosting this session's character (0 = none;
+    // packets are handled here)
+    uint32_t getWorldShard() const { return m_worldShard; }
+    void setWorldShard(uint32_t worldId) { m_worldShard = worldId; }
+
 private:
     uint32_t m_id;
     std::unique_ptr<SfSocket> m_socket;
+    uint32_t m_remoteIp = 0;
+    std::unique_ptr<RelaySink> m_relay;
+    uint32_t m_worldShard = 0;
 
     // State
     SessionState m_state = SessionState::Connected;
@@ -116,8 +164,12 @@ private:
     int64_t m_lastActivity = 0;
     int64_t m_lastPing = 0;
     int64_t m_connectedAt = 0;
+    int64_t m_scheduledDeadline = 0;
+    SessionLatency m_latency;
+
+    bool m_flushQueued = false;
+    bool m_sendOverflow = false;  // Send limit hit; removal queued
 
     // Disconnect handling
-    bool m_markedForRemoval = false;
     std::string m_disconnectReason;
 };
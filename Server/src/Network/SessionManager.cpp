@@ -7,18 +7,29 @@
 #include "Core/Logger.h"
 #include "SfSocket.h"
 
+#include <algorithm>
+#include <ctime>
+
 SessionManager& SessionManager::instance()
 {
     static SessionManager instance;
     return instance;
 }
 
-Session* SessionManager::createSession()
+SessionManager::SessionManager()
+    : m_timeoutWheel(TIMEOUT_WHEEL_SECONDS)
+{
+}
+
+Session* SessionManager::createSession(uint32_t remoteIp)
 {
     std::lock_guard<std::recursive_mutex> lock(m_mutex);
     uint32_t id = m_nextId++;
     auto session = std::make_unique<Session>(id);
     auto* ptr = session.get();
+    ptr->setRemoteIp(remoteIp);
+    ++m_sessionsPerAddress[remoteIp];
+    scheduleTimeout(*ptr);
     m_sessions[id] = std::move(session);
     LOG_INFO("Session %u created", id);
     return ptr;
@@ -27,9 +38,16 @@ Session* SessionManager::createSession()
 void SessionManager::removeSession(uint32_t id)
 {
     std::lock_guard<std::recursive_mutex> lock(m_mutex);
-    if (m_sessions.erase(id) > 0) {
-        LOG_INFO("Session %u removed", id);
-    }
+    auto it = m_sessions.find(id);
+    if (it == m_sessions.end())
+        return;
+
+    auto addrIt = m_sessionsPerAddress.find(it->second->getRemoteIp());
+    if (addrIt != m_sessionsPerAddress.end() && --addrIt->second == 0)
+        m_sessionsPerAddress.erase(addrIt);
+
+    m_sessions.erase(it);
+    LOG_INFO("Session %u removed", id);
 }
 
 Session* SessionManager::getSession(uint32_t id)
@@ -41,37 +59,124 @@ Session* SessionManager::getSession(uint32_t id)
 
 void SessionManager::update()
 {
-    std::vector<uint32_t> toRemove;
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
-    {
-        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    int64_t now = std::time(nullptr);
+    if (m_lastTimeoutSecond == 0)
+        m_lastTimeoutSecond = now;
 
-        for (auto& [id, session] : m_sessions) {
-            // Check for disconnected sessions
-            if (session->shouldRemove()) {
-                toRemove.push_back(id);
-                continue;
-            }
+    // Usually one bucket per second; catches up after a stall
+    while (m_lastTimeoutSecond < now) {
+        ++m_lastTimeoutSecond;
+        processTimeoutBucket(m_lastTimeoutSecond, now);
+    }
+}
 
-            // Check for timeout based on state
-            if (isSessionTimedOut(*session)) {
-                session->initiateDisconnect("Connection timeout");
-                toRemove.push_back(id);
-                continue;
-            }
+void SessionManager::processTimeoutBucket(int64_t second, int64_t now)
+{
+    auto& bucket = m_timeoutWheel[static_cast<size_t>(second) % TIMEOUT_WHEEL_SECONDS];
+    if (bucket.empty())
+        return;
 
-            // Check if socket disconnected unexpectedly
-            if (!session->isConnected() && !session->isDisconnecting()) {
-                LOG_INFO("Session %u: Connection lost", id);
-                session->initiateDisconnect("Connection lost");
-                toRemove.push_back(id);
-            }
+    std::vector<TimeoutEntry> due;
+    due.swap(bucket);
+
+    for (const TimeoutEntry& entry : due) {
+        if (entry.deadline + 1 > second) {
+            bucket.push_back(entry);  // A later turn of the wheel
+            continue;
+        }
+
+        auto it = m_sessions.find(entry.sessionId);
+        if (it == m_sessions.end())
+            continue;
+
+        Session& session = *it->second;
+        if (session.getScheduledDeadline() != entry.deadline)
+            continue;  // Superseded by an earlier reschedule
+        if (session.isRelayed())
+            continue;  // The gateway times relayed clients out
+
+        // Activity since scheduling pushes the deadline out
+        int64_t deadline = session.computeTimeoutDeadline();
+        if (deadline >= now) {
+            insertTimeout(entry.sessionId, deadline);
+            session.setScheduledDeadline(deadline);
+            continue;
+        }
+
+        if (!session.isDisconnecting()) {
+            session.initiateDisconnect("Connection timeout");
         }
+        queueRemoval(entry.sessionId);
     }
+}
 
-    // Remove sessions outside of lock
-    for (uint32_t id : toRemove) {
-        removeSession(id);
+void SessionManager::scheduleTimeout(Session& session)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    if (session.isRelayed())
+        return;
+
+    // A later deadline is picked up lazily by the existing entry
+    int64_t deadline = session.computeTimeoutDeadline();
+    int64_t scheduled = session.getScheduledDeadline();
+    if (scheduled != 0 && scheduled <= deadline)
+        return;
+
+    insertTimeout(session.getId(), deadline);
+    session.setScheduledDeadline(deadline);
+}
+
+void SessionManager::insertTimeout(uint32_t sessionId, int64_t deadline)
+{
+    // Due in the first bucket after the deadline, never one already processed
+    int64_t second = std::max(deadline + 1, m_lastTimeoutSecond + 1);
+    m_timeoutWheel[static_cast<size_t>(second) % TIMEOUT_WHEEL_SECONDS].push_back({sessionId, deadline});
+}
+
+void SessionManager::queueRemoval(uint32_t id)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    if (std::find(m_pendingRemovals.begin(), m_pendingRemovals.end(), id) == m_pendingRemovals.end())
+        m_pendingRemovals.push_back(id);
+}
+
+std::vector<uint32_t> SessionManager::takePendingRemovals()
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::vector<uint32_t> removals;
+    removals.swap(m_pendingRemovals);
+    return removals;
+}
+
+void SessionManager::queueFlush(Session& session)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    if (session.isFlushQueued())
+        return;
+
+    session.setFlushQueued(true);
+    m_pendingFlushes.push_back(session.getId());
+}
+
+void SessionManager::flushPendingSends()
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::vector<uint32_t> flushes;
+    flushes.swap(m_pendingFlushes);
+
+    for (uint32_t id : flushes) {
+        auto it = m_sessions.find(id);
+        if (it == m_sessions.end())
+            continue;
+
+        Session& session = *it->second;
+        session.setFlushQueued(false);
+
+        SfSocket* socket = session.getSocket();
+        if (socket && socket->flush() && socket->hasPendingSend())
+            queueFlush(session);
     }
 }
 
@@ -140,26 +245,9 @@ size_t SessionManager::getSessionCount() const
     return m_sessions.size();
 }
 
-bool SessionManager::isSessionTimedOut(const Session& session) const
+size_t SessionManager::getSessionCountForAddress(uint32_t remoteIp) const
 {
-    switch (session.getState()) {
-        case SessionState::Connected:
-            // Unauthenticated connections timeout quickly
-            return session.isTimedOut(Session::AUTH_TIMEOUT_SECONDS);
-
-        case SessionState::Authenticated:
-            // Character select can take longer
-            return session.isTimedOut(Session::CHAR_SELECT_TIMEOUT);
-
-        case SessionState::InWorld:
-            // In-world sessions check ping timeout
-            return session.isPingTimedOut(Session::INWORLD_PING_TIMEOUT);
-
-        case SessionState::Disconnecting:
-            // Already disconnecting, don't timeout again
-            return false;
-
-        default:
-            return false;
-    }
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    auto it = m_sessionsPerAddress.find(remoteIp);
+    return it != m_sessionsPerAddress.end() ? it->second : 0;
 }
@@ -1,5 +1,10 @@
 // Session Manager - Manages all client sessions
 // Task 2.6: Added update() for timeout checking
+//
+// Timeouts live in a timing wheel with one bucket per second. A session has
+// one live entry at its current deadline; activity only moves the deadline
+// later, so entries are re-checked lazily when their bucket comes due and
+// idle sessions cost nothing per tick.
 
 #pragma once
 
@@ -18,13 +23,29 @@ public:
     static SessionManager& instance();
 
     // Session management
-    Session* createSession();
+    Session* createSession(uint32_t remoteIp = 0);
     void removeSession(uint32_t id);
     Session* getSession(uint32_t id);
 
-    // Update all sessions - check timeouts, remove disconnected
+    // Expire sessions whose timeout bucket has come due (call each tick)
     void update();
 
+    // (Re)schedule a session's timeout; called on creation and state change
+    void scheduleTimeout(Session& session);
+
+    // Sessions to tear down (network errors, timeouts). The network layer
+    // drains this once per loop so sockets leave the selector before the
+    // session is destroyed.
+    void queueRemoval(uint32_t id);
+    std::vector<uint32_t> takePendingRemovals();
+
+    // Sessions with packets queued on their socket. Flushed once per loop
+    // so everything a session is sent in one iteration leaves in as few
+    // writes as the socket accepts; sessions the kernel could not take in
+    // full stay queued for the next flush.
+    void queueFlush(Session& session);
+    void flushPendingSends();
+
     // Disconnect all sessions (for shutdown)
     void disconnectAll(const std::string& reason = "");
 
@@ -46,14 +67,30 @@ public:
 
     // Statistics
     size_t getSessionCount() const;
+    size_t getSessionCountForAddress(uint32_t remoteIp) const;
 
 private:
-    SessionManager() = default;
+    SessionManager();
 
-    // Check if a session has timed out based on its state
-    bool isSessionTimedOut(const Session& session) const;
+    struct TimeoutEntry
+    {
+        uint32_t sessionId = 0;
+        int64_t deadline = 0;  // Expires once the clock passes this second
+    };
+
+    // Longer than any session timeout, so entries never wrap in practice
+    static constexpr size_t TIMEOUT_WHEEL_SECONDS = 512;
+
+    void insertTimeout(uint32_t sessionId, int64_t deadline);
+    void processTimeoutBucket(int64_t second, int64_t now);
 
     std::unordered_map<uint32_t, std::unique_ptr<Session>> m_sessions;
+    std::unordered_map<uint32_t, size_t> m_sessionsPerAddress;
+
+    std::vector<std::vector<TimeoutEntry>> m_timeoutWheel;
+    int64_t m_lastTimeoutSecond = 0;  // Last second whose bucket was processed
+    std::vector<uint32_t> m_pendingRemovals;
+    std::vector<uint32_t> m_pendingFlushes;
     mutable std::recursive_mutex m_mutex;  // Recursive to allow nested calls (e.g., kickDuplicateLogin from packet handlers)
     uint32_t m_nextId = 1;
 };
@@ -0,0 +1,437 @@
+// ShardLink - Framed Unix socket between the gateway and a world process
+
+#include "stdafx.h"
+#include "Network/ShardLink.h"
+#include "Core/Logger.h"
+#include "StlBuffer.h"
+
+#include <cstdlib>
+
+#ifndef _WIN32
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#endif
+
+// ============================================================================
+// Arguments
+// ============================================================================
+
+bool ShardArguments::parse(int argc, char* argv[], ShardOptions& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--gateway")
+        {
+            options.role = ShardRole::Gateway;
+        }
+        else if (arg == "--world" && i + 1 < argc)
+        {
+            long worldId = std::strtol(argv[++i], nullptr, 10);
+            if (worldId < 1 || worldId > static_cast<long>(ShardConfig::MAX_WORLDS))
+            {
+                LOG_ERROR("Shard: --world takes an ID from 1 to %u", ShardConfig::MAX_WORLDS);
+                return false;
+            }
+            options.role = ShardRole::World;
+            options.worldId = static_cast<uint32_t>(worldId);
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// Messages
+// ============================================================================
+
+namespace
+{
+size_t bytesLeft(const StlBuffer& buf)
+{
+    return buf.size() - buf.readPos();
+}
+
+// Length-prefixed string; false if the length runs past the body (a short
+// string would otherwise read back as empty)
+bool readString(StlBuffer& in, std::string& out)
+{
+    if (bytesLeft(in) < sizeof(uint16_t))
+        return false;
+
+    const uint8_t* lengthBytes = in.data() + in.readPos();
+    size_t length = static_cast<size_t>(lengthBytes[0]) | (static_cast<size_t>(lengthBytes[1]) << 8);
+    if (bytesLeft(in) < sizeof(uint16_t) + length)
+        return false;
+
+    in >> out;
+    return true;
+}
+} // namespace
+
+void ShardHandoff::write(StlBuffer& out) const
+{
+    out << sessionId << accountId << username << isGm << characterGuid << characterName << mapId;
+}
+
+bool ShardHandoff::read(StlBuffer& in)
+{
+    if (bytesLeft(in) < sizeof(sessionId) + sizeof(accountId))
+        return false;
+    in >> sessionId >> accountId;
+
+    if (!readString(in, username) || bytesLeft(in) < sizeof(uint8_t) + sizeof(characterGuid))
+        return false;
+    in >> isGm >> characterGuid;
+
+    if (!readString(in, characterName) || bytesLeft(in) < sizeof(mapId))
+        return false;
+    in >> mapId;
+    return true;
+}
+
+void ShardChat::write(StlBuffer& out) const
+{
+    out << senderSessionId << channel << senderGuid << senderName << targetName << message;
+}
+
+bool ShardChat::read(StlBuffer& in)
+{
+    if (bytesLeft(in) < sizeof(senderSessionId) + sizeof(channel) + sizeof(senderGuid))
+        return false;
+    in >> senderSessionId >> channel >> senderGuid;
+
+    return readString(in, senderName) && readString(in, targetName) && readString(in, message);
+}
+
+StlBuffer frameBody(const ShardFrame& frame)
+{
+    return StlBuffer(frame.body);
+}
+
+// ============================================================================
+// Map Ownership
+// ============================================================================
+
+bool ShardMapTable::parse(const std::string& spec)
+{
+    m_owners.clear();
+
+    size_t start = 0;
+    while (start < spec.size())
+    {
+        size_t end = spec.find(';', start);
+        if (end == std::string::npos)
+            end = spec.size();
+        std::string entry = spec.substr(start, end - start);
+        start = end + 1;
+
+        if (entry.find_first_not_of(" \t") == std::string::npos)
+            continue;
+
+        size_t colon = entry.find(':');
+        char* parsed = nullptr;
+        long worldId = std::strtol(entry.c_str(), &parsed, 10);
+        if (colon == std::string::npos || parsed == entry.c_str() ||
+            worldId < 1 || worldId > static_cast<long>(ShardConfig::MAX_WORLDS))
+        {
+            LOG_ERROR("Shard: malformed map assignment '%s'", entry.c_str());
+            m_owners.clear();
+            return false;
+        }
+
+        std::string maps = entry.substr(colon + 1);
+        size_t mapStart = 0;
+        while (mapStart < maps.size())
+        {
+            size_t mapEnd = maps.find(',', mapStart);
+            if (mapEnd == std::string::npos)
+                mapEnd = maps.size();
+            std::string map = maps.substr(mapStart, mapEnd - mapStart);
+            mapStart = mapEnd + 1;
+
+            char* mapParsed = nullptr;
+            long mapId = std::strtol(map.c_str(), &mapParsed, 10);
+            if (mapParsed == map.c_str())
+            {
+                LOG_ERROR("Shard: malformed map '%s' for world %ld", map.c_str(), worldId);
+                m_owners.clear();
+                return false;
+            }
+            m_owners[static_cast<int32_t>(mapId)] = static_cast<uint32_t>(worldId);
+        }
+    }
+    return true;
+}
+
+uint32_t ShardMapTable::getOwner(int32_t mapId) const
+{
+    auto it = m_owners.find(mapId);
+    return it != m_owners.end() ? it->second : 1;
+}
+
+std::vector<int32_t> ShardMapTable::getMaps(uint32_t worldId) const
+{
+    std::vector<int32_t> maps;
+    for (const auto& [mapId, owner] : m_owners)
+    {
+        if (owner == worldId)
+            maps.push_back(mapId);
+    }
+    std::sort(maps.begin(), maps.end());
+    return maps;
+}
+
+// ============================================================================
+// ShardLink
+// ============================================================================
+
+void ShardLink::beginFrame(ShardMessage type, size_t bodySize)
+{
+    uint32_t size = static_cast<uint32_t>(sizeof(uint8_t) + bodySize);
+    const uint8_t header[] = {
+        static_cast<uint8_t>(size), static_cast<uint8_t>(size >> 8),
+        static_cast<uint8_t>(size >> 16), static_cast<uint8_t>(size >> 24),
+        static_cast<uint8_t>(type)
+    };
+    m_sendBuffer.insert(m_sendBuffer.end(), header, header + sizeof(header));
+}
+
+void ShardLink::send(ShardMessage type, const StlBuffer& body)
+{
+    beginFrame(type, body.size());
+    m_sendBuffer.insert(m_sendBuffer.end(), body.data(), body.data() + body.size());
+}
+
+void ShardLink::sendPacket(ShardMessage type, uint32_t sessionId, uint16_t opcode,
+                           const uint8_t* payload, size_t size)
+{
+    beginFrame(type, sizeof(sessionId) + sizeof(opcode) + size);
+    const uint8_t head[] = {
+        static_cast<uint8_t>(sessionId), static_cast<uint8_t>(sessionId >> 8),
+        static_cast<uint8_t>(sessionId >> 16), static_cast<uint8_t>(sessionId >> 24),
+        static_cast<uint8_t>(opcode), static_cast<uint8_t>(opcode >> 8)
+    };
+    m_sendBuffer.insert(m_sendBuffer.end(), head, head + sizeof(head));
+    m_sendBuffer.insert(m_sendBuffer.end(), payload, payload + size);
+}
+
+#ifdef _WIN32
+
+ShardLink::ShardLink(int handle) : m_handle(handle) {}
+ShardLink::~ShardLink() {}
+bool ShardLink::flush() { return false; }
+bool ShardLink::receive(std::vector<ShardFrame>&) { return false; }
+bool ShardLink::receive(std::vector<ShardFrame>&, int) { return false; }
+void ShardLink::close() { m_handle = -1; }
+int ShardLink::listen(const std::string&) { return -1; }
+int ShardLink::accept(int) { return -1; }
+int ShardLink::connect(const std::string&, int) { return -1; }
+
+#else
+
+namespace
+{
+bool makeAddress(const std::string& path, sockaddr_un& address)
+{
+    address = sockaddr_un{};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path))
+    {
+        errno = ENAMETOOLONG;
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+    return true;
+}
+} // namespace
+
+ShardLink::ShardLink(int handle)
+    : m_handle(handle)
+{
+    if (m_handle >= 0)
+        ::fcntl(m_handle, F_SETFL, ::fcntl(m_handle, F_GETFL, 0) | O_NONBLOCK);
+}
+
+ShardLink::~ShardLink()
+{
+    close();
+}
+
+void ShardLink::close()
+{
+    if (m_handle >= 0)
+        ::close(m_handle);
+    m_handle = -1;
+}
+
+bool ShardLink::flush()
+{
+    if (m_handle < 0)
+        return false;
+
+    while (m_sendOffset < m_sendBuffer.size())
+    {
+        ssize_t written = ::send(m_handle, m_sendBuffer.data() + m_sendOffset,
+                                 m_sendBuffer.size() - m_sendOffset, MSG_NOSIGNAL);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        if (written <= 0)
+            return false;
+        m_sendOffset += static_cast<size_t>(written);
+    }
+
+    // Drop what was written once it is most of the buffer
+    if (m_sendOffset == m_sendBuffer.size())
+    {
+        m_sendBuffer.clear();
+        m_sendOffset = 0;
+    }
+    else if (m_sendOffset > m_sendBuffer.size() / 2)
+    {
+        m_sendBuffer.erase(m_sendBuffer.begin(), m_sendBuffer.begin() + static_cast<ptrdiff_t>(m_sendOffset));
+        m_sendOffset = 0;
+    }
+    return true;
+}
+
+bool ShardLink::receive(std::vector<ShardFrame>& frames)
+{
+    if (m_handle < 0)
+        return false;
+
+    bool open = true;
+    size_t received = 0;
+    uint8_t chunk[65536];
+    while (received < ShardConfig::MAX_RECEIVE_PER_CALL)
+    {
+        ssize_t got = ::recv(m_handle, chunk, sizeof(chunk), 0);
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        if (got <= 0)
+        {
+            open = false;
+            break;
+        }
+        m_receiveBuffer.insert(m_receiveBuffer.end(), chunk, chunk + got);
+        received += static_cast<size_t>(got);
+    }
+
+    // Complete frames; a partial one waits for the rest
+    size_t offset = 0;
+    while (m_receiveBuffer.size() - offset >= sizeof(uint32_t) + sizeof(uint8_t))
+    {
+        const uint8_t* header = m_receiveBuffer.data() + offset;
+        uint32_t size = static_cast<uint32_t>(header[0]) | (static_cast<uint32_t>(header[1]) << 8) |
+                        (static_cast<uint32_t>(header[2]) << 16) | (static_cast<uint32_t>(header[3]) << 24);
+        if (size == 0 || size > ShardConfig::MAX_FRAME_BYTES)
+        {
+            LOG_ERROR("ShardLink: corrupt frame (size %u)", size);
+            open = false;
+            break;
+        }
+        if (m_receiveBuffer.size() - offset < sizeof(uint32_t) + size)
+            break;
+
+        ShardFrame frame;
+        frame.type = static_cast<ShardMessage>(header[4]);
+        frame.body.assign(header + sizeof(uint32_t) + sizeof(uint8_t), header + sizeof(uint32_t) + size);
+        frames.push_back(std::move(frame));
+        offset += sizeof(uint32_t) + size;
+    }
+    m_receiveBuffer.erase(m_receiveBuffer.begin(), m_receiveBuffer.begin() + static_cast<ptrdiff_t>(offset));
+    return open;
+}
+
+bool ShardLink::receive(std::vector<ShardFrame>& frames, int timeoutMs)
+{
+    size_t first = frames.size();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (frames.size() == first)
+    {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        if (left <= 0)
+            return false;
+
+        pollfd entry{m_handle, POLLIN, 0};
+        int result = ::poll(&entry, 1, static_cast<int>(left));
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result <= 0 || !receive(frames))
+            return frames.size() > first;
+    }
+    return true;
+}
+
+int ShardLink::listen(const std::string& path)
+{
+    sockaddr_un address;
+    if (!makeAddress(path, address))
+        return -1;
+
+    int handle = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (handle < 0)
+        return -1;
+
+    // A socket file left by a previous run would make bind fail
+    ::unlink(path.c_str());
+    if (::bind(handle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(handle, static_cast<int>(ShardConfig::MAX_WORLDS)) != 0)
+    {
+        int error = errno;
+        ::close(handle);
+        errno = error;
+        return -1;
+    }
+
+    ::fcntl(handle, F_SETFL, ::fcntl(handle, F_GETFL, 0) | O_NONBLOCK);
+    return handle;
+}
+
+int ShardLink::accept(int listener)
+{
+    int handle;
+    do
+    {
+        handle = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+    } while (handle < 0 && errno == EINTR);
+    return handle;
+}
+
+int ShardLink::connect(const std::string& path, int timeoutMs)
+{
+    sockaddr_un address;
+    if (!makeAddress(path, address))
+        return -1;
+
+    // The gateway may still be loading game data; retry until it listens
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (true)
+    {
+        int handle = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (handle < 0)
+            return -1;
+
+        if (::connect(handle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0)
+            return handle;
+
+        int error = errno;
+        ::close(handle);
+        if ((error != ENOENT && error != ECONNREFUSED) || std::chrono::steady_clock::now() >= deadline)
+        {
+            errno = error;
+            return -1;
+        }
+        ::usleep(100 * 1000);
+    }
+}
+
+#endif
@@ -0,0 +1,204 @@
+// ShardLink - Framed Unix socket between the gateway and a world process
+//
+// Multi-process mode splits the server on one machine: a gateway process
+// (--gateway) owns the client sockets and handles login and character
+// select; world processes (--world N) each own a set of maps and run the
+// simulation for the characters on them. The gateway forwards a session's
+// client packets to the world hosting its character, and writes whatever
+// that world sends back to the client.
+//
+// A character moves between processes as a handoff record: the player is
+// saved (synchronously, to the shared server database) and dropped by one
+// process, and the next one loads it through the normal EnterWorld path -
+// the same contract HotUpgrade uses between binaries.
+//
+// Frames are [uint32 size][uint8 type][body], size counting type and body.
+// POSIX only.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class StlBuffer;
+
+// ============================================================================
+// Shard Configuration
+// ============================================================================
+
+namespace ShardConfig
+{
+    // Poller tokens of the gateway's Unix listener and world links (base
+    // + world ID); session IDs count up from 1 and never get this high
+    constexpr uint32_t LISTENER_TOKEN = 0xFFFF0000;
+    constexpr uint32_t LINK_TOKEN_BASE = 0xFFFF0100;
+
+    // World IDs are 1..MAX_WORLDS
+    constexpr uint32_t MAX_WORLDS = 64;
+
+    // A frame this large means the stream is corrupt
+    constexpr uint32_t MAX_FRAME_BYTES = 16 * 1024 * 1024;
+
+    // Bytes read per receive() before yielding to the rest of the loop
+    constexpr size_t MAX_RECEIVE_PER_CALL = 1024 * 1024;
+
+    // How long a world process keeps retrying while the gateway starts,
+    // and how long the gateway waits for a new link's Hello
+    constexpr int CONNECT_TIMEOUT_MS = 10000;
+    constexpr int HELLO_TIMEOUT_MS = 1000;
+}
+
+// ============================================================================
+// Process Role
+// ============================================================================
+
+enum class ShardRole
+{
+    Standalone,  // Single process (default)
+    Gateway,     // --gateway
+    World        // --world N
+};
+
+struct ShardOptions
+{
+    ShardRole role = ShardRole::Standalone;
+    uint32_t worldId = 0;
+};
+
+namespace ShardArguments
+{
+    // Fills `options` from --gateway / --world N; false on a bad world ID
+    bool parse(int argc, char* argv[], ShardOptions& options);
+}
+
+// ============================================================================
+// Messages
+// ============================================================================
+
+enum class ShardMessage : uint8_t
+{
+    Hello = 1,         // World -> gateway: world ID; first frame on a link
+    Enter = 2,         // Gateway -> world: handoff record; load the character here
+    ClientPacket = 3,  // Gateway -> world: session ID, opcode and payload from the client
+    ServerPacket = 4,  // World -> gateway: session ID, opcode and payload for the client
+    Leave = 5,         // Gateway -> world: session ID, character GUID; client gone, save and drop it
+    Left = 6,          // World -> gateway: character GUID; saved after Leave
+    Transfer = 7,      // World -> gateway: handoff record; character saved on a map it doesn't own
+    Kick = 8,          // World -> gateway: session ID, reason; disconnect the client
+    Chat = 9           // Either way: cross-world whisper or all-chat line (ShardChat)
+};
+
+// A character changing process. The gateway session stays the same for the
+// whole connection; the world keys its relayed session by it.
+struct ShardHandoff
+{
+    uint32_t sessionId = 0;      // Gateway session
+    uint32_t accountId = 0;
+    std::string username;
+    bool isGm = false;
+    uint32_t characterGuid = 0;
+    std::string characterName;
+    int32_t mapId = 0;           // Map the character is saved on
+
+    void write(StlBuffer& out) const;
+    bool read(StlBuffer& in);    // False if truncated
+};
+
+// Chat line for players hosted by other world processes
+struct ShardChat
+{
+    uint32_t senderSessionId = 0;  // Gateway session, for replies
+    uint8_t channel = 0;           // ChatDefines::Channels (Whisper or AllChat)
+    uint32_t senderGuid = 0;
+    std::string senderName;
+    std::string targetName;        // Whisper only
+    std::string message;
+
+    void write(StlBuffer& out) const;
+    bool read(StlBuffer& in);
+};
+
+struct ShardFrame
+{
+    ShardMessage type = ShardMessage::Hello;
+    std::vector<uint8_t> body;
+};
+
+// Frame body as a buffer to read fields from
+StlBuffer frameBody(const ShardFrame& frame);
+
+// ============================================================================
+// Map Ownership
+// ============================================================================
+
+// Which world process owns each map, from "<world>:<map>,<map>;<world>:..."
+// (e.g. "1:1,2;2:3,4"). Maps not listed belong to world 1.
+class ShardMapTable
+{
+public:
+    // False (table left empty) on a malformed entry
+    bool parse(const std::string& spec);
+
+    uint32_t getOwner(int32_t mapId) const;
+    std::vector<int32_t> getMaps(uint32_t worldId) const;
+
+private:
+    std::unordered_map<int32_t, uint32_t> m_owners;
+};
+
+// ============================================================================
+// ShardLink
+// ============================================================================
+
+class ShardLink
+{
+public:
+    // Takes ownership of a connected stream socket and makes it non-blocking
+    explicit ShardLink(int handle);
+    ~ShardLink();
+
+    ShardLink(const ShardLink&) = delete;
+    ShardLink& operator=(const ShardLink&) = delete;
+
+    int getHandle() const { return m_handle; }
+    bool isOpen() const { return m_handle >= 0; }
+
+    // Frame a message for the next flush()
+    void send(ShardMessage type, const StlBuffer& body);
+
+    // ClientPacket/ServerPacket without building a body first:
+    // [uint32 session ID][uint16 opcode][payload]
+    void sendPacket(ShardMessage type, uint32_t sessionId, uint16_t opcode,
+                    const uint8_t* payload, size_t size);
+
+    // Write what the socket takes; the rest stays queued. False once the
+    // link is broken.
+    bool flush();
+    bool hasPendingSend() const { return m_sendOffset < m_sendBuffer.size(); }
+
+    // Read what is available and append complete frames. False once the
+    // peer has closed or sent a corrupt frame (frames read before that
+    // are still appended).
+    bool receive(std::vector<ShardFrame>& frames);
+
+    // Wait up to timeoutMs for at least one frame
+    bool receive(std::vector<ShardFrame>& frames, int timeoutMs);
+
+    void close();
+
+    // Socket setup; -1 on failure (errno set)
+    static int listen(const std::string& path);
+    static int accept(int listener);
+    static int connect(const std::string& path, int timeoutMs);
+
+private:
+    void beginFrame(ShardMessage type, size_t bodySize);
+
+    int m_handle = -1;
+    std::vector<uint8_t> m_sendBuffer;
+    size_t m_sendOffset = 0;       // Bytes of m_sendBuffer already written
+    std::vector<uint8_t> m_receiveBuffer;
+};
@@ -0,0 +1,711 @@
+// SocketPoller - Readiness notification for the listener and session sockets
+
+#include "stdafx.h"
+#include "Network/SocketPoller.h"
+#include "Core/Logger.h"
+
+#include <SFML/Network.hpp>
+
+#ifdef __linux__
+    #include <sys/epoll.h>
+    #include <unistd.h>
+    #include <cerrno>
+#endif
+
+#ifndef _WIN32
+    #include <poll.h>
+#endif
+
+#ifdef DREADMYST_HAVE_IO_URING
+    #include <csignal>
+#endif
+
+namespace
+{
+// sf::Socket::getHandle is protected; naming it through a derived class
+// yields a member pointer usable on any socket
+struct HandleAccess : sf::Socket
+{
+    static int get(const sf::Socket& socket)
+    {
+        return static_cast<int>((socket.*(&HandleAccess::getHandle))());
+    }
+};
+
+#ifdef DREADMYST_HAVE_IO_URING
+// Completion tags: the kind of request in the high half of user_data, the
+// token (or send slot) in the low half
+enum class RingOp : uint32_t
+{
+    Listener = 1,
+    Receive = 2,
+    Send = 3,
+    Cancel = 4,
+    Handle = 5
+};
+
+constexpr uint16_t RECV_BUFFER_GROUP = 0;
+
+uint64_t ringTag(RingOp op, uint32_t id)
+{
+    return (static_cast<uint64_t>(op) << 32) | id;
+}
+#endif
+} // namespace
+
+int SocketPoller::getNativeHandle(const sf::Socket& socket)
+{
+    return HandleAccess::get(socket);
+}
+
+SocketPoller::Backend SocketPoller::backendFromString(const std::string& name)
+{
+    if (name == "select")
+        return Backend::Select;
+    if (name == "io_uring")
+        return Backend::IoUring;
+    return Backend::Epoll;  // Default; falls back where unavailable
+}
+
+const char* SocketPoller::backendToString(Backend backend)
+{
+    switch (backend)
+    {
+        case Backend::IoUring: return "io_uring";
+        case Backend::Epoll:   return "epoll";
+        default:               return "select";
+    }
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+SocketPoller::SocketPoller(Backend requested)
+{
+    if (requested == Backend::IoUring)
+    {
+#ifdef DREADMYST_HAVE_IO_URING
+        if (setupRing())
+        {
+            m_backend = Backend::IoUring;
+            return;
+        }
+        LOG_WARN("SocketPoller: io_uring unavailable (errno %d), using epoll", errno);
+#else
+        LOG_WARN("SocketPoller: io_uring not compiled in, using epoll");
+#endif
+        requested = Backend::Epoll;
+    }
+
+#ifdef __linux__
+    if (requested == Backend::Epoll)
+    {
+        m_epollHandle = ::epoll_create1(EPOLL_CLOEXEC);
+        if (m_epollHandle >= 0)
+        {
+            m_backend = Backend::Epoll;
+            m_events.resize(sizeof(epoll_event) * SocketPollerConfig::MAX_EVENTS);
+        }
+        else
+        {
+            LOG_WARN("SocketPoller: epoll unavailable (errno %d), using select", errno);
+        }
+    }
+#else
+    if (requested == Backend::Epoll)
+        LOG_WARN("SocketPoller: epoll not supported on this platform, using select");
+#endif
+}
+
+SocketPoller::~SocketPoller()
+{
+#ifdef DREADMYST_HAVE_IO_URING
+    // Sessions outliving the poller fall back to direct I/O
+    for (auto& [token, ring] : m_ringSockets)
+        ring.socket->setTransport(nullptr);
+#endif
+
+#ifdef __linux__
+    if (m_epollHandle >= 0)
+        ::close(m_epollHandle);
+#endif
+}
+
+// ============================================================================
+// Registration
+// ============================================================================
+
+void SocketPoller::add(sf::Socket& socket, uint32_t token)
+{
+#ifdef DREADMYST_HAVE_IO_URING
+    if (m_backend == Backend::IoUring)
+    {
+        m_listenerHandle = getNativeHandle(socket);
+        m_listenerToken = token;
+        armListener();
+        return;
+    }
+#endif
+
+#ifdef __linux__
+    if (m_backend == Backend::Epoll)
+    {
+        // Level-triggered: SfSocket reads one chunk per wake-up and relies
+        // on being woken again while more is buffered
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u32 = token;
+        if (::epoll_ctl(m_epollHandle, EPOLL_CTL_ADD, getNativeHandle(socket), &event) != 0)
+            LOG_WARN("SocketPoller: epoll_ctl add failed for token %u (errno %d)", token, errno);
+        return;
+    }
+#endif
+
+    m_selector.add(socket);
+    m_selectTokens[&socket] = token;
+}
+
+void SocketPoller::remove(sf::Socket& socket)
+{
+#ifdef DREADMYST_HAVE_IO_URING
+    if (m_backend == Backend::IoUring)
+    {
+        if (m_listenerHandle >= 0)
+            cancel(ringTag(RingOp::Listener, m_listenerToken));
+        m_listenerHandle = -1;
+        m_ring.submit();
+        return;
+    }
+#endif
+
+#ifdef __linux__
+    if (m_backend == Backend::Epoll)
+    {
+        // A socket already closed has left the epoll set with its handle
+        int handle = getNativeHandle(socket);
+        if (handle >= 0)
+            ::epoll_ctl(m_epollHandle, EPOLL_CTL_DEL, handle, nullptr);
+        return;
+    }
+#endif
+
+    m_selector.remove(socket);
+    m_selectTokens.erase(&socket);
+}
+
+void SocketPoller::add(SfSocket& socket, uint32_t token)
+{
+#ifdef DREADMYST_HAVE_IO_URING
+    if (m_backend == Backend::IoUring)
+    {
+        RingSocket& ring = m_ringSockets[token];
+        ring.socket = &socket;
+        ring.handle = getNativeHandle(*socket.getSocket());
+        m_ringTokens[&socket] = token;
+        socket.setTransport(this);
+        armReceive(token, ring);
+        return;
+    }
+#endif
+
+    add(*socket.getSocket(), token);
+}
+
+void SocketPoller::remove(SfSocket& socket)
+{
+#ifdef DREADMYST_HAVE_IO_URING
+    if (m_backend == Backend::IoUring)
+    {
+        release(socket);  // Already done if the socket was disconnected
+        return;
+    }
+#endif
+
+    remove(*socket.getSocket());
+}
+
+void SocketPoller::addHandle(int handle, uint32_t token)
+{
+#ifdef DREADMYST_HAVE_IO_URING
+    if (m_backend == Backend::IoUring)
+    {
+        m_ringHandles[token] = handle;
+        armHandle(token, handle);
+        return;
+    }
+#endif
+
+#ifdef __linux__
+    if (m_backend == Backend::Epoll)
+    {
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u32 = token;
+        if (::epoll_ctl(m_epollHandle, EPOLL_CTL_ADD, handle, &event) != 0)
+            LOG_WARN("SocketPoller: epoll_ctl add failed for token %u (errno %d)", token, errno);
+        return;
+    }
+#endif
+
+    m_selectHandles.emplace_back(handle, token);
+}
+
+void SocketPoller::removeHandle(int handle)
+{
+#ifdef DREADMYST_HAVE_IO_URING
+    if (m_backend == Backend::IoUring)
+    {
+        for (auto it = m_ringHandles.begin(); it != m_ringHandles.end(); ++it)
+        {
+            if (it->second == handle)
+            {
+                cancel(ringTag(RingOp::Handle, it->first));
+                m_ringHandles.erase(it);
+                m_ring.submit();
+                break;
+            }
+        }
+        return;
+    }
+#endif
+
+#ifdef __linux__
+    if (m_backend == Backend::Epoll)
+    {
+        ::epoll_ctl(m_epollHandle, EPOLL_CTL_DEL, handle, nullptr);
+        return;
+    }
+#endif
+
+    m_selectHandles.erase(std::remove_if(m_selectHandles.begin(), m_selectHandles.end(),
+                                         [handle](const auto& entry) { return entry.first == handle; }),
+                          m_selectHandles.end());
+}
+
+// ============================================================================
+// Waiting
+// ============================================================================
+
+bool SocketPoller::wait(int timeoutMs, std::vector<uint32_t>& ready)
+{
+#ifdef DREADMYST_HAVE_IO_URING
+    if (m_backend == Backend::IoUring)
+    {
+        size_t first = ready.size();
+        if (!m_carriedReady.empty())
+        {
+            ready.insert(ready.end(), m_carriedReady.begin(), m_carriedReady.end());
+            m_carriedReady.clear();
+            timeoutMs = 0;
+        }
+
+        m_ring.submitAndWait(timeoutMs);
+        reapCompletions(ready);
+
+        // One entry per socket, however many completions it had
+        std::sort(ready.begin() + first, ready.end());
+        ready.erase(std::unique(ready.begin() + first, ready.end()), ready.end());
+        return ready.size() > first;
+    }
+#endif
+
+#ifdef __linux__
+    if (m_backend == Backend::Epoll)
+    {
+        auto* events = reinterpret_cast<epoll_event*>(m_events.data());
+        int count = ::epoll_wait(m_epollHandle, events, SocketPollerConfig::MAX_EVENTS, timeoutMs);
+        if (count <= 0)
+            return false;  // Timeout, or EINTR from a signal
+
+        for (int i = 0; i < count; ++i)
+            ready.push_back(events[i].data.u32);
+        return true;
+    }
+#endif
+
+    size_t first = ready.size();
+    if (m_selector.wait(sf::milliseconds(timeoutMs)))
+    {
+        for (const auto& [socket, token] : m_selectTokens)
+        {
+            if (m_selector.isReady(*socket))
+                ready.push_back(token);
+        }
+    }
+
+#ifndef _WIN32
+    if (!m_selectHandles.empty())
+    {
+        std::vector<pollfd> entries;
+        entries.reserve(m_selectHandles.size());
+        for (const auto& [handle, token] : m_selectHandles)
+            entries.push_back({handle, POLLIN, 0});
+
+        if (::poll(entries.data(), entries.size(), 0) > 0)
+        {
+            for (size_t i = 0; i < entries.size(); ++i)
+            {
+                if (entries[i].revents != 0)
+                    ready.push_back(m_selectHandles[i].second);
+            }
+        }
+    }
+#endif
+    return ready.size() > first;
+}
+
+void SocketPoller::submit()
+{
+#ifdef DREADMYST_HAVE_IO_URING
+    if (m_backend == Backend::IoUring)
+        m_ring.submit();
+#endif
+}
+
+// ============================================================================
+// io_uring Backend
+// ============================================================================
+
+#ifdef DREADMYST_HAVE_IO_URING
+
+bool SocketPoller::setupRing()
+{
+    using namespace SocketPollerConfig;
+
+    if (!m_ring.setup(RING_ENTRIES) ||
+        !m_ring.registerBufferRing(RECV_BUFFER_GROUP, RECV_BUFFER_COUNT, RECV_BUFFER_SIZE))
+        return false;
+
+    m_sendArena = m_ring.registerFixedBuffer(static_cast<size_t>(SEND_SLOT_COUNT) * SEND_SLOT_SIZE);
+    if (!m_sendArena)
+        return false;
+
+    m_sendSlots.resize(SEND_SLOT_COUNT);
+    for (uint32_t slot = SEND_SLOT_COUNT; slot > 0; --slot)
+        m_freeSendSlots.push_back(slot - 1);
+
+    // Fixed-buffer writes can't pass MSG_NOSIGNAL; a write to a reset
+    // connection has to fail with EPIPE rather than kill the server
+    std::signal(SIGPIPE, SIG_IGN);
+    return true;
+}
+
+void SocketPoller::cancel(uint64_t userData)
+{
+    io_uring_sqe* sqe = m_ring.getSqe();
+    if (!sqe)
+    {
+        m_ring.submit();
+        sqe = m_ring.getSqe();
+        if (!sqe)
+            return;
+    }
+
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = userData;
+    sqe->user_data = ringTag(RingOp::Cancel, 0);
+}
+
+void SocketPoller::armListener()
+{
+    if (!m_ring.reserve(1))
+        return;
+
+    // One-shot, re-armed after each completion: acceptPending() takes at
+    // most MAX_ACCEPTS_PER_POLL connections and relies on being woken
+    // again while the backlog is not empty, which multishot poll (edge
+    // triggered) would not do
+    io_uring_sqe* sqe = m_ring.getSqe();
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = m_listenerHandle;
+    sqe->poll32_events = POLLIN;
+    sqe->user_data = ringTag(RingOp::Listener, m_listenerToken);
+}
+
+void SocketPoller::armHandle(uint32_t token, int handle)
+{
+    if (!m_ring.reserve(1))
+        return;
+
+    // One-shot like the listener: level semantics for readers that stop
+    // before draining the descriptor
+    io_uring_sqe* sqe = m_ring.getSqe();
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = handle;
+    sqe->poll32_events = POLLIN | POLLRDHUP;
+    sqe->user_data = ringTag(RingOp::Handle, token);
+}
+
+void SocketPoller::armReceive(uint32_t token, RingSocket& ring)
+{
+    if (!m_ring.reserve(1))
+        return;
+
+    // The kernel picks a provided buffer per completion and keeps the
+    // receive armed until the buffers run out or the connection ends
+    io_uring_sqe* sqe = m_ring.getSqe();
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = ring.handle;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = RECV_BUFFER_GROUP;
+    sqe->user_data = ringTag(RingOp::Receive, token);
+    ring.receiving = true;
+}
+
+bool SocketPoller::submitSend(SfSocket& socket)
+{
+    using namespace SocketPollerConfig;
+
+    auto tokenIt = m_ringTokens.find(&socket);
+    if (tokenIt == m_ringTokens.end())
+        return false;
+
+    uint32_t token = tokenIt->second;
+    RingSocket& ring = m_ringSockets[token];
+    if (ring.closed)
+        return false;
+
+    // One chain per socket at a time keeps the bytes in order; whatever
+    // is queued meanwhile goes with the next flush after it completes
+    if (ring.sendsInFlight > 0 || m_paused)
+        return true;
+
+    size_t pending = socket.getPendingSendSize();
+    size_t slots = std::min<size_t>({(pending + SEND_SLOT_SIZE - 1) / SEND_SLOT_SIZE,
+                                     MAX_LINKED_SENDS, m_freeSendSlots.size()});
+    if (slots == 0 || !m_ring.reserve(static_cast<unsigned>(slots)))
+        return true;  // Out of slots; retried on the next flush
+
+    // Linked, so each write starts only after the previous one finished
+    // in full; a short write cancels the rest, which stays queued
+    const uint8_t* data = socket.getPendingSendData();
+    size_t offset = 0;
+    for (size_t i = 0; i < slots; ++i)
+    {
+        uint32_t slot = m_freeSendSlots.back();
+        m_freeSendSlots.pop_back();
+
+        size_t length = std::min<size_t>(SEND_SLOT_SIZE, pending - offset);
+        uint8_t* buffer = m_sendArena + static_cast<size_t>(slot) * SEND_SLOT_SIZE;
+        std::memcpy(buffer, data + offset, length);
+        offset += length;
+
+        io_uring_sqe* sqe = m_ring.getSqe();
+        sqe->opcode = IORING_OP_WRITE_FIXED;
+        sqe->fd = ring.handle;
+        sqe->addr = reinterpret_cast<uint64_t>(buffer);
+        sqe->len = static_cast<uint32_t>(length);
+        sqe->buf_index = 0;
+        sqe->user_data = ringTag(RingOp::Send, slot);
+        if (i + 1 < slots)
+            sqe->flags = IOSQE_IO_LINK;
+
+        m_sendSlots[slot] = SendSlot{token, static_cast<uint32_t>(length), true};
+    }
+
+    ring.sendsInFlight = static_cast<uint32_t>(slots);
+    return true;
+}
+
+void SocketPoller::release(SfSocket& socket)
+{
+    auto tokenIt = m_ringTokens.find(&socket);
+    if (tokenIt == m_ringTokens.end())
+        return;
+
+    uint32_t token = tokenIt->second;
+    RingSocket& ring = m_ringSockets[token];
+    if (ring.receiving)
+        cancel(ringTag(RingOp::Receive, token));
+
+    // Writes already in the kernel go out ahead of the close; anything
+    // queued behind them would arrive out of order if written directly
+    if (ring.sendsInFlight > 0)
+        socket.markSent(socket.getPendingSendSize());
+
+    socket.setTransport(nullptr);
+    m_ringSockets.erase(token);
+    m_ringTokens.erase(tokenIt);
+
+    // The caller closes the handle next; queued entries name it by number
+    m_ring.submit();
+}
+
+void SocketPoller::reapCompletions(std::vector<uint32_t>& ready)
+{
+    m_ring.forEachCompletion([&](const io_uring_cqe& cqe) {
+        auto op = static_cast<RingOp>(cqe.user_data >> 32);
+        uint32_t id = static_cast<uint32_t>(cqe.user_data);
+
+        switch (op)
+        {
+            case RingOp::Listener:
+                if (m_listenerHandle < 0)
+                    break;
+                if (cqe.res > 0)
+                    ready.push_back(m_listenerToken);
+                if (!(cqe.flags & IORING_CQE_F_MORE))
+                    armListener();
+                break;
+
+            case RingOp::Handle:
+            {
+                auto it = m_ringHandles.find(id);
+                if (it == m_ringHandles.end())
+                    break;
+                // An error is reported too; the owner finds it on read
+                ready.push_back(id);
+                if (cqe.res > 0)
+                    armHandle(id, it->second);
+                break;
+            }
+
+            case RingOp::Receive:
+                onReceive(id, cqe, ready);
+                break;
+
+            case RingOp::Send:
+                onSend(id, cqe, ready);
+                break;
+
+            case RingOp::Cancel:
+                break;
+        }
+    });
+
+    m_ring.publishProvided();
+}
+
+void SocketPoller::onReceive(uint32_t token, const io_uring_cqe& cqe, std::vector<uint32_t>& ready)
+{
+    bool hasBuffer = (cqe.flags & IORING_CQE_F_BUFFER) != 0;
+    auto bufferId = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+
+    auto it = m_ringSockets.find(token);
+    if (it == m_ringSockets.end())
+    {
+        if (hasBuffer)
+            m_ring.recycleProvided(bufferId);
+        return;
+    }
+
+    RingSocket& ring = it->second;
+    if (!(cqe.flags & IORING_CQE_F_MORE))
+        ring.receiving = false;
+
+    if (cqe.res > 0 && hasBuffer)
+    {
+        ring.socket->deliverReceived(m_ring.providedBuffer(bufferId), static_cast<size_t>(cqe.res));
+        ready.push_back(token);
+    }
+    else if (cqe.res == 0 || (cqe.res < 0 && cqe.res != -ENOBUFS && cqe.res != -ECANCELED))
+    {
+        ring.closed = true;
+        ring.socket->deliverClosed();
+        ready.push_back(token);
+    }
+
+    if (hasBuffer)
+        m_ring.recycleProvided(bufferId);
+
+    // Ran out of buffers (or the kernel ended it): re-arm; the buffers
+    // recycled above are published before the next submission
+    if (!ring.receiving && !ring.closed && !m_paused)
+        armReceive(token, ring);
+}
+
+void SocketPoller::onSend(uint32_t slot, const io_uring_cqe& cqe, std::vector<uint32_t>& ready)
+{
+    SendSlot& sent = m_sendSlots[slot];
+    sent.busy = false;
+    m_freeSendSlots.push_back(slot);
+
+    auto it = m_ringSockets.find(sent.token);
+    if (it == m_ringSockets.end())
+        return;
+
+    RingSocket& ring = it->second;
+    --ring.sendsInFlight;
+
+    // Completions of a chain arrive in order, so this is the front
+    if (cqe.res > 0)
+        ring.socket->markSent(static_cast<size_t>(cqe.res));
+    else if (cqe.res < 0 && cqe.res != -ECANCELED && cqe.res != -EAGAIN && !ring.closed)
+    {
+        ring.closed = true;
+        ring.socket->deliverClosed();
+        ready.push_back(sent.token);
+    }
+}
+
+#else
+
+bool SocketPoller::submitSend(SfSocket&) { return false; }
+void SocketPoller::release(SfSocket&) {}
+
+#endif // DREADMYST_HAVE_IO_URING
+
+// ============================================================================
+// Hot Upgrade
+// ============================================================================
+
+void SocketPoller::pause()
+{
+#ifdef DREADMYST_HAVE_IO_URING
+    if (m_backend != Backend::IoUring)
+        return;
+
+    m_paused = true;
+    for (const auto& [token, ring] : m_ringSockets)
+    {
+        if (ring.receiving)
+            cancel(ringTag(RingOp::Receive, token));
+    }
+    for (uint32_t slot = 0; slot < m_sendSlots.size(); ++slot)
+    {
+        if (m_sendSlots[slot].busy)
+            cancel(ringTag(RingOp::Send, slot));
+    }
+
+    // Bytes taken before the cancels land in the SfSocket buffers; writes
+    // cancelled before they ran stay queued there
+    auto busy = [this]() {
+        for (const auto& [token, ring] : m_ringSockets)
+        {
+            if (ring.receiving || ring.sendsInFlight > 0)
+                return true;
+        }
+        return false;
+    };
+
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(SocketPollerConfig::PAUSE_TIMEOUT_MS);
+    while (busy() && std::chrono::steady_clock::now() < deadline)
+    {
+        m_ring.submitAndWait(10);
+        reapCompletions(m_carriedReady);
+    }
+
+    if (busy())
+        LOG_WARN("SocketPoller: io_uring still busy after %d ms", SocketPollerConfig::PAUSE_TIMEOUT_MS);
+#endif
+}
+
+void SocketPoller::resume()
+{
+#ifdef DREADMYST_HAVE_IO_URING
+    if (m_backend != Backend::IoUring || !m_paused)
+        return;
+
+    m_paused = false;
+    for (auto& [token, ring] : m_ringSockets)
+    {
+        if (!ring.receiving && !ring.closed)
+            armReceive(token, ring);
+    }
+    m_ring.submit();
+#endif
+}
@@ -0,0 +1,181 @@
+// SocketPoller - Readiness notification for the listener and session sockets
+//
+// Sockets are registered with a token (session ID, or LISTENER_TOKEN) and
+// wait() reports the tokens of readable sockets, so the network loop only
+// touches sessions that actually have data instead of testing every socket
+// after each wake-up.
+//
+// Backends:
+//   io_uring - Linux 6.0+; the ring does the I/O itself. Each session has
+//              a multishot receive into a shared provided-buffer ring, and
+//              SfSocket::flush() copies the backlog into registered send
+//              slots as a chain of linked writes; submit() hands every
+//              session's chain to the kernel in one system call, usually
+//              together with the next wait.
+//   epoll    - Linux; cost per wait scales with ready sockets, not registered
+//   select   - sf::SocketSelector; portable fallback (FD_SETSIZE-limited on
+//              most platforms)
+
+#pragma once
+
+#include "SfSocket.h"
+#include "Network/IoUring.h"
+#include <SFML/Network/SocketSelector.hpp>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sf { class Socket; }
+
+// ============================================================================
+// Poller Configuration
+// ============================================================================
+
+namespace SocketPollerConfig
+{
+    // Session IDs start at 1, so 0 is free for the listener
+    constexpr uint32_t LISTENER_TOKEN = 0;
+
+    // Events fetched per epoll_wait; more are picked up by the next wait
+    constexpr int MAX_EVENTS = 512;
+
+    // io_uring submission queue entries (completion queue gets 4x)
+    constexpr unsigned RING_ENTRIES = 1024;
+
+    // Provided receive buffers shared by all sessions (count a power of
+    // two); a buffer goes back to the ring as soon as it is copied out
+    constexpr unsigned RECV_BUFFER_COUNT = 1024;
+    constexpr unsigned RECV_BUFFER_SIZE = 4096;
+
+    // Registered send slots shared by all sessions (16 MiB locked)
+    constexpr unsigned SEND_SLOT_COUNT = 1024;
+    constexpr unsigned SEND_SLOT_SIZE = 16384;
+
+    // Slots one flush may chain for a session; the rest follows once the
+    // chain completes
+    constexpr unsigned MAX_LINKED_SENDS = 8;
+
+    // How long pause() waits for the ring to let go of the sockets
+    constexpr int PAUSE_TIMEOUT_MS = 1000;
+}
+
+// ============================================================================
+// SocketPoller
+// ============================================================================
+
+class SocketPoller : private SfSocketTransport
+{
+public:
+    enum class Backend
+    {
+        Select,
+        Epoll,
+        IoUring
+    };
+
+    // Falls back to Epoll, then Select, when the requested backend is
+    // unavailable
+    explicit SocketPoller(Backend requested);
+    ~SocketPoller();
+
+    SocketPoller(const SocketPoller&) = delete;
+    SocketPoller& operator=(const SocketPoller&) = delete;
+
+    Backend getBackend() const { return m_backend; }
+
+    // The listener
+    void add(sf::Socket& socket, uint32_t token);
+    void remove(sf::Socket& socket);
+
+    // Session sockets. Under io_uring the ring reads and writes them from
+    // here on (SfSocket::receive/flush go through the poller); the other
+    // backends register the underlying socket.
+    void add(SfSocket& socket, uint32_t token);
+    void remove(SfSocket& socket);
+
+    // Other descriptors reported on readability, such as the Unix sockets
+    // between gateway and world processes (ShardLink). The select backend
+    // checks them once per wait, after the selector wakes or times out.
+    void addHandle(int handle, uint32_t token);
+    void removeHandle(int handle);
+
+    // Wait up to timeoutMs for activity; appends the tokens of readable
+    // sockets to `ready` and returns false on timeout. Under io_uring the
+    // bytes have already been delivered to the SfSocket.
+    bool wait(int timeoutMs, std::vector<uint32_t>& ready);
+
+    // Hand the writes queued by SfSocket::flush() to the kernel in one
+    // system call (io_uring only)
+    void submit();
+
+    // Stop the ring taking bytes from session sockets and wait until it
+    // holds none, so socket buffers are complete for a hot upgrade
+    // snapshot; resume() re-arms if the handoff fails (io_uring only)
+    void pause();
+    void resume();
+
+    // "io_uring" / "epoll" / "select"; unknown names map to the platform
+    // default
+    static Backend backendFromString(const std::string& name);
+    static const char* backendToString(Backend backend);
+
+    // Native handle of an SFML socket (SFML only exposes it to subclasses)
+    static int getNativeHandle(const sf::Socket& socket);
+
+private:
+    // SfSocketTransport (io_uring)
+    bool submitSend(SfSocket& socket) override;
+    void release(SfSocket& socket) override;
+
+    Backend m_backend = Backend::Select;
+
+#ifdef DREADMYST_HAVE_IO_URING
+    struct RingSocket
+    {
+        SfSocket* socket = nullptr;
+        int handle = -1;
+        bool receiving = false;      // Multishot receive armed
+        bool closed = false;         // Peer closed, or the socket failed
+        uint32_t sendsInFlight = 0;  // Linked writes not yet completed
+    };
+
+    struct SendSlot
+    {
+        uint32_t token = 0;
+        uint32_t length = 0;
+        bool busy = false;
+    };
+
+    bool setupRing();
+    void armListener();
+    void armHandle(uint32_t token, int handle);
+    void armReceive(uint32_t token, RingSocket& ring);
+    void cancel(uint64_t userData);
+    void reapCompletions(std::vector<uint32_t>& ready);
+    void onReceive(uint32_t token, const io_uring_cqe& cqe, std::vector<uint32_t>& ready);
+    void onSend(uint32_t slot, const io_uring_cqe& cqe, std::vector<uint32_t>& ready);
+
+    // io_uring backend
+    IoUring m_ring;
+    std::unordered_map<uint32_t, RingSocket> m_ringSockets;
+    std::unordered_map<SfSocket*, uint32_t> m_ringTokens;
+    uint8_t* m_sendArena = nullptr;  // SEND_SLOT_COUNT slots, registered
+    std::vector<SendSlot> m_sendSlots;
+    std::vector<uint32_t> m_freeSendSlots;
+    int m_listenerHandle = -1;
+    uint32_t m_listenerToken = 0;
+    std::unordered_map<uint32_t, int> m_ringHandles;  // addHandle(), by token
+    std::vector<uint32_t> m_carriedReady;  // Reported while paused
+    bool m_paused = false;
+#endif
+
+    // Epoll backend
+    int m_epollHandle = -1;
+    std::vector<uint8_t> m_events;  // Raw epoll_event storage
+
+    // Select backend
+    sf::SocketSelector m_selector;
+    std::unordered_map<sf::Socket*, uint32_t> m_selectTokens;
+    std::vector<std::pair<int, uint32_t>> m_selectHandles;  // addHandle()
+};
@@ -0,0 +1,386 @@
+// WorldShard - World process of the multi-process server (--world N)
+
+#include "stdafx.h"
+#include "Network/WorldShard.h"
+#include "Network/Session.h"
+#include "Network/SessionManager.h"
+#include "Network/SocketPoller.h"
+#include "Network/PacketRouter.h"
+#include "Handlers/WorldHandlers.h"
+#include "Database/CharacterDb.h"
+#include "Systems/ChatSystem.h"
+#include "World/Player.h"
+#include "Core/Logger.h"
+#include "GamePacketClient.h"
+#include "StlBuffer.h"
+
+#include <thread>
+
+namespace
+{
+// How long disconnect() keeps writing what is queued for the gateway
+constexpr int DISCONNECT_FLUSH_TIMEOUT_MS = 1000;
+} // namespace
+
+void RelaySink::sendPacket(const StlBuffer& data)
+{
+    sWorldShard.relay(m_gatewaySessionId, data);
+}
+
+WorldShard& WorldShard::instance()
+{
+    static WorldShard instance;
+    return instance;
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+bool WorldShard::connect(const std::string& socketPath, uint32_t worldId, const std::string& mapSpec,
+                         SocketPoller& poller)
+{
+    if (!m_maps.parse(mapSpec))
+        return false;
+
+    int handle = ShardLink::connect(socketPath, ShardConfig::CONNECT_TIMEOUT_MS);
+    if (handle < 0)
+    {
+        LOG_ERROR("WorldShard: cannot reach the gateway at %s (errno %d)", socketPath.c_str(), errno);
+        return false;
+    }
+
+    m_link = std::make_unique<ShardLink>(handle);
+    m_worldId = worldId;
+
+    StlBuffer hello;
+    hello << worldId;
+    m_link->send(ShardMessage::Hello, hello);
+    if (!m_link->flush())
+    {
+        LOG_ERROR("WorldShard: gateway closed the link");
+        m_link.reset();
+        return false;
+    }
+
+    poller.addHandle(handle, ShardConfig::LINK_TOKEN_BASE + worldId);
+    LOG_INFO("WorldShard: world %u connected to the gateway at %s", worldId, socketPath.c_str());
+    return true;
+}
+
+void WorldShard::disconnect(SocketPoller& poller)
+{
+    if (!m_link)
+        return;
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(DISCONNECT_FLUSH_TIMEOUT_MS);
+    while (m_link->flush() && m_link->hasPendingSend() && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    if (!m_linkLost)
+        poller.removeHandle(m_link->getHandle());
+    m_link.reset();
+}
+
+void WorldShard::onReadable(SocketPoller& poller)
+{
+    if (!m_link || m_linkLost)
+        return;
+
+    std::vector<ShardFrame> frames;
+    bool open = m_link->receive(frames);
+    for (const ShardFrame& frame : frames)
+        onFrame(frame);
+
+    if (!open)
+    {
+        LOG_ERROR("WorldShard: lost the gateway");
+        poller.removeHandle(m_link->getHandle());
+        m_linkLost = true;
+    }
+}
+
+void WorldShard::flush()
+{
+    if (!m_link)
+        return;
+
+    processTransfers();
+    if (!m_linkLost && !m_link->flush())
+        LOG_WARN("WorldShard: write to the gateway failed");
+}
+
+// ============================================================================
+// Relayed Sessions
+// ============================================================================
+
+void WorldShard::relay(uint32_t gatewaySessionId, const StlBuffer& packet)
+{
+    if (!m_link || packet.size() < sizeof(uint16_t))
+        return;
+
+    const uint8_t* bytes = packet.data();
+    uint16_t opcode = static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+    m_link->sendPacket(ShardMessage::ServerPacket, gatewaySessionId, opcode,
+                       bytes + sizeof(uint16_t), packet.size() - sizeof(uint16_t));
+}
+
+void WorldShard::kick(Session& session, const std::string& reason)
+{
+    RelaySink* relay = session.getRelay();
+    if (!relay || !m_link)
+        return;
+
+    auto it = m_sessions.find(relay->getGatewaySessionId());
+    if (it == m_sessions.end() || it->second != session.getId())
+        return;
+    m_sessions.erase(it);
+
+    StlBuffer body;
+    body << relay->getGatewaySessionId() << reason;
+    m_link->send(ShardMessage::Kick, body);
+
+    // No socket to linger on
+    sSessionManager.queueRemoval(session.getId());
+}
+
+uint32_t WorldShard::getGatewaySessionId(Player& player) const
+{
+    auto* session = dynamic_cast<Session*>(&player.getSink());
+    RelaySink* relay = session ? session->getRelay() : nullptr;
+    return relay ? relay->getGatewaySessionId() : 0;
+}
+
+void WorldShard::onFrame(const ShardFrame& frame)
+{
+    switch (frame.type)
+    {
+        case ShardMessage::ClientPacket:
+            onClientPacket(frame);
+            return;
+
+        case ShardMessage::Enter:
+        {
+            StlBuffer body = frameBody(frame);
+            onEnter(body);
+            return;
+        }
+
+        case ShardMessage::Leave:
+        {
+            StlBuffer body = frameBody(frame);
+            onLeave(body);
+            return;
+        }
+
+        case ShardMessage::Chat:
+        {
+            StlBuffer body = frameBody(frame);
+            onChat(body);
+            return;
+        }
+
+        default:
+            LOG_WARN("WorldShard: unexpected message %u from the gateway", static_cast<uint32_t>(frame.type));
+            return;
+    }
+}
+
+void WorldShard::onEnter(StlBuffer& body)
+{
+    ShardHandoff record;
+    if (!record.read(body))
+    {
+        LOG_WARN("WorldShard: truncated handoff record");
+        return;
+    }
+
+    if (m_sessions.count(record.sessionId))
+    {
+        LOG_WARN("WorldShard: gateway session %u is already here", record.sessionId);
+        return;
+    }
+
+    Session* session = sSessionManager.createSession(0);
+    session->setRelay(std::make_unique<RelaySink>(record.sessionId));
+    session->setAuthenticated(record.accountId, record.username, record.isGm);
+    m_sessions[record.sessionId] = session->getId();
+
+    // The regular entry path loads the character from the database, where
+    // the gateway or the previous world left it
+    GP_Client_EnterWorld enter;
+    enter.m_characterGuid = record.characterGuid;
+
+    StlBuffer buf;
+    enter.pack(buf);
+    Handlers::handleEnterWorld(*session, buf);
+
+    if (!session->getPlayer())
+        session->initiateDisconnect("Could not enter the world");
+}
+
+void WorldShard::onLeave(StlBuffer& body)
+{
+    uint32_t gatewaySessionId = 0;
+    uint32_t characterGuid = 0;
+    body >> gatewaySessionId >> characterGuid;
+
+    auto it = m_sessions.find(gatewaySessionId);
+    if (it != m_sessions.end())
+    {
+        uint32_t sessionId = it->second;
+        m_sessions.erase(it);
+
+        // Saves the character before the Left below
+        if (Session* session = sSessionManager.getSession(sessionId))
+            session->initiateDisconnect("Client left");
+        sSessionManager.queueRemoval(sessionId);
+    }
+
+    // Also sent when the character had already been handed on; it was
+    // saved before the Transfer
+    StlBuffer left;
+    left << characterGuid;
+    m_link->send(ShardMessage::Left, left);
+}
+
+void WorldShard::onClientPacket(const ShardFrame& frame)
+{
+    if (frame.body.size() < sizeof(uint32_t) + sizeof(uint16_t))
+        return;
+
+    const uint8_t* bytes = frame.body.data();
+    uint32_t gatewaySessionId = static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+                                (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+    uint16_t opcode = static_cast<uint16_t>(bytes[4] | (bytes[5] << 8));
+
+    // Packets still in flight for a character that has moved on are dropped
+    auto it = m_sessions.find(gatewaySessionId);
+    if (it == m_sessions.end())
+        return;
+    Session* session = sSessionManager.getSession(it->second);
+    if (!session)
+        return;
+
+    constexpr size_t HEAD_BYTES = sizeof(uint32_t) + sizeof(uint16_t);
+    StlBuffer payload;
+    payload.write(reinterpret_cast<const char*>(bytes) + HEAD_BYTES, frame.body.size() - HEAD_BYTES);
+    sPacketRouter.dispatch(*session, opcode, payload);
+}
+
+// ============================================================================
+// Transfers
+// ============================================================================
+
+void WorldShard::queueTransfer(Player& player, int32_t mapId, float x, float y, float orientation)
+{
+    auto* session = dynamic_cast<Session*>(&player.getSink());
+    if (!session || !session->isRelayed())
+        return;
+
+    // A later move before the handoff replaces the earlier one
+    PendingTransfer transfer{session->getId(), player.getGuid(), mapId, x, y, orientation};
+    for (PendingTransfer& pending : m_transfers)
+    {
+        if (pending.sessionId == transfer.sessionId)
+        {
+            pending = transfer;
+            return;
+        }
+    }
+    m_transfers.push_back(transfer);
+}
+
+void WorldShard::processTransfers()
+{
+    std::vector<PendingTransfer> transfers;
+    transfers.swap(m_transfers);
+
+    for (const PendingTransfer& transfer : transfers)
+    {
+        Session* session = sSessionManager.getSession(transfer.sessionId);
+        Player* player = session ? session->getPlayer() : nullptr;
+        if (!player || player->getGuid() != transfer.characterGuid)
+            continue;
+
+        uint32_t gatewaySessionId = session->getRelay()->getGatewaySessionId();
+        auto it = m_sessions.find(gatewaySessionId);
+        if (it == m_sessions.end() || it->second != session->getId())
+            continue;
+
+        ShardHandoff record;
+        record.sessionId = gatewaySessionId;
+        record.accountId = session->getAccountId();
+        record.username = session->getUsername();
+        record.isGm = session->isGm();
+        record.characterGuid = transfer.characterGuid;
+        record.characterName = player->getName();
+        record.mapId = transfer.mapId;
+
+        // Off this world (party and trade end, as on logout) and saved
+        // where it stands, then placed on the new map for the next world
+        m_sessions.erase(it);
+        session->initiateDisconnect("Moving to another world");
+        CharacterDb::updatePosition(static_cast<int32_t>(transfer.characterGuid), transfer.mapId,
+                                    transfer.x, transfer.y, transfer.orientation);
+        sSessionManager.queueRemoval(transfer.sessionId);
+
+        StlBuffer body;
+        record.write(body);
+        m_link->send(ShardMessage::Transfer, body);
+
+        LOG_INFO("WorldShard: '%s' handed to the gateway for map %d (world %u)",
+                 record.characterName.c_str(), transfer.mapId, m_maps.getOwner(transfer.mapId));
+    }
+}
+
+// ============================================================================
+// Chat
+// ============================================================================
+
+void WorldShard::relayWhisper(Player& sender, const std::string& targetName, const std::string& message)
+{
+    ShardChat chat;
+    chat.senderSessionId = getGatewaySessionId(sender);
+    chat.channel = static_cast<uint8_t>(ChatDefines::Channels::Whisper);
+    chat.senderGuid = sender.getGuid();
+    chat.senderName = sender.getName();
+    chat.targetName = targetName;
+    chat.message = message;
+
+    StlBuffer body;
+    chat.write(body);
+    m_link->send(ShardMessage::Chat, body);
+}
+
+void WorldShard::relayAllChat(Player& sender, const std::string& message)
+{
+    ShardChat chat;
+    chat.senderSessionId = getGatewaySessionId(sender);
+    chat.channel = static_cast<uint8_t>(ChatDefines::Channels::AllChat);
+    chat.senderGuid = sender.getGuid();
+    chat.senderName = sender.getName();
+    chat.message = message;
+
+    StlBuffer body;
+    chat.write(body);
+    m_link->send(ShardMessage::Chat, body);
+}
+
+void WorldShard::onChat(StlBuffer& body)
+{
+    ShardChat chat;
+    if (!chat.read(body))
+        return;
+
+    if (chat.channel == static_cast<uint8_t>(ChatDefines::Channels::Whisper))
+    {
+        RelaySink reply(chat.senderSessionId);
+        sChatManager.deliverRemoteWhisper(reply, chat.senderGuid, chat.senderName,
+                                          chat.targetName, chat.message);
+    }
+    else if (chat.channel == static_cast<uint8_t>(ChatDefines::Channels::AllChat))
+    {
+        sChatManager.deliverRemoteAllChat(chat.senderGuid, chat.senderName, chat.message);
+    }
+}
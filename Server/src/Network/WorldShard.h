@@ -0,0 +1,113 @@
+// WorldShard - World process of the multi-process server (--world N)
+//
+// Connects to the gateway's Unix socket and hosts the characters the
+// gateway hands over (see ShardLink.h). Each one gets a Session without a
+// socket whose outbound packets go back over the link (RelaySink), and
+// the client packets the gateway forwards are dispatched through
+// PacketRouter as usual. Only the maps this world owns are preloaded; a
+// character moving to a map another world owns is saved there and handed
+// back to the gateway, which passes it on.
+
+#pragma once
+
+#include "Network/PacketSink.h"
+#include "Network/ShardLink.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Player;
+class Session;
+class SocketPoller;
+
+// PacketSink of a relayed session: packets reach the client through the
+// gateway
+class RelaySink : public PacketSink
+{
+public:
+    explicit RelaySink(uint32_t gatewaySessionId) : m_gatewaySessionId(gatewaySessionId) {}
+
+    void sendPacket(const StlBuffer& data) override;
+    uint32_t getGatewaySessionId() const { return m_gatewaySessionId; }
+
+private:
+    uint32_t m_gatewaySessionId;
+};
+
+class WorldShard
+{
+public:
+    static WorldShard& instance();
+
+    // Connect to the gateway as world `worldId` (retries while it starts);
+    // maps are assigned by `mapSpec` (see ShardMapTable)
+    bool connect(const std::string& socketPath, uint32_t worldId, const std::string& mapSpec,
+                 SocketPoller& poller);
+    bool isActive() const { return m_link != nullptr; }
+
+    // Write what is still queued and close the link (on shutdown)
+    void disconnect(SocketPoller& poller);
+
+    uint32_t getWorldId() const { return m_worldId; }
+    bool ownsMap(int32_t mapId) const { return m_maps.getOwner(mapId) == m_worldId; }
+    std::vector<int32_t> getOwnedMaps() const { return m_maps.getMaps(m_worldId); }
+
+    // Poller token of the gateway link
+    bool ownsToken(uint32_t token) const { return isActive() && token == ShardConfig::LINK_TOKEN_BASE + m_worldId; }
+    void onReadable(SocketPoller& poller);
+
+    // The gateway went away; nobody can reach this world any more
+    bool isLinkLost() const { return m_linkLost; }
+
+    // Packet for a relayed session's client
+    void relay(uint32_t gatewaySessionId, const StlBuffer& packet);
+
+    // A relayed session disconnected here (kick, shutdown): the gateway
+    // drops the client. No-op when the gateway asked for it.
+    void kick(Session& session, const std::string& reason);
+
+    // changePlayerMap to a map another world owns; done at the next
+    // flush(), outside whatever handler or update asked for it
+    void queueTransfer(Player& player, int32_t mapId, float x, float y, float orientation);
+
+    // Chat for players this world doesn't host
+    void relayWhisper(Player& sender, const std::string& targetName, const std::string& message);
+    void relayAllChat(Player& sender, const std::string& message);
+
+    // Hand over queued transfers and write the link (call once per loop)
+    void flush();
+
+private:
+    WorldShard() = default;
+
+    struct PendingTransfer
+    {
+        uint32_t sessionId = 0;  // Local session
+        uint32_t characterGuid = 0;
+        int32_t mapId = 0;
+        float x = 0.0f;
+        float y = 0.0f;
+        float orientation = 0.0f;
+    };
+
+    void onFrame(const ShardFrame& frame);
+    void onEnter(StlBuffer& body);
+    void onLeave(StlBuffer& body);
+    void onClientPacket(const ShardFrame& frame);
+    void onChat(StlBuffer& body);
+    void processTransfers();
+    uint32_t getGatewaySessionId(Player& player) const;
+
+    std::unique_ptr<ShardLink> m_link;
+    uint32_t m_worldId = 0;
+    ShardMapTable m_maps;
+    bool m_linkLost = false;
+
+    std::unordered_map<uint32_t, uint32_t> m_sessions;  // Gateway session ID -> local session ID
+    std::vector<PendingTransfer> m_transfers;
+};
+
+#define sWorldShard WorldShard::instance()
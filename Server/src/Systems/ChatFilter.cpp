@@ -0,0 +1,248 @@
+// ChatFilter - Dictionary-driven chat filter (profanity, spam, URLs)
+// Phase 8, Task 8.1: Chat System
+
+#include "stdafx.h"
+#include "Systems/ChatFilter.h"
+#include "Core/Logger.h"
+
+#include <fstream>
+#include <queue>
+
+namespace ChatSystem
+{
+
+namespace
+{
+constexpr uint8_t letter(char c)
+{
+    return static_cast<uint8_t>(c - 'a' + 1);
+}
+
+// Byte -> filter symbol. Letters fold to 1..26 regardless of case, the usual
+// leetspeak stand-ins fold onto the letter they imitate, and the remaining
+// digits plus URL punctuation get symbols of their own.
+constexpr std::array<uint8_t, 256> buildSymbolTable()
+{
+    std::array<uint8_t, 256> table{};
+
+    for (char c = 'a'; c <= 'z'; ++c)
+    {
+        table[static_cast<uint8_t>(c)] = letter(c);
+        table[static_cast<uint8_t>(c - 'a' + 'A')] = letter(c);
+    }
+
+    table['0'] = letter('o');
+    table['1'] = letter('i');
+    table['3'] = letter('e');
+    table['4'] = letter('a');
+    table['5'] = letter('s');
+    table['7'] = letter('t');
+    table['8'] = letter('b');
+    table['@'] = letter('a');
+    table['$'] = letter('s');
+    table['!'] = letter('i');
+
+    table['2'] = 27;
+    table['6'] = 28;
+    table['9'] = 29;
+    table['.'] = 30;
+    table['/'] = 31;
+    table[':'] = 32;
+
+    return table;
+}
+
+constexpr std::array<uint8_t, 256> SYMBOLS = buildSymbolTable();
+
+static_assert(SYMBOLS['Z'] == SYMBOLS['z'] && SYMBOLS['4'] == SYMBOLS['a'],
+              "Case and leetspeak must fold onto the same symbol");
+static_assert(SYMBOLS[':'] < ChatFilterConfig::ALPHABET_SIZE,
+              "Symbol table exceeds the filter alphabet");
+
+// Fold a dictionary term into symbols, collapsing separator runs and
+// dropping leading/trailing separators so masks never start or end on one
+std::string foldTerm(const std::string& term)
+{
+    std::string folded;
+    folded.reserve(term.size());
+
+    for (char c : term)
+    {
+        uint8_t symbol = SYMBOLS[static_cast<uint8_t>(c)];
+        if (symbol == 0 && (folded.empty() || folded.back() == 0))
+            continue;
+        folded.push_back(static_cast<char>(symbol));
+    }
+
+    while (!folded.empty() && folded.back() == 0)
+        folded.pop_back();
+
+    return folded;
+}
+} // namespace
+
+const std::array<uint8_t, 256> ChatFilter::s_symbols = SYMBOLS;
+
+ChatFilter& ChatFilter::instance()
+{
+    static ChatFilter instance;
+    return instance;
+}
+
+// ============================================================================
+// Loading
+// ============================================================================
+
+bool ChatFilter::load(const std::string& path)
+{
+    m_path = path;
+
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        LOG_WARN("ChatFilter: Could not open dictionary %s", path.c_str());
+        return false;
+    }
+
+    std::vector<std::string> terms;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::string folded = foldTerm(line);
+        if (folded.empty() || folded.size() > ChatFilterConfig::MAX_TERM_LENGTH)
+            continue;
+
+        terms.push_back(std::move(folded));
+    }
+
+    m_automaton = compile(terms);
+
+    LOG_INFO("ChatFilter: Compiled %zu terms from %s into %zu states",
+             m_automaton->termCount, path.c_str(), m_automaton->matchLength.size());
+    return true;
+}
+
+bool ChatFilter::reload()
+{
+    if (m_path.empty())
+        return false;
+    return load(m_path);
+}
+
+std::unique_ptr<ChatFilter::Automaton> ChatFilter::compile(const std::vector<std::string>& terms)
+{
+    constexpr uint32_t A = ChatFilterConfig::ALPHABET_SIZE;
+
+    // Build the trie (-1 = no edge)
+    std::vector<int32_t> trie(A, -1);
+    std::vector<uint8_t> terminal(1, 0);
+
+    for (const std::string& term : terms)
+    {
+        uint32_t state = 0;
+        for (char c : term)
+        {
+            uint8_t symbol = static_cast<uint8_t>(c);
+            int32_t child = trie[state * A + symbol];
+            if (child < 0)
+            {
+                child = static_cast<int32_t>(terminal.size());
+                trie[state * A + symbol] = child;
+                trie.resize(trie.size() + A, -1);
+                terminal.push_back(0);
+            }
+            state = static_cast<uint32_t>(child);
+        }
+        terminal[state] = static_cast<uint8_t>(term.size());
+    }
+
+    // Resolve failure links breadth-first into a complete DFA
+    auto automaton = std::make_unique<Automaton>();
+    size_t stateCount = terminal.size();
+    automaton->next.assign(stateCount * A, 0);
+    automaton->matchLength = std::move(terminal);
+    automaton->termCount = terms.size();
+
+    std::vector<uint32_t> fail(stateCount, 0);
+    std::queue<uint32_t> pending;
+
+    for (uint32_t symbol = 0; symbol < A; ++symbol)
+    {
+        int32_t child = trie[symbol];
+        if (child < 0)
+            continue;
+        automaton->next[symbol] = static_cast<uint32_t>(child);
+        pending.push(static_cast<uint32_t>(child));
+    }
+
+    while (!pending.empty())
+    {
+        uint32_t state = pending.front();
+        pending.pop();
+
+        for (uint32_t symbol = 0; symbol < A; ++symbol)
+        {
+            int32_t child = trie[state * A + symbol];
+            uint32_t fallback = automaton->next[fail[state] * A + symbol];
+
+            if (child < 0)
+            {
+                automaton->next[state * A + symbol] = fallback;
+                continue;
+            }
+
+            uint32_t target = static_cast<uint32_t>(child);
+            fail[target] = fallback;
+            automaton->matchLength[target] =
+                std::max(automaton->matchLength[target], automaton->matchLength[fallback]);
+            automaton->next[state * A + symbol] = target;
+            pending.push(target);
+        }
+    }
+
+    return automaton;
+}
+
+// ============================================================================
+// Filtering
+// ============================================================================
+
+bool ChatFilter::filter(std::string& message) const
+{
+    const Automaton* automaton = m_automaton.get();
+    if (!automaton || automaton->termCount == 0)
+        return false;
+
+    const uint32_t* next = automaton->next.data();
+    const uint8_t* matchLength = automaton->matchLength.data();
+
+    uint32_t state = 0;
+    size_t maskedEnd = 0;  // Bytes before this index are already masked
+    bool masked = false;
+
+    for (size_t i = 0; i < message.size(); ++i)
+    {
+        uint8_t symbol = s_symbols[static_cast<uint8_t>(message[i])];
+        state = next[state * ChatFilterConfig::ALPHABET_SIZE + symbol];
+
+        uint8_t length = matchLength[state];
+        if (length == 0)
+            continue;
+
+        // Folding is byte-for-byte, so the match covers exactly `length`
+        // bytes of the original message
+        size_t start = std::max(i + 1 - length, maskedEnd);
+        for (size_t j = start; j <= i; ++j)
+            message[j] = ChatFilterConfig::MASK_CHAR;
+
+        maskedEnd = i + 1;
+        masked = true;
+    }
+
+    return masked;
+}
+
+} // namespace ChatSystem
@@ -0,0 +1,89 @@
+// ChatFilter - Dictionary-driven chat filter (profanity, spam, URLs)
+// Phase 8, Task 8.1: Chat System
+//
+// Banned terms are compiled at startup into an Aho-Corasick automaton with
+// every failure transition resolved, so filtering is a single table lookup
+// per byte with no backtracking and no allocation. Case and common
+// leetspeak substitutions are folded by the same byte -> symbol table the
+// automaton is indexed with, which keeps matches aligned with the original
+// message so masks are applied in place.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ChatSystem
+{
+
+// ============================================================================
+// Filter Alphabet
+// ============================================================================
+
+namespace ChatFilterConfig
+{
+    // Symbol 0 covers whitespace, punctuation and non-ASCII bytes; a space
+    // in a dictionary term therefore matches any separator
+    constexpr uint32_t ALPHABET_SIZE = 33;
+
+    // Longest term kept from the dictionary (chat messages are capped at 255)
+    constexpr size_t MAX_TERM_LENGTH = 255;
+
+    constexpr char MASK_CHAR = '*';
+}
+
+// ============================================================================
+// ChatFilter
+// ============================================================================
+
+class ChatFilter
+{
+public:
+    static ChatFilter& instance();
+
+    // Compile the dictionary at path (one term per line, '#' comments).
+    // On failure the previously loaded automaton stays active.
+    bool load(const std::string& path);
+
+    // Rebuild from the last loaded path
+    bool reload();
+
+    // Mask every banned term in place. Returns true if anything was masked.
+    bool filter(std::string& message) const;
+
+    // Stats
+    bool isLoaded() const { return m_automaton != nullptr; }
+    size_t getTermCount() const { return m_automaton ? m_automaton->termCount : 0; }
+    size_t getStateCount() const { return m_automaton ? m_automaton->matchLength.size() : 0; }
+
+    // Fold a byte to its filter symbol (case and leetspeak folded)
+    static uint8_t symbolOf(uint8_t byte) { return s_symbols[byte]; }
+
+private:
+    ChatFilter() = default;
+    ChatFilter(const ChatFilter&) = delete;
+    ChatFilter& operator=(const ChatFilter&) = delete;
+
+    struct Automaton
+    {
+        // Dense transition table: next[state * ALPHABET_SIZE + symbol]
+        std::vector<uint32_t> next;
+        // Longest term ending at each state, suffix matches included (0 = none)
+        std::vector<uint8_t> matchLength;
+        size_t termCount = 0;
+    };
+
+    static std::unique_ptr<Automaton> compile(const std::vector<std::string>& terms);
+
+    static const std::array<uint8_t, 256> s_symbols;
+
+    std::unique_ptr<Automaton> m_automaton;
+    std::string m_path;
+};
+
+#define sChatFilter ChatSystem::ChatFilter::instance()
+
+} // namespace ChatSystem
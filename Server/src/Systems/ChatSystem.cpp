@@ -3,11 +3,14 @@
 
 #include "stdafx.h"
 #include "Systems/ChatSystem.h"
+#include "Systems/ChatFilter.h"
 #include "Systems/PartySystem.h"
 #include "Systems/GuildSystem.h"
 #include "World/Player.h"
 #include "World/WorldManager.h"
 #include "Network/Session.h"
+#include "Network/WorldShard.h"
+#include "Core/GameClock.h"
 #include "Core/Logger.h"
 #include "Database/DatabaseManager.h"
 
@@ -183,6 +186,13 @@ void ChatManager::handleWhisper(Player* sender, const std::string& targetName, c
     Player* target = sWorldManager.getPlayerByName(targetName);
     if (!target)
     {
+        // Maybe on another world process; the gateway replies if not
+        if (sWorldShard.isActive())
+        {
+            sWorldShard.relayWhisper(*sender, targetName, message);
+            return;
+        }
+
         sendChatError(sender, ChatError::PlayerNotFound);
         return;
     }
@@ -256,6 +266,46 @@ void ChatManager::handleAllChat(Player* sender, const std::string& message)
         sendChatMessage(recipient, ChatDefines::Channels::AllChat,
                         sender->getGuid(), sender->getName(), message);
     }
+
+    if (sWorldShard.isActive())
+        sWorldShard.relayAllChat(*sender, message);
+}
+
+// ============================================================================
+// Cross-World Chat
+// ============================================================================
+
+void ChatManager::deliverRemoteWhisper(PacketSink& reply, uint32_t senderGuid, const std::string& senderName,
+                                       const std::string& targetName, const std::string& message)
+{
+    Player* target = sWorldManager.getPlayerByName(targetName);
+    if (!target)
+    {
+        sendChatError(reply, ChatError::PlayerNotFound);
+        return;
+    }
+
+    if (isIgnoring(target->getGuid(), senderGuid))
+    {
+        sendChatError(reply, ChatError::PlayerIgnoringYou);
+        return;
+    }
+
+    sendChatMessage(target, ChatDefines::Channels::Whisper, senderGuid, senderName, message);
+    sendChatMessage(reply, ChatDefines::Channels::System, 0, "",
+                    "To [" + target->getName() + "]: " + message);
+}
+
+void ChatManager::deliverRemoteAllChat(uint32_t senderGuid, const std::string& senderName,
+                                       const std::string& message)
+{
+    for (Player* recipient : sWorldManager.getAllPlayers())
+    {
+        if (isIgnoring(recipient->getGuid(), senderGuid))
+            continue;
+
+        sendChatMessage(recipient, ChatDefines::Channels::AllChat, senderGuid, senderName, message);
+    }
 }
 
 // ============================================================================
@@ -439,8 +489,7 @@ bool ChatManager::isRateLimited(Player* player, ChatDefines::Channels channel)
     if (!player)
         return true;
 
-    auto now = std::chrono::steady_clock::now();
-    auto nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+    int64_t nowMs = sGameClock.getNowMs();
 
     uint32_t guid = player->getGuid();
 
@@ -472,8 +521,7 @@ void ChatManager::updateRateLimit(Player* player, ChatDefines::Channels channel)
     if (!player)
         return;
 
-    auto now = std::chrono::steady_clock::now();
-    auto nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+    int64_t nowMs = sGameClock.getNowMs();
 
     uint32_t guid = player->getGuid();
 
@@ -519,10 +567,9 @@ bool ChatManager::validateMessage(const std::string& message) const
 
 std::string ChatManager::filterMessage(const std::string& message) const
 {
-    // Simple profanity filter placeholder
-    // In production, this would use a dictionary of banned words
-    // For now, just return the message as-is
-    return message;
+    std::string filtered = message;
+    sChatFilter.filter(filtered);
+    return filtered;
 }
 
 void ChatManager::sendChatError(Player* player, ChatError error)
@@ -530,10 +577,15 @@ void ChatManager::sendChatError(Player* player, ChatError error)
     if (!player)
         return;
 
+    sendChatError(player->getSink(), error);
+}
+
+void ChatManager::sendChatError(PacketSink& sink, ChatError error)
+{
     GP_Server_ChatError packet;
     packet.m_code = static_cast<uint8_t>(error);
 
-    player->sendPacket(packet.build(StlBuffer{}));
+    sink.sendPacket(packet.build(StlBuffer{}));
 }
 
 void ChatManager::sendChatMessage(Player* recipient, ChatDefines::Channels channel,
@@ -543,6 +595,13 @@ void ChatManager::sendChatMessage(Player* recipient, ChatDefines::Channels chann
     if (!recipient)
         return;
 
+    sendChatMessage(recipient->getSink(), channel, senderGuid, senderName, message);
+}
+
+void ChatManager::sendChatMessage(PacketSink& sink, ChatDefines::Channels channel,
+                                  uint32_t senderGuid, const std::string& senderName,
+                                  const std::string& message)
+{
     GP_Server_ChatMsg packet;
     packet.m_channelId = static_cast<uint8_t>(channel);
     packet.m_fromGuid = senderGuid;
@@ -550,7 +609,7 @@ void ChatManager::sendChatMessage(Player* recipient, ChatDefines::Channels chann
     packet.m_text = message;
     // packet.m_itemId left default (no item link)
 
-    recipient->sendPacket(packet.build(StlBuffer{}));
+    sink.sendPacket(packet.build(StlBuffer{}));
 }
 
 std::vector<Player*> ChatManager::getPlayersInRange(int mapId, float x, float y, float range) const
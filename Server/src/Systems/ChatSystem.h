@@ -13,6 +13,7 @@
 class Player;
 class StlBuffer;
 class Session;
+class PacketSink;
 
 namespace ChatSystem
 {
@@ -76,6 +77,19 @@ public:
     // Send a system message to all online players
     void sendSystemMessageGlobal(const std::string& message);
 
+    // -------------------------------------------------------------------------
+    // Cross-World Chat (WorldShard)
+    // -------------------------------------------------------------------------
+
+    // Whisper from a player on another world process; `reply` reaches the
+    // sender (confirmation or error)
+    void deliverRemoteWhisper(PacketSink& reply, uint32_t senderGuid, const std::string& senderName,
+                              const std::string& targetName, const std::string& message);
+
+    // All-chat line from a player on another world process
+    void deliverRemoteAllChat(uint32_t senderGuid, const std::string& senderName,
+                              const std::string& message);
+
     // -------------------------------------------------------------------------
     // Ignore List
     // -------------------------------------------------------------------------
@@ -132,16 +146,20 @@ private:
     // Validate message content
     bool validateMessage(const std::string& message) const;
 
-    // Filter profanity (simple implementation)
+    // Mask banned terms (see ChatFilter)
     std::string filterMessage(const std::string& message) const;
 
     // Send chat error to player
     void sendChatError(Player* player, ChatError error);
+    void sendChatError(PacketSink& sink, ChatError error);
 
     // Build and send GP_Server_ChatMsg to a single player
     void sendChatMessage(Player* recipient, ChatDefines::Channels channel,
                          uint32_t senderGuid, const std::string& senderName,
                          const std::string& message);
+    void sendChatMessage(PacketSink& sink, ChatDefines::Channels channel,
+                         uint32_t senderGuid, const std::string& senderName,
+                         const std::string& message);
 
     // Get players within range of a position on a map
     std::vector<Player*> getPlayersInRange(int mapId, float x, float y, float range) const;
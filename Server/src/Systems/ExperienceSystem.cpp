@@ -6,6 +6,8 @@
 #include "Database/GameData.h"
 #include "World/Player.h"
 #include "World/Npc.h"
+#include "World/WorldManager.h"
+#include "Systems/PartySystem.h"
 #include "Core/Logger.h"
 #include "GamePacketServer.h"
 #include "StlBuffer.h"
@@ -54,37 +56,21 @@ void ExperienceSystem::giveExperience(Player* player, int32_t amount, const std:
     if (!player || amount <= 0)
         return;
 
-    int32_t oldLevel = player->getLevel();
-
     player->addExperience(amount);
 
-    int32_t newLevel = checkLevelUp(player);
-    int32_t currentXp = player->getExperience();
-
-    player->setVariable(ObjDefines::Variable::Experience, currentXp);
-    player->setVariable(ObjDefines::Variable::Progression, currentXp);
-    player->broadcastVariable(ObjDefines::Variable::Experience, currentXp);
-    player->broadcastVariable(ObjDefines::Variable::Progression, currentXp);
-
-    GP_Server_ExpNotify packet;
-    packet.m_amount = amount;
-    packet.m_newLevel = newLevel > oldLevel ? newLevel : 0;
-
-    StlBuffer buf;
-    uint16_t opcode = packet.getOpcode();
-    buf << opcode;
-    packet.pack(buf);
-    player->sendPacket(buf);
+    if (player->getPendingExpGain() == 0)
+        m_pendingExperience.push_back(player);
+    player->setPendingExpGain(player->getPendingExpGain() + amount);
 
     if (!source.empty())
     {
-        LOG_DEBUG("Experience: '{}' gained {} XP from {} (level {} -> {}, xp={})",
-                  player->getName(), amount, source, oldLevel, newLevel, currentXp);
+        LOG_DEBUG("Experience: '%s' gained %d XP from %s (xp=%d)",
+                  player->getName().c_str(), amount, source.c_str(), player->getExperience());
     }
     else
     {
-        LOG_DEBUG("Experience: '{}' gained {} XP (level {} -> {}, xp={})",
-                  player->getName(), amount, oldLevel, newLevel, currentXp);
+        LOG_DEBUG("Experience: '%s' gained %d XP (xp=%d)",
+                  player->getName().c_str(), amount, player->getExperience());
     }
 }
 
@@ -101,20 +87,109 @@ void ExperienceSystem::givePartyExperience(const std::vector<Player*>& party, in
     }
 }
 
-void ExperienceSystem::onNpcKilled(Player* player, Npc* npc)
+void ExperienceSystem::flushPendingExperience()
 {
-    if (!player || !npc)
+    if (m_pendingExperience.empty())
         return;
 
-    int32_t playerLevel = player->getLevel();
-    int32_t npcLevel = npc->getVariable(ObjDefines::Variable::Level);
-    int32_t baseXp = getKillBaseXP(npcLevel);
-    int32_t xp = calculateKillXP(playerLevel, npcLevel, baseXp);
+    std::vector<Player*> pending;
+    pending.swap(m_pendingExperience);
+
+    for (Player* player : pending)
+        applyPendingExperience(player);
+}
+
+void ExperienceSystem::flushPendingExperience(Player* player)
+{
+    if (!player || player->getPendingExpGain() == 0)
+        return;
+
+    cancelPendingExperience(player);
+    applyPendingExperience(player);
+}
+
+void ExperienceSystem::applyPendingExperience(Player* player)
+{
+    int32_t gained = player->getPendingExpGain();
+    player->setPendingExpGain(0);
+
+    int32_t oldLevel = player->getLevel();
+    int32_t newLevel = checkLevelUp(player);
+
+    // Stats only depend on the final level, so however many levels
+    // were gained they are applied - and sent - once
+    if (newLevel > oldLevel)
+    {
+        applyLevelStats(player, newLevel, false, false);
+        sWorldManager.broadcastPlayerUpdate(player);
+
+        LOG_DEBUG("Experience: '%s' reached level %d (from %d)",
+                  player->getName().c_str(), newLevel, oldLevel);
+    }
+
+    GP_Server_ExpNotify packet;
+    packet.m_amount = gained;
+    packet.m_newLevel = newLevel > oldLevel ? newLevel : 0;
 
-    if (xp <= 0)
+    StlBuffer buf;
+    uint16_t opcode = packet.getOpcode();
+    buf << opcode;
+    packet.pack(buf);
+    player->sendPacket(buf);
+}
+
+void ExperienceSystem::cancelPendingExperience(Player* player)
+{
+    auto& pending = m_pendingExperience;
+    pending.erase(std::remove(pending.begin(), pending.end(), player), pending.end());
+}
+
+const std::vector<Player*>& ExperienceSystem::gatherKillCredit(Entity* killer, const Npc* npc)
+{
+    m_killCredit.clear();
+
+    if (!killer || !npc || killer->getType() != MutualObject::Type::Player)
+        return m_killCredit;
+
+    Player* player = static_cast<Player*>(killer);
+    m_killCredit.push_back(player);
+
+    const Party::PartyData* party = sPartyManager.getParty(player);
+    if (!party)
+        return m_killCredit;
+
+    for (uint32_t guid : party->memberGuids)
+    {
+        Player* member = sWorldManager.getPlayer(guid);
+        if (!member || member == player || member->isDead())
+            continue;
+
+        if (member->getMapId() != npc->getMapId() || !member->isInRange(npc, KILL_CREDIT_RANGE))
+            continue;
+
+        m_killCredit.push_back(member);
+    }
+
+    return m_killCredit;
+}
+
+void ExperienceSystem::onNpcKilled(const std::vector<Player*>& credited, Npc* npc)
+{
+    if (credited.empty() || !npc)
         return;
 
-    giveExperience(player, xp, npc->getName());
+    // Looked up once per kill; each member's share still scales with
+    // their own level
+    int32_t npcLevel = npc->getVariable(ObjDefines::Variable::Level);
+    int32_t baseXp = getKillBaseXP(npcLevel);
+    int32_t shares = static_cast<int32_t>(credited.size());
+
+    for (Player* member : credited)
+    {
+        int32_t xp = calculateKillXP(member->getLevel(), npcLevel, baseXp) / shares;
+        if (xp > 0)
+            giveExperience(member, xp, npc->getName());
+    }
 }
 
 void ExperienceSystem::applyLevelStats(Player* player, int32_t level, bool preserveCurrent, bool broadcast)
@@ -211,12 +286,11 @@ int32_t ExperienceSystem::checkLevelUp(Player* player)
 
         xp -= required;
         level += 1;
-        player->setLevel(level);
-        player->broadcastVariable(ObjDefines::Variable::Level, level);
-
-        applyLevelStats(player, level, false, true);
     }
 
+    if (level != player->getLevel())
+        player->setLevel(level);
+
     if (xp != player->getExperience())
         player->setExperience(xp);
 
@@ -7,21 +7,43 @@
 #include <string>
 #include <vector>
 
+class Entity;
 class Player;
 class Npc;
 
 namespace Experience
 {
 
+// Party members this close to a kill share its rewards (the reach of the
+// fight's combat messages)
+constexpr float KILL_CREDIT_RANGE = 1000.0f;
+
 class ExperienceSystem
 {
 public:
     static ExperienceSystem& instance();
 
     int32_t calculateKillXP(int32_t playerLevel, int32_t npcLevel, int32_t npcBaseXP) const;
+
+    // XP is added straight away; the level-up check, ExpNotify and stat
+    // broadcast wait for flushPendingExperience (end of the world tick),
+    // so several gains in one tick level the player up once
     void giveExperience(Player* player, int32_t amount, const std::string& source);
     void givePartyExperience(const std::vector<Player*>& party, int32_t totalXP);
-    void onNpcKilled(Player* player, Npc* npc);
+    void flushPendingExperience();
+
+    // Run one player's pending level-up now (leaving the world before the
+    // end-of-tick flush, so it is saved at the right level)
+    void flushPendingExperience(Player* player);
+    void cancelPendingExperience(Player* player);
+
+    // Players credited with a kill: the killer, plus living party members
+    // on its map within KILL_CREDIT_RANGE of the NPC. Empty unless the
+    // killer is a player; the list is reused by the next call.
+    const std::vector<Player*>& gatherKillCredit(Entity* killer, const Npc* npc);
+
+    // Share one kill's XP between the players credited with it
+    void onNpcKilled(const std::vector<Player*>& credited, Npc* npc);
 
     void applyLevelStats(Player* player, int32_t level, bool preserveCurrent, bool broadcast = true);
 
@@ -29,6 +51,10 @@ private:
     ExperienceSystem() = default;
     int32_t getKillBaseXP(int32_t npcLevel) const;
     int32_t checkLevelUp(Player* player);
+    void applyPendingExperience(Player* player);
+
+    std::vector<Player*> m_killCredit;          // gatherKillCredit result
+    std::vector<Player*> m_pendingExperience;   // Players with XP awaiting the flush (each once)
 };
 
 #define sExperienceSystem Experience::ExperienceSystem::instance()
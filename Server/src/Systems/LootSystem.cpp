@@ -10,6 +10,7 @@
 #include "../Database/DatabaseManager.h"
 #include "../Database/GameData.h"
 #include "../Core/Logger.h"
+#include "../Core/Random.h"
 #include "../Core/Config.h"
 #include "GamePacketServer.h"
 #include "GamePacketClient.h"
@@ -77,7 +78,7 @@ LootManager& LootManager::instance()
 // Loot Generation
 // ============================================================================
 
-void LootManager::generateLoot(Npc* npc, Entity* killer)
+void LootManager::generateLoot(Npc* npc, Entity* killer, const std::vector<Player*>& credited)
 {
     if (!npc || !killer)
         return;
@@ -107,6 +108,11 @@ void LootManager::generateLoot(Npc* npc, Entity* killer)
     loot.targetGuid = npcGuid;
     loot.ownerGuid = killerGuid;
     loot.freeForAllTimer = FREE_FOR_ALL_DELAY;
+    for (Player* member : credited)
+    {
+        if (member->getGuid() != killerGuid)
+            loot.partyGuids.push_back(member->getGuid());
+    }
 
     // Roll loot from table
     if (lootTableId > 0)
@@ -121,6 +127,7 @@ void LootManager::generateLoot(Npc* npc, Entity* killer)
     // Only store if there's something to loot
     if (!loot.items.empty() || loot.goldAmount > 0)
     {
+        setCorpseLootable(npc, true);
         m_pendingLoot[npcGuid] = std::move(loot);
         LOG_DEBUG("LootManager: Generated loot for NPC {} (items={}, gold={})",
                   npcGuid, m_pendingLoot[npcGuid].items.size(), m_pendingLoot[npcGuid].goldAmount);
@@ -218,7 +225,7 @@ std::vector<LootItem> LootManager::rollLootTable(int32_t lootTableId)
         return result;
 
     // RNG
-    static thread_local std::mt19937 rng(std::random_device{}());
+    std::mt19937& rng = Random::engine();
     std::uniform_int_distribution<int> chanceDist(1, 100);
 
     for (const auto& entry : entries)
@@ -250,7 +257,7 @@ std::vector<LootItem> LootManager::rollLootTable(int32_t lootTableId)
 int32_t LootManager::rollGold(int32_t minLevel, int32_t maxLevel)
 {
     // Base gold formula: level * 2 + random 0-5
-    static thread_local std::mt19937 rng(std::random_device{}());
+    std::mt19937& rng = Random::engine();
 
     int32_t baseGold = std::max(minLevel, maxLevel) * 2;
     std::uniform_int_distribution<int32_t> bonusDist(0, 5);
@@ -360,7 +367,7 @@ void LootManager::lootItem(Player* player, uint32_t targetGuid, const ItemDefine
                     sendItemAddNotification(player, lootItem.itemId, lootItem.stackCount);
 
                     // Send updated inventory
-                    player->sendInventory();
+                    player->markInventoryDirty();
 
                     LOG_DEBUG("LootManager: Player {} looted item {} x{} from {}",
                               player->getGuid(), lootItem.itemId.m_itemId,
@@ -425,7 +432,7 @@ void LootManager::lootAll(Player* player, uint32_t targetGuid)
     }
 
     // Send updated inventory
-    player->sendInventory();
+    player->markInventoryDirty();
 
     // Check if all loot is taken
     if (loot->isEmpty())
@@ -487,8 +494,18 @@ bool LootManager::canPlayerLoot(Player* player, uint32_t targetGuid) const
     if (loot.freeForAllTimer <= 0.0f)
         return true;
 
-    // TODO: Party members could loot with different rules
-    return false;
+    // Party members credited with the kill share the owner's rights
+    const auto& party = loot.partyGuids;
+    return std::find(party.begin(), party.end(), player->getGuid()) != party.end();
+}
+
+void LootManager::restoreLoot(uint32_t targetGuid, PendingLoot loot)
+{
+    loot.targetGuid = targetGuid;
+    m_pendingLoot[targetGuid] = std::move(loot);
+
+    if (Npc* npc = sWorldManager.getNpc(targetGuid))
+        setCorpseLootable(npc, true);
 }
 
 // ============================================================================
@@ -532,8 +549,20 @@ void LootManager::cleanupExpiredLoot()
 // Private Helpers
 // ============================================================================
 
+void LootManager::setCorpseLootable(Npc* npc, bool lootable)
+{
+    npc->setVariable(ObjDefines::Variable::DynLootable, lootable ? 1 : 0);
+    if (lootable)
+        npc->queueLifecycleEvent(NpcLifecycleEvent::CorpseLootable);
+}
+
 void LootManager::removeLoot(uint32_t targetGuid)
 {
+    // Viewers already heard through markAsLooted; this keeps the corpse's
+    // spawn packet in step for anyone it is sent to later
+    if (Npc* npc = sWorldManager.getNpc(targetGuid))
+        setCorpseLootable(npc, false);
+
     m_pendingLoot.erase(targetGuid);
     LOG_DEBUG("LootManager: Removed loot for target {}", targetGuid);
 }
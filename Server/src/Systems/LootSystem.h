@@ -41,6 +41,7 @@ struct PendingLoot
 {
     uint32_t targetGuid = 0;      // GUID of the lootable object
     uint32_t ownerGuid = 0;       // Player who has loot rights
+    std::vector<uint32_t> partyGuids; // Owner's party members credited with the kill
     int32_t goldAmount = 0;       // Gold to loot
     std::vector<LootItem> items;  // Items to loot
     float freeForAllTimer = 0.0f; // When anyone can loot
@@ -81,8 +82,9 @@ public:
     // Loot Generation
     // -------------------------------------------------------------------------
 
-    // Generate loot when NPC dies
-    void generateLoot(Npc* npc, Entity* killer);
+    // Generate loot when NPC dies; `credited` players share the owner's
+    // loot rights (see ExperienceSystem::gatherKillCredit)
+    void generateLoot(Npc* npc, Entity* killer, const std::vector<Player*>& credited = {});
 
     // Generate loot for a game object (chests, etc.)
     void generateLootForGameObject(uint32_t objGuid, int32_t lootTableId, uint32_t ownerGuid);
@@ -114,6 +116,12 @@ public:
     // Check if player can loot target
     bool canPlayerLoot(Player* player, uint32_t targetGuid) const;
 
+    // All pending loot (world checkpoint capture)
+    const std::unordered_map<uint32_t, PendingLoot>& getAllPendingLoot() const { return m_pendingLoot; }
+
+    // Reattach checkpointed loot to a restored corpse
+    void restoreLoot(uint32_t targetGuid, PendingLoot loot);
+
     // -------------------------------------------------------------------------
     // Update
     // -------------------------------------------------------------------------
@@ -142,6 +150,9 @@ private:
     // Remove loot entry
     void removeLoot(uint32_t targetGuid);
 
+    // Set an NPC corpse's DynLootable flag (queues a lifecycle refresh when set)
+    void setCorpseLootable(Npc* npc, bool lootable);
+
     // Send loot window packet to player
     void sendLootWindow(Player* player, const PendingLoot& loot);
 
@@ -15,6 +15,8 @@
 #include "StlBuffer.h"
 #include "PlayerDefines.h"
 
+#include <algorithm>
+
 namespace Quest
 {
 
@@ -49,6 +51,43 @@ QuestManager& QuestManager::instance()
     return instance;
 }
 
+void QuestManager::initialize()
+{
+    m_questsByStarter.clear();
+    m_questsByFinisher.clear();
+    m_dependentNpcs.clear();
+
+    auto addDependent = [this](int32_t questId, int32_t npcEntry)
+    {
+        if (npcEntry <= 0)
+            return;
+        auto& entries = m_dependentNpcs[questId];
+        if (std::find(entries.begin(), entries.end(), npcEntry) == entries.end())
+            entries.push_back(npcEntry);
+    };
+
+    for (const auto& [questId, quest] : sGameData.getAllQuests())
+    {
+        if (quest.startNpcEntry > 0)
+            m_questsByStarter[quest.startNpcEntry].push_back(questId);
+        if (quest.finishNpcEntry > 0)
+            m_questsByFinisher[quest.finishNpcEntry].push_back(questId);
+
+        addDependent(questId, quest.startNpcEntry);
+        addDependent(questId, quest.finishNpcEntry);
+
+        // Rewarding a prerequisite can make this quest available
+        for (int i = 0; i < 3; ++i)
+        {
+            if (quest.prevQuest[i] > 0)
+                addDependent(quest.prevQuest[i], quest.startNpcEntry);
+        }
+    }
+
+    LOG_INFO("QuestManager: Indexed %zu quest givers and %zu quest enders",
+             m_questsByStarter.size(), m_questsByFinisher.size());
+}
+
 std::vector<QuestObjective> QuestManager::buildObjectives(const QuestTemplate& quest) const
 {
     std::vector<QuestObjective> objectives;
@@ -136,24 +175,30 @@ void QuestManager::getQuestsForNpc(Player* player, Npc* npc,
     if (!player || !npc)
         return;
 
+    // Items picked up earlier this tick may complete a quest
+    player->syncQuestItems();
+
     int32_t npcEntry = npc->getEntry();
-    const auto& quests = sGameData.getAllQuests();
     const auto& log = player->getQuestLog();
 
-    for (const auto& [questId, quest] : quests)
+    auto startIt = m_questsByStarter.find(npcEntry);
+    if (startIt != m_questsByStarter.end())
     {
-        if (quest.startNpcEntry == npcEntry && isQuestAvailable(player, questId))
+        for (int32_t questId : startIt->second)
         {
-            outOffers.push_back(questId);
+            if (isQuestAvailable(player, questId))
+                outOffers.push_back(questId);
         }
+    }
 
-        if (quest.finishNpcEntry == npcEntry)
+    auto finishIt = m_questsByFinisher.find(npcEntry);
+    if (finishIt != m_questsByFinisher.end())
+    {
+        for (int32_t questId : finishIt->second)
         {
             const QuestState* state = log.getQuest(questId);
             if (state && state->status == QuestDefines::Status::Complete)
-            {
                 outCompletes.push_back(questId);
-            }
         }
     }
 }
@@ -219,7 +264,7 @@ void QuestManager::updateQuestCompletion(Player* player, const QuestTemplate& qu
         packet.pack(buf);
         player->sendPacket(buf);
 
-        refreshNpcGossipStatuses(player);
+        refreshNpcGossipStatuses(player, quest.entry);
     }
     else if (!complete && state->status == QuestDefines::Status::Complete)
     {
@@ -235,26 +280,37 @@ void QuestManager::updateQuestCompletion(Player* player, const QuestTemplate& qu
         packet.pack(buf);
         player->sendPacket(buf);
 
-        refreshNpcGossipStatuses(player);
+        refreshNpcGossipStatuses(player, quest.entry);
     }
 }
 
-void QuestManager::refreshNpcGossipStatuses(Player* player) const
+void QuestManager::refreshNpcGossipStatuses(Player* player, int32_t questId) const
 {
     if (!player)
         return;
 
+    auto depIt = m_dependentNpcs.find(questId);
+    if (depIt == m_dependentNpcs.end())
+        return;
+
     // NOTE: GP_Server_ObjectVariable is NOT supported by the client binary.
-    // Instead, we resend the full NPC packet which includes DynGossipStatus.
-    // WorldManager::sendNpcTo() already includes the gossip status from getGossipStatus().
-    auto npcs = sWorldManager.getNpcsOnMap(player->getMapId());
-    for (Npc* npc : npcs)
+    // Instead, we resend the full NPC packet which includes DynGossipStatus,
+    // but only for givers the player can see whose status actually changed.
+    for (int32_t npcEntry : depIt->second)
     {
-        if (!npc || !npc->isQuestGiver())
-            continue;
+        for (Npc* npc : sWorldManager.getQuestGiversOnMap(player->getMapId(), npcEntry))
+        {
+            if (!npc->isSpawned())
+                continue;
 
-        // Resend full NPC packet to this player - includes updated gossip status
-        sWorldManager.sendNpcTo(player, npc);
+            int32_t status = static_cast<int32_t>(getGossipStatus(player, npc));
+            int32_t sentStatus = 0;
+            if (player->getSentGossipStatus(npc->getGuid(), sentStatus) && sentStatus == status)
+                continue;
+
+            // sendNpcTo() records the status it sends
+            sWorldManager.sendNpcTo(player, npc);
+        }
     }
 }
 
@@ -434,7 +490,7 @@ bool QuestManager::acceptQuest(Player* player, int32_t questId)
     player->sendPacket(buf);
 
     updateQuestCompletion(player, *quest);
-    refreshNpcGossipStatuses(player);
+    refreshNpcGossipStatuses(player, questId);
     return true;
 }
 
@@ -585,6 +641,8 @@ bool QuestManager::completeQuest(Player* player, int32_t questId, int32_t reward
     if (!player)
         return false;
 
+    player->syncQuestItems();
+
     auto* state = player->getQuestLog().getQuest(questId);
     if (!state || state->status != QuestDefines::Status::Complete)
     {
@@ -626,7 +684,7 @@ bool QuestManager::completeQuest(Player* player, int32_t questId, int32_t reward
         player->getQuestLog().setStatus(questId, QuestDefines::Status::Rewarded);
     }
 
-    refreshNpcGossipStatuses(player);
+    refreshNpcGossipStatuses(player, questId);
     return true;
 }
 
@@ -649,7 +707,7 @@ bool QuestManager::abandonQuest(Player* player, int32_t questId)
     packet.pack(buf);
     player->sendPacket(buf);
 
-    refreshNpcGossipStatuses(player);
+    refreshNpcGossipStatuses(player, questId);
     return true;
 }
 
@@ -5,6 +5,7 @@
 
 #include <array>
 #include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 #include "QuestDefines.h"
@@ -30,6 +31,9 @@ class QuestManager
 public:
     static QuestManager& instance();
 
+    // Build the quest <-> NPC entry indexes (call after game data is loaded)
+    void initialize();
+
     bool isQuestAvailable(Player* player, int32_t questId) const;
     void getQuestsForNpc(Player* player, Npc* npc,
                          std::vector<int32_t>& outOffers,
@@ -56,10 +60,20 @@ private:
     void updateQuestCompletion(Player* player, const QuestTemplate& quest);
     void sendQuestTally(Player* player, int32_t questId, QuestDefines::TallyType type,
                         int32_t targetId, int32_t progress) const;
-    void refreshNpcGossipStatuses(Player* player) const;
+    // Resend quest givers whose gossip status may depend on questId and
+    // whose status differs from what this player was last sent
+    void refreshNpcGossipStatuses(Player* player, int32_t questId) const;
     bool removeRequiredItems(Player* player, const QuestTemplate& quest) const;
     bool canReceiveRewards(Player* player, const QuestTemplate& quest, int32_t rewardChoice) const;
     void grantRewards(Player* player, const QuestTemplate& quest, int32_t rewardChoice) const;
+
+    // NPC entry -> quests it starts / finishes
+    std::unordered_map<int32_t, std::vector<int32_t>> m_questsByStarter;
+    std::unordered_map<int32_t, std::vector<int32_t>> m_questsByFinisher;
+
+    // Quest -> NPC entries whose gossip status can change with that quest's
+    // state: its giver, its ender, and the givers of quests chained after it
+    std::unordered_map<int32_t, std::vector<int32_t>> m_dependentNpcs;
 };
 
 #define sQuestManager Quest::QuestManager::instance()
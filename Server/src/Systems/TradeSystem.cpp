@@ -473,8 +473,8 @@ bool TradeManager::completeTrade(TradeSession* session)
     }
 
     // Send inventory updates
-    player1->sendInventory();
-    player2->sendInventory();
+    player1->markInventoryDirty();
+    player2->markInventoryDirty();
 
     // Send trade complete (canceled packet with empty state acts as completion)
     sendTradeCanceled(player1);
@@ -226,7 +226,7 @@ bool VendorManager::buyItem(Player* player, Npc* vendor, int32_t itemIndex, int3
 
     // Send notifications
     sendSpentGold(player, totalPrice);
-    player->sendInventory();
+    player->markInventoryDirty();
 
     LOG_DEBUG("VendorManager: Player {} bought item {} x{} for {} gold from vendor {}",
               player->getGuid(), vendorItem.itemId, count, totalPrice, npcEntry);
@@ -280,7 +280,7 @@ bool VendorManager::sellItem(Player* player, Npc* vendor, int32_t inventorySlot)
     player->setVariable(ObjDefines::Variable::Gold, currentGold + sellPrice);
 
     // Update inventory
-    player->sendInventory();
+    player->markInventoryDirty();
 
     LOG_DEBUG("VendorManager: Player {} sold item {} x{} for {} gold",
               player->getGuid(), itemId.m_itemId, stackCount, sellPrice);
@@ -341,7 +341,7 @@ bool VendorManager::buyback(Player* player, Npc* vendor, int32_t buybackSlot)
 
     // Send notifications
     sendSpentGold(player, buybackItem.price);
-    player->sendInventory();
+    player->markInventoryDirty();
 
     LOG_DEBUG("VendorManager: Player {} bought back item for {} gold", player->getGuid(), buybackItem.price);
 
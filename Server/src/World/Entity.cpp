@@ -27,12 +27,14 @@ void Entity::setPosition(int mapId, float x, float y)
     m_mapId = mapId;
     m_x = x;
     m_y = y;
+    onPositionChanged();
 }
 
 void Entity::setPosition(float x, float y)
 {
     m_x = x;
     m_y = y;
+    onPositionChanged();
 }
 
 int32_t Entity::getVariable(ObjDefines::Variable var) const
@@ -46,6 +48,9 @@ void Entity::setVariable(ObjDefines::Variable var, int32_t value)
     int32_t oldValue = getVariable(var);
     m_variables[static_cast<int>(var)] = value;
 
+    if (oldValue != value)
+        invalidateSpawnPacket();
+
     // Notify callback if value changed
     if (m_variableCallback && oldValue != value)
         m_variableCallback(this, var, oldValue, value);
@@ -195,7 +200,7 @@ void Entity::broadcastVariable(ObjDefines::Variable var, int32_t value)
     // The client tracks Health/Mana changes internally from GP_Server_CombatMsg.
     // For critical state changes, we resend the full entity packet instead.
 
-    (void)value;  // Value is already set via setVariable() before this call
+    // Value is already set via setVariable() before this call
 
     // Health/Mana updates: Client tracks these from CombatMsg damage/heal amounts
     // No need to broadcast - the client updates its internal state from combat messages
@@ -219,7 +224,16 @@ void Entity::broadcastVariable(ObjDefines::Variable var, int32_t value)
     else if (getType() == MutualObject::Type::Npc)
     {
         ::Npc* selfNpc = static_cast<::Npc*>(this);
-        // Resend full NPC data to all players on the map
-        sWorldManager.broadcastNpcUpdate(selfNpc);
+        if (var == ObjDefines::Variable::IsDead)
+        {
+            // Deaths and resurrections go out once per tick with the NPC's
+            // other lifecycle changes
+            selfNpc->queueLifecycleEvent(value ? NpcLifecycleEvent::Died : NpcLifecycleEvent::Respawned);
+        }
+        else
+        {
+            // Resend full NPC data to all players on the map
+            sWorldManager.broadcastNpcUpdate(selfNpc);
+        }
     }
 }
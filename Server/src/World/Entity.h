@@ -3,6 +3,7 @@
 #include "MutualObject.h"
 #include "ObjDefines.h"
 #include "../Combat/AuraSystem.h"
+#include "StlBuffer.h"
 
 #include <string>
 #include <functional>
@@ -10,6 +11,21 @@
 
 class Map;
 
+// Serialized spawn packet (Server_Player / Server_Npc) shared by every viewer.
+// Position and per-viewer fields are patched in place at their recorded
+// offsets right before sending; everything else is rebuilt only when the
+// owning entity's spawn version moves on.
+struct SpawnPacketCache
+{
+    StlBuffer packet;
+    uint32_t version = 0;
+    bool valid = false;
+    size_t positionOffset = 0;   // x, y, orientation (3 x float)
+    size_t gossipOffset = 0;     // DynGossipStatus value (NPCs only, 0 = absent)
+
+    bool isCurrent(uint32_t spawnVersion) const { return valid && version == spawnVersion; }
+};
+
 // Server-side entity with position and world presence
 class Entity : public MutualObject
 {
@@ -43,12 +59,18 @@ public:
     bool isSpawned() const { return m_spawned; }
     void setSpawned(bool spawned) { m_spawned = spawned; }
 
+    // Spawn packet cache - bumped whenever a field of the spawn packet
+    // other than position changes
+    uint32_t getSpawnVersion() const { return m_spawnVersion; }
+    void invalidateSpawnPacket() { ++m_spawnVersion; }
+    SpawnPacketCache& getSpawnPacketCache() { return m_spawnPacket; }
+
     // Update (called each tick)
     virtual void update(float deltaTime) = 0;
 
     // Name (for logging/display)
     virtual const std::string& getName() const { return m_name; }
-    void setName(const std::string& name) { m_name = name; }
+    void setName(const std::string& name) { m_name = name; invalidateSpawnPacket(); }
 
     // Distance calculations
     float distanceTo(const Entity* other) const;
@@ -93,6 +115,9 @@ public:
     void broadcastVariable(ObjDefines::Variable var, int32_t value);
 
 protected:
+    // Called after setPosition() moves the entity
+    virtual void onPositionChanged() {}
+
     std::string m_name;
 
     // World position
@@ -119,4 +144,8 @@ protected:
 
     // Aura manager (Task 5.8)
     AuraManager m_auras;
+
+    // Spawn packet cache
+    uint32_t m_spawnVersion = 0;
+    SpawnPacketCache m_spawnPacket;
 };
@@ -0,0 +1,104 @@
+// HotStatePool - Contiguous storage for per-tick entity state
+//
+// Entities keep the fields their tick touches in a small struct allocated
+// from a pool per map, so the update loop walks dense arrays instead of
+// chasing heap objects whose cold members (names, containers, caches)
+// share their cache lines. Slots live in fixed-size chunks: addresses stay
+// stable for the owner's lifetime and freed slots are reused.
+
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+template <typename T, size_t ChunkSize = 64>
+class HotStatePool
+{
+public:
+    // A reset (value-initialized) slot
+    T* acquire()
+    {
+        T* slot = nullptr;
+        if (!m_free.empty())
+        {
+            slot = m_free.back();
+            m_free.pop_back();
+        }
+        else
+        {
+            if (m_chunks.empty() || m_chunks.back()->used == ChunkSize)
+                m_chunks.push_back(std::make_unique<Chunk>());
+            Chunk& chunk = *m_chunks.back();
+            slot = &chunk.slots[chunk.used++];
+        }
+
+        *slot = T{};
+        setLive(slot, true);
+        ++m_liveCount;
+        return slot;
+    }
+
+    void release(T* slot)
+    {
+        if (!slot || !setLive(slot, false))
+            return;
+
+        m_free.push_back(slot);
+        --m_liveCount;
+    }
+
+    // Visit live slots in memory order. Slots acquired during the walk may
+    // or may not be visited; released ones are skipped from then on.
+    template <typename Fn>
+    void forEach(Fn&& fn)
+    {
+        size_t chunkCount = m_chunks.size();
+        for (size_t c = 0; c < chunkCount; ++c)
+        {
+            Chunk& chunk = *m_chunks[c];
+            for (size_t i = 0; i < chunk.used; ++i)
+            {
+                if (chunk.live[i])
+                    fn(chunk.slots[i]);
+            }
+        }
+    }
+
+    size_t size() const { return m_liveCount; }
+    bool empty() const { return m_liveCount == 0; }
+
+private:
+    struct Chunk
+    {
+        std::array<T, ChunkSize> slots{};
+        std::bitset<ChunkSize> live;
+        size_t used = 0;
+    };
+
+    // Returns whether the slot's live bit changed
+    bool setLive(T* slot, bool live)
+    {
+        for (auto& chunk : m_chunks)
+        {
+            T* first = chunk->slots.data();
+            if (slot < first || slot >= first + ChunkSize)
+                continue;
+
+            size_t index = static_cast<size_t>(slot - first);
+            if (chunk->live[index] == live)
+                return false;
+            chunk->live[index] = live;
+            return true;
+        }
+        return false;
+    }
+
+    std::vector<std::unique_ptr<Chunk>> m_chunks;
+    std::vector<T*> m_free;
+    size_t m_liveCount = 0;
+};
@@ -2,14 +2,37 @@
 #include "Map.h"
 #include "../Core/Logger.h"
 
+#include <chrono>
+#include <cmath>
 #include <fstream>
 
-// Constants matching client's GameMap::Defines
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define MAP_NAV_SSE2 1
+#endif
+
+// Constants matching the .map file layout
 namespace MapDefines
 {
-    constexpr int NumLayers = 4;
-    constexpr int BaseCellWidth = 64;
-    constexpr int BaseCellHeight = 32;
+    // Layer records stored per cell. The client renders 4 layers, but the
+    // .map files only carry 3 per cell (every shipped map parses to EOF with 3).
+    constexpr int NumStoredLayers = 3;
+}
+
+// Sidecar cache for derived navigation data (<map>.nav)
+namespace NavCache
+{
+    constexpr uint32_t Magic = 0x5641444E;  // "NDAV"
+    constexpr uint32_t Version = 1;
+
+    struct Header
+    {
+        uint32_t magic = Magic;
+        uint32_t version = Version;
+        int32_t width = 0;
+        uint32_t regionCount = 0;
+        uint64_t flagsChecksum = 0;
+    };
 }
 
 bool Map::load(const std::string& filepath)
@@ -81,8 +104,8 @@ bool Map::load(const std::string& filepath)
         if (cellId >= 0 && cellId < static_cast<int32_t>(m_cells.size()))
             m_cells[cellId].flags = flags;
 
-        // Skip layer texture data (4 layers)
-        for (int layer = 0; layer < MapDefines::NumLayers; ++layer)
+        // Skip layer texture data
+        for (int layer = 0; layer < MapDefines::NumStoredLayers; ++layer)
         {
             bool hasTexture = false;
             file.read(reinterpret_cast<char*>(&hasTexture), 1);
@@ -132,12 +155,270 @@ bool Map::load(const std::string& filepath)
         readInt32();  // areaId
     }
 
-    LOG_INFO("Map: Loaded '%s' (%dx%d, %zu cells with flags)",
+    LOG_INFO("Map: Loaded '%s' (%dx%d, %d cells with flags)",
              m_name.c_str(), m_width, m_width, numCells);
 
+    // Derived navigation data, cached next to the map file
+    std::string navCachePath = filepath;
+    if (lastDot != std::string::npos && lastDot >= lastSlash)
+        navCachePath = filepath.substr(0, lastDot);
+    navCachePath += ".nav";
+
+    buildNavigation(navCachePath);
+
     return true;
 }
 
+// ============================================================================
+// Navigation Preprocessing
+// ============================================================================
+
+void Map::buildNavigation(const std::string& navCachePath)
+{
+    auto startTime = std::chrono::steady_clock::now();
+
+    // Bitmaps are cheaper to rebuild than to read back
+    buildCellBitmaps();
+
+    uint64_t checksum = computeFlagsChecksum();
+    bool fromCache = loadNavCache(navCachePath, checksum);
+    if (!fromCache)
+    {
+        buildRegions();
+        buildClearance();
+        saveNavCache(navCachePath, checksum);
+    }
+
+    double elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
+
+    LOG_INFO("Map: Navigation for '%s' ready (%u regions, %s, %.1f ms)",
+             m_name.c_str(), m_regionCount, fromCache ? "cached" : "built", elapsedMs);
+}
+
+void Map::buildCellBitmaps()
+{
+    const size_t numCells = m_cells.size();
+    const size_t numWords = (numCells + 63) / 64;
+    m_walkableBits.assign(numWords, 0);
+    m_losBlockBits.assign(numWords, 0);
+
+    const uint8_t* flags = reinterpret_cast<const uint8_t*>(m_cells.data());
+    size_t i = 0;
+
+#ifdef MAP_NAV_SSE2
+    // 16 cells per step: mask the flag bytes, compare against zero and
+    // collapse the byte lanes into a 16-bit mask with movemask
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i unwalkable = _mm_set1_epi8(static_cast<char>(CellFlags::Unwalkable));
+    const __m128i collide = _mm_set1_epi8(static_cast<char>(CellFlags::CollideBlock));
+
+    for (; i + 16 <= numCells; i += 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(flags + i));
+
+        uint32_t walkable = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(v, unwalkable), zero)));
+        uint32_t losBlock = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(v, collide), zero))) ^ 0xFFFFu;
+
+        // i is a multiple of 16, so the 16 bits never straddle two words
+        m_walkableBits[i >> 6] |= static_cast<uint64_t>(walkable) << (i & 63);
+        m_losBlockBits[i >> 6] |= static_cast<uint64_t>(losBlock) << (i & 63);
+    }
+#endif
+
+    for (; i < numCells; ++i)
+    {
+        if ((flags[i] & CellFlags::Unwalkable) == 0)
+            m_walkableBits[i >> 6] |= uint64_t(1) << (i & 63);
+        if ((flags[i] & CellFlags::CollideBlock) != 0)
+            m_losBlockBits[i >> 6] |= uint64_t(1) << (i & 63);
+    }
+}
+
+void Map::buildRegions()
+{
+    const int numCells = getNumCells();
+    m_regions.assign(numCells, MapNav::NoRegion);
+    m_regionCount = 0;
+
+    // 8-connected flood fill (movement is free-direction, diagonals connect)
+    std::vector<int> stack;
+    for (int start = 0; start < numCells; ++start)
+    {
+        if (m_regions[start] != MapNav::NoRegion || !testBit(m_walkableBits, start))
+            continue;
+
+        uint32_t region = ++m_regionCount;
+        m_regions[start] = region;
+        stack.push_back(start);
+
+        while (!stack.empty())
+        {
+            int cell = stack.back();
+            stack.pop_back();
+
+            int x = cell % m_width;
+            int y = cell / m_width;
+
+            for (int ny = std::max(0, y - 1); ny <= std::min(m_width - 1, y + 1); ++ny)
+            {
+                for (int nx = std::max(0, x - 1); nx <= std::min(m_width - 1, x + 1); ++nx)
+                {
+                    int neighbor = ny * m_width + nx;
+                    if (m_regions[neighbor] == MapNav::NoRegion && testBit(m_walkableBits, neighbor))
+                    {
+                        m_regions[neighbor] = region;
+                        stack.push_back(neighbor);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void Map::buildClearance()
+{
+    // Two-pass chessboard distance transform. Unwalkable cells are 0 and the
+    // map edge counts as blocked. The row-to-row step is a plain min over a
+    // padded buffer so the compiler can vectorize it; only the in-row
+    // left/right propagation is sequential.
+    const int w = m_width;
+    const uint8_t* flags = reinterpret_cast<const uint8_t*>(m_cells.data());
+    m_clearance.assign(m_cells.size(), 0);
+
+    std::vector<uint8_t> padded(static_cast<size_t>(w) + 2, 0);
+
+    auto stepFromRow = [&](uint8_t* row, const uint8_t* rowFlags)
+    {
+        const uint8_t* p = padded.data();
+        for (int x = 0; x < w; ++x)
+        {
+            uint8_t m = std::min(std::min(p[x], p[x + 1]), p[x + 2]);
+            uint8_t candidate = static_cast<uint8_t>(m + (m != MapNav::MaxClearance ? 1 : 0));
+            uint8_t blocked = rowFlags[x] & CellFlags::Unwalkable;
+            row[x] = blocked ? 0 : std::min(row[x], candidate);
+        }
+    };
+
+    auto saturatingInc = [](uint8_t v) -> uint8_t
+    {
+        return static_cast<uint8_t>(v + (v != MapNav::MaxClearance ? 1 : 0));
+    };
+
+    // Forward pass: up-left, up, up-right, left
+    for (int y = 0; y < w; ++y)
+    {
+        uint8_t* row = &m_clearance[static_cast<size_t>(y) * w];
+        const uint8_t* rowFlags = flags + static_cast<size_t>(y) * w;
+
+        std::fill(row, row + w, MapNav::MaxClearance);
+        stepFromRow(row, rowFlags);
+
+        uint8_t left = 0;
+        for (int x = 0; x < w; ++x)
+        {
+            row[x] = std::min(row[x], saturatingInc(left));
+            left = row[x];
+        }
+
+        std::copy(row, row + w, padded.begin() + 1);
+    }
+
+    // Backward pass: down-left, down, down-right, right
+    std::fill(padded.begin(), padded.end(), 0);
+    for (int y = w - 1; y >= 0; --y)
+    {
+        uint8_t* row = &m_clearance[static_cast<size_t>(y) * w];
+        const uint8_t* rowFlags = flags + static_cast<size_t>(y) * w;
+
+        stepFromRow(row, rowFlags);
+
+        uint8_t right = 0;
+        for (int x = w - 1; x >= 0; --x)
+        {
+            row[x] = std::min(row[x], saturatingInc(right));
+            right = row[x];
+        }
+
+        std::copy(row, row + w, padded.begin() + 1);
+    }
+}
+
+uint64_t Map::computeFlagsChecksum() const
+{
+    // FNV-1a over width + raw cell flags
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](uint8_t byte)
+    {
+        hash ^= byte;
+        hash *= 1099511628211ULL;
+    };
+
+    for (int shift = 0; shift < 32; shift += 8)
+        mix(static_cast<uint8_t>(static_cast<uint32_t>(m_width) >> shift));
+    for (const MapCell& cell : m_cells)
+        mix(cell.flags);
+
+    return hash;
+}
+
+bool Map::loadNavCache(const std::string& path, uint64_t checksum)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    NavCache::Header header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file ||
+        header.magic != NavCache::Magic ||
+        header.version != NavCache::Version ||
+        header.width != m_width ||
+        header.flagsChecksum != checksum)
+    {
+        LOG_DEBUG("Map: Ignoring stale navigation cache %s", path.c_str());
+        return false;
+    }
+
+    const size_t numCells = m_cells.size();
+    std::vector<uint32_t> regions(numCells);
+    std::vector<uint8_t> clearance(numCells);
+
+    file.read(reinterpret_cast<char*>(regions.data()), numCells * sizeof(uint32_t));
+    file.read(reinterpret_cast<char*>(clearance.data()), numCells);
+    if (!file)
+    {
+        LOG_WARN("Map: Truncated navigation cache %s, rebuilding", path.c_str());
+        return false;
+    }
+
+    m_regions = std::move(regions);
+    m_clearance = std::move(clearance);
+    m_regionCount = header.regionCount;
+    return true;
+}
+
+void Map::saveNavCache(const std::string& path, uint64_t checksum) const
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        LOG_DEBUG("Map: Could not write navigation cache %s", path.c_str());
+        return;
+    }
+
+    NavCache::Header header;
+    header.width = m_width;
+    header.regionCount = m_regionCount;
+    header.flagsChecksum = checksum;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(m_regions.data()), m_regions.size() * sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(m_clearance.data()), m_clearance.size());
+}
+
 const MapCell* Map::getCell(int cellId) const
 {
     if (cellId < 0 || cellId >= static_cast<int>(m_cells.size()))
@@ -152,10 +433,9 @@ const MapCell* Map::getCell(int x, int y) const
 
 bool Map::isWalkable(int cellId) const
 {
-    const MapCell* cell = getCell(cellId);
-    if (!cell)
+    if (cellId < 0 || cellId >= getNumCells())
         return false;  // Out of bounds = not walkable
-    return (cell->flags & CellFlags::Unwalkable) == 0;
+    return testBit(m_walkableBits, cellId);
 }
 
 bool Map::isWalkable(int x, int y) const
@@ -165,10 +445,9 @@ bool Map::isWalkable(int x, int y) const
 
 bool Map::blocksLineOfSight(int cellId) const
 {
-    const MapCell* cell = getCell(cellId);
-    if (!cell)
+    if (cellId < 0 || cellId >= getNumCells())
         return true;  // Out of bounds = blocks
-    return (cell->flags & CellFlags::CollideBlock) != 0;
+    return testBit(m_losBlockBits, cellId);
 }
 
 bool Map::blocksLineOfSight(int x, int y) const
@@ -176,6 +455,26 @@ bool Map::blocksLineOfSight(int x, int y) const
     return blocksLineOfSight(cellIdFromCoords(x, y));
 }
 
+uint32_t Map::getRegionId(int cellId) const
+{
+    if (cellId < 0 || cellId >= getNumCells())
+        return MapNav::NoRegion;
+    return m_regions[cellId];
+}
+
+bool Map::isReachable(int fromCellId, int toCellId) const
+{
+    uint32_t fromRegion = getRegionId(fromCellId);
+    return fromRegion != MapNav::NoRegion && fromRegion == getRegionId(toCellId);
+}
+
+uint8_t Map::getClearance(int cellId) const
+{
+    if (cellId < 0 || cellId >= getNumCells())
+        return 0;
+    return m_clearance[cellId];
+}
+
 int Map::cellIdFromCoords(int x, int y) const
 {
     if (x < 0 || x >= m_width || y < 0 || y >= m_width)
@@ -196,9 +495,16 @@ void Map::coordsFromCellId(int cellId, int& x, int& y) const
 
 int Map::cellIdFromWorldPos(float worldX, float worldY) const
 {
-    // Convert world position to cell coordinates
-    // Client uses isometric projection: BaseCellWidth=64, BaseCellHeight=32
-    int cellX = static_cast<int>(worldX / MapDefines::BaseCellWidth);
-    int cellY = static_cast<int>(worldY / MapDefines::BaseCellHeight);
+    // World positions are already in cell units (spawn tables and map start
+    // positions use the same space); the isometric projection is client-only.
+    // Off-map, NaN and infinite positions are rejected before the int
+    // conversion, which is undefined for them.
+    if (!std::isfinite(worldX) || !std::isfinite(worldY) ||
+        worldX < 0.0f || worldY < 0.0f ||
+        worldX >= static_cast<float>(m_width) || worldY >= static_cast<float>(m_width))
+        return -1;
+
+    int cellX = static_cast<int>(std::floor(worldX));
+    int cellY = static_cast<int>(std::floor(worldY));
     return cellIdFromCoords(cellX, cellY);
 }
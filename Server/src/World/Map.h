@@ -18,6 +18,15 @@ struct MapCell
     uint8_t flags = CellFlags::None;
 };
 
+static_assert(sizeof(MapCell) == 1, "MapCell must stay one byte (bitmap packing reads it as raw flags)");
+
+// Navigation data derived from cell flags at load time
+namespace MapNav
+{
+    constexpr uint32_t NoRegion = 0;          // Region ID of unwalkable/out-of-bounds cells
+    constexpr uint8_t MaxClearance = 255;     // Clearance values saturate here
+}
+
 // Server-side map data loaded from .map files
 class Map
 {
@@ -39,17 +48,27 @@ public:
     // Cell access by coordinates
     const MapCell* getCell(int x, int y) const;
 
-    // Collision queries
+    // Collision queries (O(1) bitmap lookups, built at load)
     bool isWalkable(int cellId) const;
     bool isWalkable(int x, int y) const;
     bool blocksLineOfSight(int cellId) const;
     bool blocksLineOfSight(int x, int y) const;
 
+    // Connected walkable region of a cell (MapNav::NoRegion if unwalkable)
+    uint32_t getRegionId(int cellId) const;
+    uint32_t getRegionCount() const { return m_regionCount; }
+
+    // True if both cells are walkable and in the same connected region
+    bool isReachable(int fromCellId, int toCellId) const;
+
+    // Chebyshev distance (in cells) to the nearest unwalkable cell or map edge
+    uint8_t getClearance(int cellId) const;
+
     // Coordinate conversion
     int cellIdFromCoords(int x, int y) const;
     void coordsFromCellId(int cellId, int& x, int& y) const;
 
-    // World position to cell
+    // World position to cell (world coordinates are in cell units)
     int cellIdFromWorldPos(float worldX, float worldY) const;
 
     // Map name
@@ -58,8 +77,31 @@ public:
     void setMapId(int id) { m_mapId = id; }
 
 private:
+    // Build packed bitmaps, region labels and clearance field from m_cells
+    void buildNavigation(const std::string& navCachePath);
+    void buildCellBitmaps();
+    void buildRegions();
+    void buildClearance();
+
+    // Region/clearance sidecar cache (<map>.nav next to the .map file)
+    uint64_t computeFlagsChecksum() const;
+    bool loadNavCache(const std::string& path, uint64_t checksum);
+    void saveNavCache(const std::string& path, uint64_t checksum) const;
+
+    bool testBit(const std::vector<uint64_t>& bits, int cellId) const
+    {
+        return (bits[static_cast<size_t>(cellId) >> 6] >> (cellId & 63)) & 1u;
+    }
+
     std::string m_name;
     int m_mapId = 0;
     int m_width = 0;
     std::vector<MapCell> m_cells;
+
+    // Navigation data (one bit / entry per cell)
+    std::vector<uint64_t> m_walkableBits;   // Set = walkable
+    std::vector<uint64_t> m_losBlockBits;   // Set = blocks line of sight
+    std::vector<uint32_t> m_regions;        // Connected component ID per cell
+    std::vector<uint8_t> m_clearance;       // Distance to nearest blocked cell
+    uint32_t m_regionCount = 0;
 };
@@ -35,21 +35,25 @@ void MapManager::shutdown()
 
 Map* MapManager::getMap(int mapId)
 {
-    std::lock_guard<std::mutex> lock(m_mapMutex);
+    Map* result = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mapMutex);
 
-    // Check if already loaded
-    auto it = m_loadedMaps.find(mapId);
-    if (it != m_loadedMaps.end())
-        return it->second.get();
+        // Check if already loaded
+        auto it = m_loadedMaps.find(mapId);
+        if (it != m_loadedMaps.end())
+            return it->second.get();
 
-    // Load the map
-    auto map = loadMapFromFile(mapId);
-    if (!map)
-        return nullptr;
+        // Load the map
+        auto map = loadMapFromFile(mapId);
+        if (!map)
+            return nullptr;
 
-    Map* result = map.get();
-    m_loadedMaps[mapId] = std::move(map);
+        result = map.get();
+        m_loadedMaps[mapId] = std::move(map);
+    }
 
+    // Spawned NPCs look their map back up, so spawn outside the lock
     sNpcSpawner.loadSpawnsForMap(mapId);
 
     return result;
@@ -9,6 +9,7 @@
 #include "../AI/NpcAI.h"
 #include "NpcSpawner.h"
 #include "../Core/Logger.h"
+#include "../Core/Random.h"
 #include "../Systems/LootSystem.h"
 #include "../Systems/QuestManager.h"
 #include "../Systems/ExperienceSystem.h"
@@ -20,17 +21,28 @@
 #include <algorithm>
 #include <random>
 
+// Per-tick fields live in NpcHotState; what stays here beyond Entity is
+// read on interaction, spawn and death
+static_assert(sizeof(Npc) - sizeof(Entity) <= 3 * CACHE_LINE_SIZE,
+              "cold Npc members grew; per-tick fields belong in NpcHotState");
+
 // ============================================================================
 // Constructor / Destructor
 // ============================================================================
 
-Npc::Npc(const NpcTemplate& tmpl, int32_t mapId, float x, float y, float orientation)
-    : m_entry(tmpl.entry)
+Npc::Npc(const NpcTemplate& tmpl, NpcHotState& hot, int32_t mapId, float x, float y, float orientation)
+    : m_hot(hot)
+    , m_entry(tmpl.entry)
     , m_template(&tmpl)
-    , m_homeX(x)
-    , m_homeY(y)
-    , m_homeOrientation(orientation)
 {
+    m_hot.owner = this;
+    m_hot.homeX = x;
+    m_hot.homeY = y;
+    m_hot.homeOrientation = orientation;
+    m_hot.aggroRange = DEFAULT_AGGRO_RANGE;
+    m_hot.leashRange = DEFAULT_LEASH_RANGE;
+    m_hot.meleeRange = DEFAULT_MELEE_RANGE;
+
     // Set entity position
     setPosition(mapId, x, y);
     setOrientation(orientation);
@@ -59,21 +71,21 @@ void Npc::initFromTemplate(const NpcTemplate& tmpl)
     setName(tmpl.name);
 
     // Faction and flags
-    m_faction = tmpl.faction;
+    m_hot.faction = tmpl.faction;
     m_npcFlags = tmpl.npcFlags;
     m_isElite = (tmpl.boolElite != 0);
     m_isBoss = (tmpl.boolBoss != 0);
 
     // Combat properties
-    m_leashRange = tmpl.leashRange > 0 ? static_cast<float>(tmpl.leashRange) : DEFAULT_LEASH_RANGE;
-    m_meleeSpeed = tmpl.meleeSpeed > 0 ? tmpl.meleeSpeed : 2000;
+    m_hot.leashRange = tmpl.leashRange > 0 ? static_cast<float>(tmpl.leashRange) : DEFAULT_LEASH_RANGE;
+    m_hot.meleeSpeed = tmpl.meleeSpeed > 0 ? tmpl.meleeSpeed : 2000;
     m_weaponValue = tmpl.weaponValue > 0 ? tmpl.weaponValue : 10;
 
     // Determine level (random between min and max)
     int32_t level = tmpl.minLevel;
     if (tmpl.maxLevel > tmpl.minLevel)
     {
-        static thread_local std::mt19937 rng(std::random_device{}());
+        std::mt19937& rng = Random::engine();
         std::uniform_int_distribution<int32_t> dist(tmpl.minLevel, tmpl.maxLevel);
         level = dist(rng);
     }
@@ -111,7 +123,7 @@ void Npc::initFromTemplate(const NpcTemplate& tmpl)
     m_primarySpellId = tmpl.spellPrimary;
 
     // Set faction variable
-    setVariable(ObjDefines::Variable::Faction, m_faction);
+    setVariable(ObjDefines::Variable::Faction, m_hot.faction);
 
     // Model/visuals
     setVariable(ObjDefines::Variable::ModelId, tmpl.modelId);
@@ -159,27 +171,24 @@ int32_t Npc::calculateMana(int32_t level) const
 void Npc::update(float deltaTime)
 {
     // Handle respawn timer when dead
-    if (m_aiState == NpcAIState::Dead)
+    if (m_hot.aiState == NpcAIState::Dead)
     {
-        m_deathTimer += deltaTime * 1000.0f;  // Convert to ms
+        m_hot.deathTimer += deltaTime * 1000.0f;  // Convert to ms
         // Respawn is triggered externally by WorldManager
         return;
     }
 
     // Update attack cooldown timer
-    m_attackTimer += deltaTime;
+    m_hot.attackTimer += deltaTime;
 
     // Update spell cooldown
-    if (m_spellCooldown > 0.0f)
+    if (m_hot.spellCooldown > 0.0f)
     {
-        m_spellCooldown -= deltaTime;
-        if (m_spellCooldown < 0.0f)
-            m_spellCooldown = 0.0f;
+        m_hot.spellCooldown -= deltaTime;
+        if (m_hot.spellCooldown < 0.0f)
+            m_hot.spellCooldown = 0.0f;
     }
 
-    // Update auras
-    getAuras().update(static_cast<int32_t>(deltaTime * 1000.0f));
-
     // AI update (Task 5.14)
     NpcAI::update(this, deltaTime);
 }
@@ -203,7 +212,7 @@ bool Npc::isHostileTo(Entity* other) const
     {
         // TODO: Implement proper faction system
         // For now: faction 1 = friendly to players, faction 2+ = hostile
-        if (m_faction >= 2)
+        if (m_hot.faction >= 2)
         {
             return true;
         }
@@ -273,13 +282,13 @@ void Npc::addThreat(Entity* attacker, int32_t amount)
     // If idle, enter combat state immediately
     // This prevents chain-reaction call-for-help cascades where each NPC
     // would otherwise stay idle, then enter combat on next tick and call for help again
-    if (m_aiState == NpcAIState::Idle)
+    if (m_hot.aiState == NpcAIState::Idle)
     {
-        m_aiState = NpcAIState::Combat;
+        m_hot.aiState = NpcAIState::Combat;
         setTarget(attacker);
         // Mark as already having called for help to prevent cascade
         // (this NPC was already recruited via someone else's call for help)
-        m_calledForHelp = true;
+        m_hot.calledForHelp = true;
         LOG_DEBUG("Npc '%s': Aggro on '%s' (threat=%d)",
                   m_name.c_str(), attacker->getName().c_str(), amount);
     }
@@ -287,13 +296,13 @@ void Npc::addThreat(Entity* attacker, int32_t amount)
 
 void Npc::setTarget(Entity* target)
 {
-    if (m_target != target)
+    if (m_hot.target != target)
     {
-        m_target = target;
+        m_hot.target = target;
 
         if (target)
         {
-            m_aiState = NpcAIState::Combat;
+            m_hot.aiState = NpcAIState::Combat;
             LOG_DEBUG("Npc '{}': Set target to entity {}", m_name, target->getGuid());
 
             if (::Player* player = dynamic_cast<::Player*>(target))
@@ -311,7 +320,7 @@ void Npc::setTarget(Entity* target)
         }
         else
         {
-            m_aiState = NpcAIState::Idle;
+            m_hot.aiState = NpcAIState::Idle;
             LOG_DEBUG("Npc '{}': Cleared target", m_name);
         }
     }
@@ -323,8 +332,8 @@ void Npc::setTarget(Entity* target)
 
 float Npc::distanceFromHome() const
 {
-    float dx = getX() - m_homeX;
-    float dy = getY() - m_homeY;
+    float dx = getX() - m_hot.homeX;
+    float dy = getY() - m_hot.homeY;
     return std::sqrt(dx * dx + dy * dy);
 }
 
@@ -346,37 +355,40 @@ void Npc::onDeath(Entity* killer)
     Entity::onDeath(killer);
 
     // Set AI state to dead
-    m_aiState = NpcAIState::Dead;
-    m_deathTimer = 0.0f;
+    m_hot.aiState = NpcAIState::Dead;
+    m_hot.deathTimer = 0.0f;
 
     // Clear target and threat list
-    m_target = nullptr;
+    m_hot.target = nullptr;
     m_threatManager.clear();
 
+    // Kill rewards are worked out once, over everyone credited with the
+    // kill (the killer and their party members nearby)
+    const std::vector<::Player*>& credited = sExperienceSystem.gatherKillCredit(killer, this);
+
     // Generate loot (Phase 6.4)
-    sLootManager.generateLoot(this, killer);
+    sLootManager.generateLoot(this, killer, credited);
 
     // Quest progress (Phase 7)
-    if (::Player* player = dynamic_cast<::Player*>(killer))
-    {
+    for (::Player* player : credited)
         sQuestManager.onNpcKilled(player, m_entry);
-        sExperienceSystem.onNpcKilled(player, this);
-    }
+    sExperienceSystem.onNpcKilled(credited, this);
 
     // Schedule respawn (Phase 7.1)
     sNpcSpawner.onNpcDeath(this);
 
-    // TODO: Broadcast death animation/corpse state
+    // The corpse (and its loot flag) reaches viewers with this tick's
+    // lifecycle flush - setDead and generateLoot queued the events
 }
 
 void Npc::respawn()
 {
     LOG_INFO("Npc '%s' (entry=%d) respawning at (%.1f, %.1f)",
-             m_name.c_str(), m_entry, m_homeX, m_homeY);
+             m_name.c_str(), m_entry, m_hot.homeX, m_hot.homeY);
 
     // Restore to home position
-    setPosition(getMapId(), m_homeX, m_homeY);
-    setOrientation(m_homeOrientation);
+    setPosition(getMapId(), m_hot.homeX, m_hot.homeY);
+    setOrientation(m_hot.homeOrientation);
 
     // Restore full health/mana
     int32_t maxHealth = getVariable(ObjDefines::Variable::MaxHealth);
@@ -390,26 +402,53 @@ void Npc::respawn()
     }
 
     // Reset AI state
-    m_aiState = NpcAIState::Idle;
-    m_target = nullptr;
-    m_deathTimer = 0.0f;
-    m_waypointIndex = 0;
-    m_waypointWaitTimer = 0.0f;
-    m_hasWanderTarget = false;
-    m_wanderWaitTimer = 0.0f;
-    m_calledForHelp = false;
+    m_hot.aiState = NpcAIState::Idle;
+    m_hot.target = nullptr;
+    m_hot.deathTimer = 0.0f;
+    m_hot.waypointIndex = 0;
+    m_hot.waypointWaitTimer = 0.0f;
+    m_hot.wanderTargetIndex = -1;
+    m_hot.wanderWaitTimer = 0.0f;
+    m_hot.calledForHelp = false;
 
     // Clear all auras
     getAuras().clearAll(true);
 
+    // Any loot left on the corpse went with it
+    setVariable(ObjDefines::Variable::DynLootable, 0);
+
     // Mark as spawned
     setSpawned(true);
+    queueLifecycleEvent(NpcLifecycleEvent::Respawned);
+}
+
+void Npc::restoreCorpse()
+{
+    setVariable(ObjDefines::Variable::Health, 0);
+    setDead(true);
 
-    // TODO: Broadcast spawn to nearby players
-    // This would require sending GP_Server_Npc to all players who can see this position
+    m_hot.aiState = NpcAIState::Dead;
+    m_hot.deathTimer = 0.0f;
+    m_hot.target = nullptr;
+    m_threatManager.clear();
+}
+
+void Npc::queueLifecycleEvent(NpcLifecycleEvent event)
+{
+    if (m_lifecycleEvents == 0)
+        sWorldManager.queueNpcLifecycle(this);
+
+    m_lifecycleEvents |= static_cast<uint8_t>(event);
+}
+
+uint8_t Npc::takeLifecycleEvents()
+{
+    uint8_t events = m_lifecycleEvents;
+    m_lifecycleEvents = 0;
+    return events;
 }
 
 bool Npc::isReadyToRespawn() const
 {
-    return m_aiState == NpcAIState::Dead && m_deathTimer >= m_respawnTimeMs;
+    return m_hot.aiState == NpcAIState::Dead && m_hot.deathTimer >= m_respawnTimeMs;
 }
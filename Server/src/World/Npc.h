@@ -5,9 +5,11 @@
 #pragma once
 
 #include "Entity.h"
+#include "HotStatePool.h"
 #include "../Database/GameData.h"
 #include "../AI/NpcAI.h"
 #include "../AI/ThreatManager.h"
+#include "StlBuffer.h"
 #include <string>
 
 class Player;
@@ -24,6 +26,21 @@ enum class NpcAIState
     Dead,       // Waiting for respawn
 };
 
+// ============================================================================
+// NPC Lifecycle Events
+// ============================================================================
+
+// Lifecycle changes viewers have to hear about. An NPC collects them as bits
+// and queues itself with WorldManager once per tick; the flush then sends
+// each viewer a single packet for the state the NPC ended the tick in.
+enum class NpcLifecycleEvent : uint8_t
+{
+    Died            = 1 << 0,
+    CorpseLootable  = 1 << 1,
+    Despawned       = 1 << 2,
+    Respawned       = 1 << 3,
+};
+
 // ============================================================================
 // NPC Waypoint
 // ============================================================================
@@ -37,6 +54,69 @@ struct NpcWaypoint
     bool run = false;
 };
 
+// Patrol path resolved once when a map's spawns load, shared by every NPC
+// walking it. splineTails[i] is the packed GP_Server_UnitSpline tail for the
+// leg ending at waypoint i (see NpcAI::buildSplineTail).
+struct NpcPatrolPath
+{
+    std::vector<NpcWaypoint> waypoints;
+    std::vector<StlBuffer> splineTails;
+};
+
+// Reachable wander point around a spawn's home, precomputed per spawn
+struct NpcWanderTarget
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    StlBuffer splineTail;
+};
+
+// ============================================================================
+// NPC Hot State
+// ============================================================================
+
+class Npc;
+
+// Fields the NPC tick and AI touch every update, kept apart from the NPC's
+// cold members (names, template, threat list, spawn packet cache). Slots
+// come from a per-map HotStatePool owned by WorldManager, so the update
+// loop walks them contiguously and only dereferences the Npc for live AI.
+struct NpcHotState
+{
+    Npc* owner = nullptr;
+    Entity* target = nullptr;
+    const NpcPatrolPath* patrolPath = nullptr;
+    const std::vector<NpcWanderTarget>* wanderTargets = nullptr;
+    Player* aggroCandidate = nullptr;   // Parallel aggro pass result (see aggroScanned)
+
+    float homeX = 0.0f;
+    float homeY = 0.0f;
+    float homeOrientation = 0.0f;
+    float aggroRange = 0.0f;
+    float leashRange = 0.0f;
+    float meleeRange = 0.0f;
+
+    float attackTimer = 0.0f;        // Time since last melee attack
+    float spellCooldown = 0.0f;      // Time until spell can be cast again
+    float deathTimer = 0.0f;         // ms since death
+    float waypointWaitTimer = 0.0f;
+    float wanderWaitTimer = 0.0f;
+
+    int32_t meleeSpeed = 2000;
+    int32_t faction = 1;
+    int32_t movementType = 0;
+    int32_t waypointIndex = 0;
+    int32_t wanderTargetIndex = -1;
+
+    NpcAIState aiState = NpcAIState::Idle;
+    bool callForHelp = true;
+    bool calledForHelp = false;
+    bool aggroScanned = false;          // aggroCandidate is from this tick
+};
+
+static_assert(sizeof(NpcHotState) <= 2 * CACHE_LINE_SIZE,
+              "NpcHotState is walked every tick; keep it within two cache lines");
+
 // ============================================================================
 // NPC Entity
 // ============================================================================
@@ -44,8 +124,10 @@ struct NpcWaypoint
 class Npc : public Entity
 {
 public:
-    // Create NPC from template at spawn position
-    Npc(const NpcTemplate& tmpl, int32_t mapId, float x, float y, float orientation = 0.0f);
+    // Create NPC from template at spawn position; `hot` is a fresh slot from
+    // the map's hot state pool and must outlive the NPC
+    Npc(const NpcTemplate& tmpl, NpcHotState& hot, int32_t mapId, float x, float y,
+        float orientation = 0.0f);
     ~Npc() override;
 
     // Entity interface
@@ -53,12 +135,14 @@ public:
     MutualObject::Type getType() const override { return MutualObject::Type::Npc; }
     const std::string& getName() const override { return m_name; }
 
+    NpcHotState& getHotState() { return m_hot; }
+
     // Template info
     int32_t getEntry() const { return m_entry; }
     const NpcTemplate* getTemplate() const { return m_template; }
 
     // Faction/hostility
-    int32_t getFaction() const { return m_faction; }
+    int32_t getFaction() const { return m_hot.faction; }
     bool isHostileTo(Entity* other) const;
     bool isFriendlyTo(Entity* other) const;
 
@@ -71,24 +155,35 @@ public:
     bool isBoss() const { return m_isBoss; }
 
     // Combat
-    float getAggroRange() const { return m_aggroRange; }
-    float getLeashRange() const { return m_leashRange; }
-    float getMeleeRange() const { return m_meleeRange; }
-    int32_t getMeleeSpeed() const { return m_meleeSpeed; }
+    float getAggroRange() const { return m_hot.aggroRange; }
+    float getLeashRange() const { return m_hot.leashRange; }
+    float getMeleeRange() const { return m_hot.meleeRange; }
+    int32_t getMeleeSpeed() const { return m_hot.meleeSpeed; }
     int32_t getMeleeDamage() const;
 
     // AI state
-    NpcAIState getAIState() const { return m_aiState; }
-    void setAIState(NpcAIState state) { m_aiState = state; }
+    NpcAIState getAIState() const { return m_hot.aiState; }
+    void setAIState(NpcAIState state) { m_hot.aiState = state; }
+
+    // Aggro pick made by the world's parallel pass this tick, if any
+    // (consumed by NpcAI::findAggroTarget)
+    bool takeAggroCandidate(::Player*& candidate)
+    {
+        if (!m_hot.aggroScanned)
+            return false;
+        m_hot.aggroScanned = false;
+        candidate = m_hot.aggroCandidate;
+        return true;
+    }
 
     // Combat target
-    Entity* getTarget() const { return m_target; }
+    Entity* getTarget() const { return m_hot.target; }
     void setTarget(Entity* target);
-    bool hasTarget() const { return m_target != nullptr; }
+    bool hasTarget() const { return m_hot.target != nullptr; }
 
     // Home position (where NPC spawned)
-    float getHomeX() const { return m_homeX; }
-    float getHomeY() const { return m_homeY; }
+    float getHomeX() const { return m_hot.homeX; }
+    float getHomeY() const { return m_hot.homeY; }
     float distanceFromHome() const;
     bool isAtHome() const;
 
@@ -96,9 +191,18 @@ public:
     void onDeath(Entity* killer) override;
     void respawn();
     bool isReadyToRespawn() const;
+
+    // Put a freshly spawned NPC straight into its corpse state (world
+    // checkpoint restore); skips loot, quest credit and respawn scheduling
+    void restoreCorpse();
     int32_t getRespawnTimeMs() const { return m_respawnTimeMs; }
     void setRespawnTimeMs(int32_t ms) { m_respawnTimeMs = ms; }
 
+    // Lifecycle replication (see NpcLifecycleEvent); take returns and clears
+    // the bits collected since the last flush
+    void queueLifecycleEvent(NpcLifecycleEvent event);
+    uint8_t takeLifecycleEvents();
+
     // Loot (stub for Phase 7)
     int32_t getCustomLootId() const { return m_customLootId; }
 
@@ -114,13 +218,13 @@ public:
     void addThreat(Entity* attacker, int32_t amount);
 
     // Attack timing (Task 5.14)
-    float getTimeSinceLastAttack() const { return m_attackTimer; }
-    void resetAttackTimer() { m_attackTimer = 0.0f; }
+    float getTimeSinceLastAttack() const { return m_hot.attackTimer; }
+    void resetAttackTimer() { m_hot.attackTimer = 0.0f; }
 
     // Spell cooldown (for NPC spell casting)
-    float getSpellCooldown() const { return m_spellCooldown; }
-    void setSpellCooldown(float cooldown) { m_spellCooldown = cooldown; }
-    bool isSpellOnCooldown() const { return m_spellCooldown > 0.0f; }
+    float getSpellCooldown() const { return m_hot.spellCooldown; }
+    void setSpellCooldown(float cooldown) { m_hot.spellCooldown = cooldown; }
+    bool isSpellOnCooldown() const { return m_hot.spellCooldown > 0.0f; }
 
     // Configuration
     static constexpr float DEFAULT_AGGRO_RANGE = 5.0f;
@@ -132,8 +236,8 @@ public:
     int32_t getSpawnId() const { return m_spawnId; }
     void setSpawnId(int32_t spawnId) { m_spawnId = spawnId; }
 
-    int32_t getMovementType() const { return m_movementType; }
-    void setMovementType(int32_t movementType) { m_movementType = movementType; }
+    int32_t getMovementType() const { return m_hot.movementType; }
+    void setMovementType(int32_t movementType) { m_hot.movementType = movementType; }
 
     int32_t getPathId() const { return m_pathId; }
     void setPathId(int32_t pathId) { m_pathId = pathId; }
@@ -141,34 +245,38 @@ public:
     float getWanderDistance() const { return m_wanderDistance; }
     void setWanderDistance(float distance) { m_wanderDistance = distance; }
 
-    bool shouldCallForHelp() const { return m_callForHelp; }
-    void setCallForHelp(bool value) { m_callForHelp = value; }
+    bool shouldCallForHelp() const { return m_hot.callForHelp; }
+    void setCallForHelp(bool value) { m_hot.callForHelp = value; }
+
+    // Shared, spawner-owned movement tables (may be null)
+    const NpcPatrolPath* getPatrolPath() const { return m_hot.patrolPath; }
+    void setPatrolPath(const NpcPatrolPath* path) { m_hot.patrolPath = path; }
 
-    std::vector<NpcWaypoint>& getWaypoints() { return m_waypoints; }
-    const std::vector<NpcWaypoint>& getWaypoints() const { return m_waypoints; }
+    const std::vector<NpcWanderTarget>* getWanderTargets() const { return m_hot.wanderTargets; }
+    void setWanderTargets(const std::vector<NpcWanderTarget>* targets) { m_hot.wanderTargets = targets; }
 
-    int32_t getCurrentWaypointIndex() const { return m_waypointIndex; }
-    void setCurrentWaypointIndex(int32_t index) { m_waypointIndex = index; }
+    int32_t getCurrentWaypointIndex() const { return m_hot.waypointIndex; }
+    void setCurrentWaypointIndex(int32_t index) { m_hot.waypointIndex = index; }
 
-    float getWaypointWaitTimer() const { return m_waypointWaitTimer; }
-    void setWaypointWaitTimer(float timer) { m_waypointWaitTimer = timer; }
+    float getWaypointWaitTimer() const { return m_hot.waypointWaitTimer; }
+    void setWaypointWaitTimer(float timer) { m_hot.waypointWaitTimer = timer; }
 
-    bool hasWanderTarget() const { return m_hasWanderTarget; }
-    void setWanderTarget(float x, float y)
+    bool hasWanderTarget() const { return m_hot.wanderTargetIndex >= 0; }
+    void setWanderTarget(int32_t index) { m_hot.wanderTargetIndex = index; }
+    void clearWanderTarget() { m_hot.wanderTargetIndex = -1; }
+    const NpcWanderTarget* getWanderTarget() const
     {
-        m_wanderTargetX = x;
-        m_wanderTargetY = y;
-        m_hasWanderTarget = true;
+        if (!m_hot.wanderTargets || m_hot.wanderTargetIndex < 0 ||
+            static_cast<size_t>(m_hot.wanderTargetIndex) >= m_hot.wanderTargets->size())
+            return nullptr;
+        return &(*m_hot.wanderTargets)[m_hot.wanderTargetIndex];
     }
-    void clearWanderTarget() { m_hasWanderTarget = false; }
-    float getWanderTargetX() const { return m_wanderTargetX; }
-    float getWanderTargetY() const { return m_wanderTargetY; }
 
-    float getWanderWaitTimer() const { return m_wanderWaitTimer; }
-    void setWanderWaitTimer(float timer) { m_wanderWaitTimer = timer; }
+    float getWanderWaitTimer() const { return m_hot.wanderWaitTimer; }
+    void setWanderWaitTimer(float timer) { m_hot.wanderWaitTimer = timer; }
 
-    bool hasCalledForHelp() const { return m_calledForHelp; }
-    void setCalledForHelp(bool called) { m_calledForHelp = called; }
+    bool hasCalledForHelp() const { return m_hot.calledForHelp; }
+    void setCalledForHelp(bool called) { m_hot.calledForHelp = called; }
 
 private:
     // Initialize stats from template
@@ -176,42 +284,29 @@ private:
     int32_t calculateHealth(int32_t level, bool isElite, bool isBoss) const;
     int32_t calculateMana(int32_t level) const;
 
+    // Per-tick state (pooled, see NpcHotState)
+    NpcHotState& m_hot;
+
     // Template reference
     int32_t m_entry = 0;
     const NpcTemplate* m_template = nullptr;
     std::string m_name;
     std::string m_subname;
 
-    // Faction
-    int32_t m_faction = 1;
-
     // Flags
     int32_t m_npcFlags = 0;
     bool m_isElite = false;
     bool m_isBoss = false;
 
     // Combat properties
-    float m_aggroRange = DEFAULT_AGGRO_RANGE;
-    float m_leashRange = DEFAULT_LEASH_RANGE;
-    float m_meleeRange = DEFAULT_MELEE_RANGE;
-    int32_t m_meleeSpeed = 2000;
     int32_t m_weaponValue = 10;
 
-    // Home position
-    float m_homeX = 0.0f;
-    float m_homeY = 0.0f;
-    float m_homeOrientation = 0.0f;
-
-    // AI state
-    NpcAIState m_aiState = NpcAIState::Idle;
-    Entity* m_target = nullptr;
+    // Threat list (Task 5.14)
     ThreatManager m_threatManager;
-    float m_attackTimer = 0.0f;  // Time since last melee attack
-    float m_spellCooldown = 0.0f;  // Time until spell can be cast again
 
     // Death/respawn
     int32_t m_respawnTimeMs = DEFAULT_RESPAWN_TIME_MS;
-    float m_deathTimer = 0.0f;
+    uint8_t m_lifecycleEvents = 0;   // Pending NpcLifecycleEvent bits (non-zero = queued)
 
     // Content references
     int32_t m_gossipMenuId = 0;
@@ -220,20 +315,6 @@ private:
 
     // Spawn info (Task 7.1)
     int32_t m_spawnId = 0;
-    int32_t m_movementType = 0;
     int32_t m_pathId = 0;
     float m_wanderDistance = 0.0f;
-    bool m_callForHelp = true;
-
-    // Movement state (Task 7.4)
-    std::vector<NpcWaypoint> m_waypoints;
-    int32_t m_waypointIndex = 0;
-    float m_waypointWaitTimer = 0.0f;
-    float m_wanderTargetX = 0.0f;
-    float m_wanderTargetY = 0.0f;
-    bool m_hasWanderTarget = false;
-    float m_wanderWaitTimer = 0.0f;
-
-    // Combat coordination
-    bool m_calledForHelp = false;
 };
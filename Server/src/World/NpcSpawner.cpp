@@ -7,8 +7,13 @@
 #include "../Core/Logger.h"
 #include "../Database/GameData.h"
 #include "WorldManager.h"
+#include "MapManager.h"
+#include "Map.h"
+#include "NpcDefines.h"
 
 #include <sqlite3.h>
+#include <algorithm>
+#include <cmath>
 
 NpcSpawner& NpcSpawner::instance()
 {
@@ -58,12 +63,17 @@ void NpcSpawner::loadGroups()
     sqlite3_close(db);
 }
 
-void NpcSpawner::loadWaypoints(int32_t pathId)
+void NpcSpawner::loadWaypoints(const std::vector<int32_t>& pathIds)
 {
-    if (pathId <= 0 || m_loadedPathIds.count(pathId) > 0)
-        return;
+    std::vector<int32_t> toLoad;
+    for (int32_t pathId : pathIds)
+    {
+        if (pathId > 0 && m_loadedPathIds.insert(pathId).second)
+            toLoad.push_back(pathId);
+    }
 
-    m_loadedPathIds.insert(pathId);
+    if (toLoad.empty())
+        return;
 
     sqlite3* db = nullptr;
     if (sqlite3_open_v2(sConfig.getGameDbPath().c_str(), &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK)
@@ -83,27 +93,129 @@ void NpcSpawner::loadWaypoints(int32_t pathId)
         return;
     }
 
-    sqlite3_bind_int(stmt, 1, pathId);
-
-    std::vector<NpcWaypoint> waypoints;
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    for (int32_t pathId : toLoad)
     {
-        NpcWaypoint wp;
-        wp.x = static_cast<float>(sqlite3_column_double(stmt, 1));
-        wp.y = static_cast<float>(sqlite3_column_double(stmt, 2));
-        wp.orientation = static_cast<float>(sqlite3_column_double(stmt, 3));
-        wp.run = sqlite3_column_int(stmt, 4) != 0;
-        wp.waitTimeMs = sqlite3_column_int(stmt, 5);
-        waypoints.push_back(wp);
+        sqlite3_reset(stmt);
+        sqlite3_bind_int(stmt, 1, pathId);
+
+        NpcPatrolPath path;
+        while (sqlite3_step(stmt) == SQLITE_ROW)
+        {
+            NpcWaypoint wp;
+            wp.x = static_cast<float>(sqlite3_column_double(stmt, 1));
+            wp.y = static_cast<float>(sqlite3_column_double(stmt, 2));
+            wp.orientation = static_cast<float>(sqlite3_column_double(stmt, 3));
+            wp.run = sqlite3_column_int(stmt, 4) != 0;
+            wp.waitTimeMs = sqlite3_column_int(stmt, 5);
+            path.waypoints.push_back(wp);
+        }
+
+        if (path.waypoints.empty())
+            continue;
+
+        // Pre-resolve the spline sent while walking each leg
+        path.splineTails.reserve(path.waypoints.size());
+        for (const NpcWaypoint& wp : path.waypoints)
+            path.splineTails.push_back(NpcAI::buildSplineTail(wp.x, wp.y));
+
+        LOG_DEBUG("NpcSpawner: Loaded %zu waypoints for path %d", path.waypoints.size(), pathId);
+        m_pathsById[pathId] = std::move(path);
     }
 
     sqlite3_finalize(stmt);
     sqlite3_close(db);
+}
+
+void NpcSpawner::placeSpawn(NpcSpawnInfo& spawn, const Map* map)
+{
+    if (!map)
+        return;
 
-    if (!waypoints.empty())
+    int homeCell = map->cellIdFromWorldPos(spawn.x, spawn.y);
+    if (map->getRegionId(homeCell) == MapNav::NoRegion ||
+        map->getClearance(homeCell) >= NpcAI::MIN_SPAWN_CLEARANCE)
+        return;
+
+    // Hugging a wall: move to the nearest clearer cell in the same region,
+    // searching outward ring by ring. Keep the authored spot if none is close.
+    for (int radius = 1; radius <= NpcAI::SPAWN_NUDGE_RADIUS; ++radius)
     {
-        m_waypointsByPathId[pathId] = std::move(waypoints);
-        LOG_DEBUG("NpcSpawner: Loaded {} waypoints for path {}", m_waypointsByPathId[pathId].size(), pathId);
+        int bestDx = 0, bestDy = 0, bestDistSq = -1;
+        for (int dy = -radius; dy <= radius; ++dy)
+        {
+            for (int dx = -radius; dx <= radius; ++dx)
+            {
+                if (std::max(std::abs(dx), std::abs(dy)) != radius)
+                    continue;
+
+                int distSq = dx * dx + dy * dy;
+                if (bestDistSq >= 0 && distSq >= bestDistSq)
+                    continue;
+
+                int cell = map->cellIdFromWorldPos(spawn.x + static_cast<float>(dx), spawn.y + static_cast<float>(dy));
+                if (map->getClearance(cell) >= NpcAI::MIN_SPAWN_CLEARANCE && map->isReachable(homeCell, cell))
+                {
+                    bestDx = dx;
+                    bestDy = dy;
+                    bestDistSq = distSq;
+                }
+            }
+        }
+
+        if (bestDistSq >= 0)
+        {
+            LOG_DEBUG("NpcSpawner: Spawn %d moved (%d, %d) cells away from a wall",
+                      spawn.spawnId, bestDx, bestDy);
+            spawn.x += static_cast<float>(bestDx);
+            spawn.y += static_cast<float>(bestDy);
+            return;
+        }
+    }
+}
+
+void NpcSpawner::buildWanderTargets(NpcSpawnInfo& spawn, const Map* map)
+{
+    spawn.wanderTargets.clear();
+
+    float radius = spawn.wanderDistance;
+    if (radius <= 0.0f ||
+        spawn.resolvedMovementType != static_cast<int32_t>(NpcDefines::DefaultMovement::Random))
+        return;
+
+    // Candidate points on a grid over the wander disc, thinned so large radii
+    // still produce at most MAX_WANDER_TARGETS entries
+    int cells = static_cast<int>(std::ceil(radius));
+    float area = 3.14159265f * radius * radius;
+    int stride = std::max(1, static_cast<int>(std::ceil(std::sqrt(area / NpcAI::MAX_WANDER_TARGETS))));
+
+    int homeCell = map ? map->cellIdFromWorldPos(spawn.x, spawn.y) : -1;
+    bool checkMap = map && map->getRegionId(homeCell) != MapNav::NoRegion;
+
+    for (int dy = -cells; dy <= cells; dy += stride)
+    {
+        for (int dx = -cells; dx <= cells; dx += stride)
+        {
+            if (static_cast<float>(dx * dx + dy * dy) > radius * radius)
+                continue;
+
+            float x = spawn.x + static_cast<float>(dx);
+            float y = spawn.y + static_cast<float>(dy);
+
+            // Reachable from home and not pressed against a wall
+            int cell = map ? map->cellIdFromWorldPos(x, y) : -1;
+            if (checkMap && (!map->isReachable(homeCell, cell) ||
+                             map->getClearance(cell) < NpcAI::MIN_WANDER_CLEARANCE))
+                continue;
+
+            NpcWanderTarget target;
+            target.x = x;
+            target.y = y;
+            target.splineTail = NpcAI::buildSplineTail(x, y);
+            spawn.wanderTargets.push_back(std::move(target));
+
+            if (spawn.wanderTargets.size() >= static_cast<size_t>(NpcAI::MAX_WANDER_TARGETS))
+                return;
+        }
     }
 }
 
@@ -136,6 +248,9 @@ void NpcSpawner::loadSpawnsForMap(int mapId)
 
     sqlite3_bind_int(stmt, 1, mapId);
 
+    const Map* map = sMapManager.getMap(mapId);
+    std::vector<int32_t> pathIds;
+
     int loaded = 0;
     while (sqlite3_step(stmt) == SQLITE_ROW)
     {
@@ -155,21 +270,60 @@ void NpcSpawner::loadSpawnsForMap(int mapId)
         if (info.respawnSeconds <= 0)
             info.respawnSeconds = 60;
 
-        m_spawns[info.spawnId] = info;
+        // Spawn overrides fall back to the template
+        info.resolvedMovementType = info.movementType;
+        info.resolvedPathId = info.pathId;
+        if (const NpcTemplate* tmpl = sGameData.getNpc(info.npcEntry))
+        {
+            if (info.resolvedMovementType == 0)
+                info.resolvedMovementType = tmpl->movementType;
+            if (info.resolvedPathId == 0)
+                info.resolvedPathId = tmpl->pathId;
+        }
+
+        if (info.resolvedPathId > 0)
+            pathIds.push_back(info.resolvedPathId);
+
+        placeSpawn(info, map);
+        buildWanderTargets(info, map);
+
         m_spawnsByMap[mapId].push_back(info.spawnId);
+        m_spawns[info.spawnId] = std::move(info);
         ++loaded;
-
-        if (info.pathId > 0)
-            loadWaypoints(info.pathId);
     }
 
     sqlite3_finalize(stmt);
     sqlite3_close(db);
 
+    loadWaypoints(pathIds);
+
     LOG_INFO("NpcSpawner: Loaded %d spawns for map %d", loaded, mapId);
     spawnAllForMap(mapId);
 }
 
+Npc* NpcSpawner::createSpawnNpc(const NpcSpawnInfo& spawn, const NpcTemplate& tmpl)
+{
+    Npc* npc = sWorldManager.spawnNpc(tmpl, spawn.mapId, spawn.x, spawn.y, spawn.orientation);
+    if (!npc)
+        return nullptr;
+
+    npc->setSpawnId(spawn.spawnId);
+    npc->setRespawnTimeMs(spawn.respawnSeconds * 1000);
+    npc->setMovementType(spawn.resolvedMovementType);
+    npc->setPathId(spawn.resolvedPathId);
+    npc->setWanderDistance(spawn.wanderDistance);
+    npc->setCallForHelp(spawn.callForHelp);
+    npc->setCalledForHelp(false);
+
+    // Movement tables are owned here and shared by reference
+    auto pathIt = m_pathsById.find(spawn.resolvedPathId);
+    npc->setPatrolPath(pathIt != m_pathsById.end() ? &pathIt->second : nullptr);
+    npc->setWanderTargets(spawn.wanderTargets.empty() ? nullptr : &spawn.wanderTargets);
+
+    m_spawnToNpcGuid[spawn.spawnId] = npc->getGuid();
+    return npc;
+}
+
 void NpcSpawner::spawnAllForMap(int mapId)
 {
     auto it = m_spawnsByMap.find(mapId);
@@ -185,39 +339,39 @@ void NpcSpawner::spawnAllForMap(int mapId)
         if (spawnIt == m_spawns.end())
             continue;
 
+        // Checkpointed respawn still running: resume its timer and come
+        // back as it was (corpse, or not spawned at all)
+        auto state = NpcSpawnCheckpoint::State::Alive;
+        auto restoredIt = m_restoredSpawns.find(spawnId);
+        if (restoredIt != m_restoredSpawns.end())
+        {
+            if (restoredIt->second.respawnRemaining > 0.0f)
+            {
+                state = restoredIt->second.state;
+                m_respawnTimers[spawnId] = restoredIt->second.respawnRemaining;
+            }
+            m_restoredSpawns.erase(restoredIt);
+        }
+
+        if (state == NpcSpawnCheckpoint::State::Despawned)
+            continue;
+
         const NpcSpawnInfo& spawn = spawnIt->second;
         const NpcTemplate* tmpl = sGameData.getNpc(spawn.npcEntry);
         if (!tmpl)
         {
-            LOG_WARN("NpcSpawner: Missing NPC template entry {}", spawn.npcEntry);
+            LOG_WARN("NpcSpawner: Missing NPC template entry %d", spawn.npcEntry);
             continue;
         }
 
-        int32_t movementType = spawn.movementType != 0 ? spawn.movementType : tmpl->movementType;
-        int32_t pathId = spawn.pathId != 0 ? spawn.pathId : tmpl->pathId;
-
-        if (pathId > 0)
-            loadWaypoints(pathId);
-
-        Npc* npc = sWorldManager.spawnNpc(*tmpl, spawn.mapId, spawn.x, spawn.y, spawn.orientation);
+        Npc* npc = createSpawnNpc(spawn, *tmpl);
         if (!npc)
             continue;
 
-        npc->setSpawnId(spawn.spawnId);
-        npc->setRespawnTimeMs(spawn.respawnSeconds * 1000);
-        npc->setMovementType(movementType);
-        npc->setPathId(pathId);
-        npc->setWanderDistance(spawn.wanderDistance);
-        npc->setCallForHelp(spawn.callForHelp);
-        npc->setCalledForHelp(false);
-
-        npc->getWaypoints().clear();
-        auto waypointsIt = m_waypointsByPathId.find(pathId);
-        if (waypointsIt != m_waypointsByPathId.end())
-            npc->getWaypoints() = waypointsIt->second;
+        if (state == NpcSpawnCheckpoint::State::Corpse)
+            npc->restoreCorpse();
 
-        m_spawnToNpcGuid[spawn.spawnId] = npc->getGuid();
-        sWorldManager.broadcastNpcSpawn(npc);
+        npc->queueLifecycleEvent(NpcLifecycleEvent::Respawned);
     }
 }
 
@@ -282,30 +436,9 @@ void NpcSpawner::respawnSpawn(int32_t spawnId)
         if (!tmpl)
             return;
 
-        int32_t movementType = spawn.movementType != 0 ? spawn.movementType : tmpl->movementType;
-        int32_t pathId = spawn.pathId != 0 ? spawn.pathId : tmpl->pathId;
-
-        if (pathId > 0)
-            loadWaypoints(pathId);
-
-        npc = sWorldManager.spawnNpc(*tmpl, spawn.mapId, spawn.x, spawn.y, spawn.orientation);
+        npc = createSpawnNpc(spawn, *tmpl);
         if (!npc)
             return;
-
-        npc->setSpawnId(spawn.spawnId);
-        npc->setRespawnTimeMs(spawn.respawnSeconds * 1000);
-        npc->setMovementType(movementType);
-        npc->setPathId(pathId);
-        npc->setWanderDistance(spawn.wanderDistance);
-        npc->setCallForHelp(spawn.callForHelp);
-        npc->setCalledForHelp(false);
-
-        npc->getWaypoints().clear();
-        auto waypointsIt = m_waypointsByPathId.find(pathId);
-        if (waypointsIt != m_waypointsByPathId.end())
-            npc->getWaypoints() = waypointsIt->second;
-
-        m_spawnToNpcGuid[spawn.spawnId] = npc->getGuid();
     }
     else
     {
@@ -313,7 +446,7 @@ void NpcSpawner::respawnSpawn(int32_t spawnId)
         npc->setCalledForHelp(false);
     }
 
-    sWorldManager.broadcastNpcSpawn(npc);
+    npc->queueLifecycleEvent(NpcLifecycleEvent::Respawned);
 }
 
 void NpcSpawner::update(float deltaTime)
@@ -337,3 +470,52 @@ void NpcSpawner::update(float deltaTime)
         m_respawnTimers.erase(spawnId);
     }
 }
+
+// ============================================================================
+// World Checkpoint
+// ============================================================================
+
+void NpcSpawner::captureCheckpoint(std::vector<NpcSpawnCheckpoint>& outSpawns,
+                                   std::vector<int32_t>& outMapIds) const
+{
+    outSpawns.clear();
+    outSpawns.reserve(m_respawnTimers.size());
+
+    for (const auto& [spawnId, timer] : m_respawnTimers)
+    {
+        auto spawnIt = m_spawns.find(spawnId);
+        if (spawnIt == m_spawns.end())
+            continue;
+
+        NpcSpawnCheckpoint entry;
+        entry.spawnId = spawnId;
+        entry.mapId = spawnIt->second.mapId;
+        entry.respawnRemaining = timer;
+        entry.state = NpcSpawnCheckpoint::State::Despawned;
+
+        auto guidIt = m_spawnToNpcGuid.find(spawnId);
+        if (guidIt != m_spawnToNpcGuid.end())
+        {
+            if (const Npc* npc = sWorldManager.getNpc(guidIt->second))
+                entry.state = npc->isDead() ? NpcSpawnCheckpoint::State::Corpse
+                                            : NpcSpawnCheckpoint::State::Alive;
+        }
+
+        outSpawns.push_back(entry);
+    }
+
+    outMapIds.assign(m_loadedMaps.begin(), m_loadedMaps.end());
+    std::sort(outMapIds.begin(), outMapIds.end());
+}
+
+void NpcSpawner::restoreCheckpoint(const std::vector<NpcSpawnCheckpoint>& spawns)
+{
+    for (const NpcSpawnCheckpoint& entry : spawns)
+        m_restoredSpawns[entry.spawnId] = entry;
+}
+
+uint32_t NpcSpawner::getNpcGuidForSpawn(int32_t spawnId) const
+{
+    auto it = m_spawnToNpcGuid.find(spawnId);
+    return it != m_spawnToNpcGuid.end() ? it->second : 0;
+}
@@ -25,6 +25,28 @@ struct NpcSpawnInfo
     int32_t pathId = 0;
     float wanderDistance = 0.0f;
     bool callForHelp = true;
+
+    // Resolved once when the map's spawns load
+    int32_t resolvedMovementType = 0;
+    int32_t resolvedPathId = 0;
+    std::vector<NpcWanderTarget> wanderTargets;
+};
+
+// Spawn state carried across restarts by the world checkpoint. Only spawns
+// with a respawn timer running are recorded; everything else spawns alive.
+struct NpcSpawnCheckpoint
+{
+    enum class State : uint8_t
+    {
+        Alive,      // NPC up, respawn still pending (linked group member)
+        Corpse,     // NPC dead in the world, waiting to respawn
+        Despawned,  // No NPC, waiting to respawn
+    };
+
+    int32_t spawnId = 0;
+    int32_t mapId = 0;
+    State state = State::Alive;
+    float respawnRemaining = 0.0f;  // Seconds
 };
 
 class NpcSpawner
@@ -37,6 +59,13 @@ public:
     void onNpcDeath(Npc* npc);
     void update(float deltaTime);
 
+    // World checkpoint: capture pending respawns and loaded maps, and stage
+    // restored state to be applied as each map's spawns load
+    void captureCheckpoint(std::vector<NpcSpawnCheckpoint>& outSpawns,
+                           std::vector<int32_t>& outMapIds) const;
+    void restoreCheckpoint(const std::vector<NpcSpawnCheckpoint>& spawns);
+    uint32_t getNpcGuidForSpawn(int32_t spawnId) const;
+
 private:
     NpcSpawner() = default;
 
@@ -50,7 +79,10 @@ private:
     };
 
     void loadGroups();
-    void loadWaypoints(int32_t pathId);
+    void loadWaypoints(const std::vector<int32_t>& pathIds);
+    void placeSpawn(NpcSpawnInfo& spawn, const class Map* map);
+    void buildWanderTargets(NpcSpawnInfo& spawn, const class Map* map);
+    Npc* createSpawnNpc(const NpcSpawnInfo& spawn, const NpcTemplate& tmpl);
     void respawnSpawn(int32_t spawnId);
 
     std::unordered_map<int32_t, NpcSpawnInfo> m_spawns;
@@ -58,11 +90,12 @@ private:
     std::unordered_map<int32_t, uint32_t> m_spawnToNpcGuid;
     std::unordered_map<int32_t, float> m_respawnTimers;
     std::unordered_set<int32_t> m_loadedMaps;
+    std::unordered_map<int32_t, NpcSpawnCheckpoint> m_restoredSpawns;
 
     std::unordered_map<int32_t, std::vector<NpcGroupEntry>> m_groupsByLeader;
     std::unordered_map<int32_t, int32_t> m_spawnToGroupLeader;
     std::unordered_set<int32_t> m_loadedPathIds;
-    std::unordered_map<int32_t, std::vector<NpcWaypoint>> m_waypointsByPathId;
+    std::unordered_map<int32_t, NpcPatrolPath> m_pathsById;
     bool m_groupsLoaded = false;
 };
 
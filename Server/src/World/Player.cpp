@@ -2,7 +2,7 @@
 #include "Player.h"
 #include "WorldManager.h"
 #include "MapManager.h"
-#include "../Network/Session.h"
+#include "../Network/PacketSink.h"
 #include "../Handlers/WorldHandlers.h"
 #include "../Systems/ExperienceSystem.h"
 #include "../Systems/QuestManager.h"
@@ -23,8 +23,15 @@ namespace {
     }
 }
 
-Player::Player(Session& session, const CharacterInfo& info)
-    : m_session(session)
+// Containers live in PlayerColdState and per-tick fields in PlayerHotState;
+// the Player object itself should stay a few cache lines beyond Entity
+static_assert(sizeof(Player) - sizeof(Entity) <= 4 * CACHE_LINE_SIZE,
+              "Player grew; move containers and tables into PlayerColdState");
+
+Player::Player(PacketSink& sink, const CharacterInfo& info)
+    : m_sink(sink)
+    , m_hot(&m_parkedHot)
+    , m_cold(std::make_unique<PlayerColdState>())
     , m_characterGuid(info.guid)
     , m_accountId(info.accountId)
     , m_characterName(info.name)
@@ -39,6 +46,8 @@ Player::Player(Session& session, const CharacterInfo& info)
     , m_gold(info.gold)
     , m_playedTime(info.playedTime)
 {
+    m_parkedHot.owner = this;
+
     // Set entity name
     setName(info.name);
 
@@ -60,23 +69,23 @@ Player::Player(Session& session, const CharacterInfo& info)
     m_sessionStartTime = getCurrentTimeMs();
 
     // Load inventory from database
-    m_inventory.setOwner(this);
-    m_inventory.load(m_characterGuid);
+    m_cold->inventory.setOwner(this);
+    m_cold->inventory.load(m_characterGuid);
 
     // Load equipment from database
-    m_equipment.load(m_characterGuid);
+    m_cold->equipment.load(m_characterGuid);
 
     // Load bank from database
-    m_bank.load(m_characterGuid);
+    m_cold->bank.load(m_characterGuid);
 
     // Load quest log from database (Phase 7)
-    m_questLog.load(m_characterGuid);
+    m_cold->questLog.load(m_characterGuid);
 
     // Load stat bonuses (Phase 7 level-up)
     loadStatBonuses();
 
-    // Sync quest item progress from inventory
-    onInventoryChanged();
+    // Sync quest item progress from inventory (before the quest list is sent)
+    sQuestManager.onInventoryChanged(this);
 
     // Initialize base stats from class stats (preserve current health/mana)
     sExperienceSystem.applyLevelStats(this, m_level, true, false);
@@ -96,45 +105,111 @@ Player::Player(Session& session, const CharacterInfo& info)
 Player::~Player()
 {
     // Final save before destruction
-    if (m_needsSave)
+    if (m_hot->needsSave)
     {
         save();
     }
 
+    if (m_containerSyncQueued)
+        sWorldManager.cancelContainerSync(this);
+
+    if (m_movementQueued)
+        sWorldManager.cancelMovement(this);
+
+    // despawnPlayer() already ran any pending level-up; this only covers
+    // a player destroyed without leaving the world
+    if (m_pendingExpGain != 0)
+        sExperienceSystem.cancelPendingExperience(this);
+
     LOG_DEBUG("Player: Destroyed '{}'", m_characterName);
 }
 
 void Player::update(float deltaTime)
 {
+    commitTick(deltaTime, computeTick(deltaTime));
+}
+
+Player::TickResult Player::computeTick(const PlayerHotState& hot, float deltaTime)
+{
+    TickResult result;
+
     // Periodic position/data save (Task 4.9)
-    if (m_needsSave)
+    if (hot.needsSave)
+    {
+        result.saving = true;
+        result.saveTimer = hot.saveTimer + deltaTime;
+    }
+
+    // Check pending cast timer
+    if (hot.cast.active)
+    {
+        result.casting = true;
+        result.castRemaining = hot.cast.remainingTime - deltaTime;
+    }
+
+    // Future: update movement interpolation, combat, buffs, etc.
+    return result;
+}
+
+void Player::commitTick(float deltaTime, const TickResult& result)
+{
+    // An earlier commit this tick may have dirtied, saved or interrupted
+    // this player; redo the step from current state when it no longer
+    // matches what computeTick() saw
+    PlayerHotState& hot = *m_hot;
+    if (hot.needsSave)
     {
-        m_saveTimer += deltaTime;
-        if (m_saveTimer >= SAVE_INTERVAL)
+        hot.saveTimer = result.saving ? result.saveTimer : hot.saveTimer + deltaTime;
+        if (hot.saveTimer >= SAVE_INTERVAL)
         {
             save();
-            m_saveTimer = 0.0f;
+            hot.saveTimer = 0.0f;
             LOG_DEBUG("Player: Periodic save for '%s' at (%.1f, %.1f)",
                       m_characterName.c_str(), getX(), getY());
         }
     }
 
-    // Check pending cast timer
-    if (m_pendingCast.active)
+    if (hot.cast.active)
     {
-        m_pendingCast.remainingTime -= deltaTime;
-        if (m_pendingCast.remainingTime <= 0.0f)
+        hot.cast.remainingTime = result.casting ? result.castRemaining
+                                                : hot.cast.remainingTime - deltaTime;
+        if (hot.cast.remainingTime <= 0.0f)
         {
             completeCast();
         }
     }
-
-    // Future: update movement interpolation, combat, buffs, etc.
 }
 
 void Player::sendPacket(const StlBuffer& packet)
 {
-    m_session.sendPacket(packet);
+    m_sink.sendPacket(packet);
+}
+
+// ============================================================================
+// Hot State
+// ============================================================================
+
+void Player::attachHotState(PlayerHotState& slot)
+{
+    slot = *m_hot;
+    m_hot = &slot;
+}
+
+PlayerHotState* Player::detachHotState()
+{
+    if (m_hot == &m_parkedHot)
+        return nullptr;
+
+    PlayerHotState* slot = m_hot;
+    m_parkedHot = *slot;
+    m_hot = &m_parkedHot;
+    return slot;
+}
+
+void Player::onPositionChanged()
+{
+    m_hot->x = m_x;
+    m_hot->y = m_y;
 }
 
 void Player::addExperience(int32_t amount)
@@ -147,7 +222,7 @@ void Player::addExperience(int32_t amount)
     setVariable(ObjDefines::Variable::Progression, m_experience);
     markDirty();
 
-    // TODO: Check for level up
+    // Level-ups are checked by ExperienceSystem's end-of-tick flush
 }
 
 void Player::setExperience(int32_t value)
@@ -215,40 +290,40 @@ void Player::save()
         CharacterDb::saveCharacter(info);
 
         // Save inventory if dirty
-        if (m_inventory.isDirty())
+        if (m_cold->inventory.isDirty())
         {
-            m_inventory.save(m_characterGuid);
-            m_inventory.clearDirty();
+            m_cold->inventory.save(m_characterGuid);
+            m_cold->inventory.clearDirty();
         }
 
         // Save equipment if dirty
-        if (m_equipment.isDirty())
+        if (m_cold->equipment.isDirty())
         {
-            m_equipment.save(m_characterGuid);
-            m_equipment.clearDirty();
+            m_cold->equipment.save(m_characterGuid);
+            m_cold->equipment.clearDirty();
         }
 
         // Save bank if dirty
-        if (m_bank.isDirty())
+        if (m_cold->bank.isDirty())
         {
-            m_bank.save(m_characterGuid);
-            m_bank.clearDirty();
+            m_cold->bank.save(m_characterGuid);
+            m_cold->bank.clearDirty();
         }
 
         // Save quest log if dirty (Phase 7)
-        if (m_questLog.isDirty())
+        if (m_cold->questLog.isDirty())
         {
-            m_questLog.save(m_characterGuid);
-            m_questLog.clearDirty();
+            m_cold->questLog.save(m_characterGuid);
+            m_cold->questLog.clearDirty();
         }
 
         // Save stat bonuses if dirty (Phase 7 level-up)
-        if (m_statBonusesDirty)
+        if (m_cold->statBonusesDirty)
             saveStatBonuses();
 
         // All saves successful - commit the transaction
         sDatabase.commit();
-        m_needsSave = false;
+        m_hot->needsSave = false;
 
         LOG_DEBUG("Player: Save committed for '{}'", m_characterName);
     }
@@ -272,6 +347,7 @@ void Player::loadFromDatabase()
     // Update from database
     m_characterName = info->name;
     m_level = info->level;
+    invalidateSpawnPacket();
     m_experience = info->experience;
     m_gold = info->gold;
     m_playedTime = info->playedTime;
@@ -288,7 +364,7 @@ void Player::loadFromDatabase()
 
 void Player::loadStatBonuses()
 {
-    m_statBonuses.clear();
+    m_cold->statBonuses.clear();
 
     auto stmt = sDatabase.prepare(
         "SELECT stat_id, bonus FROM character_stat_bonuses WHERE character_guid = ?"
@@ -305,11 +381,11 @@ void Player::loadStatBonuses()
     {
         int32_t statId = stmt.getInt(0);
         int32_t bonus = stmt.getInt(1);
-        m_statBonuses[static_cast<UnitDefines::Stat>(statId)] = bonus;
+        m_cold->statBonuses[static_cast<UnitDefines::Stat>(statId)] = bonus;
     }
 
-    m_statBonusesDirty = false;
-    LOG_DEBUG("Player: Loaded %zu stat bonuses for %d", m_statBonuses.size(), m_characterGuid);
+    m_cold->statBonusesDirty = false;
+    LOG_DEBUG("Player: Loaded %zu stat bonuses for %d", m_cold->statBonuses.size(), m_characterGuid);
 }
 
 void Player::saveStatBonuses()
@@ -335,7 +411,7 @@ void Player::saveStatBonuses()
         return;
     }
 
-    for (const auto& [stat, bonus] : m_statBonuses)
+    for (const auto& [stat, bonus] : m_cold->statBonuses)
     {
         insertStmt.reset();
         insertStmt.bind(1, m_characterGuid);
@@ -344,19 +420,140 @@ void Player::saveStatBonuses()
         insertStmt.step();
     }
 
-    m_statBonusesDirty = false;
-    LOG_DEBUG("Player: Saved %zu stat bonuses for %d", m_statBonuses.size(), m_characterGuid);
+    m_cold->statBonusesDirty = false;
+    LOG_DEBUG("Player: Saved %zu stat bonuses for %d", m_cold->statBonuses.size(), m_characterGuid);
 }
 
 void Player::onInventoryChanged()
 {
+    markContainerSync(SyncQuestItems);
+}
+
+void Player::markContainerSync(uint8_t flags)
+{
+    if (!m_containerSyncQueued)
+    {
+        sWorldManager.queueContainerSync(this);
+        m_containerSyncQueued = true;
+    }
+    m_pendingContainerSync |= flags;
+}
+
+void Player::syncContainers()
+{
+    uint8_t pending = m_pendingContainerSync;
+    m_pendingContainerSync = 0;
+    m_containerSyncQueued = false;
+
+    // Tally first so quest progress packets precede the inventory they count
+    if (pending & SyncQuestItems)
+        sQuestManager.onInventoryChanged(this);
+    if (pending & SyncInventory)
+        sendInventory();
+    if (pending & SyncEquipment)
+        sendEquipment();
+    if (pending & SyncBank)
+        sendBank();
+}
+
+void Player::syncQuestItems()
+{
+    if (!(m_pendingContainerSync & SyncQuestItems))
+        return;
+
+    m_pendingContainerSync &= ~SyncQuestItems;
     sQuestManager.onInventoryChanged(this);
 }
 
+// ============================================================================
+// Queued Movement (Task 4.8)
+// ============================================================================
+
+void Player::queueMove(float destX, float destY)
+{
+    m_queuedMove.destX = destX;
+    m_queuedMove.destY = destY;
+    m_queuedMove.move = true;
+    m_queuedMove.stop = false;
+
+    if (!m_movementQueued)
+    {
+        sWorldManager.queueMovement(this);
+        m_movementQueued = true;
+    }
+}
+
+void Player::queueStop()
+{
+    m_queuedMove.stop = true;
+
+    if (!m_movementQueued)
+    {
+        sWorldManager.queueMovement(this);
+        m_movementQueued = true;
+    }
+}
+
+void Player::applyQueuedMovement()
+{
+    if (!hasQueuedMovement())
+        return;
+
+    QueuedMove queued = m_queuedMove;
+    m_queuedMove = QueuedMove{};
+
+    if (queued.move)
+    {
+        // Store old position for visibility updates
+        float oldX = getX();
+        float oldY = getY();
+
+        // Update orientation to face movement direction (Task 4.9)
+        updateOrientationFromMovement(queued.destX, queued.destY);
+
+        // Position updates immediately since we don't have server-side
+        // movement interpolation yet
+        setPosition(queued.destX, queued.destY);
+        setMoving(true);
+        markDirty();  // Position changed, needs save
+
+        Handlers::broadcastMovement(this, queued.destX, queued.destY);
+        sWorldManager.onPlayerMoved(this, oldX, oldY);
+    }
+
+    if (queued.stop)
+    {
+        setMoving(false);
+        Handlers::broadcastStop(this);
+    }
+}
+
+void Player::flushQueuedMovement()
+{
+    m_movementQueued = false;
+    applyQueuedMovement();
+}
+
+void Player::discardQueuedMovement()
+{
+    // Left in the world's queue; flushing an empty move does nothing
+    m_queuedMove = QueuedMove{};
+}
+
+bool Player::getSentGossipStatus(uint32_t npcGuid, int32_t& outStatus) const
+{
+    auto it = m_cold->sentGossipStatus.find(npcGuid);
+    if (it == m_cold->sentGossipStatus.end())
+        return false;
+
+    outStatus = it->second;
+    return true;
+}
+
 int32_t Player::getStatBonus(UnitDefines::Stat stat) const
 {
-    auto it = m_statBonuses.find(stat);
-    return it != m_statBonuses.end() ? it->second : 0;
+    auto it = m_cold->statBonuses.find(stat);
+    return it != m_cold->statBonuses.end() ? it->second : 0;
 }
 
 void Player::addStatBonus(UnitDefines::Stat stat, int32_t amount)
@@ -374,16 +571,16 @@ void Player::addStatBonus(UnitDefines::Stat stat, int32_t amount)
 void Player::setStatBonus(UnitDefines::Stat stat, int32_t value)
 {
     if (value <= 0)
-        m_statBonuses.erase(stat);
+        m_cold->statBonuses.erase(stat);
     else
-        m_statBonuses[stat] = value;
+        m_cold->statBonuses[stat] = value;
 
-    m_statBonusesDirty = true;
+    m_cold->statBonusesDirty = true;
 }
 
 int32_t Player::getEquipmentStatBonus(UnitDefines::Stat stat) const
 {
-    auto equipBonuses = m_equipment.calculateStatBonuses();
+    auto equipBonuses = m_cold->equipment.calculateStatBonuses();
     auto it = equipBonuses.find(static_cast<int32_t>(stat));
     return it != equipBonuses.end() ? it->second : 0;
 }
@@ -414,7 +611,7 @@ void Player::recalculateStats()
 
 bool Player::hasShieldEquipped() const
 {
-    const auto* offhand = m_equipment.getItem(UnitDefines::EquipSlot::Offhand);
+    const auto* offhand = m_cold->equipment.getItem(UnitDefines::EquipSlot::Offhand);
     if (!offhand)
         return false;
 
@@ -428,12 +625,12 @@ bool Player::hasShieldEquipped() const
 
 bool Player::hasWeaponEquipped() const
 {
-    return !m_equipment.isSlotEmpty(UnitDefines::EquipSlot::Weapon1);
+    return !m_cold->equipment.isSlotEmpty(UnitDefines::EquipSlot::Weapon1);
 }
 
 int32_t Player::getWeaponDamage() const
 {
-    const auto* weapon = m_equipment.getItem(UnitDefines::EquipSlot::Weapon1);
+    const auto* weapon = m_cold->equipment.getItem(UnitDefines::EquipSlot::Weapon1);
     if (!weapon)
         return 0;
 
@@ -519,10 +716,10 @@ void Player::onDeath(Entity* killer)
     setVariable(ObjDefines::Variable::InCombat, 0);
 
     // Reduce equipment durability on death
-    if (m_equipment.reduceDurabilityOnDeath())
+    if (m_cold->equipment.reduceDurabilityOnDeath())
     {
         // Send equipment update to client so they see the durability change
-        sendEquipment();
+        markEquipmentDirty();
     }
 
     // Mark for save (death state should be saved)
@@ -602,6 +799,7 @@ void Player::respawn()
 
 void Player::teleportTo(float x, float y)
 {
+    discardQueuedMovement();
     setPosition(x, y);
     broadcastTeleport();
     markDirty();
@@ -677,7 +875,7 @@ void Player::startCooldown(int32_t spellId, int32_t durationMs, int32_t category
         return;
 
     // Start the cooldown internally
-    m_cooldowns.startCooldown(spellId, durationMs, categoryId);
+    m_cold->cooldowns.startCooldown(spellId, durationMs, categoryId);
 
     // Send cooldown notification to client
     GP_Server_Cooldown packet;
@@ -697,7 +895,7 @@ void Player::startCooldown(int32_t spellId, int32_t durationMs, int32_t category
 
 void Player::startGCD()
 {
-    m_cooldowns.startGCD();
+    m_cold->cooldowns.startGCD();
 
     // GCD is typically not sent as a separate packet - client handles it locally
     // based on spell cast. However, if needed we can send a special indicator.
@@ -706,7 +904,7 @@ void Player::startGCD()
 
 void Player::sendAllCooldowns()
 {
-    auto cooldowns = m_cooldowns.getAllCooldowns();
+    auto cooldowns = m_cold->cooldowns.getAllCooldowns();
 
     for (const auto& [spellId, remainingMs] : cooldowns)
     {
@@ -730,7 +928,7 @@ void Player::sendInventory()
     GP_Server_Inventory packet;
     packet.m_gold = m_gold;
 
-    const auto& slots = m_inventory.getSlots();
+    const auto& slots = m_cold->inventory.getSlots();
     for (int i = 0; i < Inventory::MAX_SLOTS; ++i)
     {
         const auto& item = slots[i];
@@ -766,7 +964,7 @@ void Player::sendInventory()
 
 void Player::sendEquipment()
 {
-    const auto& slots = m_equipment.getSlots();
+    const auto& slots = m_cold->equipment.getSlots();
     int sentCount = 0;
 
     for (int i = 0; i < Equipment::NUM_SLOTS; ++i)
@@ -802,13 +1000,44 @@ void Player::sendEquipment()
               m_characterName, sentCount);
 }
 
+void Player::sendBank()
+{
+    GP_Server_Bank packet;
+
+    const auto& slots = m_cold->bank.getSlots();
+    for (int i = 0; i < Bank::MAX_SLOTS; ++i)
+    {
+        const auto& item = slots[i];
+        if (!item.isEmpty())
+        {
+            GP_Server_Bank::Slot slot;
+            slot.slot = i;
+            slot.itemId.m_itemId = item.itemId;
+            slot.itemId.m_durability = item.durability;
+            slot.itemId.m_enchant = item.enchantId;
+            slot.itemId.m_count = item.stackCount;
+            slot.stackCount = item.stackCount;
+            packet.m_slots.push_back(slot);
+        }
+    }
+
+    StlBuffer buf;
+    uint16_t opcode = packet.getOpcode();
+    buf << opcode;
+    packet.pack(buf);
+
+    sendPacket(buf);
+
+    LOG_DEBUG("Player: '{}' sent bank ({} items)", m_characterName, packet.m_slots.size());
+}
+
 void Player::broadcastEquipmentChange(UnitDefines::EquipSlot slot)
 {
     GP_Server_EquipItem packet;
     packet.m_guid = static_cast<uint32_t>(getGuid());
     packet.m_slot = static_cast<int32_t>(slot);
 
-    const Equipment::EquippedItem* item = m_equipment.getItem(slot);
+    const Equipment::EquippedItem* item = m_cold->equipment.getItem(slot);
     if (item)
     {
         packet.m_itemId.m_itemId = item->itemId;
@@ -850,15 +1079,15 @@ void Player::broadcastEquipmentChange(UnitDefines::EquipSlot slot)
 void Player::startCast(int32_t spellId, uint32_t targetGuid, float castTime)
 {
     // Cancel any existing cast
-    if (m_pendingCast.active)
+    if (m_hot->cast.active)
     {
         cancelCast();
     }
 
-    m_pendingCast.spellId = spellId;
-    m_pendingCast.targetGuid = targetGuid;
-    m_pendingCast.remainingTime = castTime / 1000.0f;  // Convert ms to seconds
-    m_pendingCast.active = true;
+    m_hot->cast.spellId = spellId;
+    m_hot->cast.targetGuid = targetGuid;
+    m_hot->cast.remainingTime = castTime / 1000.0f;  // Convert ms to seconds
+    m_hot->cast.active = true;
 
     LOG_DEBUG("Player: '{}' started casting spell {} (cast time: {} ms)",
               m_characterName, spellId, castTime);
@@ -866,14 +1095,14 @@ void Player::startCast(int32_t spellId, uint32_t targetGuid, float castTime)
 
 void Player::cancelCast()
 {
-    if (!m_pendingCast.active)
+    if (!m_hot->cast.active)
         return;
 
-    int32_t cancelledSpell = m_pendingCast.spellId;
-    m_pendingCast.active = false;
-    m_pendingCast.spellId = 0;
-    m_pendingCast.targetGuid = 0;
-    m_pendingCast.remainingTime = 0.0f;
+    int32_t cancelledSpell = m_hot->cast.spellId;
+    m_hot->cast.active = false;
+    m_hot->cast.spellId = 0;
+    m_hot->cast.targetGuid = 0;
+    m_hot->cast.remainingTime = 0.0f;
 
     // Send cast stop to client and nearby players
     GP_Server_CastStop stopPacket;
@@ -893,16 +1122,16 @@ void Player::cancelCast()
 
 void Player::completeCast()
 {
-    if (!m_pendingCast.active)
+    if (!m_hot->cast.active)
         return;
 
     // Copy cast info and clear pending (prevent re-entry)
-    int32_t spellId = m_pendingCast.spellId;
-    uint32_t targetGuid = m_pendingCast.targetGuid;
-    m_pendingCast.active = false;
-    m_pendingCast.spellId = 0;
-    m_pendingCast.targetGuid = 0;
-    m_pendingCast.remainingTime = 0.0f;
+    int32_t spellId = m_hot->cast.spellId;
+    uint32_t targetGuid = m_hot->cast.targetGuid;
+    m_hot->cast.active = false;
+    m_hot->cast.spellId = 0;
+    m_hot->cast.targetGuid = 0;
+    m_hot->cast.remainingTime = 0.0f;
 
     LOG_DEBUG("Player: '{}' completed cast of spell {} on target {}",
               m_characterName, spellId, targetGuid);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Entity.h"
+#include "HotStatePool.h"
 #include "../Database/CharacterDb.h"
 #include "../Combat/CooldownManager.h"
 #include "../Systems/Inventory.h"
@@ -13,25 +14,90 @@
 #include <memory>
 #include <unordered_map>
 
-class Session;
+class PacketSink;
 class StlBuffer;
 
+// Containers and tables a player only touches on demand (item moves, quest
+// events, casts, saves). Held behind a pointer so the Player object the
+// tick and range queries walk stays a few cache lines.
+struct PlayerColdState
+{
+    CooldownManager cooldowns;                            // Task 5.7
+    Inventory::PlayerInventory inventory;                 // Phase 6, Task 6.1
+    Equipment::PlayerEquipment equipment;                 // Phase 6, Task 6.3
+    Bank::PlayerBank bank;                                // Phase 6, Task 6.6
+    Quest::PlayerQuestLog questLog;                       // Phase 7
+    std::unordered_map<uint32_t, int32_t> sentGossipStatus;
+    std::unordered_map<UnitDefines::Stat, int32_t> statBonuses;  // Phase 7 level-up
+    bool statBonusesDirty = false;
+};
+
+// Cast in progress (cast time spells)
+struct PlayerPendingCast
+{
+    int32_t spellId = 0;
+    uint32_t targetGuid = 0;
+    float remainingTime = 0.0f;  // Seconds remaining
+    bool active = false;
+};
+
+// Fields the player tick touches every update, plus the position NPC aggro
+// scans read, kept apart from the Player object. While the player is in
+// the world the slot comes from its map's HotStatePool owned by
+// WorldManager, so those walks stay contiguous; otherwise the state is
+// parked inside the Player (see Player::attachHotState).
+struct PlayerHotState
+{
+    Player* owner = nullptr;
+    float x = 0.0f;                 // Mirrors Entity position
+    float y = 0.0f;
+    float saveTimer = 0.0f;         // Periodic save timer (Task 4.9)
+    PlayerPendingCast cast;
+    bool moving = false;
+    bool needsSave = false;
+};
+
+static_assert(sizeof(PlayerHotState) <= CACHE_LINE_SIZE,
+              "PlayerHotState is walked every tick; keep it within one cache line");
+
 // Player entity - represents a player character in the world
 class Player : public Entity
 {
 public:
     // Create player from character info and bind to session
-    Player(Session& session, const CharacterInfo& info);
+    Player(PacketSink& sink, const CharacterInfo& info);
     ~Player() override;
 
     // Entity interface
     void update(float deltaTime) override;
+
+    // update() split for the world's parallel player phase: computeTick()
+    // only reads this player and may run on any thread; commitTick() then
+    // applies it (timers, save, cast completion) on the world thread, in
+    // world order
+    struct TickResult
+    {
+        bool saving = false;         // Save timer was running
+        bool casting = false;        // Cast timer was running
+        float saveTimer = 0.0f;      // Timer values after this tick
+        float castRemaining = 0.0f;
+    };
+    TickResult computeTick(float deltaTime) const { return computeTick(*m_hot, deltaTime); }
+    static TickResult computeTick(const PlayerHotState& hot, float deltaTime);
+    void commitTick(float deltaTime, const TickResult& result);
     MutualObject::Type getType() const override { return MutualObject::Type::Player; }
     const std::string& getName() const override { return m_characterName; }
 
-    // Session
-    Session& getSession() { return m_session; }
-    const Session& getSession() const { return m_session; }
+    // Where this player's packets go (its Session, locally)
+    PacketSink& getSink() { return m_sink; }
+
+    // Per-tick state. attachHotState() moves it into `slot` (a fresh slot
+    // from the map's pool); detachHotState() moves it back into the Player
+    // and returns the slot for the caller to release.
+    PlayerHotState& getHotState() { return *m_hot; }
+    const PlayerHotState& getHotState() const { return *m_hot; }
+    void attachHotState(PlayerHotState& slot);
+    PlayerHotState* detachHotState();
 
     // Character info
     int32_t getCharacterGuid() const { return m_characterGuid; }
@@ -63,6 +129,11 @@ public:
     void setExperience(int32_t value);
     void setLevel(int32_t level);
 
+    // XP gained since the last experience flush (non-zero = queued, see
+    // ExperienceSystem::giveExperience)
+    int32_t getPendingExpGain() const { return m_pendingExpGain; }
+    void setPendingExpGain(int32_t amount) { m_pendingExpGain = amount; }
+
     // Gold
     void addGold(int32_t amount);
     bool spendGold(int32_t amount);
@@ -82,8 +153,24 @@ public:
     void updatePlayedTime();
 
     // Movement
-    bool isMoving() const { return m_isMoving; }
-    void setMoving(bool moving) { m_isMoving = moving; }
+    bool isMoving() const { return m_hot->moving; }
+    void setMoving(bool moving) { m_hot->moving = moving; }
+
+    // Queued client movement. Move and stop requests collapse into one
+    // pending move per player, applied before the player's next other
+    // packet or at the start of the next world tick
+    // (WorldManager::flushMovement), so only the last move of a tick is
+    // broadcast.
+    void queueMove(float destX, float destY);
+    void queueStop();
+    void applyQueuedMovement();     // Early, ahead of another packet
+    void flushQueuedMovement();     // From the world's queue
+    void discardQueuedMovement();   // Server moved the player instead
+    bool hasQueuedMovement() const { return m_queuedMove.move || m_queuedMove.stop; }
+
+    // Where the player stands once queued movement lands (move validation)
+    float getMoveOriginX() const { return m_queuedMove.move ? m_queuedMove.destX : getX(); }
+    float getMoveOriginY() const { return m_queuedMove.move ? m_queuedMove.destY : getY(); }
 
     // Combat
     bool isInCombat() const;
@@ -104,20 +191,14 @@ public:
     bool canRespawn() const;
 
     // Cooldown system (Task 5.7)
-    CooldownManager& getCooldowns() { return m_cooldowns; }
-    const CooldownManager& getCooldowns() const { return m_cooldowns; }
+    CooldownManager& getCooldowns() { return m_cold->cooldowns; }
+    const CooldownManager& getCooldowns() const { return m_cold->cooldowns; }
 
     // Cast system (cast time spells)
-    struct PendingCast
-    {
-        int32_t spellId = 0;
-        uint32_t targetGuid = 0;
-        float remainingTime = 0.0f;  // Seconds remaining
-        bool active = false;
-    };
+    using PendingCast = PlayerPendingCast;
 
-    bool isCasting() const { return m_pendingCast.active; }
-    const PendingCast& getPendingCast() const { return m_pendingCast; }
+    bool isCasting() const { return m_hot->cast.active; }
+    const PendingCast& getPendingCast() const { return m_hot->cast; }
     void startCast(int32_t spellId, uint32_t targetGuid, float castTime);
     void cancelCast();
     void completeCast();
@@ -132,37 +213,58 @@ public:
     void sendAllCooldowns();
 
     // Inventory system (Phase 6, Task 6.1)
-    Inventory::PlayerInventory& getInventory() { return m_inventory; }
-    const Inventory::PlayerInventory& getInventory() const { return m_inventory; }
+    Inventory::PlayerInventory& getInventory() { return m_cold->inventory; }
+    const Inventory::PlayerInventory& getInventory() const { return m_cold->inventory; }
 
-    // Send full inventory to client
+    // Send full inventory to client now (login); mutations use markInventoryDirty
     void sendInventory();
 
     // Equipment system (Phase 6, Task 6.3)
-    Equipment::PlayerEquipment& getEquipment() { return m_equipment; }
-    const Equipment::PlayerEquipment& getEquipment() const { return m_equipment; }
+    Equipment::PlayerEquipment& getEquipment() { return m_cold->equipment; }
+    const Equipment::PlayerEquipment& getEquipment() const { return m_cold->equipment; }
 
     // Send equipment state to client (broadcasts GP_Server_EquipItem for each slot)
     void sendEquipment();
 
+    // Send full bank contents to client
+    void sendBank();
+
     // Bank system (Phase 6, Task 6.6)
-    Bank::PlayerBank& getBank() { return m_bank; }
-    const Bank::PlayerBank& getBank() const { return m_bank; }
+    Bank::PlayerBank& getBank() { return m_cold->bank; }
+    const Bank::PlayerBank& getBank() const { return m_cold->bank; }
 
     // Quest log (Phase 7)
-    Quest::PlayerQuestLog& getQuestLog() { return m_questLog; }
-    const Quest::PlayerQuestLog& getQuestLog() const { return m_questLog; }
+    Quest::PlayerQuestLog& getQuestLog() { return m_cold->questLog; }
+    const Quest::PlayerQuestLog& getQuestLog() const { return m_cold->questLog; }
 
-    // Inventory change hook (Phase 7 quest objectives)
+    // Last DynGossipStatus sent to this client per quest giver guid, so quest
+    // changes only resend NPCs whose marker actually changed
+    bool getSentGossipStatus(uint32_t npcGuid, int32_t& outStatus) const;
+    void setSentGossipStatus(uint32_t npcGuid, int32_t status) { m_cold->sentGossipStatus[npcGuid] = status; }
+    void clearSentGossipStatuses() { m_cold->sentGossipStatus.clear(); }
+
+    // Inventory change hook (Phase 7 quest objectives). Defers the quest
+    // item tally to the next container sync.
     void onInventoryChanged();
 
+    // Coalesced container sync. Mutations mark what changed; the world runs
+    // one sync pass per loop iteration (WorldManager::flushContainerSyncs),
+    // which sends each dirty container once and tallies quest items once.
+    void markInventoryDirty() { markContainerSync(SyncInventory); }
+    void markEquipmentDirty() { markContainerSync(SyncEquipment); }
+    void markBankDirty() { markContainerSync(SyncBank); }
+    void syncContainers();
+
+    // Run a pending quest item tally now (before quest state is checked)
+    void syncQuestItems();
+
     // Stat bonuses (Phase 7 level-up)
     int32_t getStatBonus(UnitDefines::Stat stat) const;           // Manual stat investments only
     int32_t getEquipmentStatBonus(UnitDefines::Stat stat) const;  // Equipment bonuses only
     int32_t getTotalStatBonus(UnitDefines::Stat stat) const;      // Manual + equipment + aura
     void addStatBonus(UnitDefines::Stat stat, int32_t amount);
     void setStatBonus(UnitDefines::Stat stat, int32_t value);
-    const std::unordered_map<UnitDefines::Stat, int32_t>& getStatBonuses() const { return m_statBonuses; }
+    const std::unordered_map<UnitDefines::Stat, int32_t>& getStatBonuses() const { return m_cold->statBonuses; }
 
     // Stat recalculation (called when equipment changes)
     void recalculateStats();
@@ -177,8 +279,8 @@ public:
     void broadcastEquipmentChange(UnitDefines::EquipSlot slot);
 
     // Save tracking
-    void markDirty() { m_needsSave = true; }
-    bool needsSave() const { return m_needsSave; }
+    void markDirty() { m_hot->needsSave = true; }
+    bool needsSave() const { return m_hot->needsSave; }
 
     // Position sync (Task 4.9)
     void teleportTo(float x, float y);              // Forcibly move player
@@ -189,11 +291,40 @@ public:
     // Save interval constant (seconds)
     static constexpr float SAVE_INTERVAL = 30.0f;
 
+protected:
+    // Keeps the hot state's position mirror current
+    void onPositionChanged() override;
+
 private:
     void loadStatBonuses();
     void saveStatBonuses();
-    // Bound session
-    Session& m_session;
+
+    enum ContainerSync : uint8_t
+    {
+        SyncInventory  = 1 << 0,
+        SyncEquipment  = 1 << 1,
+        SyncBank       = 1 << 2,
+        SyncQuestItems = 1 << 3,
+    };
+    void markContainerSync(uint8_t flags);
+
+    struct QueuedMove
+    {
+        float destX = 0.0f;
+        float destY = 0.0f;
+        bool move = false;   // Move to dest
+        bool stop = false;   // Then stop there
+    };
+
+    // Outbound packets
+    PacketSink& m_sink;
+
+    // Per-tick state: a pool slot while in the world, else m_parkedHot
+    PlayerHotState* m_hot;
+    PlayerHotState m_parkedHot;
+
+    // Cold containers (see PlayerColdState)
+    std::unique_ptr<PlayerColdState> m_cold;
 
     // Character data (from database)
     int32_t m_characterGuid = 0;
@@ -203,6 +334,7 @@ private:
     int32_t m_gender = 0;
     int32_t m_level = 1;
     int32_t m_experience = 0;
+    int32_t m_pendingExpGain = 0;
     int32_t m_portraitId = 0;
     int32_t m_skinColor = 0;
     int32_t m_hairStyle = 0;
@@ -211,36 +343,13 @@ private:
     int32_t m_playedTime = 0;
 
     // State
-    bool m_isMoving = false;
-    bool m_needsSave = false;
     uint32_t m_selectedTarget = 0;  // Currently selected target GUID
     uint32_t m_gossipTargetGuid = 0;  // Last gossip NPC GUID
+    uint8_t m_pendingContainerSync = 0;  // ContainerSync flags awaiting the sync pass
+    bool m_containerSyncQueued = false;  // In WorldManager's sync queue
+    QueuedMove m_queuedMove;
+    bool m_movementQueued = false;  // In WorldManager's movement queue
 
     // Session start time for played time tracking
     int64_t m_sessionStartTime = 0;
-
-    // Periodic save timer (Task 4.9)
-    float m_saveTimer = 0.0f;
-
-    // Cooldown manager (Task 5.7)
-    CooldownManager m_cooldowns;
-
-    // Pending cast (cast time spells)
-    PendingCast m_pendingCast;
-
-    // Inventory (Phase 6, Task 6.1)
-    Inventory::PlayerInventory m_inventory;
-
-    // Equipment (Phase 6, Task 6.3)
-    Equipment::PlayerEquipment m_equipment;
-
-    // Bank (Phase 6, Task 6.6)
-    Bank::PlayerBank m_bank;
-
-    // Quest log (Phase 7)
-    Quest::PlayerQuestLog m_questLog;
-
-    // Stat bonus storage (Phase 7 level-up)
-    std::unordered_map<UnitDefines::Stat, int32_t> m_statBonuses;
-    bool m_statBonusesDirty = false;
 };
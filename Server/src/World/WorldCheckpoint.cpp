@@ -0,0 +1,475 @@
+// WorldCheckpoint - Warm-restart snapshot of world state
+
+#include "stdafx.h"
+#include "World/WorldCheckpoint.h"
+#include "World/MapManager.h"
+#include "World/Npc.h"
+#include "World/NpcSpawner.h"
+#include "World/WorldManager.h"
+#include "Systems/LootSystem.h"
+#include "Database/AsyncSaver.h"
+#include "Core/Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+    #include <fstream>
+    #include <iterator>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace
+{
+constexpr uint32_t CHECKPOINT_MAGIC = 0x43574D44;  // "DMWC"
+constexpr uint16_t CHECKPOINT_VERSION = 1;
+
+// ============================================================================
+// File Layout
+// ============================================================================
+//
+//   FileHeader
+//   int32_t      mapIds[mapCount]
+//   FileSpawn    spawns[spawnCount]
+//   FileLoot     loot[lootCount]
+//   FileLootItem items[lootItemCount]   (each loot's items, in loot order)
+
+struct FileHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerSize;
+    int64_t savedAtMs;       // Wall clock, for downtime on restore
+    uint32_t mapCount;
+    uint32_t spawnCount;
+    uint32_t lootCount;
+    uint32_t lootItemCount;
+    uint32_t checksum;       // FNV-1a of everything after the header
+    uint32_t reserved;
+};
+
+struct FileSpawn
+{
+    int32_t spawnId;
+    int32_t mapId;
+    float respawnRemaining;
+    uint8_t state;           // NpcSpawnCheckpoint::State
+    uint8_t padding[3];
+};
+
+struct FileLoot
+{
+    int32_t spawnId;         // Corpse the loot belongs to
+    int32_t goldAmount;
+    float freeForAllTimer;
+    uint8_t goldLooted;
+    uint8_t padding;
+    uint16_t itemCount;
+};
+
+struct FileLootItem
+{
+    int32_t itemId;
+    int32_t affix1;
+    int32_t affix2;
+    int32_t gems[4];
+    int32_t stackCount;
+    uint8_t looted;
+    uint8_t padding[3];
+};
+
+static_assert(sizeof(FileHeader) == 40, "checkpoint header layout changed");
+static_assert(sizeof(FileSpawn) == 16, "checkpoint spawn record layout changed");
+static_assert(sizeof(FileLoot) == 16, "checkpoint loot record layout changed");
+static_assert(sizeof(FileLootItem) == 36, "checkpoint loot item layout changed");
+static_assert(std::is_trivially_copyable<FileHeader>::value &&
+              std::is_trivially_copyable<FileSpawn>::value &&
+              std::is_trivially_copyable<FileLoot>::value &&
+              std::is_trivially_copyable<FileLootItem>::value,
+              "checkpoint records are copied as raw bytes");
+
+// State copied off the world on the tick thread
+struct Capture
+{
+    int64_t savedAtMs = 0;
+    std::vector<int32_t> mapIds;
+    std::vector<NpcSpawnCheckpoint> spawns;
+    std::vector<std::pair<int32_t, LootSystem::PendingLoot>> loot;  // (spawnId, loot)
+};
+
+int64_t wallClockMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+uint32_t fnv1a(const uint8_t* data, size_t size)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+template <typename T>
+void append(std::vector<uint8_t>& out, const T& record)
+{
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&record);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T readRecord(const uint8_t*& cursor)
+{
+    T record;
+    std::memcpy(&record, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return record;
+}
+
+std::vector<uint8_t> encode(const Capture& capture)
+{
+    FileHeader header{};
+    header.magic = CHECKPOINT_MAGIC;
+    header.version = CHECKPOINT_VERSION;
+    header.headerSize = sizeof(FileHeader);
+    header.savedAtMs = capture.savedAtMs;
+    header.mapCount = static_cast<uint32_t>(capture.mapIds.size());
+    header.spawnCount = static_cast<uint32_t>(capture.spawns.size());
+    header.lootCount = static_cast<uint32_t>(capture.loot.size());
+
+    std::vector<uint8_t> body;
+    for (int32_t mapId : capture.mapIds)
+        append(body, mapId);
+
+    for (const NpcSpawnCheckpoint& spawn : capture.spawns)
+    {
+        FileSpawn record{};
+        record.spawnId = spawn.spawnId;
+        record.mapId = spawn.mapId;
+        record.respawnRemaining = spawn.respawnRemaining;
+        record.state = static_cast<uint8_t>(spawn.state);
+        append(body, record);
+    }
+
+    for (const auto& [spawnId, loot] : capture.loot)
+    {
+        FileLoot record{};
+        record.spawnId = spawnId;
+        record.goldAmount = loot.goldAmount;
+        record.freeForAllTimer = loot.freeForAllTimer;
+        record.goldLooted = loot.goldLooted ? 1 : 0;
+        record.itemCount = static_cast<uint16_t>(loot.items.size());
+        append(body, record);
+    }
+
+    for (const auto& entry : capture.loot)
+    {
+        for (const LootSystem::LootItem& item : entry.second.items)
+        {
+            FileLootItem record{};
+            record.itemId = item.itemId.m_itemId;
+            record.affix1 = item.itemId.m_affix1;
+            record.affix2 = item.itemId.m_affix2;
+            record.gems[0] = item.itemId.m_gem1;
+            record.gems[1] = item.itemId.m_gem2;
+            record.gems[2] = item.itemId.m_gem3;
+            record.gems[3] = item.itemId.m_gem4;
+            record.stackCount = item.stackCount;
+            record.looted = item.looted ? 1 : 0;
+            append(body, record);
+            ++header.lootItemCount;
+        }
+    }
+
+    header.checksum = fnv1a(body.data(), body.size());
+
+    std::vector<uint8_t> out;
+    out.reserve(sizeof(FileHeader) + body.size());
+    append(out, header);
+    out.insert(out.end(), body.begin(), body.end());
+    return out;
+}
+
+// Write to <path>.tmp and rename over the previous checkpoint, so a crash
+// mid-write leaves the old one intact
+bool writeFile(const std::string& path, const std::vector<uint8_t>& bytes)
+{
+    std::string tmpPath = path + ".tmp";
+
+    FILE* file = std::fopen(tmpPath.c_str(), "wb");
+    if (!file)
+        return false;
+
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    ok = std::fflush(file) == 0 && ok;
+#ifndef _WIN32
+    ok = ::fsync(::fileno(file)) == 0 && ok;
+#endif
+    ok = std::fclose(file) == 0 && ok;
+
+    if (!ok || std::rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Read-only view of a whole file (mmap; a plain read on Windows)
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile()
+    {
+#ifndef _WIN32
+        if (m_data)
+            ::munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path)
+    {
+#ifdef _WIN32
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            return false;
+        m_buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+        return true;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return false;
+
+        struct stat info{};
+        if (::fstat(fd, &info) != 0 || info.st_size <= 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        void* mapped = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED)
+            return false;
+
+        m_data = static_cast<const uint8_t*>(mapped);
+        m_size = static_cast<size_t>(info.st_size);
+        return true;
+#endif
+    }
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    std::vector<uint8_t> m_buffer;
+#endif
+};
+}
+
+WorldCheckpoint& WorldCheckpoint::instance()
+{
+    static WorldCheckpoint instance;
+    return instance;
+}
+
+// ============================================================================
+// Restore
+// ============================================================================
+
+bool WorldCheckpoint::restore(const std::string& path)
+{
+    MappedFile file;
+    if (!file.open(path))
+    {
+        LOG_INFO("WorldCheckpoint: No checkpoint at %s, starting a fresh world", path.c_str());
+        return false;
+    }
+
+    if (file.size() < sizeof(FileHeader))
+    {
+        LOG_WARN("WorldCheckpoint: %s is truncated, ignoring it", path.c_str());
+        return false;
+    }
+
+    const uint8_t* cursor = file.data();
+    const FileHeader header = readRecord<FileHeader>(cursor);
+
+    if (header.magic != CHECKPOINT_MAGIC || header.version != CHECKPOINT_VERSION ||
+        header.headerSize != sizeof(FileHeader))
+    {
+        LOG_WARN("WorldCheckpoint: %s has an unknown format (magic %08X, version %u), ignoring it",
+                 path.c_str(), header.magic, header.version);
+        return false;
+    }
+
+    uint64_t expectedSize = sizeof(FileHeader) +
+                            uint64_t(header.mapCount) * sizeof(int32_t) +
+                            uint64_t(header.spawnCount) * sizeof(FileSpawn) +
+                            uint64_t(header.lootCount) * sizeof(FileLoot) +
+                            uint64_t(header.lootItemCount) * sizeof(FileLootItem);
+    if (expectedSize != file.size() ||
+        fnv1a(cursor, file.size() - sizeof(FileHeader)) != header.checksum)
+    {
+        LOG_WARN("WorldCheckpoint: %s is corrupt, ignoring it", path.c_str());
+        return false;
+    }
+
+    float downtime = static_cast<float>(std::max<int64_t>(0, wallClockMs() - header.savedAtMs)) / 1000.0f;
+
+    std::vector<int> mapIds;
+    mapIds.reserve(header.mapCount);
+    for (uint32_t i = 0; i < header.mapCount; ++i)
+        mapIds.push_back(readRecord<int32_t>(cursor));
+
+    // Stage spawns first so each map applies them as it loads
+    std::vector<NpcSpawnCheckpoint> spawns;
+    spawns.reserve(header.spawnCount);
+    for (uint32_t i = 0; i < header.spawnCount; ++i)
+    {
+        FileSpawn record = readRecord<FileSpawn>(cursor);
+        if (record.state > static_cast<uint8_t>(NpcSpawnCheckpoint::State::Despawned))
+            continue;
+
+        NpcSpawnCheckpoint spawn;
+        spawn.spawnId = record.spawnId;
+        spawn.mapId = record.mapId;
+        spawn.state = static_cast<NpcSpawnCheckpoint::State>(record.state);
+        spawn.respawnRemaining = record.respawnRemaining - downtime;
+        if (spawn.respawnRemaining > 0.0f)
+            spawns.push_back(spawn);
+    }
+    sNpcSpawner.restoreCheckpoint(spawns);
+
+    sMapManager.preloadMaps(mapIds);
+
+    // Loot goes back on corpses that are still corpses. World GUIDs are not
+    // stable across restarts, so the killer's loot rights are dropped; the
+    // free-for-all timer carries on from where it was.
+    const uint8_t* itemCursor = cursor + uint64_t(header.lootCount) * sizeof(FileLoot);
+    uint32_t restoredLoot = 0;
+    for (uint32_t i = 0; i < header.lootCount; ++i)
+    {
+        FileLoot record = readRecord<FileLoot>(cursor);
+
+        LootSystem::PendingLoot loot;
+        loot.goldAmount = record.goldAmount;
+        loot.goldLooted = record.goldLooted != 0;
+        loot.freeForAllTimer = std::max(0.0f, record.freeForAllTimer - downtime);
+        loot.items.reserve(record.itemCount);
+        for (uint16_t j = 0; j < record.itemCount; ++j)
+        {
+            FileLootItem itemRecord = readRecord<FileLootItem>(itemCursor);
+
+            LootSystem::LootItem item;
+            item.itemId.m_itemId = itemRecord.itemId;
+            item.itemId.m_affix1 = itemRecord.affix1;
+            item.itemId.m_affix2 = itemRecord.affix2;
+            item.itemId.m_gem1 = itemRecord.gems[0];
+            item.itemId.m_gem2 = itemRecord.gems[1];
+            item.itemId.m_gem3 = itemRecord.gems[2];
+            item.itemId.m_gem4 = itemRecord.gems[3];
+            item.stackCount = itemRecord.stackCount;
+            item.looted = itemRecord.looted != 0;
+            loot.items.push_back(item);
+        }
+
+        uint32_t npcGuid = sNpcSpawner.getNpcGuidForSpawn(record.spawnId);
+        const Npc* npc = npcGuid ? sWorldManager.getNpc(npcGuid) : nullptr;
+        if (!npc || !npc->isDead())
+            continue;
+
+        sLootManager.restoreLoot(npcGuid, std::move(loot));
+        ++restoredLoot;
+    }
+
+    LOG_INFO("WorldCheckpoint: Restored %zu maps, %zu pending respawns, %u corpse loots "
+             "(%.0f s since checkpoint)",
+             mapIds.size(), spawns.size(), restoredLoot, downtime);
+    return true;
+}
+
+// ============================================================================
+// Periodic Checkpoint
+// ============================================================================
+
+void WorldCheckpoint::start(const std::string& path, int intervalSeconds)
+{
+    m_path = path;
+    m_interval = static_cast<float>(std::max(1, intervalSeconds));
+    m_timer = 0.0f;
+
+    LOG_INFO("WorldCheckpoint: Writing %s every %d s", m_path.c_str(), static_cast<int>(m_interval));
+}
+
+void WorldCheckpoint::update(float deltaTime)
+{
+    if (m_path.empty())
+        return;
+
+    m_timer += deltaTime;
+    if (m_timer < m_interval)
+        return;
+    m_timer = 0.0f;
+
+    // Disk slower than the interval: skip rather than pile up writes
+    if (m_pendingWrites.load() > 0)
+        return;
+
+    checkpoint();
+}
+
+void WorldCheckpoint::checkpoint()
+{
+    if (m_path.empty())
+        return;
+
+    auto capture = std::make_shared<Capture>();
+    capture->savedAtMs = wallClockMs();
+    sNpcSpawner.captureCheckpoint(capture->spawns, capture->mapIds);
+
+    for (const auto& [guid, loot] : sLootManager.getAllPendingLoot())
+    {
+        if (loot.isEmpty())
+            continue;
+
+        const Npc* npc = sWorldManager.getNpc(guid);
+        if (npc && npc->getSpawnId() > 0)
+            capture->loot.emplace_back(npc->getSpawnId(), loot);
+    }
+
+    ++m_pendingWrites;
+    std::string path = m_path;
+    sAsyncSaver.queueSave([this, capture, path]() {
+        std::vector<uint8_t> bytes = encode(*capture);
+        if (writeFile(path, bytes))
+            LOG_DEBUG("WorldCheckpoint: Wrote %zu bytes (%zu respawns, %zu loots)",
+                      bytes.size(), capture->spawns.size(), capture->loot.size());
+        else
+            LOG_ERROR("WorldCheckpoint: Failed to write %s", path.c_str());
+        --m_pendingWrites;
+    });
+}
@@ -0,0 +1,55 @@
+// WorldCheckpoint - Warm-restart snapshot of world state
+//
+// Periodically records what a restart would otherwise lose: respawn timers
+// still running in NpcSpawner (with whether each NPC is up, a corpse, or
+// gone), the maps that were loaded, and the loot left on corpses. The tick
+// thread only copies that state out; encoding and writing the file run on
+// the AsyncSaver thread (written to <path>.tmp, then renamed).
+//
+// On startup the file is mapped read-only, validated, and every map it
+// lists is loaded in bulk before the server listens, so spawns resume their
+// timers instead of all coming back at once, and the first players onto a
+// map no longer pay for loading it. Downtime counts against the timers.
+//
+// The format is fixed-size records in host byte order behind a versioned,
+// checksummed header; a mismatching file is ignored and the world starts
+// fresh.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+class WorldCheckpoint
+{
+public:
+    static WorldCheckpoint& instance();
+
+    // Restore from `path` (missing or invalid file = fresh world); returns
+    // true when a checkpoint was applied. Call after the map manager is
+    // initialized and before players connect.
+    bool restore(const std::string& path);
+
+    // Write a checkpoint every `intervalSeconds` of game time
+    void start(const std::string& path, int intervalSeconds);
+    void update(float deltaTime);
+
+    // Capture now and queue the write (shutdown; AsyncSaver flush waits)
+    void checkpoint();
+
+private:
+    WorldCheckpoint() = default;
+
+    WorldCheckpoint(const WorldCheckpoint&) = delete;
+    WorldCheckpoint& operator=(const WorldCheckpoint&) = delete;
+
+    std::string m_path;
+    float m_interval = 0.0f;
+    float m_timer = 0.0f;
+
+    // Writes queued or running; periodic captures skip while one is
+    std::atomic<int> m_pendingWrites{0};
+};
+
+#define sWorldCheckpoint WorldCheckpoint::instance()
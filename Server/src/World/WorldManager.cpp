@@ -8,15 +8,72 @@
 #include "World/Player.h"
 #include "World/Npc.h"
 #include "World/NpcSpawner.h"
+#include "World/MapManager.h"
+#include "Combat/AuraScheduler.h"
+#include "Combat/AuraSystem.h"
 #include "Systems/QuestManager.h"
 #include "Systems/DuelSystem.h"
+#include "Systems/ExperienceSystem.h"
 #include "Network/Session.h"
+#include "Network/WorldShard.h"
+#include "Core/Config.h"
 #include "Core/Logger.h"
+#include "Core/TaskPool.h"
 #include "GamePacketServer.h"
 #include "StlBuffer.h"
 #include "ObjDefines.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+    // Entities per task pool chunk in the parallel tick phases
+    constexpr size_t PLAYER_TICK_GRAIN = 64;
+    constexpr size_t NPC_AGGRO_SCAN_GRAIN = 32;
+
+    // Size of a map serialized by packMap()
+    size_t packedMapSize(const std::map<int32_t, int32_t>& values)
+    {
+        return sizeof(uint16_t) + values.size() * (sizeof(int32_t) * 2);
+    }
+
+    // Overwrite a 32-bit little-endian field of a serialized packet
+    void patchUInt32(StlBuffer& buf, size_t offset, uint32_t value)
+    {
+        uint8_t* out = buf.data() + offset;
+        out[0] = static_cast<uint8_t>(value & 0xFF);
+        out[1] = static_cast<uint8_t>((value >> 8) & 0xFF);
+        out[2] = static_cast<uint8_t>((value >> 16) & 0xFF);
+        out[3] = static_cast<uint8_t>((value >> 24) & 0xFF);
+    }
+
+    void patchFloat(StlBuffer& buf, size_t offset, float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        patchUInt32(buf, offset, bits);
+    }
+
+    void patchPosition(SpawnPacketCache& cache, const Entity* entity)
+    {
+        patchFloat(cache.packet, cache.positionOffset, entity->getX());
+        patchFloat(cache.packet, cache.positionOffset + 4, entity->getY());
+        patchFloat(cache.packet, cache.positionOffset + 8, entity->getOrientation());
+    }
+
+    void serializeSpawnPacket(SpawnPacketCache& cache, const GamePacket& packet, uint32_t version)
+    {
+        cache.packet.clear();
+        uint16_t opcode = packet.getOpcode();
+        cache.packet << opcode;
+        packet.pack(cache.packet);
+        cache.version = version;
+        cache.valid = true;
+    }
+}
 
 WorldManager& WorldManager::instance()
 {
@@ -26,6 +83,12 @@ WorldManager& WorldManager::instance()
 
 void WorldManager::initialize()
 {
+    // Threads for the parallel tick phases (the main thread is one of them)
+    int tickThreads = sConfig.getTickThreads();
+    if (tickThreads <= 0)
+        tickThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    sTaskPool.start(static_cast<size_t>(tickThreads - 1));
+
     LOG_INFO("WorldManager initialized");
 }
 
@@ -33,9 +96,23 @@ void WorldManager::shutdown()
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    // Note: We don't delete players here - Session owns them
+    // Note: We don't delete players here - Session owns them. Their hot
+    // state moves back into them since the pools don't outlive this.
+    for (const auto& [guid, player] : m_players)
+    {
+        auto poolIt = m_playerHotByMap.find(player->getMapId());
+        PlayerHotState* slot = player->detachHotState();
+        if (poolIt != m_playerHotByMap.end())
+            poolIt->second.release(slot);
+    }
+    m_playerHotByMap.clear();
     m_players.clear();
     m_playersByMap.clear();
+    m_pendingContainerSyncs.clear();
+    m_pendingMovement.clear();
+    m_pendingNpcLifecycle.clear();
+
+    sTaskPool.stop();
 
     LOG_INFO("WorldManager shutdown");
 }
@@ -57,8 +134,9 @@ void WorldManager::addPlayer(Player* player)
     // Add to global map
     m_players[guid] = player;
 
-    // Add to per-map set
+    // Add to per-map set, with a hot state slot from the map's pool
     m_playersByMap[mapId].insert(player);
+    player->attachHotState(*m_playerHotByMap[mapId].acquire());
 
     LOG_DEBUG("WorldManager: Added player '%s' (guid=%u) to map %d. Total players: %zu",
               player->getName().c_str(), guid, mapId, m_players.size());
@@ -90,6 +168,10 @@ void WorldManager::removePlayer(Player* player)
         }
     }
 
+    auto poolIt = m_playerHotByMap.find(mapId);
+    if (poolIt != m_playerHotByMap.end())
+        poolIt->second.release(player->detachHotState());
+
     LOG_DEBUG("WorldManager: Removed player '%s' (guid=%u) from map %d. Total players: %zu",
               player->getName().c_str(), guid, mapId, m_players.size());
 }
@@ -212,6 +294,7 @@ void WorldManager::spawnPlayer(Player* player)
     }
 
     // Send all NPCs on this map to the new player (Task 5.14)
+    player->clearSentGossipStatuses();
     std::vector<Npc*> npcsOnMap = getNpcsOnMap(mapId);
     for (Npc* npc : npcsOnMap)
     {
@@ -230,6 +313,16 @@ void WorldManager::despawnPlayer(Player* player)
     if (!player)
         return;
 
+    player->discardQueuedMovement();
+
+    // A level-up earned this tick lands before the player leaves (and is
+    // saved), not at the end-of-tick flush
+    sExperienceSystem.flushPendingExperience(player);
+
+    // Its DoTs and buffs on others would otherwise outlive it with a
+    // dangling caster
+    AuraManager::removeAurasAppliedBy(player->getGuid());
+
     int mapId = player->getMapId();
     uint32_t guid = player->getGuid();
 
@@ -281,6 +374,8 @@ void WorldManager::changePlayerMap(Player* player, int newMapId, float x, float
     if (!player)
         return;
 
+    player->discardQueuedMovement();
+
     int oldMapId = player->getMapId();
     uint32_t guid = player->getGuid();
 
@@ -292,6 +387,13 @@ void WorldManager::changePlayerMap(Player* player, int newMapId, float x, float
         return;
     }
 
+    // Map owned by another world process: the gateway moves the player there
+    if (sWorldShard.isActive() && !sWorldShard.ownsMap(newMapId))
+    {
+        sWorldShard.queueTransfer(*player, newMapId, x, y, orientation);
+        return;
+    }
+
     // Clean up visibility on old map - notify all viewers and clean up tracking
     std::vector<Player*> oldViewers;
     {
@@ -321,6 +423,7 @@ void WorldManager::changePlayerMap(Player* player, int newMapId, float x, float
     // Clear this player's visibility sets
     player->clearCanSee();
     player->clearVisibleTo();
+    player->clearSentGossipStatuses();
 
     // Update per-map tracking
     {
@@ -328,17 +431,20 @@ void WorldManager::changePlayerMap(Player* player, int newMapId, float x, float
         m_playersByMap[oldMapId].erase(player);
         if (m_playersByMap[oldMapId].empty())
             m_playersByMap.erase(oldMapId);
+        m_playerHotByMap[oldMapId].release(player->detachHotState());
     }
 
     // Update player position
     player->setPosition(newMapId, x, y);
     player->setOrientation(orientation);
+    player->setMap(sMapManager.getMap(newMapId));
 
     // Add to new map tracking and get players on new map
     std::vector<Player*> newMapPlayers;
     {
         std::lock_guard<std::mutex> lock(m_mutex);
         m_playersByMap[newMapId].insert(player);
+        player->attachHotState(*m_playerHotByMap[newMapId].acquire());
 
         auto it = m_playersByMap.find(newMapId);
         if (it != m_playersByMap.end())
@@ -437,44 +543,256 @@ void WorldManager::broadcastGlobal(const StlBuffer& packet, Player* excludePlaye
 
 void WorldManager::update(float deltaTime)
 {
-    // Get snapshot of players and NPCs to avoid holding lock during update
+    // Client movement queued since the last tick lands first
+    flushMovement();
+
+    // Get snapshot of players (in hot state pool order), NPC state pools
+    // and the player pool sharing each NPC pool's map to avoid holding lock
+    // during update
     std::vector<Player*> players;
-    std::vector<Npc*> npcs;
+    std::vector<PlayerHotState*> playerHot;
+    std::vector<HotStatePool<NpcHotState>*> npcPools;
+    std::vector<HotStatePool<PlayerHotState>*> npcPoolPlayers;
     {
         std::lock_guard<std::mutex> lock(m_mutex);
         players.reserve(m_players.size());
-        for (const auto& [guid, player] : m_players)
+        playerHot.reserve(m_players.size());
+        for (auto& [mapId, pool] : m_playerHotByMap)
         {
-            players.push_back(player);
+            pool.forEach([&](PlayerHotState& hot) {
+                players.push_back(hot.owner);
+                playerHot.push_back(&hot);
+            });
         }
 
-        npcs.reserve(m_npcs.size());
-        for (const auto& [guid, npc] : m_npcs)
+        npcPools.reserve(m_npcHotByMap.size());
+        npcPoolPlayers.reserve(m_npcHotByMap.size());
+        for (auto& [mapId, pool] : m_npcHotByMap)
         {
-            npcs.push_back(npc.get());
+            npcPools.push_back(&pool);
+            auto it = m_playerHotByMap.find(mapId);
+            npcPoolPlayers.push_back(it != m_playerHotByMap.end() ? &it->second : nullptr);
         }
     }
 
-    // Update all players
-    for (Player* player : players)
+    // Phase timing is only taken when profiling; one branch per phase otherwise
+    auto phaseStart = m_phaseProfiling ? Clock::now() : TimePoint{};
+    auto endPhase = [&](uint64_t& total) {
+        if (!m_phaseProfiling)
+            return;
+        auto now = Clock::now();
+        total += std::chrono::duration_cast<std::chrono::microseconds>(now - phaseStart).count();
+        phaseStart = now;
+    };
+
+    // Each phase below computes in parallel on the task pool, writing only
+    // per-entity results, then commits serially in snapshot order. Anything
+    // that reaches another entity (damage, deaths, saves, packets) happens
+    // in the commit, so the outcome matches a fully serial tick.
+
+    // Update all players. The parallel step reads only the hot state.
+    std::vector<Player::TickResult> tickResults(players.size());
+    sTaskPool.parallelFor(players.size(), PLAYER_TICK_GRAIN,
+        [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; ++i)
+                tickResults[i] = Player::computeTick(*playerHot[i], deltaTime);
+        });
+    for (size_t i = 0; i < players.size(); ++i)
     {
-        player->update(deltaTime);
+        players[i]->commitTick(deltaTime, tickResults[i]);
     }
+    endPhase(m_phaseTimes.playersUs);
 
-    // Update all NPCs (Task 5.14)
-    for (Npc* npc : npcs)
+    // Update all NPCs (Task 5.14). Idle NPCs scan their map for aggro
+    // targets first - the bulk of NPC time, and read-only since players
+    // only die during NPC updates - against each map's living players.
+    struct AggroScan
     {
-        if (!npc->isSpawned())
-            continue;
+        NpcHotState* hot;
+        const std::vector<const PlayerHotState*>* livingPlayers;
+    };
+    std::vector<AggroScan> aggroScans;
+    std::vector<std::vector<const PlayerHotState*>> livingByPool(npcPools.size());
+    for (size_t p = 0; p < npcPools.size(); ++p)
+    {
+        std::vector<const PlayerHotState*>& living = livingByPool[p];
+        if (npcPoolPlayers[p])
+        {
+            npcPoolPlayers[p]->forEach([&living](PlayerHotState& player) {
+                if (!player.owner->isDead())
+                    living.push_back(&player);
+            });
+        }
+
+        npcPools[p]->forEach([&](NpcHotState& hot) {
+            hot.aggroScanned = false;
+            if (hot.aiState == NpcAIState::Idle && hot.owner->isSpawned())
+                aggroScans.push_back({&hot, &living});
+        });
+    }
+    sTaskPool.parallelFor(aggroScans.size(), NPC_AGGRO_SCAN_GRAIN,
+        [&aggroScans](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                NpcHotState& hot = *aggroScans[i].hot;
+                hot.aggroCandidate = NpcAI::pickAggroTarget(hot.owner, *aggroScans[i].livingPlayers);
+                hot.aggroScanned = true;
+            }
+        });
+
+    // Then every NPC updates serially, walking each map's hot state in
+    // memory order. Corpses only advance their death timer, so the Npc
+    // itself is touched just for NPCs running AI.
+    for (HotStatePool<NpcHotState>* pool : npcPools)
+    {
+        pool->forEach([deltaTime](NpcHotState& hot) {
+            if (hot.aiState == NpcAIState::Dead)
+            {
+                hot.deathTimer += deltaTime * 1000.0f;
+                return;
+            }
 
-        npc->update(deltaTime);
+            if (hot.owner->isSpawned())
+                hot.owner->update(deltaTime);
+        });
     }
+    endPhase(m_phaseTimes.npcsUs);
+
+    // Aura ticks/expiries and batched aura broadcasts
+    sAuraScheduler.update(static_cast<int32_t>(deltaTime * 1000.0f));
+    endPhase(m_phaseTimes.aurasUs);
 
     // Update NPC respawn timers (Task 7.1)
     sNpcSpawner.update(deltaTime);
+    endPhase(m_phaseTimes.respawnsUs);
 
     // Update duel system (Task 8.8)
     sDuelManager.update(deltaTime);
+    endPhase(m_phaseTimes.duelsUs);
+
+    // Level-ups and XP notifications from this tick's kills and quests
+    sExperienceSystem.flushPendingExperience();
+
+    // Deaths, loot and respawns from this tick (packet handlers included)
+    flushNpcLifecycle();
+}
+
+// ============================================================================
+// Container Sync
+// ============================================================================
+
+void WorldManager::queueContainerSync(Player* player)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pendingContainerSyncs.push_back(player);
+}
+
+void WorldManager::cancelContainerSync(Player* player)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& pending = m_pendingContainerSyncs;
+    pending.erase(std::remove(pending.begin(), pending.end(), player), pending.end());
+}
+
+void WorldManager::flushContainerSyncs()
+{
+    std::vector<Player*> pending;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pendingContainerSyncs.empty())
+            return;
+        pending.swap(m_pendingContainerSyncs);
+    }
+
+    // Anything dirtied during the sync re-queues for the next flush
+    for (Player* player : pending)
+        player->syncContainers();
+}
+
+// ============================================================================
+// Queued Movement
+// ============================================================================
+
+void WorldManager::queueMovement(Player* player)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pendingMovement.push_back(player);
+}
+
+void WorldManager::cancelMovement(Player* player)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& pending = m_pendingMovement;
+    pending.erase(std::remove(pending.begin(), pending.end(), player), pending.end());
+}
+
+void WorldManager::flushMovement()
+{
+    std::vector<Player*> pending;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pendingMovement.empty())
+            return;
+        pending.swap(m_pendingMovement);
+    }
+
+    // In arrival order; players applied early by a later packet of their
+    // own have nothing left to do
+    for (Player* player : pending)
+        player->flushQueuedMovement();
+}
+
+// ============================================================================
+// NPC Lifecycle Events
+// ============================================================================
+
+void WorldManager::queueNpcLifecycle(Npc* npc)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pendingNpcLifecycle.push_back(npc);
+}
+
+void WorldManager::flushNpcLifecycle()
+{
+    std::vector<Npc*> pending;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pendingNpcLifecycle.empty())
+            return;
+        pending.swap(m_pendingNpcLifecycle);
+    }
+
+    // NPCs are replicated map-wide (spawnPlayer sends every NPC on the
+    // map), so a map's players are the viewers of all its NPCs. Gather
+    // them once per map rather than once per event.
+    std::unordered_map<int, std::vector<Player*>> viewersByMap;
+
+    for (Npc* npc : pending)
+    {
+        uint8_t events = npc->takeLifecycleEvents();
+        if (events == 0)
+            continue;
+
+        auto [it, inserted] = viewersByMap.try_emplace(npc->getMapId());
+        if (inserted)
+            it->second = getPlayersOnMap(npc->getMapId());
+
+        // One packet per viewer for the state the NPC ended the tick in:
+        // a despawn that wasn't undone destroys it, anything else (death,
+        // loot, respawn, or several of them) refreshes its spawn packet
+        bool despawned = (events & static_cast<uint8_t>(NpcLifecycleEvent::Despawned)) &&
+                         !npc->isSpawned();
+        for (Player* viewer : it->second)
+        {
+            if (despawned)
+                sendDestroyTo(viewer, npc->getGuid());
+            else
+                sendNpcTo(viewer, npc);
+        }
+
+        LOG_DEBUG("WorldManager: NPC '%s' lifecycle events 0x%x sent to %zu players",
+                  npc->getName().c_str(), static_cast<unsigned>(events), it->second.size());
+    }
 }
 
 // ============================================================================
@@ -589,26 +907,13 @@ void WorldManager::broadcastToVisible(Player* player, const StlBuffer& packet, b
     if (!player)
         return;
 
-    // Get list of players who can see this player
-    std::vector<Player*> viewers;
+    // Viewers come straight from the visibility set; only players are ever
+    // added to it (updateVisibility / spawnPlayer), and sending doesn't
+    // change it
+    for (Entity* viewer : player->getVisibleTo())
     {
-        // Copy the visibleTo set to avoid issues with concurrent modification
-        const auto& visibleTo = player->getVisibleTo();
-        viewers.reserve(visibleTo.size() + 1);
-
-        for (Entity* entity : visibleTo)
-        {
-            if (Player* viewer = dynamic_cast<Player*>(entity))
-            {
-                viewers.push_back(viewer);
-            }
-        }
-    }
-
-    // Send to all viewers
-    for (Player* viewer : viewers)
-    {
-        viewer->sendPacket(packet);
+        if (viewer->getType() == MutualObject::Type::Player)
+            static_cast<Player*>(viewer)->sendPacket(packet);
     }
 
     // Optionally send to self
@@ -627,31 +932,40 @@ void WorldManager::sendPlayerTo(Player* target, Player* playerToSend)
     if (!target || !playerToSend)
         return;
 
+    SpawnPacketCache& cache = playerToSend->getSpawnPacketCache();
+    if (!cache.isCurrent(playerToSend->getSpawnVersion()))
+        buildPlayerSpawnPacket(playerToSend);
+
+    patchPosition(cache, playerToSend);
+    target->sendPacket(cache.packet);
+}
+
+void WorldManager::buildPlayerSpawnPacket(Player* player)
+{
     GP_Server_Player packet;
-    packet.m_guid = playerToSend->getGuid();
-    packet.m_name = playerToSend->getName();
+    packet.m_guid = player->getGuid();
+    packet.m_name = player->getName();
     packet.m_subName = "";
-    packet.m_classId = static_cast<uint8_t>(playerToSend->getClassId());
-    packet.m_gender = static_cast<uint8_t>(playerToSend->getGender());
-    packet.m_portraitId = playerToSend->getPortraitId();
-    packet.m_x = playerToSend->getX();
-    packet.m_y = playerToSend->getY();
-    packet.m_orientation = playerToSend->getOrientation();
+    packet.m_classId = static_cast<uint8_t>(player->getClassId());
+    packet.m_gender = static_cast<uint8_t>(player->getGender());
+    packet.m_portraitId = player->getPortraitId();
 
     // Variables
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::Health)] = playerToSend->getHealth();
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::MaxHealth)] = playerToSend->getMaxHealth();
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::Mana)] = playerToSend->getMana();
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::MaxMana)] = playerToSend->getMaxMana();
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::Level)] = playerToSend->getLevel();
+    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::Health)] = player->getHealth();
+    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::MaxHealth)] = player->getMaxHealth();
+    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::Mana)] = player->getMana();
+    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::MaxMana)] = player->getMaxMana();
+    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::Level)] = player->getLevel();
 
     // TODO: Equipment in Phase 6
 
-    StlBuffer buf;
-    uint16_t opcode = packet.getOpcode();
-    buf << opcode;
-    packet.pack(buf);
-    target->sendPacket(buf);
+    SpawnPacketCache& cache = player->getSpawnPacketCache();
+    serializeSpawnPacket(cache, packet, player->getSpawnVersion());
+
+    // Position is followed only by the equipment and variable maps
+    cache.positionOffset = cache.packet.size() - sizeof(float) * 3 -
+                           packedMapSize(packet.m_equipment) - packedMapSize(packet.m_variables);
+    cache.gossipOffset = 0;
 }
 
 void WorldManager::sendDestroyTo(Player* target, uint32_t guid)
@@ -675,14 +989,19 @@ void WorldManager::sendDestroyTo(Player* target, uint32_t guid)
 
 Npc* WorldManager::spawnNpc(const NpcTemplate& tmpl, int mapId, float x, float y, float orientation)
 {
+    // Resolve the map before taking the lock (first access loads it and its spawns)
+    Map* map = sMapManager.getMap(mapId);
+
     std::lock_guard<std::mutex> lock(m_mutex);
 
     // Generate unique GUID for NPC
     uint32_t guid = m_nextNpcGuid++;
 
-    // Create NPC
-    auto npc = std::make_unique<Npc>(tmpl, mapId, x, y, orientation);
+    // Create NPC with a hot state slot from its map's pool
+    NpcHotState* hot = m_npcHotByMap[mapId].acquire();
+    auto npc = std::make_unique<Npc>(tmpl, *hot, mapId, x, y, orientation);
     npc->setGuid(guid);
+    npc->setMap(map);
     npc->setSpawned(true);
 
     Npc* npcPtr = npc.get();
@@ -690,6 +1009,8 @@ Npc* WorldManager::spawnNpc(const NpcTemplate& tmpl, int mapId, float x, float y
     // Store in maps
     m_npcs[guid] = std::move(npc);
     m_npcsByMap[mapId].insert(npcPtr);
+    if (npcPtr->isQuestGiver())
+        m_questGiversByMapEntry[questGiverKey(mapId, tmpl.entry)].push_back(npcPtr);
 
     LOG_DEBUG("WorldManager: Spawned NPC '{}' (entry={}, guid={}) at map {} ({:.1f}, {:.1f})",
               npcPtr->getName(), tmpl.entry, guid, mapId, x, y);
@@ -705,8 +1026,8 @@ void WorldManager::despawnNpc(Npc* npc)
     // Note: NPC is kept for respawn, just marked as despawned
     npc->setSpawned(false);
 
-    // Broadcast despawn to all players on the map
-    broadcastNpcDespawn(npc);
+    // Viewers drop it with this tick's lifecycle flush
+    npc->queueLifecycleEvent(NpcLifecycleEvent::Despawned);
 
     LOG_DEBUG("WorldManager: Despawned NPC '{}' (guid={})",
               npc->getName(), npc->getGuid());
@@ -717,11 +1038,17 @@ void WorldManager::removeNpc(Npc* npc)
     if (!npc)
         return;
 
+    // Before taking the lock: undoing effects updates their owners
+    AuraManager::removeAurasAppliedBy(npc->getGuid());
+
     std::lock_guard<std::mutex> lock(m_mutex);
 
     uint32_t guid = npc->getGuid();
     int mapId = npc->getMapId();
 
+    auto& lifecycle = m_pendingNpcLifecycle;
+    lifecycle.erase(std::remove(lifecycle.begin(), lifecycle.end(), npc), lifecycle.end());
+
     // Remove from per-map tracking
     auto mapIt = m_npcsByMap.find(mapId);
     if (mapIt != m_npcsByMap.end())
@@ -731,8 +1058,19 @@ void WorldManager::removeNpc(Npc* npc)
             m_npcsByMap.erase(mapIt);
     }
 
-    // Remove from main map (this deletes the NPC)
+    auto giverIt = m_questGiversByMapEntry.find(questGiverKey(mapId, npc->getEntry()));
+    if (giverIt != m_questGiversByMapEntry.end())
+    {
+        auto& givers = giverIt->second;
+        givers.erase(std::remove(givers.begin(), givers.end(), npc), givers.end());
+        if (givers.empty())
+            m_questGiversByMapEntry.erase(giverIt);
+    }
+
+    // Remove from main map (this deletes the NPC), then free its hot slot
+    NpcHotState* hot = &npc->getHotState();
     m_npcs.erase(guid);
+    m_npcHotByMap[mapId].release(hot);
 
     LOG_DEBUG("WorldManager: Removed NPC guid={}", guid);
 }
@@ -745,6 +1083,13 @@ Npc* WorldManager::getNpc(uint32_t guid) const
     return it != m_npcs.end() ? it->second.get() : nullptr;
 }
 
+Entity* WorldManager::findEntity(uint32_t guid) const
+{
+    if (guid >= NPC_GUID_BASE)
+        return getNpc(guid);
+    return getPlayer(guid);
+}
+
 std::vector<Npc*> WorldManager::getNpcsOnMap(int mapId) const
 {
     std::lock_guard<std::mutex> lock(m_mutex);
@@ -762,6 +1107,16 @@ std::vector<Npc*> WorldManager::getNpcsOnMap(int mapId) const
     return result;
 }
 
+std::vector<Npc*> WorldManager::getQuestGiversOnMap(int mapId, int32_t entry) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_questGiversByMapEntry.find(questGiverKey(mapId, entry));
+    if (it == m_questGiversByMapEntry.end())
+        return {};
+    return it->second;
+}
+
 std::vector<Npc*> WorldManager::getAllNpcs() const
 {
     std::lock_guard<std::mutex> lock(m_mutex);
@@ -786,12 +1141,28 @@ void WorldManager::sendNpcTo(Player* target, Npc* npc)
     if (!target || !npc || !npc->isSpawned())
         return;
 
+    SpawnPacketCache& cache = npc->getSpawnPacketCache();
+    if (!cache.isCurrent(npc->getSpawnVersion()))
+        buildNpcSpawnPacket(npc);
+
+    patchPosition(cache, npc);
+
+    // Gossip status is the only per-viewer field
+    if (npc->isQuestGiver())
+    {
+        int32_t gossipStatus = static_cast<int32_t>(sQuestManager.getGossipStatus(target, npc));
+        patchUInt32(cache.packet, cache.gossipOffset, static_cast<uint32_t>(gossipStatus));
+        target->setSentGossipStatus(npc->getGuid(), gossipStatus);
+    }
+
+    target->sendPacket(cache.packet);
+}
+
+void WorldManager::buildNpcSpawnPacket(Npc* npc)
+{
     GP_Server_Npc packet;
     packet.m_guid = npc->getGuid();
     packet.m_entry = npc->getEntry();
-    packet.m_x = npc->getX();
-    packet.m_y = npc->getY();
-    packet.m_orientation = npc->getOrientation();
 
     // Send key variables
     packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::Health)] =
@@ -809,12 +1180,18 @@ void WorldManager::sendNpcTo(Player* target, Npc* npc)
     packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::MoveSpeedPct)] =
         npc->getVariable(ObjDefines::Variable::MoveSpeedPct);
     packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::DynGossipStatus)] =
-        static_cast<int32_t>(sQuestManager.getGossipStatus(target, npc));
+        static_cast<int32_t>(ObjDefines::GossipStatus::None);
     packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::Elite)] =
         npc->getVariable(ObjDefines::Variable::Elite);
     packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::Boss)] =
         npc->getVariable(ObjDefines::Variable::Boss);
 
+    // Corpse state, carried by lifecycle refreshes (only sent when set)
+    if (npc->isDead())
+        packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::IsDead)] = 1;
+    if (npc->getVariable(ObjDefines::Variable::DynLootable) != 0)
+        packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::DynLootable)] = 1;
+
     // Mana if applicable
     int32_t maxMana = npc->getVariable(ObjDefines::Variable::MaxMana);
     if (maxMana > 0)
@@ -824,44 +1201,18 @@ void WorldManager::sendNpcTo(Player* target, Npc* npc)
         packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::MaxMana)] = maxMana;
     }
 
-    StlBuffer buf;
-    uint16_t opcode = packet.getOpcode();
-    buf << opcode;
-    packet.pack(buf);
-    target->sendPacket(buf);
-}
+    SpawnPacketCache& cache = npc->getSpawnPacketCache();
+    serializeSpawnPacket(cache, packet, npc->getSpawnVersion());
 
-void WorldManager::broadcastNpcSpawn(Npc* npc)
-{
-    if (!npc || !npc->isSpawned())
-        return;
+    // Position is followed only by the variable map, whose entries are
+    // serialized in key order
+    size_t variablesOffset = cache.packet.size() - packedMapSize(packet.m_variables);
+    cache.positionOffset = variablesOffset - sizeof(float) * 3;
 
-    int mapId = npc->getMapId();
-    std::vector<Player*> playersOnMap = getPlayersOnMap(mapId);
-
-    for (Player* player : playersOnMap)
-    {
-        sendNpcTo(player, npc);
-    }
-
-    LOG_DEBUG("WorldManager: Broadcast NPC '{}' spawn to {} players",
-              npc->getName(), playersOnMap.size());
-}
-
-void WorldManager::broadcastNpcDespawn(Npc* npc)
-{
-    if (!npc)
-        return;
-
-    int mapId = npc->getMapId();
-    uint32_t guid = npc->getGuid();
-
-    std::vector<Player*> playersOnMap = getPlayersOnMap(mapId);
-
-    for (Player* player : playersOnMap)
-    {
-        sendDestroyTo(player, guid);
-    }
+    auto gossipIt = packet.m_variables.find(static_cast<int32_t>(ObjDefines::Variable::DynGossipStatus));
+    size_t gossipIndex = static_cast<size_t>(std::distance(packet.m_variables.begin(), gossipIt));
+    cache.gossipOffset = variablesOffset + sizeof(uint16_t) +
+                         gossipIndex * (sizeof(int32_t) * 2) + sizeof(int32_t);
 }
 
 // ============================================================================
@@ -12,10 +12,14 @@
 #include <mutex>
 #include <memory>
 
+#include "HotStatePool.h"
+
 class Player;
 class Entity;
 class Npc;
 struct NpcTemplate;
+struct NpcHotState;
+struct PlayerHotState;
 
 // View distance for visibility system (in pixels)
 // Set to 0 for unlimited visibility (all players on same map can see each other)
@@ -63,6 +67,38 @@ public:
     // Update all entities (called each tick)
     void update(float deltaTime);
 
+    // Per-phase wall time of update(), accumulated while profiling is on
+    // (headless simulation reports these; off on the live server)
+    struct PhaseTimes
+    {
+        uint64_t playersUs = 0;
+        uint64_t npcsUs = 0;
+        uint64_t aurasUs = 0;
+        uint64_t respawnsUs = 0;
+        uint64_t duelsUs = 0;
+    };
+    void setPhaseProfiling(bool enabled) { m_phaseProfiling = enabled; }
+    const PhaseTimes& getPhaseTimes() const { return m_phaseTimes; }
+    void resetPhaseTimes() { m_phaseTimes = PhaseTimes{}; }
+
+    // Coalesced container sync (see Player::markInventoryDirty). Players
+    // with dirty inventory/equipment/bank/quest items queue themselves once;
+    // the main loop flushes the queue at the end of each iteration.
+    void queueContainerSync(Player* player);
+    void cancelContainerSync(Player* player);
+    void flushContainerSyncs();
+
+    // Queued client movement (see Player::queueMove). Players queue
+    // themselves once; update() applies the queue before anything else.
+    void queueMovement(Player* player);
+    void cancelMovement(Player* player);
+    void flushMovement();
+
+    // Coalesced NPC lifecycle replication (see NpcLifecycleEvent). NPCs
+    // queue themselves once per tick; update() flushes the queue last.
+    void queueNpcLifecycle(Npc* npc);
+    void flushNpcLifecycle();
+
     // Visibility system (Task 4.7)
     // Updates which players can see which - call after significant movement
     void updateVisibility(Player* player);
@@ -98,9 +134,15 @@ public:
     // Get NPC by GUID
     Npc* getNpc(uint32_t guid) const;
 
+    // Get player or NPC by GUID
+    Entity* findEntity(uint32_t guid) const;
+
     // Get all NPCs on a specific map
     std::vector<Npc*> getNpcsOnMap(int mapId) const;
 
+    // Get quest giver NPCs of one entry on a map (spawned or not)
+    std::vector<Npc*> getQuestGiversOnMap(int mapId, int32_t entry) const;
+
     // Get all NPCs
     std::vector<Npc*> getAllNpcs() const;
 
@@ -110,12 +152,6 @@ public:
     // Send NPC spawn packet to a player
     void sendNpcTo(Player* target, Npc* npc);
 
-    // Broadcast NPC to all players on map
-    void broadcastNpcSpawn(Npc* npc);
-
-    // Broadcast NPC despawn to all players on map
-    void broadcastNpcDespawn(Npc* npc);
-
     // Broadcast entity updates (resend full entity packet for variable changes)
     // Used when GP_Server_ObjectVariable is not supported by client
     void broadcastPlayerUpdate(Player* player);
@@ -130,6 +166,10 @@ private:
     // Send player packet to a specific player (for spawn visibility)
     void sendPlayerTo(Player* target, Player* playerToSend);
 
+    // Rebuild an entity's cached spawn packet (see SpawnPacketCache)
+    void buildPlayerSpawnPacket(Player* player);
+    void buildNpcSpawnPacket(Npc* npc);
+
     // Send destroy packet to a specific player
     void sendDestroyTo(Player* target, uint32_t guid);
 
@@ -139,14 +179,43 @@ private:
     // Players grouped by map ID for efficient map-local operations
     std::unordered_map<int, std::unordered_set<Player*>> m_playersByMap;
 
+    // Per-tick player state, contiguous per map (see PlayerHotState). A
+    // player holds a slot from its map's pool from addPlayer() until
+    // removePlayer() or shutdown() parks it back inside the Player.
+    std::unordered_map<int, HotStatePool<PlayerHotState>> m_playerHotByMap;
+
+    // Per-tick NPC state, contiguous per map (see NpcHotState). Declared
+    // before m_npcs so the slots outlive the NPCs referencing them.
+    std::unordered_map<int, HotStatePool<NpcHotState>> m_npcHotByMap;
+
     // All NPCs by GUID (owns the Npc objects)
     std::unordered_map<uint32_t, std::unique_ptr<Npc>> m_npcs;
 
     // NPCs grouped by map ID for efficient map-local operations
     std::unordered_map<int, std::unordered_set<Npc*>> m_npcsByMap;
 
+    // Quest givers keyed by (mapId << 32 | entry) for gossip status refreshes
+    std::unordered_map<uint64_t, std::vector<Npc*>> m_questGiversByMapEntry;
+    static uint64_t questGiverKey(int mapId, int32_t entry)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(mapId)) << 32) | static_cast<uint32_t>(entry);
+    }
+
     // GUID counter for NPCs (uses high bits to distinguish from players)
-    uint32_t m_nextNpcGuid = 0x80000000;  // Start NPCs at high GUID range
+    static constexpr uint32_t NPC_GUID_BASE = 0x80000000;
+    uint32_t m_nextNpcGuid = NPC_GUID_BASE;  // Start NPCs at high GUID range
+
+    bool m_phaseProfiling = false;
+    PhaseTimes m_phaseTimes;
+
+    // Players awaiting a container sync (each queued at most once)
+    std::vector<Player*> m_pendingContainerSyncs;
+
+    // Players with queued movement (each queued at most once)
+    std::vector<Player*> m_pendingMovement;
+
+    // NPCs with lifecycle events to replicate (each queued at most once)
+    std::vector<Npc*> m_pendingNpcLifecycle;
 
     // Thread safety
     mutable std::mutex m_mutex;
@@ -7,26 +7,48 @@
 #include "Core/Config.h"
 #include "Core/Logger.h"
 #include "Core/GameClock.h"
+#include "Core/HeadlessSimulation.h"
+#include "Core/Random.h"
+#include "Combat/SpellDescriptor.h"
 #include "Database/AsyncSaver.h"
+#include "Database/BackupManager.h"
 #include "Database/DatabaseManager.h"
 #include "Database/GameData.h"
+#include "Network/Acceptor.h"
 #include "Network/Session.h"
 #include "Network/SessionManager.h"
 #include "Network/PacketRouter.h"
+#include "Network/HotUpgrade.h"
+#include "Network/SocketPoller.h"
+#include "Network/LatencyMonitor.h"
+#include "Network/Gateway.h"
+#include "Network/WorldShard.h"
 #include "World/WorldManager.h"
 #include "World/MapManager.h"
+#include "World/WorldCheckpoint.h"
 #include "Systems/VendorSystem.h"
 #include "Systems/GossipSystem.h"
 #include "Systems/GuildSystem.h"
+#include "Systems/ChatFilter.h"
+#include "Systems/QuestManager.h"
 #include "SfSocket.h"
-#include <SFML/Network/TcpListener.hpp>
-#include <SFML/Network/SocketSelector.hpp>
 #include <csignal>
 #include <atomic>
+#include <cstdio>
+#include <cstdlib>
 
 // Global flag for graceful shutdown
 static std::atomic<bool> g_running{true};
 
+// Set by SIGHUP; reloads data files that support it (chat filter)
+static std::atomic<bool> g_reloadRequested{false};
+
+// Set by SIGUSR2; hands sessions over to a freshly started server binary
+static std::atomic<bool> g_upgradeRequested{false};
+
+// Set by SIGUSR1; takes an online backup of the server database now
+static std::atomic<bool> g_backupRequested{false};
+
 // Signal handler for graceful shutdown (Ctrl+C)
 void signalHandler(int signum)
 {
@@ -34,16 +56,54 @@ void signalHandler(int signum)
         LOG_INFO("Shutdown signal received...");
         g_running = false;
     }
+#ifdef SIGHUP
+    else if (signum == SIGHUP) {
+        g_reloadRequested = true;
+    }
+#endif
+#ifdef SIGUSR2
+    else if (signum == SIGUSR2) {
+        g_upgradeRequested = true;
+    }
+#endif
+#ifdef SIGUSR1
+    else if (signum == SIGUSR1) {
+        g_backupRequested = true;
+    }
+#endif
 }
 
 int main(int argc, char* argv[])
 {
-    (void)argc;
-    (void)argv;
+    sHotUpgrade.initialize(argc, argv);
+
+    // --simulate N: headless world simulation instead of a network server
+    SimulationOptions simulation;
+    bool simulate = HeadlessSimulation::parseArguments(argc, argv, simulation);
+    if (simulate) {
+        Random::seed(simulation.seed);  // Before any spawn rolls
+    }
+
+    // --gateway / --world N: one process of the multi-process server
+    ShardOptions shard;
+    if (!ShardArguments::parse(argc, argv, shard)) {
+        return 1;
+    }
+    bool worldProcess = !simulate && shard.role == ShardRole::World;
+    bool shardProcess = !simulate && shard.role != ShardRole::Standalone;
 
     // Register signal handlers
     std::signal(SIGINT, signalHandler);
     std::signal(SIGTERM, signalHandler);
+#ifdef SIGHUP
+    std::signal(SIGHUP, signalHandler);
+#endif
+#ifdef SIGUSR2
+    std::signal(SIGUSR2, signalHandler);
+#endif
+#ifdef SIGUSR1
+    std::signal(SIGUSR1, signalHandler);
+#endif
 
     // Print startup banner
     LOG_INFO("===========================================");
@@ -58,11 +118,17 @@ int main(int argc, char* argv[])
 
     LOG_INFO("Server Port: %d", sConfig.getServerPort());
     LOG_INFO("Max Connections: %d", sConfig.getMaxConnections());
+    if (shard.role == ShardRole::Gateway) {
+        LOG_INFO("Role: gateway");
+    } else if (shard.role == ShardRole::World) {
+        LOG_INFO("Role: world %u", shard.worldId);
+    }
 
-    // Initialize databases
-    if (!sDatabase.open(sConfig.getServerDbPath())) {
+    // Initialize databases (simulation runs against a throwaway in-memory DB)
+    std::string serverDbPath = simulate ? HeadlessSimulation::DATABASE_PATH : sConfig.getServerDbPath();
+    if (!sDatabase.open(serverDbPath)) {
         LOG_WARN("Could not open server database, creating new one");
-        if (!sDatabase.open(sConfig.getServerDbPath())) {
+        if (!sDatabase.open(serverDbPath)) {
             LOG_ERROR("Failed to create server database");
             return 1;
         }
@@ -79,12 +145,21 @@ int main(int argc, char* argv[])
         return 1;
     }
 
+    // Compile spells for the cast pipeline
+    sSpellDescriptors.build();
+
     // Load vendor data (Phase 6, Task 6.5)
     sVendorManager.loadVendorData();
 
     // Load gossip data (Phase 7, Task 7.5)
     sGossipManager.loadGossipData();
 
+    // Index quest givers and enders for gossip status lookups
+    sQuestManager.initialize();
+
+    // Compile chat filter dictionary (reloaded on SIGHUP)
+    sChatFilter.load(sConfig.getChatFilterPath());
+
     // Load guild data (Phase 8, Task 8.6)
     sGuildManager.loadGuildsFromDatabase();
 
@@ -98,8 +173,15 @@ int main(int argc, char* argv[])
     }
     else
     {
-        // Preload default start map to seed NPC spawns
-        sMapManager.getMap(sMapManager.getDefaultStartMapId());
+        // Warm restart: reload every checkpointed map with its respawn
+        // timers and corpses before anyone connects
+        if (!simulate && !shardProcess && sConfig.getCheckpointEnabled())
+            sWorldCheckpoint.restore(sConfig.getCheckpointPath());
+
+        // Preload default start map to seed NPC spawns; the gateway hosts
+        // no maps, and a world process preloads the ones it owns
+        if (!shardProcess)
+            sMapManager.getMap(sMapManager.getDefaultStartMapId());
     }
 
     // Initialize world manager
@@ -112,22 +194,150 @@ int main(int argc, char* argv[])
     sGameClock.setTickRate(20); // 20 ticks per second
     sGameClock.start();
 
-    // Create TCP listener
-    sf::TcpListener listener;
-    listener.setBlocking(false);
+    if (simulate) {
+        int result = HeadlessSimulation::run(simulation);
+        sSessionManager.disconnectAll("Simulation finished");
+        sWorldManager.shutdown();
+        sAsyncSaver.flush();
+        sAsyncSaver.stop();
+        sDatabase.close();
+        return result;
+    }
+
+    // Daily online backups of the server database (taken by the gateway
+    // in multi-process mode)
+    if (!worldProcess)
+        sBackupManager.start(sConfig.getServerDbPath());
+
+    // Periodic world checkpoint for warm restarts
+    if (!shardProcess && sConfig.getCheckpointEnabled())
+        sWorldCheckpoint.start(sConfig.getCheckpointPath(), sConfig.getCheckpointIntervalSeconds());
+
+    // Readiness polling for the listener and session sockets
+    SocketPoller poller(SocketPoller::backendFromString(sConfig.getNetworkBackend()));
+    LOG_INFO("Network backend: %s", SocketPoller::backendToString(poller.getBackend()));
 
-    if (listener.listen(sConfig.getServerPort()) != sf::Socket::Done) {
+    // A world process takes its clients from the gateway instead of a
+    // listener
+    if (worldProcess) {
+        if (!sWorldShard.connect(sConfig.getShardSocketPath(), shard.worldId, sConfig.getShardMaps(), poller)) {
+            LOG_ERROR("World %u could not join the gateway", shard.worldId);
+            return 1;
+        }
+        for (int32_t mapId : sWorldShard.getOwnedMaps()) {
+            sMapManager.getMap(mapId);
+        }
+        if (sWorldShard.ownsMap(sMapManager.getDefaultStartMapId()))
+            sMapManager.getMap(sMapManager.getDefaultStartMapId());
+    }
+
+    // Create TCP listener, or take over the running server's listener and
+    // sessions when started by a hot upgrade
+    std::vector<Session*> restored;
+    if (sHotUpgrade.isSuccessor()) {
+        if (!sHotUpgrade.receive(restored)) {
+            LOG_ERROR("Hot upgrade handoff failed");
+            return 1;
+        }
+    }
+    else if (!worldProcess && !sAcceptor.listen(sConfig.getServerPort())) {
         LOG_ERROR("Failed to bind to port %d", sConfig.getServerPort());
         return 1;
     }
-    LOG_INFO("Listening on port %d", sConfig.getServerPort());
+    if (!worldProcess) {
+        LOG_INFO("Listening on port %d", sConfig.getServerPort());
+        poller.add(sAcceptor.getListener(), SocketPollerConfig::LISTENER_TOKEN);
+    }
+    for (Session* session : restored) {
+        poller.add(*session->getSocket(), session->getId());
+    }
+
+    // The gateway hands characters to the world processes that connect here
+    if (shard.role == ShardRole::Gateway &&
+        !sGateway.start(sConfig.getShardSocketPath(), sConfig.getShardMaps(), poller)) {
+        LOG_ERROR("Gateway could not listen on %s", sConfig.getShardSocketPath().c_str());
+        return 1;
+    }
 
-    // Socket selector for efficient polling
-    sf::SocketSelector selector;
-    selector.add(listener);
+    // Connections cleared by the acceptor, attached to sessions in one batch
+    std::vector<AcceptedConnection> admitted;
+    auto attachAdmitted = [&]() {
+        for (AcceptedConnection& connection : admitted) {
+            Session* session = sSessionManager.createSession(connection.address);
+            LOG_INFO("Session %u connected from %s",
+                     session->getId(), connection.socket->getRemoteAddress().c_str());
+
+            session->setSocket(std::move(connection.socket));
+            poller.add(*session->getSocket(), session->getId());
+        }
+        admitted.clear();
+    };
+
+    // Single teardown path for sessions: detach the socket from the
+    // poller, then destroy the session
+    auto removePendingSessions = [&]() {
+        for (uint32_t id : sSessionManager.takePendingRemovals()) {
+            Session* session = sSessionManager.getSession(id);
+            if (session && session->getSocket() && session->getSocket()->getSocket()) {
+                poller.remove(*session->getSocket());
+            }
+            sSessionManager.removeSession(id);
+        }
+    };
 
     LOG_INFO("Server started. Press Ctrl+C to shutdown.");
 
+    // Receive and dispatch everything a readable session has sent
+    auto processSession = [&](Session& session) {
+        try {
+            SfSocket* socket = session.getSocket();
+            if (!socket || !socket->isConnected()) {
+                sSessionManager.queueRemoval(session.getId());
+                return;
+            }
+
+            // Receive packets
+            std::vector<std::unique_ptr<StlBuffer>> packets;
+            socket->receive(packets);
+
+            // Check for disconnection
+            if (!socket->isConnected()) {
+                LOG_INFO("Session %u disconnected", session.getId());
+                sSessionManager.queueRemoval(session.getId());
+                return;
+            }
+
+            // Process received packets
+            for (auto& packet : packets) {
+                if (packet->size() < 2) {
+                    LOG_WARN("Session %u: Malformed packet (size=%zu)",
+                             session.getId(), packet->size());
+                    continue;
+                }
+
+                uint16_t opcode;
+                *packet >> opcode;
+
+                size_t queuedBefore = socket->getPendingSendSize();
+                uint64_t handlerStart = LatencyMonitor::nowMicros();
+                sPacketRouter.dispatch(session, opcode, *packet);
+                sLatencyMonitor.recordDispatch(session, opcode, handlerStart,
+                                               socket->getPendingSendSize() > queuedBefore);
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR("Session %u: Network error: %s", session.getId(), e.what());
+            sSessionManager.queueRemoval(session.getId());
+        } catch (...) {
+            LOG_ERROR("Session %u: Unknown network error", session.getId());
+            sSessionManager.queueRemoval(session.getId());
+        }
+    };
+
+    std::vector<uint32_t> readyTokens;
+
+    // Set once a hot upgrade successor owns the sockets
+    bool handedOff = false;
+
     // Main server loop
     while (g_running) {
         try {
@@ -135,105 +345,77 @@ int main(int argc, char* argv[])
             bool shouldTick = sGameClock.tick();
 
             // Poll for network activity (short timeout to maintain responsiveness)
-            if (selector.wait(sf::milliseconds(10))) {
-                // Check for new connections
-                if (selector.isReady(listener)) {
-                    Session* session = sSessionManager.createSession();
-                    if (session) {
-                        auto socket = std::make_unique<SfSocket>(SfSocket::Type::ServerSide);
-                        sf::TcpSocket* rawSocket = socket->getSocket();
-
-                        if (listener.accept(*rawSocket) == sf::Socket::Done) {
-                            rawSocket->setBlocking(false);
-                            LOG_INFO("Session %u connected from %s",
-                                     session->getId(),
-                                     rawSocket->getRemoteAddress().toString().c_str());
-
-                            session->setSocket(std::move(socket));
-                            selector.add(*session->getSocket()->getSocket());
-                        } else {
-                            LOG_WARN("Failed to accept connection");
-                            sSessionManager.removeSession(session->getId());
-                        }
-                    } else {
-                        // Accept and immediately close to reject connection
-                        sf::TcpSocket rejector;
-                        listener.accept(rejector);
-                        LOG_WARN("Connection rejected (server full)");
+            readyTokens.clear();
+            if (poller.wait(10, readyTokens)) {
+                sLatencyMonitor.beginIteration(LatencyMonitor::nowMicros());
+
+                for (uint32_t token : readyTokens) {
+                    // Check for new connections (drains the whole backlog)
+                    if (token == SocketPollerConfig::LISTENER_TOKEN) {
+                        sAcceptor.acceptPending(admitted);
+                        attachAdmitted();
+                        continue;
                     }
-                }
 
-                // Process existing sessions
-                std::vector<uint32_t> sessionsToRemove;
-
-                sSessionManager.forEachSession([&](Session& session) {
-                    try {
-                        SfSocket* socket = session.getSocket();
-                        if (!socket || !socket->isConnected()) {
-                            sessionsToRemove.push_back(session.getId());
-                            return;
-                        }
-
-                        sf::TcpSocket* rawSocket = socket->getSocket();
-                        if (selector.isReady(*rawSocket)) {
-                            // Receive packets
-                            std::vector<std::unique_ptr<StlBuffer>> packets;
-                            socket->receive(packets);
-
-                            // Check for disconnection
-                            if (!socket->isConnected()) {
-                                LOG_INFO("Session %u disconnected", session.getId());
-                                selector.remove(*rawSocket);
-                                sessionsToRemove.push_back(session.getId());
-                                return;
-                            }
-
-                            // Process received packets
-                            for (auto& packet : packets) {
-                                if (packet->size() < 2) {
-                                    LOG_WARN("Session %u: Malformed packet (size=%zu)",
-                                             session.getId(), packet->size());
-                                    continue;
-                                }
-
-                                uint16_t opcode;
-                                *packet >> opcode;
-                                sPacketRouter.dispatch(session, opcode, *packet);
-                            }
-                        }
-                    } catch (const std::exception& e) {
-                        LOG_ERROR("Session %u: Network error: %s", session.getId(), e.what());
-                        sessionsToRemove.push_back(session.getId());
-                    } catch (...) {
-                        LOG_ERROR("Session %u: Unknown network error", session.getId());
-                        sessionsToRemove.push_back(session.getId());
+                    // Links between the gateway and world processes
+                    if (sGateway.isActive() && Gateway::ownsToken(token)) {
+                        sGateway.onReadable(token, poller);
+                        continue;
+                    }
+                    if (sWorldShard.ownsToken(token)) {
+                        sWorldShard.onReadable(poller);
+                        continue;
                     }
-                });
 
-                // Remove disconnected sessions (remove from selector first)
-                for (uint32_t id : sessionsToRemove) {
-                    Session* session = sSessionManager.getSession(id);
-                    if (session && session->getSocket() && session->getSocket()->getSocket()) {
-                        selector.remove(*session->getSocket()->getSocket());
+                    // Only sessions with data (or a hangup) are touched
+                    Session* session = sSessionManager.getSession(token);
+                    if (session) {
+                        processSession(*session);
                     }
-                    sSessionManager.removeSession(id);
                 }
             }
 
-            // On each tick, update game systems
+            // On each tick, expire sessions whose timeout bucket came due
             if (shouldTick) {
-                // Update session manager (timeout checks)
                 sSessionManager.update();
+                sLatencyMonitor.update();
+            }
 
-                // Remove timed out sessions from selector
-                sSessionManager.forEachSession([&](Session& session) {
-                    if (session.shouldRemove()) {
-                        if (session.getSocket() && session.getSocket()->getSocket()) {
-                            selector.remove(*session.getSocket()->getSocket());
-                        }
-                    }
-                });
+            // Remove disconnected and timed out sessions in one pass
+            removePendingSessions();
+
+            // Move queued connections into any capacity freed above
+            sAcceptor.update(admitted);
+            attachAdmitted();
+
+            // Hot reload requested by SIGHUP
+            if (g_reloadRequested.exchange(false)) {
+                LOG_INFO("Reload signal received...");
+                sChatFilter.reload();
+            }
+
+            // Backup requested by SIGUSR1 (runs on the backup thread)
+            if (g_backupRequested.exchange(false)) {
+                LOG_INFO("Backup signal received...");
+                sBackupManager.requestBackup();
+            }
+
+            // Hot upgrade requested by SIGUSR2; the handoff happens once
+            // the new binary has finished loading
+            if (g_upgradeRequested.exchange(false)) {
+                LOG_INFO("Upgrade signal received...");
+                if (shardProcess)
+                    LOG_WARN("Hot upgrade is not supported in multi-process mode");
+                else
+                    sHotUpgrade.start();
+            }
+            if (sHotUpgrade.isInProgress() && sHotUpgrade.poll(poller)) {
+                handedOff = true;
+                g_running = false;
+            }
 
+            // On each tick, update game systems
+            if (shouldTick) {
                 // Update world manager (updates all players) with error handling
                 try {
                     sWorldManager.update(sGameClock.getDeltaTime());
@@ -243,16 +425,33 @@ int main(int argc, char* argv[])
                     LOG_ERROR("Unknown world update error");
                 }
 
+                sWorldCheckpoint.update(sGameClock.getDeltaTime());
+
                 // Periodic status logging (every ~60 seconds)
                 static uint64_t lastStatusTick = 0;
                 if (sGameClock.getTickCount() - lastStatusTick >= 60ULL * sGameClock.getTickRate()) {
                     lastStatusTick = sGameClock.getTickCount();
-                    LOG_INFO("Uptime: %s | Sessions: %zu | Ticks: %llu",
+                    LOG_INFO("Uptime: %s | Sessions: %zu | Queued: %zu | Ticks: %llu",
                              sGameClock.getUptimeString().c_str(),
                              sSessionManager.getSessionCount(),
+                             sAcceptor.getQueueSize(),
                              static_cast<unsigned long long>(sGameClock.getTickCount()));
+                    sLatencyMonitor.report();
                 }
             }
+
+            // One inventory/equipment/bank update per dirty player, then
+            // write everything queued for sessions during this iteration
+            sWorldManager.flushContainerSyncs();
+            sSessionManager.flushPendingSends();
+            sGateway.flush(poller);
+            sWorldShard.flush();
+            poller.submit();
+            sLatencyMonitor.recordFlush();
+
+            // Without the gateway no client can reach this world
+            if (sWorldShard.isLinkLost())
+                g_running = false;
         } catch (const std::exception& e) {
             LOG_ERROR("Main loop exception: %s - server continues", e.what());
         } catch (...) {
@@ -260,31 +459,48 @@ int main(int argc, char* argv[])
         }
     }
 
+    // The successor now owns every socket and has reloaded the players;
+    // leave without disconnecting or saving anything
+    if (handedOff) {
+        LOG_INFO("Handed off to upgraded server. Goodbye!");
+        std::fflush(nullptr);
+        std::_Exit(0);
+    }
+
     // ========================================
     // Graceful Shutdown Sequence
     // ========================================
     LOG_INFO("Initiating graceful shutdown...");
 
     // 1. Stop accepting new connections
-    listener.close();
-    LOG_INFO("Stopped accepting connections");
+    if (!worldProcess) {
+        poller.remove(sAcceptor.getListener());
+        sAcceptor.close();
+        LOG_INFO("Stopped accepting connections");
+    }
 
-    // 2. Disconnect all sessions with message
+    // 2. Disconnect all sessions with message, then close the links to
+    //    the other processes with the Leave / Kick messages that produced
     sSessionManager.disconnectAll("Server shutting down");
+    sGateway.stop(poller);
+    sWorldShard.disconnect(poller);
 
-    // 3. Remove remaining sessions from selector
+    // 3. Remove remaining sessions from poller
     sSessionManager.forEachSession([&](Session& session) {
         if (session.getSocket() && session.getSocket()->getSocket()) {
-            selector.remove(*session.getSocket()->getSocket());
+            poller.remove(*session.getSocket());
         }
     });
 
-    // 4. Shutdown world manager
+    // 4. Checkpoint the world (written by the saver flush below), then
+    //    shutdown world manager
+    sWorldCheckpoint.checkpoint();
     sWorldManager.shutdown();
 
-    // 5. Flush and stop async saver
+    // 5. Flush and stop async saver, abandon any backup in progress
     sAsyncSaver.flush();
     sAsyncSaver.stop();
+    sBackupManager.stop();
 
     // 6. Close database
     sDatabase.close();
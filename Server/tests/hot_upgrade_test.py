@@ -0,0 +1,244 @@
+#!/usr/bin/env python3
+"""
+Hot Upgrade Test for Dreadmyst Server
+
+Logs a swarm of bots into the world, sends the server SIGUSR2 and checks
+that the upgrade is invisible to them: no bot is disconnected, each one is
+put back into the world by the successor (Server_NewWorld) and its pings
+are still answered afterwards.
+
+The successor is the binary at the server's own path, so rebuild (or
+leave) it in place before running. Bots are spread over 127.0.0.0/8
+source addresses so the per-address limit does not apply.
+
+Usage: python3 hot_upgrade_test.py --pid <server pid> [--bots 20]
+       [--seconds 10] [--host 127.0.0.1] [--port 8080]
+"""
+
+import argparse
+import os
+import random
+import signal
+import socket
+import string
+import struct
+import sys
+import threading
+import time
+
+# Opcodes (GamePacketBase.h)
+OPCODE_PING = 0x00
+OPCODE_SERVER_VALIDATE = 0x50
+OPCODE_SERVER_CHARACTER_LIST = 0x52
+OPCODE_SERVER_NEW_WORLD = 0x54
+OPCODE_CLIENT_AUTHENTICATE = 0x02
+OPCODE_CLIENT_CHARACTER_LIST = 0x03
+OPCODE_CLIENT_CHAR_CREATE = 0x04
+OPCODE_CLIENT_ENTER_WORLD = 0x06
+
+PING_INTERVAL = 1.0
+
+
+def frame(opcode, payload=b""):
+    """Wire format: [uint32 payload size][uint16 opcode][payload]"""
+    body = struct.pack("<H", opcode) + payload
+    return struct.pack("<I", len(body)) + body
+
+
+def pack_string(value):
+    encoded = value.encode("utf-8")
+    return struct.pack("<H", len(encoded)) + encoded
+
+
+class Bot:
+    """One logged-in client; a reader thread records what the server sends."""
+
+    def __init__(self, index, run_tag, host, port):
+        self.index = index
+        self.username = f"hu{run_tag}{index}"
+        self.char_name = "Hu" + run_tag + "".join(random.choice(string.ascii_lowercase) for _ in range(4))
+        self.host = host
+        self.port = port
+        self.sock = None
+        self.closed = False
+        self.error = None
+        self.validated = threading.Event()
+        self.characters = None
+        self.character_list = threading.Event()
+        self.new_worlds = 0
+        self.pongs = 0
+        self.lock = threading.Lock()
+
+    def connect(self):
+        source = f"127.{(self.index >> 16) & 0xFF}.{(self.index >> 8) & 0xFF}.{(self.index & 0xFF) or 1}"
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        self.sock.bind((source, 0))
+        self.sock.connect((self.host, self.port))
+        threading.Thread(target=self._read_loop, daemon=True).start()
+
+    def send(self, opcode, payload=b""):
+        self.sock.sendall(frame(opcode, payload))
+
+    def _read_loop(self):
+        buf = bytearray()
+        while True:
+            try:
+                data = self.sock.recv(65536)
+            except OSError as e:
+                self.error = str(e)
+                data = b""
+            if not data:
+                self.closed = True
+                return
+
+            buf.extend(data)
+            while len(buf) >= 6:
+                size = struct.unpack_from("<I", buf, 0)[0]
+                if len(buf) < 4 + size:
+                    break
+                opcode = struct.unpack_from("<H", buf, 4)[0]
+                self._handle(opcode, bytes(buf[6:4 + size]))
+                del buf[:4 + size]
+
+    def _handle(self, opcode, payload):
+        with self.lock:
+            if opcode == OPCODE_PING:
+                self.pongs += 1
+            elif opcode == OPCODE_SERVER_VALIDATE:
+                if payload and payload[0] == 0:
+                    self.validated.set()
+            elif opcode == OPCODE_SERVER_CHARACTER_LIST:
+                count = struct.unpack_from("<H", payload, 0)[0]
+                self.characters = []
+                pos = 2
+                for _ in range(count):
+                    guid = struct.unpack_from("<I", payload, pos)[0]
+                    name_len = struct.unpack_from("<H", payload, pos + 4)[0]
+                    pos += 4 + 2 + name_len + 1 + 1 + 4 + 4
+                    self.characters.append(guid)
+                self.character_list.set()
+            elif opcode == OPCODE_SERVER_NEW_WORLD:
+                self.new_worlds += 1
+
+    def request_characters(self, timeout):
+        self.character_list.clear()
+        self.send(OPCODE_CLIENT_CHARACTER_LIST)
+        return self.character_list.wait(timeout)
+
+    def login(self, timeout=10.0):
+        self.connect()
+        self.send(OPCODE_CLIENT_AUTHENTICATE,
+                  pack_string(f"{self.username}:password") + struct.pack("<i", 0) + pack_string(""))
+        if not self.validated.wait(timeout):
+            raise RuntimeError("authentication timed out")
+
+        if not self.request_characters(timeout):
+            raise RuntimeError("no character list")
+        if not self.characters:
+            self.send(OPCODE_CLIENT_CHAR_CREATE,
+                      pack_string(self.char_name) + struct.pack("<BBi", 1, 0, 1))
+            time.sleep(0.5)
+            if not self.request_characters(timeout) or not self.characters:
+                raise RuntimeError("character creation failed")
+
+        self.send(OPCODE_CLIENT_ENTER_WORLD, struct.pack("<I", self.characters[0]))
+        deadline = time.time() + timeout
+        while self.new_worlds == 0:
+            if self.closed or time.time() > deadline:
+                raise RuntimeError("world entry timed out")
+            time.sleep(0.05)
+
+    def ping(self):
+        try:
+            self.send(OPCODE_PING)
+        except OSError as e:
+            self.error = str(e)
+            self.closed = True
+
+
+def process_alive(pid):
+    try:
+        with open(f"/proc/{pid}/stat") as f:
+            return f.read().rsplit(")", 1)[1].split()[0] != "Z"
+    except OSError:
+        return False
+
+
+def ping_all(bots, seconds):
+    deadline = time.time() + seconds
+    while time.time() < deadline:
+        for bot in bots:
+            if not bot.closed:
+                bot.ping()
+        time.sleep(PING_INTERVAL)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--pid", type=int, required=True)
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--bots", type=int, default=20)
+    parser.add_argument("--seconds", type=float, default=10.0)
+    parser.add_argument("--handoff-timeout", type=float, default=60.0)
+    args = parser.parse_args()
+
+    run_tag = "".join(random.choice(string.ascii_lowercase) for _ in range(4))
+    bots = [Bot(i + 1, run_tag, args.host, args.port) for i in range(args.bots)]
+    for bot in bots:
+        try:
+            bot.login()
+        except (OSError, RuntimeError) as e:
+            print(f"FAIL: bot {bot.index} could not enter the world: {e}")
+            return 1
+    print(f"{len(bots)} bots in world")
+
+    ping_all(bots, 2.0)
+    for bot in bots:
+        with bot.lock:
+            bot.new_worlds = 0
+            bot.pongs = 0
+
+    print(f"Sending SIGUSR2 to {args.pid}")
+    os.kill(args.pid, signal.SIGUSR2)
+
+    # The predecessor exits once the successor has acknowledged the handoff
+    deadline = time.time() + args.handoff_timeout
+    while process_alive(args.pid):
+        if time.time() > deadline:
+            print("FAIL: server did not hand off (predecessor still running)")
+            return 1
+        for bot in bots:
+            if not bot.closed:
+                bot.ping()
+        time.sleep(PING_INTERVAL)
+    print("Predecessor exited")
+
+    ping_all(bots, args.seconds)
+
+    failures = 0
+    for bot in bots:
+        with bot.lock:
+            if bot.closed:
+                print(f"FAIL: bot {bot.index} disconnected ({bot.error or 'closed by server'})")
+            elif bot.new_worlds == 0:
+                print(f"FAIL: bot {bot.index} was not put back into the world")
+            elif bot.pongs == 0:
+                print(f"FAIL: bot {bot.index} got no ping replies after the upgrade")
+            else:
+                continue
+        failures += 1
+
+    for bot in bots:
+        bot.sock.close()
+
+    if failures:
+        print(f"FAIL: {failures}/{len(bots)} bots affected by the upgrade")
+        return 1
+
+    print(f"PASS: {len(bots)} bots stayed connected across the upgrade")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
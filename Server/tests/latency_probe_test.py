@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+"""
+Latency Probe Test for Dreadmyst Server
+
+Checks the server-initiated latency pings (LatencyMonitor) against a live
+server:
+  - probes are Mutual_Pings carrying a timestamp and a nonce, and each
+    probe has a fresh nonce and a later timestamp
+  - the client's own payload-less Mutual_Ping is always echoed, also while
+    a probe is outstanding
+  - a client that echoes probes keeps being probed
+
+With --log, also checks the server's periodic latency report (logged
+every ~60 s) shows an RTT sample for the echoing client.
+
+Usage: python3 latency_probe_test.py [--host 127.0.0.1] [--port 8080]
+       [--seconds 12] [--log server.log]
+"""
+
+import argparse
+import random
+import re
+import socket
+import string
+import struct
+import sys
+import threading
+import time
+
+# Opcodes (GamePacketBase.h)
+OPCODE_MUTUAL_PING = 0x00
+OPCODE_SERVER_VALIDATE = 0x50
+OPCODE_CLIENT_AUTHENTICATE = 0x02
+
+PROBE_PAYLOAD = struct.Struct("<QI")  # sentAtMicros, nonce
+
+
+def frame(opcode, payload=b""):
+    """Wire format: [uint32 payload size][uint16 opcode][payload]"""
+    body = struct.pack("<H", opcode) + payload
+    return struct.pack("<I", len(body)) + body
+
+
+def pack_string(value):
+    encoded = value.encode("utf-8")
+    return struct.pack("<H", len(encoded)) + encoded
+
+
+class Client:
+    """Authenticated connection; optionally echoes latency probes."""
+
+    def __init__(self, host, port, username, echo_probes):
+        self.echo_probes = echo_probes
+        self.probes = []          # (sentAtMicros, nonce)
+        self.ping_replies = 0     # Payload-less Mutual_Pings
+        self.validated = threading.Event()
+        self.closed = False
+        self.lock = threading.Lock()
+        self.sock = socket.create_connection((host, port))
+        threading.Thread(target=self._read_loop, daemon=True).start()
+        self.send(OPCODE_CLIENT_AUTHENTICATE,
+                  pack_string(f"{username}:password") + struct.pack("<i", 0) + pack_string(""))
+
+    def send(self, opcode, payload=b""):
+        self.sock.sendall(frame(opcode, payload))
+
+    def _read_loop(self):
+        buf = bytearray()
+        while True:
+            try:
+                data = self.sock.recv(65536)
+            except OSError:
+                data = b""
+            if not data:
+                self.closed = True
+                return
+
+            buf.extend(data)
+            while len(buf) >= 6:
+                size = struct.unpack_from("<I", buf, 0)[0]
+                if len(buf) < 4 + size:
+                    break
+                opcode = struct.unpack_from("<H", buf, 4)[0]
+                self._handle(opcode, bytes(buf[6:4 + size]))
+                del buf[:4 + size]
+
+    def _handle(self, opcode, payload):
+        if opcode == OPCODE_SERVER_VALIDATE:
+            if payload and payload[0] == 0:
+                self.validated.set()
+        elif opcode == OPCODE_MUTUAL_PING:
+            with self.lock:
+                if len(payload) >= PROBE_PAYLOAD.size:
+                    self.probes.append(PROBE_PAYLOAD.unpack_from(payload))
+                    if self.echo_probes:
+                        self.send(OPCODE_MUTUAL_PING, payload)
+                else:
+                    self.ping_replies += 1
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--seconds", type=float, default=12.0)
+    parser.add_argument("--log", help="server log to check for the latency report")
+    args = parser.parse_args()
+
+    tag = "".join(random.choice(string.ascii_lowercase) for _ in range(5))
+    echoing = Client(args.host, args.port, f"lpe{tag}", echo_probes=True)
+    silent = Client(args.host, args.port, f"lps{tag}", echo_probes=False)
+    for client in (echoing, silent):
+        if not client.validated.wait(10.0):
+            print("FAIL: authentication timed out")
+            return 1
+
+    # The silent client's probe stays outstanding; its own pings must still
+    # be answered
+    pings_sent = 0
+    deadline = time.time() + args.seconds
+    while time.time() < deadline:
+        silent.send(OPCODE_MUTUAL_PING)
+        pings_sent += 1
+        time.sleep(1.0)
+    time.sleep(1.0)
+
+    failures = []
+    if silent.closed or echoing.closed:
+        failures.append("server closed a connection")
+    if not silent.probes or not echoing.probes:
+        failures.append("no probe received")
+    if silent.ping_replies != pings_sent:
+        failures.append(f"{pings_sent} pings sent, {silent.ping_replies} echoed")
+    if echoing.ping_replies != 0:
+        failures.append(f"echoed probe was echoed back ({echoing.ping_replies} replies)")
+
+    for name, client in (("echoing", echoing), ("silent", silent)):
+        nonces = [nonce for _, nonce in client.probes]
+        stamps = [sent for sent, _ in client.probes]
+        if len(set(nonces)) != len(nonces):
+            failures.append(f"{name}: repeated probe nonce")
+        if stamps != sorted(stamps) or len(set(stamps)) != len(stamps):
+            failures.append(f"{name}: probe timestamps not increasing")
+
+    # One probe per interval while answered (5 s)
+    if len(echoing.probes) < int(args.seconds // 5):
+        failures.append(f"echoing client got only {len(echoing.probes)} probes")
+
+    if args.log:
+        # Wait for a report that includes an answering session
+        report = re.compile(r"Latency network map \d+: \d+ sessions \| ping RTT .* \((\d+) answering")
+        found = False
+        for _ in range(75):
+            with open(args.log, errors="replace") as f:
+                if any(int(m.group(1)) > 0 for m in report.finditer(f.read())):
+                    found = True
+                    break
+            echoing.send(OPCODE_MUTUAL_PING)  # Keep the connection busy
+            time.sleep(1.0)
+        if not found:
+            failures.append("latency report shows no answering session")
+
+    for client in (echoing, silent):
+        client.sock.close()
+
+    print(f"probes: echoing {len(echoing.probes)}, silent {len(silent.probes)}; "
+          f"pings echoed {silent.ping_replies}/{pings_sent}")
+    if failures:
+        for failure in failures:
+            print(f"FAIL: {failure}")
+        return 1
+
+    print("PASS: probes are timestamped and matched; client pings always echoed")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,241 @@
+#!/usr/bin/env python3
+"""
+Network Backend A/B Benchmark for Dreadmyst Server
+
+Holds a swarm of idle connections open while a smaller set of active
+clients ping as fast as the server answers, then reports ping round trips
+and the server's CPU time for the run.
+
+Against a running server (--pid), measures whatever [Server]
+NetworkBackend it was started with. With --server, starts the binary once
+per backend in --backends (default io_uring then epoll) from --workdir,
+switching NetworkBackend in its data/server.ini for each run (restored
+afterwards), and prints the results side by side.
+
+Connections are spread over 127.0.0.0/8 source addresses so the
+per-address limit does not apply; raise MaxConnections above the swarm
+size and LoginQueueSize to match.
+
+Usage: python3 network_backend_bench.py --pid <server pid> [--idle 2000]
+       [--active 32] [--seconds 20] [--host 127.0.0.1] [--port 8080]
+       python3 network_backend_bench.py --server <binary> --workdir <dir>
+       [--backends io_uring,epoll] [...]
+"""
+
+import argparse
+import os
+import re
+import signal
+import socket
+import struct
+import subprocess
+import sys
+import threading
+import time
+
+OPCODE_PING = 0
+
+
+def frame(opcode, payload=b""):
+    """Wire format: [uint32 payload size][uint16 opcode][payload]"""
+    body = struct.pack("<H", opcode) + payload
+    return struct.pack("<I", len(body)) + body
+
+
+def server_cpu_seconds(pid):
+    """User + system CPU time of the server process from /proc."""
+    with open(f"/proc/{pid}/stat") as f:
+        fields = f.read().rsplit(")", 1)[1].split()
+    ticks = os.sysconf("SC_CLK_TCK")
+    return (int(fields[11]) + int(fields[12])) / ticks
+
+
+def open_idle(host, port, count):
+    sockets = []
+    for i in range(count):
+        source = f"127.{(i >> 16) & 0xFF}.{(i >> 8) & 0xFF}.{(i & 0xFF) or 1}"
+        s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        try:
+            s.bind((source, 0))
+            s.connect((host, port))
+            sockets.append(s)
+        except OSError as e:
+            print(f"Idle connection {i} failed: {e}")
+            s.close()
+            break
+    return sockets
+
+
+def ping_loop(host, port, deadline, samples, index):
+    # Own source address, clear of the idle swarm's, so the per-address
+    # limit does not turn active clients away
+    s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    s.bind((f"127.255.{(index >> 8) & 0xFF}.{(index & 0xFF) or 1}", 0))
+    s.connect((host, port))
+    s.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    ping = frame(OPCODE_PING)
+    buf = bytearray()
+    rtts = []
+    while time.time() < deadline:
+        start = time.perf_counter()
+        s.sendall(ping)
+        while True:
+            data = s.recv(65536)
+            if not data:
+                samples[index] = rtts
+                return
+            buf.extend(data)
+            if len(buf) >= 4 and len(buf) >= 4 + struct.unpack_from("<I", buf, 0)[0]:
+                del buf[:4 + struct.unpack_from("<I", buf, 0)[0]]
+                break
+        rtts.append(time.perf_counter() - start)
+    s.close()
+    samples[index] = rtts
+
+
+def percentile(values, fraction):
+    if not values:
+        return 0.0
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(len(ordered) * fraction))]
+
+
+def run(args, pid):
+    """One measurement against the server process `pid`."""
+    idle = open_idle(args.host, args.port, args.idle)
+    print(f"Idle connections: {len(idle)}")
+    time.sleep(2.0)  # Let the server admit them
+
+    cpu_start = server_cpu_seconds(pid)
+    wall_start = time.time()
+    deadline = wall_start + args.seconds
+
+    samples = [None] * args.active
+    threads = [threading.Thread(target=ping_loop, args=(args.host, args.port, deadline, samples, i))
+               for i in range(args.active)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+
+    wall = time.time() - wall_start
+    cpu = server_cpu_seconds(pid) - cpu_start
+    rtts = [rtt for client in samples if client for rtt in client]
+
+    for s in idle:
+        s.close()
+
+    return {
+        "pings": len(rtts) / wall,
+        "p50": percentile(rtts, 0.50) * 1000,
+        "p99": percentile(rtts, 0.99) * 1000,
+        "cpu": 100.0 * cpu / wall,
+        "cpu_per_kping": 1000.0 * cpu / max(len(rtts), 1),
+    }
+
+
+def report(result):
+    print(f"Pings:      {result['pings']:.0f}/s")
+    print(f"RTT p50:    {result['p50']:.2f} ms")
+    print(f"RTT p99:    {result['p99']:.2f} ms")
+    print(f"Server CPU: {result['cpu']:.0f}% ({result['cpu_per_kping']:.3f} s per 1000 pings)")
+
+
+def set_backend(ini_path, backend):
+    with open(ini_path) as f:
+        text = f.read()
+    text, count = re.subn(r"(?m)^NetworkBackend=.*$", f"NetworkBackend={backend}", text)
+    if count == 0:
+        text = text.replace("[Server]\n", f"[Server]\nNetworkBackend={backend}\n", 1)
+    with open(ini_path, "w") as f:
+        f.write(text)
+
+
+def wait_for_port(host, port, timeout):
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        try:
+            socket.create_connection((host, port), timeout=1.0).close()
+            return True
+        except OSError:
+            time.sleep(0.2)
+    return False
+
+
+def run_backend(args, backend):
+    """Start the server with `backend`, measure, stop it."""
+    log_path = os.path.join(args.workdir, f"bench_{backend}.log")
+    with open(log_path, "w") as log:
+        server = subprocess.Popen([args.server], cwd=args.workdir, stdout=log, stderr=subprocess.STDOUT)
+    try:
+        if not wait_for_port(args.host, args.port, 60.0):
+            print(f"{backend}: server did not start (see {log_path})")
+            return None
+
+        # The poller falls back silently as far as this script can tell;
+        # only count runs that got the backend asked for
+        with open(log_path, errors="replace") as f:
+            active = re.search(r"Network backend: (\S+)", f.read())
+        if not active or active.group(1) != backend:
+            print(f"{backend}: server runs {active.group(1) if active else 'unknown'} instead")
+            return None
+
+        print(f"--- {backend} ---")
+        result = run(args, server.pid)
+        report(result)
+        return result
+    finally:
+        server.send_signal(signal.SIGTERM)
+        try:
+            server.wait(timeout=30)
+        except subprocess.TimeoutExpired:
+            server.kill()
+            server.wait()
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--pid", type=int, help="measure this running server")
+    parser.add_argument("--server", help="server binary to start once per backend")
+    parser.add_argument("--workdir", default=".", help="directory the server runs in (with data/server.ini)")
+    parser.add_argument("--backends", default="io_uring,epoll")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--idle", type=int, default=2000)
+    parser.add_argument("--active", type=int, default=32)
+    parser.add_argument("--seconds", type=float, default=20.0)
+    args = parser.parse_args()
+
+    if args.pid:
+        report(run(args, args.pid))
+        return 0
+
+    if not args.server:
+        parser.error("--pid or --server is required")
+
+    ini_path = os.path.join(args.workdir, "data", "server.ini")
+    with open(ini_path) as f:
+        original = f.read()
+
+    results = {}
+    try:
+        for backend in args.backends.split(","):
+            set_backend(ini_path, backend)
+            results[backend] = run_backend(args, backend)
+    finally:
+        with open(ini_path, "w") as f:
+            f.write(original)
+
+    print()
+    print(f"{'backend':<10} {'pings/s':>9} {'p50 ms':>8} {'p99 ms':>8} {'CPU %':>6} {'CPU s/1k':>9}")
+    for backend, result in results.items():
+        if result is None:
+            print(f"{backend:<10} {'failed':>9}")
+            continue
+        print(f"{backend:<10} {result['pings']:>9.0f} {result['p50']:>8.2f} {result['p99']:>8.2f} "
+              f"{result['cpu']:>6.0f} {result['cpu_per_kping']:>9.3f}")
+    return 0 if all(results.values()) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,326 @@
+#!/usr/bin/env python3
+"""
+Multi-Process Test for Dreadmyst Server
+
+Checks a gateway (--gateway) with two world processes (--world 1,
+--world 2) against a live setup:
+  - characters enter the world through the gateway, on the world process
+    owning their map, and the gateway answers their pings
+  - whispers reach a player on the other world and the sender gets the
+    confirmation; whispers to nobody come back as PlayerNotFound
+  - all-chat reaches players on the other world
+  - a character logging out and straight back in is entered again once
+    its world has saved it
+
+The second bot's character is placed on --remote-map in the server
+database before it enters, so run against a scratch server directory
+whose [Shard] Maps gives that map to world 2, e.g.
+
+    [Shard]
+    Maps=2:4
+
+    DreadmystServer --gateway &
+    DreadmystServer --world 1 &
+    DreadmystServer --world 2 &
+
+Usage: python3 shard_test.py --db data/server.db [--remote-map 4]
+       [--world-pids <pid> <pid>] [--host 127.0.0.1] [--port 8080]
+"""
+
+import argparse
+import random
+import socket
+import sqlite3
+import string
+import struct
+import sys
+import threading
+import time
+
+# Opcodes (GamePacketBase.h)
+OPCODE_PING = 0x00
+OPCODE_SERVER_VALIDATE = 0x50
+OPCODE_SERVER_CHARACTER_LIST = 0x52
+OPCODE_SERVER_NEW_WORLD = 0x54
+OPCODE_SERVER_CHAT_MSG = 0x87
+OPCODE_SERVER_CHAT_ERROR = 0x88
+OPCODE_SERVER_WORLD_ERROR = 0x9C
+OPCODE_CLIENT_AUTHENTICATE = 0x02
+OPCODE_CLIENT_CHARACTER_LIST = 0x03
+OPCODE_CLIENT_CHAR_CREATE = 0x04
+OPCODE_CLIENT_ENTER_WORLD = 0x06
+OPCODE_CLIENT_CHAT_MSG = 0x0A
+
+# ChatDefines::Channels / ChatError
+CHANNEL_WHISPER = 2
+CHANNEL_ALL_CHAT = 5
+CHANNEL_SYSTEM = 6
+CHAT_ERROR_PLAYER_NOT_FOUND = 1
+
+
+def frame(opcode, payload=b""):
+    """Wire format: [uint32 payload size][uint16 opcode][payload]"""
+    body = struct.pack("<H", opcode) + payload
+    return struct.pack("<I", len(body)) + body
+
+
+def pack_string(value):
+    encoded = value.encode("utf-8")
+    return struct.pack("<H", len(encoded)) + encoded
+
+
+def unpack_string(payload, pos):
+    length = struct.unpack_from("<H", payload, pos)[0]
+    return payload[pos + 2:pos + 2 + length].decode("utf-8", "replace"), pos + 2 + length
+
+
+class Bot:
+    """One client of the gateway; a reader thread records what it is sent."""
+
+    def __init__(self, username, char_name, host, port):
+        self.username = username
+        self.char_name = char_name
+        self.host = host
+        self.port = port
+        self.sock = None
+        self.closed = False
+        self.validated = threading.Event()
+        self.characters = None    # (guid, name)
+        self.character_list = threading.Event()
+        self.new_worlds = 0
+        self.world_errors = []
+        self.chat = []            # (channel, from name, text)
+        self.chat_errors = []
+        self.pongs = 0
+        self.lock = threading.Lock()
+
+    def connect(self):
+        self.closed = False
+        self.validated.clear()
+        self.sock = socket.create_connection((self.host, self.port))
+        threading.Thread(target=self._read_loop, args=(self.sock,), daemon=True).start()
+
+    def close(self):
+        self.sock.close()
+
+    def send(self, opcode, payload=b""):
+        self.sock.sendall(frame(opcode, payload))
+
+    def _read_loop(self, sock):
+        buf = bytearray()
+        while True:
+            try:
+                data = sock.recv(65536)
+            except OSError:
+                data = b""
+            if not data:
+                if sock is self.sock:
+                    self.closed = True
+                return
+
+            buf.extend(data)
+            while len(buf) >= 6:
+                size = struct.unpack_from("<I", buf, 0)[0]
+                if len(buf) < 4 + size:
+                    break
+                opcode = struct.unpack_from("<H", buf, 4)[0]
+                self._handle(opcode, bytes(buf[6:4 + size]))
+                del buf[:4 + size]
+
+    def _handle(self, opcode, payload):
+        with self.lock:
+            if opcode == OPCODE_PING:
+                self.pongs += 1
+            elif opcode == OPCODE_SERVER_VALIDATE:
+                if payload and payload[0] == 0:
+                    self.validated.set()
+            elif opcode == OPCODE_SERVER_CHARACTER_LIST:
+                count = struct.unpack_from("<H", payload, 0)[0]
+                self.characters = []
+                pos = 2
+                for _ in range(count):
+                    guid = struct.unpack_from("<I", payload, pos)[0]
+                    name, pos = unpack_string(payload, pos + 4)
+                    pos += 1 + 1 + 4 + 4
+                    self.characters.append((guid, name))
+                self.character_list.set()
+            elif opcode == OPCODE_SERVER_NEW_WORLD:
+                self.new_worlds += 1
+            elif opcode == OPCODE_SERVER_WORLD_ERROR:
+                self.world_errors.append(payload)
+            elif opcode == OPCODE_SERVER_CHAT_MSG:
+                channel = payload[0]
+                sender, pos = unpack_string(payload, 5)
+                text, _ = unpack_string(payload, pos)
+                self.chat.append((channel, sender, text))
+            elif opcode == OPCODE_SERVER_CHAT_ERROR:
+                self.chat_errors.append(payload[0])
+
+    def request_characters(self, timeout):
+        self.character_list.clear()
+        self.send(OPCODE_CLIENT_CHARACTER_LIST)
+        return self.character_list.wait(timeout)
+
+    def login(self, timeout=10.0):
+        self.connect()
+        self.send(OPCODE_CLIENT_AUTHENTICATE,
+                  pack_string(f"{self.username}:password") + struct.pack("<i", 0) + pack_string(""))
+        if not self.validated.wait(timeout):
+            raise RuntimeError("authentication timed out")
+
+        if not self.request_characters(timeout):
+            raise RuntimeError("no character list")
+        if not self.characters:
+            self.send(OPCODE_CLIENT_CHAR_CREATE,
+                      pack_string(self.char_name) + struct.pack("<BBi", 1, 0, 1))
+            time.sleep(0.5)
+            if not self.request_characters(timeout) or not self.characters:
+                raise RuntimeError("character creation failed")
+
+    def enter_world(self, timeout=10.0):
+        """Enter with the first character, retrying while its world is
+        still saving it from an earlier session"""
+        with self.lock:
+            self.new_worlds = 0
+            self.world_errors = []
+        deadline = time.time() + timeout
+        self.send(OPCODE_CLIENT_ENTER_WORLD, struct.pack("<I", self.characters[0][0]))
+        while True:
+            with self.lock:
+                if self.new_worlds:
+                    return
+                retry = bool(self.world_errors)
+                self.world_errors = []
+            if self.closed or time.time() > deadline:
+                raise RuntimeError("world entry timed out")
+            if retry:
+                time.sleep(0.2)
+                self.send(OPCODE_CLIENT_ENTER_WORLD, struct.pack("<I", self.characters[0][0]))
+            time.sleep(0.05)
+
+    def say(self, channel, text, target=""):
+        self.send(OPCODE_CLIENT_CHAT_MSG,
+                  struct.pack("<B", channel) + pack_string(text) + pack_string(target) + bytes(24))
+
+    def wait_chat(self, channel, text, timeout=5.0):
+        deadline = time.time() + timeout
+        while time.time() < deadline:
+            with self.lock:
+                if any(c == channel and text in t for c, _, t in self.chat):
+                    return True
+            time.sleep(0.05)
+        return False
+
+    def wait_chat_error(self, code, timeout=5.0):
+        deadline = time.time() + timeout
+        while time.time() < deadline:
+            with self.lock:
+                if code in self.chat_errors:
+                    return True
+            time.sleep(0.05)
+        return False
+
+
+def process_alive(pid):
+    try:
+        with open(f"/proc/{pid}/stat") as f:
+            return f.read().rsplit(")", 1)[1].split()[0] != "Z"
+    except OSError:
+        return False
+
+
+def place_character(db_path, guid, map_id):
+    """Move an offline character to the start of `map_id`"""
+    db = sqlite3.connect(db_path, timeout=5.0)
+    try:
+        db.execute("UPDATE characters SET map_id = ?, position_x = 18, position_y = 44 WHERE guid = ?",
+                   (map_id, guid))
+        db.commit()
+    finally:
+        db.close()
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--db", required=True, help="server database the processes share")
+    parser.add_argument("--remote-map", type=int, default=4, help="a map world 2 owns")
+    parser.add_argument("--world-pids", type=int, nargs="*", default=[])
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8080)
+    args = parser.parse_args()
+
+    tag = "".join(random.choice(string.ascii_lowercase) for _ in range(5))
+    local = Bot(f"sha{tag}", "Sha" + tag, args.host, args.port)
+    remote = Bot(f"shb{tag}", "Shb" + tag, args.host, args.port)
+
+    failures = []
+    try:
+        local.login()
+        local.enter_world()
+        remote.login()
+        place_character(args.db, remote.characters[0][0], args.remote_map)
+        remote.enter_world()
+    except (OSError, RuntimeError) as e:
+        print(f"FAIL: could not enter the world: {e}")
+        return 1
+    local_name = local.characters[0][1]
+    remote_name = remote.characters[0][1]
+    print(f"'{local_name}' and '{remote_name}' in world")
+
+    # Pings stay with the gateway
+    for _ in range(3):
+        local.send(OPCODE_PING)
+        remote.send(OPCODE_PING)
+        time.sleep(0.3)
+    time.sleep(0.5)
+    if local.pongs < 3 or remote.pongs < 3:
+        failures.append(f"pings answered {local.pongs}/3 and {remote.pongs}/3")
+
+    # Whisper to the other world, and to nobody
+    local.say(CHANNEL_WHISPER, f"hello {tag}", remote_name)
+    if not remote.wait_chat(CHANNEL_WHISPER, f"hello {tag}"):
+        failures.append("whisper did not reach the other world")
+    if not local.wait_chat(CHANNEL_SYSTEM, f"To [{remote_name}]"):
+        failures.append("no whisper confirmation from the other world")
+    time.sleep(1.1)  # Whisper rate limit
+    local.say(CHANNEL_WHISPER, "anyone?", "Nobody" + tag)
+    if not local.wait_chat_error(CHAT_ERROR_PLAYER_NOT_FOUND):
+        failures.append("whisper to nobody did not fail with PlayerNotFound")
+
+    # All-chat to both worlds
+    remote.say(CHANNEL_ALL_CHAT, f"all {tag}")
+    if not local.wait_chat(CHANNEL_ALL_CHAT, f"all {tag}"):
+        failures.append("all-chat did not reach the other world")
+    if not remote.wait_chat(CHANNEL_ALL_CHAT, f"all {tag}"):
+        failures.append("all-chat did not reach the sender's world")
+
+    # Straight back in after logging out
+    remote.close()
+    try:
+        remote.login()
+        remote.enter_world()
+    except (OSError, RuntimeError) as e:
+        failures.append(f"re-entering after logout failed: {e}")
+
+    remote.send(OPCODE_PING)
+    time.sleep(0.5)
+    if local.closed or remote.closed:
+        failures.append("gateway closed a connection")
+    for pid in args.world_pids:
+        if not process_alive(pid):
+            failures.append(f"world process {pid} exited")
+
+    local.close()
+    remote.close()
+
+    if failures:
+        for failure in failures:
+            print(f"FAIL: {failure}")
+        return 1
+
+    print("PASS: characters hosted by two world processes behind one gateway")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
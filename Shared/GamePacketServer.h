@@ -64,6 +64,21 @@ struct GP_Mutual_Ping : public GamePacket
     void unpack(StlBuffer& buf) override { (void)buf; }
 };
 
+// Server latency probe: a Mutual_Ping carrying the server's send time and
+// a nonce, echoed back unchanged. Client pings and the server's echo of
+// them have no payload.
+struct GP_Mutual_PingProbe : public GamePacket
+{
+    uint64_t m_sentAtMicros = 0;  // Server monotonic clock
+    uint32_t m_nonce = 0;
+
+    static constexpr size_t PAYLOAD_SIZE = sizeof(uint64_t) + sizeof(uint32_t);
+
+    uint16_t getOpcode() const override { return Opcode::Mutual_Ping; }
+    void pack(StlBuffer& buf) const override { buf << m_sentAtMicros << m_nonce; }
+    void unpack(StlBuffer& buf) override { buf >> m_sentAtMicros >> m_nonce; }
+};
+
 struct GP_Server_Validate : public GamePacket
 {
     uint8_t m_result = 0;  // AccountDefines::AuthenticateResult
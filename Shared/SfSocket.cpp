@@ -3,6 +3,7 @@
 
 #include "SfSocket.h"
 #include <SFML/Network.hpp>
+#include <algorithm>
 
 SfSocket::SfSocket(Type type)
     : m_type(type)
@@ -41,13 +42,59 @@ bool SfSocket::send(const StlBuffer& data)
     if (!m_socket || !isConnected())
         return false;
 
-    // Build packet with size header
-    StlBuffer packet;
-    packet.build(StlBuffer(std::vector<uint8_t>(data.data(), data.data() + data.size())));
+    queue(data);
+    return flush();
+}
+
+bool SfSocket::queue(const StlBuffer& data)
+{
+    size_t framed = sizeof(uint32_t) + data.size();
+    if (m_sendLimit != 0 && getPendingSendSize() + framed > m_sendLimit)
+        return false;
+
+    // Wire format: [4 bytes: payload size] [payload]
+    m_sendBuffer << static_cast<uint32_t>(data.size());
+    m_sendBuffer.write(reinterpret_cast<const char*>(data.data()), data.size());
+    return true;
+}
+
+bool SfSocket::flush()
+{
+    if (getPendingSendSize() == 0)
+        return true;
+
+    if (!m_socket)
+        return false;
+
+    if (m_transport)
+        return m_transport->submitSend(*this);
 
+    // Whatever the socket doesn't take now stays queued for the next flush
     size_t sent = 0;
-    auto status = m_socket->send(packet.data(), packet.size(), sent);
-    return (status == sf::Socket::Done || status == sf::Socket::Partial);
+    auto status = m_socket->send(getPendingSendData(), getPendingSendSize(), sent);
+    if (status == sf::Socket::Disconnected || status == sf::Socket::Error) {
+        m_sendBuffer.clear();
+        m_sendOffset = 0;
+        return false;
+    }
+
+    markSent(sent);
+    return true;
+}
+
+void SfSocket::markSent(size_t bytes)
+{
+    // Sent bytes are skipped rather than erased, so a partial send doesn't
+    // shift the backlog; the front is reclaimed once it outweighs the rest.
+    m_sendOffset += std::min(bytes, getPendingSendSize());
+
+    if (m_sendOffset == m_sendBuffer.size()) {
+        m_sendBuffer.clear();
+        m_sendOffset = 0;
+    } else if (m_sendOffset >= m_sendBuffer.size() / 2) {
+        m_sendBuffer.eraseFront(m_sendOffset);
+        m_sendOffset = 0;
+    }
 }
 
 void SfSocket::receive(std::vector<std::unique_ptr<StlBuffer>>& output)
@@ -55,15 +102,23 @@ void SfSocket::receive(std::vector<std::unique_ptr<StlBuffer>>& output)
     if (!m_socket)
         return;
 
-    // Receive into buffer
-    uint8_t tempBuf[4096];
-    size_t received = 0;
-    auto status = m_socket->receive(tempBuf, sizeof(tempBuf), received);
-
-    if (status == sf::Socket::Done && received > 0) {
-        // Append to receive buffer
-        for (size_t i = 0; i < received; ++i) {
-            m_recvBuffer << tempBuf[i];
+    if (m_transport) {
+        // The transport already read whatever arrived
+        if (m_receiveClosed) {
+            disconnect();
+            return;
+        }
+    } else {
+        // Receive into buffer
+        uint8_t tempBuf[4096];
+        size_t received = 0;
+        auto status = m_socket->receive(tempBuf, sizeof(tempBuf), received);
+
+        if (status == sf::Socket::Done && received > 0) {
+            // Append to receive buffer
+            for (size_t i = 0; i < received; ++i) {
+                m_recvBuffer << tempBuf[i];
+            }
         }
     }
 
@@ -111,6 +166,10 @@ bool SfSocket::isConnected() const
 void SfSocket::disconnect()
 {
     if (m_socket) {
+        // Detach first: the transport's queued I/O names the handle
+        if (m_transport)
+            m_transport->release(*this);
+        flush();  // Best effort for queued packets (e.g. a kick message)
         m_socket->disconnect();
     }
 }
@@ -6,6 +6,22 @@
 
 // Forward declaration
 namespace sf { class TcpSocket; }
+class SfSocket;
+
+// Moves a socket's bytes through an external event loop (the server's
+// io_uring backend) instead of SfSocket reading and writing it directly
+class SfSocketTransport
+{
+public:
+    virtual ~SfSocketTransport() = default;
+
+    // Start writing the socket's pending send data; false if the
+    // connection failed
+    virtual bool submitSend(SfSocket& socket) = 0;
+
+    // The socket is about to close; stop all I/O on it and detach
+    virtual void release(SfSocket& socket) = 0;
+};
 
 // Socket wrapper with packet buffering
 // Handles partial sends and receives
@@ -30,6 +46,17 @@ public:
 
     // Send packet (handles partial sends)
     bool send(const StlBuffer& data);
+
+    // Frame a packet into the send buffer without writing it; flush() sends
+    // everything queued in as few writes as the socket accepts. Returns
+    // false (and queues nothing) when the packet would take the unsent
+    // backlog past the send limit.
+    bool queue(const StlBuffer& data);
+    bool flush();
+    bool hasPendingSend() const { return getPendingSendSize() > 0; }
+
+    // Cap on unsent bytes (0 = unlimited)
+    void setSendLimit(size_t bytes) { m_sendLimit = bytes; }
     void sendPacket(StlBuffer data) { send(data); }  // Legacy alias
 
     // Receive packets (may return multiple)
@@ -49,6 +76,25 @@ public:
     // Access underlying socket (for polling)
     sf::TcpSocket* getSocket();
 
+    // Bytes received but not yet forming a complete packet (carried across
+    // a server hot upgrade)
+    const StlBuffer& getPendingReceive() const { return m_recvBuffer; }
+    void restorePendingReceive(const uint8_t* data, size_t size) { m_recvBuffer.write(reinterpret_cast<const char*>(data), size); }
+
+    // Queued bytes the socket has not accepted yet (same)
+    const uint8_t* getPendingSendData() const { return m_sendBuffer.data() + m_sendOffset; }
+    size_t getPendingSendSize() const { return m_sendBuffer.size() - m_sendOffset; }
+    void restorePendingSend(const uint8_t* data, size_t size) { m_sendBuffer.write(reinterpret_cast<const char*>(data), size); }
+
+    // While a transport is set, receive() only extracts packets from the
+    // bytes it delivered and flush() hands the pending data to it
+    void setTransport(SfSocketTransport* transport) { m_transport = transport; }
+    void deliverReceived(const uint8_t* data, size_t size) { m_recvBuffer.write(reinterpret_cast<const char*>(data), size); }
+    void deliverClosed() { m_receiveClosed = true; }
+
+    // Drop bytes the transport has written from the front of the backlog
+    void markSent(size_t bytes);
+
 private:
     Type m_type;
     std::unique_ptr<sf::TcpSocket> m_ownedSocket;
@@ -56,4 +102,8 @@ private:
     sf::TcpSocket* m_socket = nullptr;  // Points to either owned or shared
     StlBuffer m_recvBuffer;
     StlBuffer m_sendBuffer;
+    size_t m_sendOffset = 0;  // Bytes at the front of m_sendBuffer already sent
+    size_t m_sendLimit = 0;
+    SfSocketTransport* m_transport = nullptr;
+    bool m_receiveClosed = false;  // Transport saw the peer close
 };